@@ -49,6 +49,7 @@ class CLIR_EXPORT block_builder : public internal::declaration_builder {
     void add(expr e);
     void add(stmt s);
     void assign(expr a, expr b);
+    void return_value(expr e);
 
     template <typename F> block_builder &body(F &&f) {
         f(*this);
@@ -158,6 +159,7 @@ class CLIR_EXPORT function_builder {
     func get_product();
 
     void argument(data_type ty, var v);
+    void return_type(data_type ty);
     void qualifier(function_qualifier q);
     void attribute(attr a);
     template <typename F> void body(F &&f) {
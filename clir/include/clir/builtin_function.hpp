@@ -425,6 +425,20 @@
     X(intel_sub_group_block_write_us8, 2, 3)                                                       \
     X(intel_sub_group_block_write_us16, 2, 3)
 
+#define CLIR_EXTENSION_INTEL_BFLOAT16_CONVERSIONS(X)                                               \
+    X(intel_convert_bfloat16_as_ushort, 1, 1)                                                      \
+    X(intel_convert_bfloat162_as_ushort2, 1, 1)                                                    \
+    X(intel_convert_bfloat163_as_ushort3, 1, 1)                                                    \
+    X(intel_convert_bfloat164_as_ushort4, 1, 1)                                                    \
+    X(intel_convert_bfloat168_as_ushort8, 1, 1)                                                    \
+    X(intel_convert_bfloat1616_as_ushort16, 1, 1)                                                  \
+    X(intel_convert_as_bfloat16_float, 1, 1)                                                       \
+    X(intel_convert_as_bfloat162_float2, 1, 1)                                                     \
+    X(intel_convert_as_bfloat163_float3, 1, 1)                                                     \
+    X(intel_convert_as_bfloat164_float4, 1, 1)                                                     \
+    X(intel_convert_as_bfloat168_float8, 1, 1)                                                     \
+    X(intel_convert_as_bfloat1616_float16, 1, 1)
+
 #define CLIR_DECLARE_BUILTIN_FUNCTION_0_0(NAME) CLIR_EXPORT expr NAME();
 #define CLIR_DECLARE_BUILTIN_FUNCTION_1_1(NAME) CLIR_EXPORT expr NAME(expr e1);
 #define CLIR_DECLARE_BUILTIN_FUNCTION_2_2(NAME) CLIR_EXPORT expr NAME(expr e1, expr e2);
@@ -453,7 +467,8 @@
     CLIR_STANDARD_BUILTIN_FUNCTION(X)                                                              \
     CLIR_EXTENSION_INTEL_SUBGROUPS(X)                                                              \
     CLIR_EXTENSION_INTEL_SUBGROUPS_LONG(X)                                                         \
-    CLIR_EXTENSION_INTEL_SUBGROUPS_SHORT(X)
+    CLIR_EXTENSION_INTEL_SUBGROUPS_SHORT(X)                                                        \
+    CLIR_EXTENSION_INTEL_BFLOAT16_CONVERSIONS(X)
 
 namespace clir {
 
@@ -466,6 +481,7 @@ enum class extension { // values must be contiguous and start from 0
     cl_intel_subgroups_long,
     cl_intel_subgroups_short,
     cl_ext_float_atomics,
+    cl_intel_bfloat16_conversions,
     unknown // must be last
 };
 
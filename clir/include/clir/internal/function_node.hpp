@@ -37,12 +37,15 @@ class CLIR_EXPORT prototype : public visitable<prototype, function_node> {
     function_qualifier qualifiers() { return qualifiers_; }
     void qualifiers(function_qualifier q) { qualifiers_ = q; }
     std::vector<attr> &attributes() { return attributes_; }
+    data_type &return_type() { return return_type_; }
+    void return_type(data_type ty) { return_type_ = std::move(ty); }
 
   private:
     std::string name_;
     std::vector<std::pair<data_type, var>> args_;
     function_qualifier qualifiers_;
     std::vector<attr> attributes_;
+    data_type return_type_ = data_type(builtin_type::void_t);
 };
 
 class CLIR_EXPORT function : public visitable<function, function_node> {
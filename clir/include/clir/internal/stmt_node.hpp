@@ -23,7 +23,7 @@ namespace clir::internal {
 class CLIR_EXPORT stmt_node
     : public virtual_type_list<class declaration, class declaration_assignment,
                                class expression_statement, class block, class for_loop,
-                               class if_selection, class while_loop> {};
+                               class if_selection, class while_loop, class return_statement> {};
 
 class CLIR_EXPORT declaration : public visitable<declaration, stmt_node> {
   public:
@@ -132,6 +132,16 @@ class CLIR_EXPORT while_loop : public visitable<while_loop, stmt_node> {
     std::vector<attr> attributes_;
 };
 
+class CLIR_EXPORT return_statement : public visitable<return_statement, stmt_node> {
+  public:
+    return_statement(expr term) : term_(std::move(term)) {}
+    expr &term() { return term_; }
+    void term(expr e) { term_ = std::move(e); }
+
+  private:
+    expr term_;
+};
+
 } // namespace clir::internal
 
 #endif // STMT_NODE_20220405_HPP
@@ -23,6 +23,7 @@ class CLIR_EXPORT stmt : public handle<internal::stmt_node> {
 };
 
 CLIR_EXPORT stmt expression_statement(expr e);
+CLIR_EXPORT stmt return_statement(expr e);
 
 } // namespace clir
 
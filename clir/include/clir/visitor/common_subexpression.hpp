@@ -0,0 +1,144 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef COMMON_SUBEXPRESSION_20240502_HPP
+#define COMMON_SUBEXPRESSION_20240502_HPP
+
+#include "clir/export.hpp"
+#include "clir/expr.hpp"
+#include "clir/internal/expr_node.hpp"
+#include "clir/internal/function_node.hpp"
+#include "clir/internal/program_node.hpp"
+#include "clir/internal/stmt_node.hpp"
+#include "clir/visitor/expression_type.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace clir {
+
+class CLIR_EXPORT func;
+class CLIR_EXPORT prog;
+
+/**
+ * @brief Replaces repeated pure expressions by a temporary variable
+ *
+ * Value numbering is done per block. When an expression is found again, a temporary is declared
+ * in front of the statement that contains the first occurrence and all occurrences are replaced
+ * by the temporary. Only the largest repeated expressions are replaced. Variables declared as
+ * T v = e that are never modified afterwards serve as temporary for e.
+ *
+ * An expression is only reused while none of the variables it depends on is modified, and never
+ * across loop iterations. Loads from memory other than private arrays, calls of user functions,
+ * the branches of ?:, and the right-hand side of && and || are never touched. Comparisons and
+ * work-item queries are cheap and not replaced.
+ * Float multiplications that are the operand of an addition or subtraction are left alone such
+ * that the OpenCL compiler may still contract them to a mad.
+ */
+class CLIR_EXPORT common_subexpression_elimination {
+  public:
+    //! Summary of a visited expression
+    struct info {
+        bool pure = false;      ///< Expression has no side effects and only reads private memory
+        bool candidate = false; ///< Expression may be replaced by a temporary
+        std::size_t hash = 0;
+        std::vector<internal::expr_node const *> deps = {}; ///< Variables read
+        std::size_t value = std::numeric_limits<std::size_t>::max(); ///< Registered value
+    };
+
+    /* Expr nodes */
+    auto operator()(internal::expr_node &) -> info;
+    auto operator()(internal::variable &v) -> info;
+    auto operator()(internal::int_imm &i) -> info;
+    auto operator()(internal::uint_imm &i) -> info;
+    auto operator()(internal::float_imm &i) -> info;
+    auto operator()(internal::cl_mem_fence_flags_imm &i) -> info;
+    auto operator()(internal::unary_op &e) -> info;
+    auto operator()(internal::binary_op &e) -> info;
+    auto operator()(internal::ternary_op &e) -> info;
+    auto operator()(internal::access &e) -> info;
+    auto operator()(internal::call_builtin &fn) -> info;
+    auto operator()(internal::call &fn) -> info;
+    auto operator()(internal::cast &c) -> info;
+    auto operator()(internal::swizzle &s) -> info;
+
+    /* Stmt nodes */
+    void operator()(internal::declaration &d);
+    void operator()(internal::declaration_assignment &d);
+    void operator()(internal::expression_statement &e);
+    void operator()(internal::return_statement &e);
+    void operator()(internal::block &b);
+    void operator()(internal::for_loop &loop);
+    void operator()(internal::if_selection &is);
+    void operator()(internal::while_loop &loop);
+
+    /* Kernel nodes */
+    void operator()(internal::prototype &proto);
+    void operator()(internal::function &fn);
+    void operator()(internal::global_declaration &d);
+
+    /* Program nodes */
+    void operator()(internal::program &prg);
+
+  private:
+    struct value {
+        std::size_t hash;
+        expr e;     ///< First occurrence
+        expr *slot; ///< Location of the first occurrence
+        data_type ty;
+        expr holder = nullptr; ///< Variable that holds the value
+        std::size_t frame;
+        std::size_t stmt_index;
+        bool alive = true;
+        std::vector<std::size_t> uses = {}; ///< Later occurrences
+    };
+    struct use {
+        expr *slot;
+        bool active = true; ///< False if the enclosing expression is replaced as a whole
+    };
+    struct insertion {
+        std::size_t stmt_index;
+        std::size_t number;
+        stmt s;
+    };
+    struct frame {
+        internal::block *b; ///< nullptr for statements that are not a block
+        std::size_t stmt_index = 0;
+        std::vector<std::size_t> values = {};
+        std::vector<insertion> insertions = {};
+    };
+
+    CLIR_NO_EXPORT auto process(expr &slot) -> info;
+    CLIR_NO_EXPORT void process_lvalue(expr &e, info &i);
+    CLIR_NO_EXPORT void process_statement(expr &e);
+    CLIR_NO_EXPORT void visit_nested(stmt &s);
+    CLIR_NO_EXPORT void kill_modified(internal::expr_node &e);
+    CLIR_NO_EXPORT void kill_modified(internal::stmt_node &s);
+    CLIR_NO_EXPORT void kill(internal::expr_node const *v);
+    CLIR_NO_EXPORT bool is_private_array(internal::expr_node const *v);
+    CLIR_NO_EXPORT bool is_escaped(internal::expr_node const *v);
+    CLIR_NO_EXPORT void push_frame(internal::block *b);
+    CLIR_NO_EXPORT void pop_frame();
+
+    expression_type types_;
+    std::vector<value> values_;
+    std::vector<use> uses_;
+    std::unordered_multimap<std::size_t, std::size_t> by_hash_;
+    std::unordered_multimap<internal::expr_node const *, std::size_t> by_dep_;
+    std::unordered_map<internal::expr_node const *, data_type> declared_;
+    std::unordered_set<internal::expr_node const *> contractible_;
+    std::unordered_set<internal::expr_node const *> address_taken_, decayed_, assigned_,
+        element_stored_;
+    std::vector<frame> frames_;
+};
+
+//! Temporaries are named cse; names are made unique afterwards
+CLIR_EXPORT void eliminate_common_subexpressions(func k);
+CLIR_EXPORT void eliminate_common_subexpressions(prog p);
+
+} // namespace clir
+
+#endif // COMMON_SUBEXPRESSION_20240502_HPP
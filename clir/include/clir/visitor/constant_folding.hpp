@@ -0,0 +1,80 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef CONSTANT_FOLDING_20240502_HPP
+#define CONSTANT_FOLDING_20240502_HPP
+
+#include "clir/export.hpp"
+#include "clir/expr.hpp"
+#include "clir/internal/expr_node.hpp"
+#include "clir/internal/function_node.hpp"
+#include "clir/internal/program_node.hpp"
+#include "clir/internal/stmt_node.hpp"
+#include "clir/visitor/expression_type.hpp"
+
+namespace clir {
+
+class CLIR_EXPORT prog;
+class CLIR_EXPORT func;
+class CLIR_EXPORT stmt;
+
+/**
+ * @brief Evaluates operations on immediates at compile time
+ *
+ * Integer operations follow the usual arithmetic conversions and are only folded if the result
+ * is representable without signed overflow. Float operations are folded if both operands have
+ * the same precision and the result is finite. Chains such as (i + 2) - 1 or (2u * i) * 3u are
+ * reassociated if i is an integer or a pointer.
+ *
+ * Moreover, the following identities are applied as they hold exactly in IEEE arithmetic:
+ * x * 1 = x, x * -1 = -x, x / 1 = x, x / -1 = -x, -(-x) = x, a + -b = a - b, a - -b = a + b,
+ * a + b * -c = a - b * c, a - b * -c = a + b * c, and (T)(v.s0, ..., v.sN) = v as well as
+ * (T)(-v.s0, ..., -v.sN) = -v for a vector v of type T. For integers, i + 0 = i and i - 0 = i.
+ */
+class CLIR_EXPORT constant_folding {
+  public:
+    /* Expr nodes */
+    expr operator()(internal::expr_node &);
+    expr operator()(internal::unary_op &e);
+    expr operator()(internal::binary_op &e);
+    expr operator()(internal::ternary_op &e);
+    expr operator()(internal::access &e);
+    expr operator()(internal::call_builtin &fn);
+    expr operator()(internal::call &fn);
+    expr operator()(internal::cast &c);
+    expr operator()(internal::swizzle &s);
+
+    /* Stmt nodes */
+    void operator()(internal::declaration &d);
+    void operator()(internal::declaration_assignment &d);
+    void operator()(internal::expression_statement &e);
+    void operator()(internal::return_statement &e);
+    void operator()(internal::block &b);
+    void operator()(internal::for_loop &loop);
+    void operator()(internal::if_selection &is);
+    void operator()(internal::while_loop &loop);
+
+    /* Kernel nodes */
+    void operator()(internal::prototype &proto);
+    void operator()(internal::function &fn);
+    void operator()(internal::global_declaration &d);
+
+    /* Program nodes */
+    void operator()(internal::program &prg);
+
+  private:
+    expr fold(internal::binary_op &e);
+    expr reassociate(internal::binary_op &e);
+    expr simplify(internal::binary_op &e);
+
+    expression_type types_;
+};
+
+CLIR_EXPORT expr fold_constants(expr e);
+CLIR_EXPORT void fold_constants(stmt s);
+CLIR_EXPORT void fold_constants(func k);
+CLIR_EXPORT void fold_constants(prog p);
+
+} // namespace clir
+
+#endif // CONSTANT_FOLDING_20240502_HPP
@@ -0,0 +1,77 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef DEAD_STORE_20240502_HPP
+#define DEAD_STORE_20240502_HPP
+
+#include "clir/export.hpp"
+#include "clir/internal/expr_node.hpp"
+#include "clir/internal/function_node.hpp"
+#include "clir/internal/program_node.hpp"
+#include "clir/internal/stmt_node.hpp"
+
+#include <cstdint>
+#include <set>
+#include <unordered_set>
+#include <utility>
+
+namespace clir {
+
+class CLIR_EXPORT func;
+class CLIR_EXPORT prog;
+
+/**
+ * @brief Removes stores to private variables that are never read
+ *
+ * Liveness is computed backwards through each function. Private array elements accessed with a
+ * constant index are tracked individually, such that e.g. the computation of outputs that are
+ * never written to memory is removed. Loop bodies assume that every variable mentioned in the
+ * loop is live at the end of an iteration. Stores with side effects, stores to variables whose
+ * address is taken, and stores through pointers are kept.
+ *
+ * Moreover, self-assignments a = a, expression statements without side effects, and
+ * declarations of variables that are not referenced anymore are removed.
+ */
+class CLIR_EXPORT dead_store_elimination {
+  public:
+    /* Stmt nodes; return true if the statement can be removed */
+    bool operator()(internal::declaration &d);
+    bool operator()(internal::declaration_assignment &d);
+    bool operator()(internal::expression_statement &e);
+    bool operator()(internal::return_statement &e);
+    bool operator()(internal::block &b);
+    bool operator()(internal::for_loop &loop);
+    bool operator()(internal::if_selection &is);
+    bool operator()(internal::while_loop &loop);
+
+    /* Kernel nodes */
+    void operator()(internal::prototype &proto);
+    void operator()(internal::function &fn);
+    void operator()(internal::global_declaration &d);
+
+    /* Program nodes */
+    void operator()(internal::program &prg);
+
+  private:
+    struct live_set {
+        std::unordered_set<internal::expr_node const *> whole;
+        std::set<std::pair<internal::expr_node const *, std::int64_t>> elements;
+    };
+
+    CLIR_NO_EXPORT bool is_live(internal::expr_node const *v) const;
+    CLIR_NO_EXPORT bool is_live(internal::expr_node const *v, std::int64_t index) const;
+    CLIR_NO_EXPORT void kill(internal::expr_node const *v);
+    CLIR_NO_EXPORT void read(internal::expr_node &e);
+    CLIR_NO_EXPORT void loop(internal::stmt_node &s, internal::stmt_node &body);
+
+    std::unordered_set<internal::expr_node const *> removable_, arrays_;
+    live_set live_;
+    bool changed_ = false;
+};
+
+CLIR_EXPORT void eliminate_dead_stores(func k);
+CLIR_EXPORT void eliminate_dead_stores(prog p);
+
+} // namespace clir
+
+#endif // DEAD_STORE_20240502_HPP
@@ -36,6 +36,7 @@ class CLIR_EXPORT equal_expr {
     bool operator()(internal::access &a, internal::access &b);
     bool operator()(internal::call_builtin &a, internal::call_builtin &b);
     bool operator()(internal::cast &a, internal::cast &b);
+    bool operator()(internal::swizzle &a, internal::swizzle &b);
 };
 
 CLIR_EXPORT bool is_equivalent(data_type a, data_type b);
@@ -0,0 +1,54 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef EXPRESSION_TYPE_20240502_HPP
+#define EXPRESSION_TYPE_20240502_HPP
+
+#include "clir/builtin_type.hpp"
+#include "clir/data_type.hpp"
+#include "clir/export.hpp"
+#include "clir/expr.hpp"
+#include "clir/internal/expr_node.hpp"
+
+#include <unordered_map>
+
+namespace clir {
+
+/**
+ * @brief Infers the OpenCL C type of an expression
+ *
+ * The usual arithmetic conversions and integer promotions are applied. An empty data type is
+ * returned whenever the type cannot be determined with certainty, e.g. for calls of user
+ * functions or for variables whose declaration has not been seen.
+ * Value types are returned in the generic address space.
+ */
+class CLIR_EXPORT expression_type {
+  public:
+    void declare(internal::expr_node const *v, data_type ty);
+
+    auto operator()(internal::expr_node &) -> data_type;
+    auto operator()(internal::variable &v) -> data_type;
+    auto operator()(internal::int_imm &i) -> data_type;
+    auto operator()(internal::uint_imm &i) -> data_type;
+    auto operator()(internal::float_imm &i) -> data_type;
+    auto operator()(internal::unary_op &op) -> data_type;
+    auto operator()(internal::binary_op &op) -> data_type;
+    auto operator()(internal::ternary_op &op) -> data_type;
+    auto operator()(internal::access &op) -> data_type;
+    auto operator()(internal::call_builtin &fn) -> data_type;
+    auto operator()(internal::cast &op) -> data_type;
+    auto operator()(internal::swizzle &op) -> data_type;
+
+  private:
+    std::unordered_map<internal::expr_node const *, data_type> types_;
+};
+
+//! Returns the type of a binary arithmetic operation or void_t if ambiguous
+CLIR_EXPORT auto usual_arithmetic_conversion(builtin_type a, builtin_type b) -> builtin_type;
+//! Promotes integer types of rank lower than int to int
+CLIR_EXPORT auto integer_promotion(builtin_type ty) -> builtin_type;
+CLIR_EXPORT bool is_signed(builtin_type ty);
+
+} // namespace clir
+
+#endif // EXPRESSION_TYPE_20240502_HPP
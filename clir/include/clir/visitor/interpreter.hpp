@@ -0,0 +1,69 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef INTERPRETER_20240502_HPP
+#define INTERPRETER_20240502_HPP
+
+#include "clir/export.hpp"
+#include "clir/func.hpp"
+#include "clir/prog.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace clir {
+
+/**
+ * @brief Executes kernels on the host
+ *
+ * The work-groups of an ND-range are executed one after another. The work-items of a work-group
+ * execute each statement in lockstep, where divergent control flow is tracked with a mask.
+ * Sub-groups are formed from consecutive local linear ids; their size is taken from the
+ * intel_reqd_sub_group_size attribute and is 1 if the attribute is missing.
+ *
+ * Pointer arguments are host addresses. Private and local memory are filled with a NaN pattern
+ * at the beginning of each work-group such that reads of uninitialized memory are visible in the
+ * result. Floating point operations are correctly rounded, also for builtins whose precision
+ * is relaxed on devices.
+ *
+ * A std::runtime_error is thrown for barriers and sub-group functions that are not reached by
+ * all work-items of the work-group or sub-group, for accesses to local memory by different
+ * sub-groups that are not separated by a barrier (unless both are reads), for calls of functions
+ * missing in the program, and for unsupported builtins such as printf.
+ */
+class CLIR_EXPORT interpreter {
+  public:
+    interpreter(prog p);
+    interpreter(func f);
+
+    /**
+     * @brief Sets a kernel argument
+     *
+     * @param index Argument index
+     * @param size Size of the argument in bytes, must match the size of the parameter type
+     * @param value Pointer to the argument; for pointer arguments a pointer to the address
+     */
+    void set_arg(std::size_t index, std::size_t size, void const *value);
+    /**
+     * @brief Executes a kernel
+     *
+     * The global size does not need to be a multiple of the local size.
+     *
+     * @param kernel Kernel name
+     * @param global_size Number of work-items
+     * @param local_size Work-group size
+     */
+    void launch(std::string_view kernel, std::array<std::size_t, 3> global_size,
+                std::array<std::size_t, 3> local_size);
+
+  private:
+    std::vector<func> decls_;
+    std::vector<std::vector<std::uint8_t>> args_;
+};
+
+} // namespace clir
+
+#endif // INTERPRETER_20240502_HPP
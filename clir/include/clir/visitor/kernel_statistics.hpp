@@ -0,0 +1,106 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef KERNEL_STATISTICS_20240502_HPP
+#define KERNEL_STATISTICS_20240502_HPP
+
+#include "clir/data_type.hpp"
+#include "clir/export.hpp"
+#include "clir/internal/data_type_node.hpp"
+#include "clir/internal/expr_node.hpp"
+#include "clir/internal/function_node.hpp"
+#include "clir/internal/program_node.hpp"
+#include "clir/internal/stmt_node.hpp"
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace clir {
+
+class CLIR_EXPORT func;
+class CLIR_EXPORT prog;
+
+/**
+ * @brief Static operation counts of a kernel
+ *
+ * Every operation is counted once per occurrence in the source, that is, loop bodies are not
+ * multiplied by their trip count and both branches of an if are counted.
+ * Calls of user functions are not followed.
+ */
+struct CLIR_EXPORT kernel_statistics {
+    std::string name;                    ///< Function name
+    std::size_t flops = 0;               ///< Floating point operations (per vector component)
+    std::size_t global_loads = 0;        ///< Loads from global or constant memory
+    std::size_t global_stores = 0;       ///< Stores to global memory
+    std::size_t local_loads = 0;         ///< Loads from shared local memory
+    std::size_t local_stores = 0;        ///< Stores to shared local memory
+    std::size_t barriers = 0;            ///< Work-group barriers
+    std::size_t sub_group_shuffles = 0;  ///< Sub-group shuffles and broadcasts
+    std::size_t private_array_bytes = 0; ///< Bytes of arrays declared in private memory
+    std::size_t local_memory_bytes = 0;  ///< Bytes of arrays declared in shared local memory
+};
+
+CLIR_EXPORT std::ostream &operator<<(std::ostream &os, kernel_statistics const &stats);
+
+class CLIR_EXPORT statistics_counter {
+  public:
+    /* Expr nodes */
+    auto operator()(internal::expr_node &) -> data_type;
+    auto operator()(internal::variable &v) -> data_type;
+    auto operator()(internal::int_imm &i) -> data_type;
+    auto operator()(internal::uint_imm &i) -> data_type;
+    auto operator()(internal::float_imm &i) -> data_type;
+    auto operator()(internal::unary_op &op) -> data_type;
+    auto operator()(internal::binary_op &op) -> data_type;
+    auto operator()(internal::ternary_op &op) -> data_type;
+    auto operator()(internal::access &op) -> data_type;
+    auto operator()(internal::call_builtin &fn) -> data_type;
+    auto operator()(internal::call &fn) -> data_type;
+    auto operator()(internal::cast &op) -> data_type;
+    auto operator()(internal::swizzle &op) -> data_type;
+
+    /* Stmt nodes */
+    void operator()(internal::declaration &d);
+    void operator()(internal::declaration_assignment &d);
+    void operator()(internal::expression_statement &e);
+    void operator()(internal::return_statement &e);
+    void operator()(internal::block &b);
+    void operator()(internal::for_loop &loop);
+    void operator()(internal::if_selection &is);
+    void operator()(internal::while_loop &loop);
+
+    /* Kernel nodes */
+    void operator()(internal::prototype &proto);
+    void operator()(internal::function &fn);
+    void operator()(internal::global_declaration &d);
+
+    /* Program nodes */
+    void operator()(internal::program &prg);
+
+    //! Statistics of the last visited function
+    inline auto statistics() const -> kernel_statistics const & { return stats_; }
+    //! Statistics of all visited kernel functions
+    inline auto kernels() const -> std::vector<kernel_statistics> const & { return kernels_; }
+
+  private:
+    enum class lvalue_mode { none, store, load_store };
+
+    void count_access(data_type &ty, lvalue_mode mode);
+    void count_flops(data_type &ty, std::size_t per_component);
+
+    kernel_statistics stats_ = {};
+    std::vector<kernel_statistics> kernels_;
+    bool is_kernel_ = false;
+    lvalue_mode lvalue_ = lvalue_mode::none;
+    std::unordered_map<internal::expr_node const *, data_type> types_;
+};
+
+CLIR_EXPORT auto get_kernel_statistics(func k) -> kernel_statistics;
+CLIR_EXPORT auto get_kernel_statistics(prog p) -> std::vector<kernel_statistics>;
+
+} // namespace clir
+
+#endif // KERNEL_STATISTICS_20240502_HPP
@@ -37,6 +37,7 @@ class CLIR_EXPORT required_extensions {
     void operator()(internal::stmt_node &);
     void operator()(internal::declaration_assignment &d);
     void operator()(internal::expression_statement &e);
+    void operator()(internal::return_statement &e);
     void operator()(internal::block &b);
     void operator()(internal::for_loop &loop);
     void operator()(internal::if_selection &is);
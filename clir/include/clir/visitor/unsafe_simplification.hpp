@@ -64,6 +64,7 @@ class CLIR_EXPORT unsafe_simplification {
     void operator()(internal::declaration &d);
     void operator()(internal::declaration_assignment &d);
     void operator()(internal::expression_statement &e);
+    void operator()(internal::return_statement &e);
     void operator()(internal::block &b);
     void operator()(internal::for_loop &loop);
     void operator()(internal::if_selection &is);
@@ -59,6 +59,7 @@ void block_builder::add(std::shared_ptr<internal::declaration_assignment> da) {
 }
 
 void block_builder::assign(expr a, expr b) { add(assignment(std::move(a), std::move(b))); }
+void block_builder::return_value(expr e) { add(return_statement(std::move(e))); }
 
 /* for loop builder */
 for_loop_builder::for_loop_builder(expr start, expr condition, expr step)
@@ -133,6 +134,8 @@ void function_builder::argument(data_type ty, var v) {
     proto_->args().emplace_back(std::move(ty), std::move(v));
 }
 
+void function_builder::return_type(data_type ty) { proto_->return_type(std::move(ty)); }
+
 void function_builder::qualifier(function_qualifier q) {
     proto_->qualifiers(proto_->qualifiers() | q);
 }
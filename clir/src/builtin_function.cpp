@@ -74,6 +74,8 @@ extension get_extension(builtin_function fn) {
         return extension::cl_intel_subgroups_long;
         CLIR_EXTENSION_INTEL_SUBGROUPS_SHORT(BUILTIN_FN_CASE_3)
         return extension::cl_intel_subgroups_short;
+        CLIR_EXTENSION_INTEL_BFLOAT16_CONVERSIONS(BUILTIN_FN_CASE_3)
+        return extension::cl_intel_bfloat16_conversions;
     default:
         break;
     }
@@ -95,6 +97,8 @@ char const *to_string(extension ext) {
         return "cl_intel_subgroups_short";
     case extension::cl_ext_float_atomics:
         return "cl_ext_float_atomics";
+    case extension::cl_intel_bfloat16_conversions:
+        return "cl_intel_bfloat16_conversions";
     case extension::builtin:
         return "builtin";
     case extension::unknown:
@@ -13,4 +13,8 @@ stmt expression_statement(expr e) {
     return stmt(std::make_shared<internal::expression_statement>(std::move(e)));
 }
 
+stmt return_statement(expr e) {
+    return stmt(std::make_shared<internal::return_statement>(std::move(e)));
+}
+
 } // namespace clir
@@ -220,6 +220,12 @@ void codegen_opencl::operator()(internal::expression_statement &e) {
     end_statement();
 }
 
+void codegen_opencl::operator()(internal::return_statement &e) {
+    os_ << "return ";
+    visit(*this, *e.term());
+    end_statement();
+}
+
 void codegen_opencl::operator()(internal::block &b) {
     os_ << "{" << std::endl;
     ++lvl_;
@@ -298,7 +304,7 @@ void codegen_opencl::operator()(internal::prototype &proto) {
         visit(*this, *a);
         os_ << std::endl << indent();
     }
-    os_ << "void " << proto.name() << "(";
+    os_ << visit(codegen_data_type{}, *proto.return_type()).first << " " << proto.name() << "(";
     do_with_infix(proto.args().begin(), proto.args().end(), [this](auto x) {
         auto dt = visit(codegen_data_type{}, *x.first);
         os_ << dt.first << " ";
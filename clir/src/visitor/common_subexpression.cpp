@@ -0,0 +1,650 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "clir/visitor/common_subexpression.hpp"
+#include "side_effects.hpp"
+#include "type_properties.hpp"
+#include "variable_usage.hpp"
+#include "clir/builtin_function.hpp"
+#include "clir/data_type.hpp"
+#include "clir/func.hpp"
+#include "clir/prog.hpp"
+#include "clir/stmt.hpp"
+#include "clir/var.hpp"
+#include "clir/visit.hpp"
+#include "clir/visitor/equal_expr.hpp"
+#include "clir/visitor/unique_names.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace clir {
+
+namespace {
+
+void hash_combine(std::size_t &seed, std::size_t v) {
+    seed ^= v + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+}
+
+template <typename... T> auto hash_of(T... values) -> std::size_t {
+    std::size_t seed = 0;
+    (hash_combine(seed, std::hash<T>{}(values)), ...);
+    return seed;
+}
+
+auto hash_of_type(data_type ty) -> std::size_t {
+    auto p = get_properties(ty);
+    auto h = hash_of(static_cast<int>(p.ty), p.components, static_cast<int>(p.space), p.is_pointer,
+                     p.is_array);
+    if (p.is_pointer && p.element) {
+        hash_combine(h, hash_of_type(p.element));
+    }
+    return h;
+}
+
+void merge_deps(std::vector<internal::expr_node const *> &deps,
+                std::vector<internal::expr_node const *> const &other) {
+    for (auto d : other) {
+        if (std::find(deps.begin(), deps.end(), d) == deps.end()) {
+            deps.emplace_back(d);
+        }
+    }
+}
+
+bool is_relational(binary_operation op) {
+    switch (op) {
+    case binary_operation::greater_than:
+    case binary_operation::less_than:
+    case binary_operation::greater_than_or_equal:
+    case binary_operation::less_than_or_equal:
+    case binary_operation::equal:
+    case binary_operation::not_equal:
+        return true;
+    default:
+        break;
+    }
+    return false;
+}
+
+//! Copies the node itself but not its children
+class shallow_copy {
+  public:
+    auto operator()(internal::expr_node &) -> expr { return nullptr; }
+    auto operator()(internal::unary_op &e) -> expr {
+        return expr(std::make_shared<internal::unary_op>(e.op(), e.term()));
+    }
+    auto operator()(internal::binary_op &e) -> expr {
+        return expr(std::make_shared<internal::binary_op>(e.op(), e.lhs(), e.rhs()));
+    }
+    auto operator()(internal::ternary_op &e) -> expr {
+        return expr(
+            std::make_shared<internal::ternary_op>(e.op(), e.term0(), e.term1(), e.term2()));
+    }
+    auto operator()(internal::access &e) -> expr {
+        return expr(std::make_shared<internal::access>(e.field(), e.address()));
+    }
+    auto operator()(internal::call_builtin &fn) -> expr {
+        return expr(std::make_shared<internal::call_builtin>(fn.fn(), fn.args()));
+    }
+    auto operator()(internal::call &fn) -> expr {
+        return expr(std::make_shared<internal::call>(std::string(fn.name()), fn.args()));
+    }
+    auto operator()(internal::cast &c) -> expr {
+        return expr(std::make_shared<internal::cast>(c.target_ty(), c.term()));
+    }
+    auto operator()(internal::swizzle &s) -> expr {
+        if (s.selector() == internal::swizzle_selector::index) {
+            return expr(std::make_shared<internal::swizzle>(s.term(), s.indices()));
+        }
+        return expr(std::make_shared<internal::swizzle>(s.term(), s.selector()));
+    }
+};
+
+/**
+ * @brief Turns the expression DAG into a tree
+ *
+ * Generators may use the same expression object at several places. Such nodes are copied such
+ * that replacing an operand of one occurrence does not affect the others.
+ */
+class unshare {
+  public:
+    /* Expr nodes */
+    void operator()(internal::expr_node &) {}
+    void operator()(internal::unary_op &e) { slot(e.term()); }
+    void operator()(internal::binary_op &e) {
+        slot(e.lhs());
+        slot(e.rhs());
+    }
+    void operator()(internal::ternary_op &e) {
+        slot(e.term0());
+        slot(e.term1());
+        slot(e.term2());
+    }
+    void operator()(internal::access &e) {
+        slot(e.field());
+        slot(e.address());
+    }
+    void operator()(internal::call_builtin &fn) {
+        for (auto &arg : fn.args()) {
+            slot(arg);
+        }
+    }
+    void operator()(internal::call &fn) {
+        for (auto &arg : fn.args()) {
+            slot(arg);
+        }
+    }
+    void operator()(internal::cast &c) { slot(c.term()); }
+    void operator()(internal::swizzle &s) { slot(s.term()); }
+
+    /* Stmt nodes */
+    void operator()(internal::declaration &) {}
+    void operator()(internal::declaration_assignment &d) { slot(d.rhs()); }
+    void operator()(internal::expression_statement &e) { slot(e.term()); }
+    void operator()(internal::return_statement &e) { slot(e.term()); }
+    void operator()(internal::block &b) {
+        for (auto &s : b.stmts()) {
+            visit(*this, *s);
+        }
+    }
+    void operator()(internal::for_loop &loop) {
+        visit(*this, *loop.start());
+        slot(loop.condition());
+        slot(loop.step());
+        visit(*this, *loop.body());
+    }
+    void operator()(internal::if_selection &is) {
+        slot(is.condition());
+        visit(*this, *is.then());
+        if (is.otherwise()) {
+            visit(*this, **is.otherwise());
+        }
+    }
+    void operator()(internal::while_loop &loop) {
+        slot(loop.condition());
+        visit(*this, *loop.body());
+    }
+
+  private:
+    void slot(expr &e) {
+        if (!seen_.insert(e.get()).second) {
+            if (auto copy = visit(shallow_copy{}, *e); copy) {
+                e = std::move(copy);
+                seen_.insert(e.get());
+            }
+        }
+        visit(*this, *e);
+    }
+
+    std::unordered_set<internal::expr_node const *> seen_;
+};
+
+bool is_pure(builtin_function fn) {
+    if (fn <= builtin_function::get_sub_group_local_id) {
+        return true;
+    }
+    if (has_side_effects(fn)) {
+        return false;
+    }
+    if ((fn >= builtin_function::acos && fn <= builtin_function::native_tan) ||
+        (fn >= builtin_function::abs && fn <= builtin_function::sign) ||
+        (fn >= builtin_function::as_char && fn <= builtin_function::as_double16) ||
+        fn == builtin_function::select || fn == builtin_function::sub_group_broadcast) {
+        return true;
+    }
+    auto const name = std::string_view(to_string(fn));
+    return name.substr(0, 23) == "intel_sub_group_shuffle";
+}
+
+} // namespace
+
+bool common_subexpression_elimination::is_private_array(internal::expr_node const *v) {
+    auto it = declared_.find(v);
+    if (it == declared_.end()) {
+        return false;
+    }
+    auto p = get_properties(it->second);
+    return p.is_array && (p.space == address_space::generic_t ||
+                          p.space == address_space::private_t);
+}
+
+bool common_subexpression_elimination::is_escaped(internal::expr_node const *v) {
+    if (address_taken_.find(v) != address_taken_.end()) {
+        return true;
+    }
+    auto it = declared_.find(v);
+    return it != declared_.end() && get_properties(it->second).is_array &&
+           decayed_.find(v) != decayed_.end();
+}
+
+void common_subexpression_elimination::kill(internal::expr_node const *v) {
+    auto [first, last] = by_dep_.equal_range(v);
+    for (auto it = first; it != last; ++it) {
+        values_[it->second].alive = false;
+    }
+    by_dep_.erase(first, last);
+}
+
+void common_subexpression_elimination::kill_modified(internal::expr_node &e) {
+    auto assigned = std::unordered_set<internal::expr_node const *>{};
+    auto stored = std::unordered_set<internal::expr_node const *>{};
+    visit(variable_usage{assigned, stored}, e);
+    for (auto v : assigned) {
+        kill(v);
+    }
+    for (auto v : stored) {
+        kill(v);
+    }
+}
+
+void common_subexpression_elimination::kill_modified(internal::stmt_node &s) {
+    auto assigned = std::unordered_set<internal::expr_node const *>{};
+    auto stored = std::unordered_set<internal::expr_node const *>{};
+    visit(variable_usage{assigned, stored}, s);
+    for (auto v : assigned) {
+        kill(v);
+    }
+    for (auto v : stored) {
+        kill(v);
+    }
+}
+
+void common_subexpression_elimination::push_frame(internal::block *b) {
+    frames_.emplace_back(frame{b});
+}
+
+void common_subexpression_elimination::pop_frame() {
+    auto &f = frames_.back();
+    for (auto number : f.values) {
+        auto &v = values_[number];
+        v.alive = false;
+        auto const used = std::any_of(v.uses.begin(), v.uses.end(),
+                                      [&](std::size_t u) { return uses_[u].active; });
+        if (!used) {
+            continue;
+        }
+        if (!bool(v.holder)) {
+            auto t = var("cse");
+            auto decl = std::make_shared<internal::declaration>(v.ty, t);
+            f.insertions.emplace_back(insertion{
+                v.stmt_index, number,
+                stmt(std::make_shared<internal::declaration_assignment>(std::move(decl), v.e))});
+            *v.slot = t;
+            v.holder = std::move(t);
+        }
+        for (auto u : v.uses) {
+            if (uses_[u].active) {
+                *uses_[u].slot = v.holder;
+            }
+        }
+    }
+    if (f.b && !f.insertions.empty()) {
+        auto &ins = f.insertions;
+        std::stable_sort(ins.begin(), ins.end(), [](insertion const &a, insertion const &b) {
+            return a.stmt_index < b.stmt_index ||
+                   (a.stmt_index == b.stmt_index && a.number < b.number);
+        });
+        auto &stmts = f.b->stmts();
+        auto new_stmts = std::vector<stmt>{};
+        new_stmts.reserve(stmts.size() + ins.size());
+        auto it = ins.begin();
+        for (std::size_t i = 0; i < stmts.size(); ++i) {
+            for (; it != ins.end() && it->stmt_index == i; ++it) {
+                new_stmts.emplace_back(std::move(it->s));
+            }
+            new_stmts.emplace_back(std::move(stmts[i]));
+        }
+        stmts = std::move(new_stmts);
+    }
+    frames_.pop_back();
+}
+
+auto common_subexpression_elimination::process(expr &slot) -> info {
+    auto const first_use = uses_.size();
+    auto i = visit(*this, *slot);
+    if (!i.pure || !i.candidate || frames_.empty() ||
+        contractible_.find(slot.get()) != contractible_.end()) {
+        return i;
+    }
+    auto [first, last] = by_hash_.equal_range(i.hash);
+    for (auto it = first; it != last; ++it) {
+        auto &v = values_[it->second];
+        if (!v.alive || !is_equivalent(v.e, slot)) {
+            continue;
+        }
+        // Repeated subexpressions are covered by the enclosing expression
+        for (auto u = first_use; u < uses_.size(); ++u) {
+            uses_[u].active = false;
+        }
+        v.uses.emplace_back(uses_.size());
+        uses_.emplace_back(use{&slot});
+        i.value = it->second;
+        return i;
+    }
+
+    auto &f = frames_.back();
+    if (!f.b) {
+        return i;
+    }
+    auto ty = visit(types_, *slot);
+    if (!ty) {
+        return i;
+    }
+    auto const number = values_.size();
+    values_.emplace_back(value{i.hash, slot, &slot, std::move(ty), nullptr, frames_.size() - 1,
+                               f.stmt_index});
+    f.values.emplace_back(number);
+    by_hash_.emplace(i.hash, number);
+    for (auto d : i.deps) {
+        by_dep_.emplace(d, number);
+    }
+    i.value = number;
+    return i;
+}
+
+void common_subexpression_elimination::process_lvalue(expr &e, info &i) {
+    if (auto a = dynamic_cast<internal::access *>(e.get()); a) {
+        if (!dynamic_cast<internal::variable *>(a->field().get())) {
+            process_lvalue(a->field(), i);
+        }
+        merge_deps(i.deps, process(a->address()).deps);
+    } else if (auto s = dynamic_cast<internal::swizzle *>(e.get()); s) {
+        process_lvalue(s->term(), i);
+    } else if (auto u = dynamic_cast<internal::unary_op *>(e.get());
+               u && u->op() == unary_operation::indirection) {
+        process(u->term());
+    } else if (!dynamic_cast<internal::variable *>(e.get())) {
+        process(e);
+    }
+}
+
+void common_subexpression_elimination::process_statement(expr &e) {
+    if (auto b = dynamic_cast<internal::binary_op *>(e.get()); b && is_assignment(b->op())) {
+        if (has_side_effects(*b->lhs()) || has_side_effects(*b->rhs())) {
+            return;
+        }
+        auto i = info{};
+        process_lvalue(b->lhs(), i);
+        process(b->rhs());
+    } else if (auto fn = dynamic_cast<internal::call_builtin *>(e.get()); fn) {
+        for (auto &arg : fn->args()) {
+            if (has_side_effects(*arg)) {
+                return;
+            }
+        }
+        for (auto &arg : fn->args()) {
+            process(arg);
+        }
+    } else if (!has_side_effects(*e)) {
+        process(e);
+    }
+}
+
+void common_subexpression_elimination::visit_nested(stmt &s) {
+    if (dynamic_cast<internal::block *>(s.get())) {
+        visit(*this, *s);
+    } else {
+        // Single statement body, e.g. if (c) x = y; values must not be hoisted out of it
+        push_frame(nullptr);
+        visit(*this, *s);
+        pop_frame();
+    }
+}
+
+/* Expr nodes */
+auto common_subexpression_elimination::operator()(internal::expr_node &) -> info { return {}; }
+auto common_subexpression_elimination::operator()(internal::variable &v) -> info {
+    return info{!is_escaped(&v), false, hash_of(static_cast<void const *>(&v)), {&v}};
+}
+auto common_subexpression_elimination::operator()(internal::int_imm &i) -> info {
+    return info{true, false, hash_of(1, i.value(), i.bits())};
+}
+auto common_subexpression_elimination::operator()(internal::uint_imm &i) -> info {
+    return info{true, false, hash_of(2, i.value(), i.bits())};
+}
+auto common_subexpression_elimination::operator()(internal::float_imm &i) -> info {
+    auto value = i.value();
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return info{true, false, hash_of(3, bits, i.bits())};
+}
+auto common_subexpression_elimination::operator()(internal::cl_mem_fence_flags_imm &i) -> info {
+    return info{true, false, hash_of(4, static_cast<int>(i.value()))};
+}
+auto common_subexpression_elimination::operator()(internal::unary_op &e) -> info {
+    switch (e.op()) {
+    case unary_operation::minus:
+    case unary_operation::bitwise_not:
+    case unary_operation::logical_not: {
+        auto t = process(e.term());
+        t.candidate = e.op() != unary_operation::logical_not;
+        hash_combine(t.hash, hash_of(5, static_cast<int>(e.op())));
+        t.value = info{}.value;
+        return t;
+    }
+    case unary_operation::address: {
+        auto i = info{};
+        process_lvalue(e.term(), i);
+        return {};
+    }
+    case unary_operation::indirection:
+        process(e.term());
+        return {};
+    default:
+        break;
+    }
+    return {};
+}
+auto common_subexpression_elimination::operator()(internal::binary_op &e) -> info {
+    if (is_assignment(e.op())) {
+        auto i = info{};
+        process_lvalue(e.lhs(), i);
+        process(e.rhs());
+        return {};
+    }
+    switch (e.op()) {
+    case binary_operation::logical_and:
+    case binary_operation::logical_or:
+        // The right-hand side is evaluated conditionally
+        process(e.lhs());
+        return {};
+    case binary_operation::add:
+    case binary_operation::subtract: {
+        auto p = get_properties(visit(types_, static_cast<internal::expr_node &>(e)));
+        if (p.components > 0 && is_floating(p.ty)) {
+            for (auto *operand : {&e.lhs(), &e.rhs()}) {
+                auto m = dynamic_cast<internal::binary_op *>(operand->get());
+                if (m && m->op() == binary_operation::multiply) {
+                    contractible_.insert(m);
+                }
+            }
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    auto l = process(e.lhs());
+    auto r = process(e.rhs());
+    auto i = info{l.pure && r.pure, e.op() != binary_operation::comma && !is_relational(e.op()),
+                  hash_of(6, static_cast<int>(e.op()))};
+    hash_combine(i.hash, l.hash);
+    hash_combine(i.hash, r.hash);
+    i.deps = std::move(l.deps);
+    merge_deps(i.deps, r.deps);
+    return i;
+}
+auto common_subexpression_elimination::operator()(internal::ternary_op &e) -> info {
+    // Only one branch is evaluated
+    process(e.term0());
+    return {};
+}
+auto common_subexpression_elimination::operator()(internal::access &e) -> info {
+    auto field = dynamic_cast<internal::variable *>(e.field().get());
+    bool field_pure = false;
+    auto i = info{};
+    if (field) {
+        // Element of a private array or component of a vector
+        auto it = declared_.find(field);
+        auto p = it != declared_.end() ? get_properties(it->second) : type_properties{};
+        field_pure = !is_escaped(field) && (is_private_array(field) || (!p.is_pointer &&
+                                                                         p.components > 1));
+        i.hash = hash_of(static_cast<void const *>(field));
+        i.deps.emplace_back(field);
+    } else {
+        process(e.field());
+    }
+    auto a = process(e.address());
+    i.pure = field_pure && a.pure;
+    hash_combine(i.hash, hash_of(7));
+    hash_combine(i.hash, a.hash);
+    merge_deps(i.deps, a.deps);
+    return i;
+}
+auto common_subexpression_elimination::operator()(internal::call_builtin &fn) -> info {
+    // Work-item queries are cheap and never replaced by a temporary
+    auto const query = fn.fn() <= builtin_function::get_sub_group_local_id;
+    auto i = info{is_pure(fn.fn()), !query, hash_of(8, static_cast<int>(fn.fn()))};
+    for (auto &arg : fn.args()) {
+        auto a = process(arg);
+        i.pure = i.pure && a.pure;
+        hash_combine(i.hash, a.hash);
+        merge_deps(i.deps, a.deps);
+    }
+    return i;
+}
+auto common_subexpression_elimination::operator()(internal::call &fn) -> info {
+    for (auto &arg : fn.args()) {
+        process(arg);
+    }
+    return {};
+}
+auto common_subexpression_elimination::operator()(internal::cast &c) -> info {
+    auto t = process(c.term());
+    t.candidate = true;
+    hash_combine(t.hash, hash_of(9));
+    hash_combine(t.hash, hash_of_type(c.target_ty()));
+    t.value = info{}.value;
+    return t;
+}
+auto common_subexpression_elimination::operator()(internal::swizzle &s) -> info {
+    auto t = process(s.term());
+    t.candidate = false;
+    hash_combine(t.hash, hash_of(10, static_cast<int>(s.selector())));
+    for (auto idx : s.indices()) {
+        hash_combine(t.hash, hash_of(idx));
+    }
+    t.value = info{}.value;
+    return t;
+}
+
+/* Stmt nodes */
+void common_subexpression_elimination::operator()(internal::declaration &d) {
+    declared_[d.variable().get()] = d.ty();
+    types_.declare(d.variable().get(), d.ty());
+}
+void common_subexpression_elimination::operator()(internal::declaration_assignment &d) {
+    (*this)(d.decl());
+    auto v = d.decl().variable().get();
+    kill(v);
+    if (has_side_effects(*d.rhs())) {
+        return;
+    }
+    auto i = process(d.rhs());
+    if (i.value >= values_.size() || values_[i.value].slot != &d.rhs() ||
+        assigned_.find(v) != assigned_.end() || element_stored_.find(v) != element_stored_.end() ||
+        is_escaped(v)) {
+        return;
+    }
+    // The declared variable holds the value
+    auto &val = values_[i.value];
+    auto p = get_properties(d.decl().ty());
+    auto ty = p.is_pointer ? d.decl().ty() : make_type(p.ty, p.components);
+    if (!p.is_array && p.components >= 0 && is_equivalent(ty, val.ty)) {
+        val.holder = d.decl().variable();
+    }
+}
+void common_subexpression_elimination::operator()(internal::expression_statement &e) {
+    process_statement(e.term());
+    kill_modified(*e.term());
+}
+void common_subexpression_elimination::operator()(internal::return_statement &e) {
+    process_statement(e.term());
+}
+
+void common_subexpression_elimination::operator()(internal::block &b) {
+    push_frame(&b);
+    for (std::size_t i = 0; i < b.stmts().size(); ++i) {
+        frames_.back().stmt_index = i;
+        visit(*this, *b.stmts()[i]);
+    }
+    pop_frame();
+}
+
+void common_subexpression_elimination::operator()(internal::for_loop &loop) {
+    kill_modified(static_cast<internal::stmt_node &>(loop));
+    // Only record the types declared in the loop header
+    if (auto d = dynamic_cast<internal::declaration_assignment *>(loop.start().get()); d) {
+        (*this)(d->decl());
+    } else if (auto d = dynamic_cast<internal::declaration *>(loop.start().get()); d) {
+        (*this)(*d);
+    }
+    visit_nested(loop.body());
+}
+
+void common_subexpression_elimination::operator()(internal::if_selection &is) {
+    if (!has_side_effects(*is.condition())) {
+        process(is.condition());
+    } else {
+        kill_modified(*is.condition());
+    }
+    visit_nested(is.then());
+    if (is.otherwise()) {
+        visit_nested(*is.otherwise());
+    }
+}
+
+void common_subexpression_elimination::operator()(internal::while_loop &loop) {
+    kill_modified(static_cast<internal::stmt_node &>(loop));
+    visit_nested(loop.body());
+}
+
+/* Kernel nodes */
+void common_subexpression_elimination::operator()(internal::prototype &proto) {
+    for (auto &[ty, v] : proto.args()) {
+        declared_[v.get()] = ty;
+        types_.declare(v.get(), ty);
+    }
+}
+void common_subexpression_elimination::operator()(internal::function &fn) {
+    *this = common_subexpression_elimination{};
+    visit(unshare{}, *fn.body());
+    visit(variable_usage{assigned_, element_stored_, &address_taken_, &decayed_}, *fn.body());
+    visit(*this, *fn.prototype());
+    visit(*this, *fn.body());
+}
+void common_subexpression_elimination::operator()(internal::global_declaration &) {}
+
+/* Program nodes */
+void common_subexpression_elimination::operator()(internal::program &prg) {
+    for (auto &d : prg.declarations()) {
+        visit(*this, *d);
+    }
+}
+
+void eliminate_common_subexpressions(func k) {
+    visit(common_subexpression_elimination{}, *k);
+    make_names_unique(std::move(k));
+}
+void eliminate_common_subexpressions(prog p) {
+    visit(common_subexpression_elimination{}, *p);
+    make_names_unique(std::move(p));
+}
+
+} // namespace clir
@@ -0,0 +1,718 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "clir/visitor/constant_folding.hpp"
+#include "side_effects.hpp"
+#include "type_properties.hpp"
+#include "clir/func.hpp"
+#include "clir/op.hpp"
+#include "clir/prog.hpp"
+#include "clir/stmt.hpp"
+#include "clir/visit.hpp"
+#include "clir/visitor/equal_expr.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace clir {
+
+namespace {
+
+struct imm_value {
+    enum class kind { sint, uint, fp } k;
+    int64_t s = 0;
+    uint64_t u = 0;
+    double f = 0.0;
+    short bits = 32;
+
+    //! Width after integer promotion
+    short promoted_bits() const { return bits > 32 ? 64 : 32; }
+    bool is_integer() const { return k != kind::fp; }
+};
+
+class get_imm {
+  public:
+    auto operator()(internal::expr_node &) -> std::optional<imm_value> { return std::nullopt; }
+    auto operator()(internal::int_imm &i) -> std::optional<imm_value> {
+        return imm_value{imm_value::kind::sint, i.value(), 0, 0.0, i.bits()};
+    }
+    auto operator()(internal::uint_imm &i) -> std::optional<imm_value> {
+        return imm_value{imm_value::kind::uint, 0, i.value(), 0.0, i.bits()};
+    }
+    auto operator()(internal::float_imm &i) -> std::optional<imm_value> {
+        return imm_value{imm_value::kind::fp, 0, 0, i.value(), i.bits()};
+    }
+};
+
+auto imm(expr &e) -> std::optional<imm_value> { return visit(get_imm{}, *e); }
+
+auto mask(short bits) -> uint64_t {
+    return bits >= 64 ? std::numeric_limits<uint64_t>::max() : (uint64_t(1) << bits) - 1;
+}
+
+auto int_min(short bits) -> int64_t {
+    return bits >= 64 ? std::numeric_limits<int64_t>::min() : -(int64_t(1) << (bits - 1));
+}
+
+auto int_max(short bits) -> int64_t {
+    return bits >= 64 ? std::numeric_limits<int64_t>::max() : (int64_t(1) << (bits - 1)) - 1;
+}
+
+//! Sets r = a + b and returns true unless the sum overflows
+bool checked_add(int64_t a, int64_t b, int64_t &r) {
+    if ((b > 0 && a > std::numeric_limits<int64_t>::max() - b) ||
+        (b < 0 && a < std::numeric_limits<int64_t>::min() - b)) {
+        return false;
+    }
+    r = a + b;
+    return true;
+}
+
+//! Sets r = a - b and returns true unless the difference overflows
+bool checked_sub(int64_t a, int64_t b, int64_t &r) {
+    if ((b < 0 && a > std::numeric_limits<int64_t>::max() + b) ||
+        (b > 0 && a < std::numeric_limits<int64_t>::min() + b)) {
+        return false;
+    }
+    r = a - b;
+    return true;
+}
+
+//! Sets r = a * b and returns true unless the product overflows
+bool checked_mul(int64_t a, int64_t b, int64_t &r) {
+    constexpr auto min = std::numeric_limits<int64_t>::min();
+    constexpr auto max = std::numeric_limits<int64_t>::max();
+    bool const overflow = a > 0 ? (b > 0 ? a > max / b : b < min / a)
+                                : (b > 0 ? a < min / b : a != 0 && b < max / a);
+    if (overflow) {
+        return false;
+    }
+    r = a * b;
+    return true;
+}
+
+//! Signed immediate if representable; the most negative value is excluded as its literal
+//! would have a wider type
+auto make_signed(int64_t value, short bits) -> expr {
+    if (value <= int_min(bits) || value > int_max(bits)) {
+        return nullptr;
+    }
+    return expr(value, bits);
+}
+
+auto make_bool(bool value) -> expr { return expr(static_cast<int32_t>(value ? 1 : 0)); }
+
+auto make_float(double value, short bits) -> expr {
+    if (!std::isfinite(value)) {
+        return nullptr;
+    }
+    return expr(value, bits);
+}
+
+auto signed_value(imm_value const &v) -> int64_t {
+    return v.k == imm_value::kind::sint ? v.s : static_cast<int64_t>(v.u);
+}
+
+auto unsigned_value(imm_value const &v, short bits) -> uint64_t {
+    return (v.k == imm_value::kind::sint ? static_cast<uint64_t>(v.s) : v.u) & mask(bits);
+}
+
+auto fold_shift(binary_operation op, imm_value const &a, imm_value const &b) -> expr {
+    // Result has the promoted type of the left operand
+    short const bits = a.promoted_bits();
+    auto const shift = b.k == imm_value::kind::sint ? b.s : static_cast<int64_t>(b.u);
+    if (shift < 0 || shift >= bits) {
+        return nullptr;
+    }
+    if (a.k == imm_value::kind::uint) {
+        auto const x = a.u & mask(bits);
+        return expr(op == binary_operation::left_shift ? (x << shift) & mask(bits) : x >> shift,
+                    bits);
+    }
+    if (a.s < 0 || (op == binary_operation::left_shift && a.s > (int_max(bits) >> shift))) {
+        return nullptr;
+    }
+    return make_signed(op == binary_operation::left_shift ? a.s << shift : a.s >> shift, bits);
+}
+
+auto fold_integer(binary_operation op, imm_value const &a, imm_value const &b) -> expr {
+    if (op == binary_operation::left_shift || op == binary_operation::right_shift) {
+        return fold_shift(op, a, b);
+    }
+    short const bits = std::max(a.promoted_bits(), b.promoted_bits());
+    bool const is_unsigned = (a.k == imm_value::kind::uint && a.promoted_bits() == bits) ||
+                             (b.k == imm_value::kind::uint && b.promoted_bits() == bits);
+    if (is_unsigned) {
+        auto const x = unsigned_value(a, bits);
+        auto const y = unsigned_value(b, bits);
+        auto const m = mask(bits);
+        switch (op) {
+        case binary_operation::add:
+            return expr((x + y) & m, bits);
+        case binary_operation::subtract:
+            return expr((x - y) & m, bits);
+        case binary_operation::multiply:
+            return expr((x * y) & m, bits);
+        case binary_operation::divide:
+            return y != 0 ? expr(x / y, bits) : nullptr;
+        case binary_operation::modulo:
+            return y != 0 ? expr(x % y, bits) : nullptr;
+        case binary_operation::bitwise_and:
+            return expr(x & y, bits);
+        case binary_operation::bitwise_or:
+            return expr(x | y, bits);
+        case binary_operation::bitwise_xor:
+            return expr(x ^ y, bits);
+        case binary_operation::greater_than:
+            return make_bool(x > y);
+        case binary_operation::less_than:
+            return make_bool(x < y);
+        case binary_operation::greater_than_or_equal:
+            return make_bool(x >= y);
+        case binary_operation::less_than_or_equal:
+            return make_bool(x <= y);
+        case binary_operation::equal:
+            return make_bool(x == y);
+        case binary_operation::not_equal:
+            return make_bool(x != y);
+        case binary_operation::logical_and:
+            return make_bool(x && y);
+        case binary_operation::logical_or:
+            return make_bool(x || y);
+        default:
+            break;
+        }
+        return nullptr;
+    }
+
+    auto const x = signed_value(a);
+    auto const y = signed_value(b);
+    int64_t r = 0;
+    switch (op) {
+    case binary_operation::add:
+        return checked_add(x, y, r) ? make_signed(r, bits) : nullptr;
+    case binary_operation::subtract:
+        return checked_sub(x, y, r) ? make_signed(r, bits) : nullptr;
+    case binary_operation::multiply:
+        return checked_mul(x, y, r) ? make_signed(r, bits) : nullptr;
+    case binary_operation::divide:
+        return y != 0 && !(x == int_min(bits) && y == -1) ? make_signed(x / y, bits) : nullptr;
+    case binary_operation::modulo:
+        return y != 0 && !(x == int_min(bits) && y == -1) ? make_signed(x % y, bits) : nullptr;
+    case binary_operation::bitwise_and:
+        return make_signed(x & y, bits);
+    case binary_operation::bitwise_or:
+        return make_signed(x | y, bits);
+    case binary_operation::bitwise_xor:
+        return make_signed(x ^ y, bits);
+    case binary_operation::greater_than:
+        return make_bool(x > y);
+    case binary_operation::less_than:
+        return make_bool(x < y);
+    case binary_operation::greater_than_or_equal:
+        return make_bool(x >= y);
+    case binary_operation::less_than_or_equal:
+        return make_bool(x <= y);
+    case binary_operation::equal:
+        return make_bool(x == y);
+    case binary_operation::not_equal:
+        return make_bool(x != y);
+    case binary_operation::logical_and:
+        return make_bool(x && y);
+    case binary_operation::logical_or:
+        return make_bool(x || y);
+    default:
+        break;
+    }
+    return nullptr;
+}
+
+template <typename T> auto fold_float(binary_operation op, T x, T y, short bits) -> expr {
+    switch (op) {
+    case binary_operation::add:
+        return make_float(static_cast<T>(x + y), bits);
+    case binary_operation::subtract:
+        return make_float(static_cast<T>(x - y), bits);
+    case binary_operation::multiply:
+        return make_float(static_cast<T>(x * y), bits);
+    case binary_operation::divide:
+        return y != T(0) ? make_float(static_cast<T>(x / y), bits) : nullptr;
+    case binary_operation::greater_than:
+        return make_bool(x > y);
+    case binary_operation::less_than:
+        return make_bool(x < y);
+    case binary_operation::greater_than_or_equal:
+        return make_bool(x >= y);
+    case binary_operation::less_than_or_equal:
+        return make_bool(x <= y);
+    case binary_operation::equal:
+        return make_bool(x == y);
+    case binary_operation::not_equal:
+        return make_bool(x != y);
+    default:
+        break;
+    }
+    return nullptr;
+}
+
+//! Returns the immediate value of a if a is +1 or -1
+auto unit(std::optional<imm_value> const &a) -> int {
+    if (!a) {
+        return 0;
+    }
+    switch (a->k) {
+    case imm_value::kind::sint:
+        return a->s == 1 ? 1 : (a->s == -1 ? -1 : 0);
+    case imm_value::kind::uint:
+        return a->u == 1 ? 1 : 0;
+    case imm_value::kind::fp:
+        return a->f == 1.0 ? 1 : (a->f == -1.0 ? -1 : 0);
+    }
+    return 0;
+}
+
+bool is_zero(std::optional<imm_value> const &a) {
+    return a && ((a->k == imm_value::kind::sint && a->s == 0) ||
+                 (a->k == imm_value::kind::uint && a->u == 0));
+}
+
+auto unary_term(expr &e, unary_operation op) -> internal::unary_op * {
+    auto u = dynamic_cast<internal::unary_op *>(e.get());
+    return u && u->op() == op ? u : nullptr;
+}
+
+void flatten_comma(expr &e, std::vector<expr> &list) {
+    auto b = dynamic_cast<internal::binary_op *>(e.get());
+    if (b && b->op() == binary_operation::comma) {
+        flatten_comma(b->lhs(), list);
+        list.emplace_back(b->rhs());
+    } else {
+        list.emplace_back(e);
+    }
+}
+
+//! Returns v if c is v.s<i>
+auto component_of(expr &c, short i) -> expr {
+    auto s = dynamic_cast<internal::swizzle *>(c.get());
+    if (s && s->selector() == internal::swizzle_selector::index && s->indices().size() == 1 &&
+        s->indices()[0] == i) {
+        return s->term();
+    }
+    return nullptr;
+}
+
+//! Splits x * c or c * x into x and c if c is an integer immediate
+auto split_multiply(expr &e) -> std::optional<std::pair<expr, imm_value>> {
+    auto b = dynamic_cast<internal::binary_op *>(e.get());
+    if (!b || b->op() != binary_operation::multiply) {
+        return std::nullopt;
+    }
+    if (auto c = imm(b->rhs()); c && c->is_integer()) {
+        return std::make_pair(b->lhs(), *c);
+    }
+    if (auto c = imm(b->lhs()); c && c->is_integer()) {
+        return std::make_pair(b->rhs(), *c);
+    }
+    return std::nullopt;
+}
+
+//! Returns x * c if e is x * -c or -c * x for a float immediate c
+auto negative_float_product(expr &e) -> expr {
+    auto b = dynamic_cast<internal::binary_op *>(e.get());
+    if (!b || b->op() != binary_operation::multiply) {
+        return nullptr;
+    }
+    auto is_negative = [](std::optional<imm_value> const &c) {
+        return c && c->k == imm_value::kind::fp && std::signbit(c->f);
+    };
+    if (auto c = imm(b->rhs()); is_negative(c)) {
+        return b->lhs() * expr(-c->f, c->bits);
+    }
+    if (auto c = imm(b->lhs()); is_negative(c)) {
+        return expr(-c->f, c->bits) * b->rhs();
+    }
+    return nullptr;
+}
+
+bool same_integer_type(imm_value const &a, imm_value const &b) {
+    return a.k == b.k && a.is_integer() && a.promoted_bits() == b.promoted_bits();
+}
+
+} // namespace
+
+expr constant_folding::fold(internal::binary_op &e) {
+    auto a = imm(e.lhs());
+    auto b = imm(e.rhs());
+    if (!a || !b) {
+        return nullptr;
+    }
+    if (a->is_integer() && b->is_integer()) {
+        return fold_integer(e.op(), *a, *b);
+    }
+    if (a->k == imm_value::kind::fp && b->k == imm_value::kind::fp && a->bits == b->bits) {
+        if (a->bits == 32) {
+            return fold_float(e.op(), static_cast<float>(a->f), static_cast<float>(b->f), 32);
+        } else if (a->bits == 64) {
+            return fold_float(e.op(), a->f, b->f, 64);
+        }
+    }
+    return nullptr;
+}
+
+expr constant_folding::reassociate(internal::binary_op &e) {
+    auto c2 = imm(e.rhs());
+    if (!c2 || !c2->is_integer()) {
+        return nullptr;
+    }
+    auto const bits = c2->promoted_bits();
+    // Constants are combined exactly, that is, no wrap-around is folded into the constant
+    auto value = [](imm_value const &c, int64_t &v) {
+        if (c.k == imm_value::kind::uint && c.u > uint64_t(std::numeric_limits<int64_t>::max())) {
+            return false;
+        }
+        v = signed_value(c);
+        return true;
+    };
+    auto make_constant = [&](int64_t k) -> expr {
+        if (c2->k == imm_value::kind::uint) {
+            return uint64_t(k) <= mask(bits) ? expr(uint64_t(k), bits) : nullptr;
+        }
+        return make_signed(k, bits);
+    };
+    auto operand_kind = [&](expr &x) {
+        auto p = get_properties(visit(types_, *x));
+        if (p.is_pointer && !p.is_array) {
+            return 2;
+        }
+        return p.components > 0 && p.ty != builtin_type::bool_t && !is_floating(p.ty) ? 1 : 0;
+    };
+
+    int64_t k1 = 0, k2 = 0, k = 0;
+    if (e.op() == binary_operation::add || e.op() == binary_operation::subtract) {
+        auto inner = dynamic_cast<internal::binary_op *>(e.lhs().get());
+        if (!inner ||
+            (inner->op() != binary_operation::add && inner->op() != binary_operation::subtract)) {
+            return nullptr;
+        }
+        auto c1 = imm(inner->rhs());
+        if (!c1 || !same_integer_type(*c1, *c2) || operand_kind(inner->lhs()) == 0 ||
+            !value(*c1, k1) || !value(*c2, k2)) {
+            return nullptr;
+        }
+        if ((inner->op() == binary_operation::subtract && !checked_sub(0, k1, k1)) ||
+            (e.op() == binary_operation::subtract && !checked_sub(0, k2, k2)) ||
+            !checked_add(k1, k2, k)) {
+            return nullptr;
+        }
+        if (k == 0) {
+            return inner->lhs();
+        }
+        int64_t abs_k_value = k;
+        if (k < 0 && !checked_sub(0, k, abs_k_value)) {
+            return nullptr;
+        }
+        auto abs_k = make_constant(abs_k_value);
+        if (!bool(abs_k)) {
+            return nullptr;
+        }
+        return k < 0 ? inner->lhs() - std::move(abs_k) : inner->lhs() + std::move(abs_k);
+    }
+
+    if (e.op() == binary_operation::multiply) {
+        auto lhs = split_multiply(e.lhs());
+        if (!lhs) {
+            return nullptr;
+        }
+        auto &[x, c1] = *lhs;
+        if (!same_integer_type(c1, *c2) || operand_kind(x) != 1 || !value(c1, k1) ||
+            !value(*c2, k2) || !checked_mul(k1, k2, k)) {
+            return nullptr;
+        }
+        auto k_imm = make_constant(k);
+        return k_imm ? x * std::move(k_imm) : nullptr;
+    }
+    return nullptr;
+}
+
+expr constant_folding::simplify(internal::binary_op &e) {
+    auto a = imm(e.lhs());
+    auto b = imm(e.rhs());
+    auto has_type_of = [&](expr &x) {
+        auto tx = visit(types_, *x);
+        auto te = visit(types_, static_cast<internal::expr_node &>(e));
+        return tx && te && is_equivalent(tx, te);
+    };
+    switch (e.op()) {
+    case binary_operation::add:
+    case binary_operation::subtract: {
+        bool const is_add = e.op() == binary_operation::add;
+        if (is_zero(b) && has_type_of(e.lhs())) {
+            return e.lhs();
+        }
+        if (is_add && is_zero(a) && has_type_of(e.rhs())) {
+            return e.rhs();
+        }
+        if (auto u = unary_term(e.rhs(), unary_operation::minus); u) {
+            return is_add ? e.lhs() - u->term() : e.lhs() + u->term();
+        }
+        if (auto m = negative_float_product(e.rhs()); m) {
+            return is_add ? e.lhs() - std::move(m) : e.lhs() + std::move(m);
+        }
+        break;
+    }
+    case binary_operation::multiply:
+        if (auto s = unit(b); s != 0 && has_type_of(e.lhs())) {
+            return s > 0 ? e.lhs() : -e.lhs();
+        }
+        if (auto s = unit(a); s != 0 && has_type_of(e.rhs())) {
+            return s > 0 ? e.rhs() : -e.rhs();
+        }
+        break;
+    case binary_operation::divide:
+        if (auto s = unit(b); s != 0 && has_type_of(e.lhs())) {
+            return s > 0 ? e.lhs() : -e.lhs();
+        }
+        break;
+    default:
+        break;
+    }
+    return nullptr;
+}
+
+/* Expr nodes */
+expr constant_folding::operator()(internal::expr_node &) { return nullptr; }
+
+expr constant_folding::operator()(internal::unary_op &e) {
+    if (auto t = visit(*this, *e.term()); t) {
+        e.term(std::move(t));
+    }
+    if (e.op() == unary_operation::minus) {
+        if (auto inner = unary_term(e.term(), unary_operation::minus); inner) {
+            return inner->term();
+        }
+    }
+    auto a = imm(e.term());
+    if (!a) {
+        return nullptr;
+    }
+    auto const bits = a->promoted_bits();
+    switch (e.op()) {
+    case unary_operation::minus:
+        if (a->k == imm_value::kind::sint) {
+            return a->s > int_min(bits) ? make_signed(-a->s, bits) : nullptr;
+        } else if (a->k == imm_value::kind::uint) {
+            return expr((-a->u) & mask(bits), bits);
+        }
+        return make_float(-a->f, a->bits);
+    case unary_operation::bitwise_not:
+        if (a->k == imm_value::kind::sint) {
+            return make_signed(~a->s, bits);
+        } else if (a->k == imm_value::kind::uint) {
+            return expr((~a->u) & mask(bits), bits);
+        }
+        break;
+    case unary_operation::logical_not:
+        if (a->is_integer()) {
+            return make_bool(a->k == imm_value::kind::sint ? a->s == 0 : a->u == 0);
+        }
+        break;
+    default:
+        break;
+    }
+    return nullptr;
+}
+
+expr constant_folding::operator()(internal::binary_op &e) {
+    if (auto lhs = visit(*this, *e.lhs()); lhs) {
+        e.lhs(std::move(lhs));
+    }
+    if (auto rhs = visit(*this, *e.rhs()); rhs) {
+        e.rhs(std::move(rhs));
+    }
+    if (auto f = fold(e); f) {
+        return f;
+    }
+    if (auto r = reassociate(e); r) {
+        auto f = visit(*this, *r);
+        return f ? f : r;
+    }
+    if (auto s = simplify(e); s) {
+        auto f = visit(*this, *s);
+        return f ? f : s;
+    }
+    return nullptr;
+}
+
+expr constant_folding::operator()(internal::ternary_op &e) {
+    if (auto t = visit(*this, *e.term0()); t) {
+        e.term0(std::move(t));
+    }
+    if (auto t = visit(*this, *e.term1()); t) {
+        e.term1(std::move(t));
+    }
+    if (auto t = visit(*this, *e.term2()); t) {
+        e.term2(std::move(t));
+    }
+    return nullptr;
+}
+
+expr constant_folding::operator()(internal::access &e) {
+    if (auto f = visit(*this, *e.field()); f) {
+        e.field(std::move(f));
+    }
+    if (auto a = visit(*this, *e.address()); a) {
+        e.address(std::move(a));
+    }
+    return nullptr;
+}
+
+expr constant_folding::operator()(internal::call_builtin &fn) {
+    for (auto &arg : fn.args()) {
+        if (auto a = visit(*this, *arg); a) {
+            arg = std::move(a);
+        }
+    }
+    return nullptr;
+}
+
+expr constant_folding::operator()(internal::call &fn) {
+    for (auto &arg : fn.args()) {
+        if (auto a = visit(*this, *arg); a) {
+            arg = std::move(a);
+        }
+    }
+    return nullptr;
+}
+
+expr constant_folding::operator()(internal::cast &c) {
+    if (auto t = visit(*this, *c.term()); t) {
+        c.term(std::move(t));
+    }
+
+    auto p = get_properties(c.target_ty());
+    if (p.is_pointer || p.components <= 1) {
+        return nullptr;
+    }
+    auto list = std::vector<expr>{};
+    flatten_comma(c.term(), list);
+    if (list.size() != static_cast<std::size_t>(p.components)) {
+        return nullptr;
+    }
+    // Vector literal that reassembles a vector of the same type, possibly negated
+    bool const negated = unary_term(list[0], unary_operation::minus) != nullptr;
+    expr v = nullptr;
+    for (short i = 0; i < p.components; ++i) {
+        auto &l = list[i];
+        auto u = unary_term(l, unary_operation::minus);
+        if ((u != nullptr) != negated) {
+            return nullptr;
+        }
+        auto vi = component_of(u ? u->term() : l, i);
+        if (!bool(vi) || (bool(v) && !is_equivalent(v, vi))) {
+            return nullptr;
+        }
+        v = std::move(vi);
+    }
+    auto ty = visit(types_, *v);
+    if (!ty || !is_equivalent(ty, make_type(p.ty, p.components)) || has_side_effects(*v)) {
+        return nullptr;
+    }
+    return negated ? -v : v;
+}
+
+expr constant_folding::operator()(internal::swizzle &s) {
+    if (auto t = visit(*this, *s.term()); t) {
+        s.term(std::move(t));
+    }
+    return nullptr;
+}
+
+/* Stmt nodes */
+void constant_folding::operator()(internal::declaration &d) {
+    types_.declare(d.variable().get(), d.ty());
+}
+void constant_folding::operator()(internal::declaration_assignment &d) {
+    (*this)(d.decl());
+    if (auto r = visit(*this, *d.rhs()); r) {
+        d.rhs(std::move(r));
+    }
+}
+void constant_folding::operator()(internal::expression_statement &e) {
+    if (auto r = visit(*this, *e.term()); r) {
+        e.term(std::move(r));
+    }
+}
+void constant_folding::operator()(internal::return_statement &e) {
+    if (auto r = visit(*this, *e.term()); r) {
+        e.term(std::move(r));
+    }
+}
+
+void constant_folding::operator()(internal::block &b) {
+    for (auto &s : b.stmts()) {
+        visit(*this, *s);
+    }
+}
+
+void constant_folding::operator()(internal::for_loop &loop) {
+    visit(*this, *loop.start());
+    if (auto r = visit(*this, *loop.condition()); r) {
+        loop.condition(std::move(r));
+    }
+    if (auto r = visit(*this, *loop.step()); r) {
+        loop.step(std::move(r));
+    }
+    visit(*this, *loop.body());
+}
+
+void constant_folding::operator()(internal::if_selection &is) {
+    if (auto r = visit(*this, *is.condition()); r) {
+        is.condition(std::move(r));
+    }
+    visit(*this, *is.then());
+    if (is.otherwise()) {
+        visit(*this, **is.otherwise());
+    }
+}
+
+void constant_folding::operator()(internal::while_loop &loop) {
+    if (auto r = visit(*this, *loop.condition()); r) {
+        loop.condition(std::move(r));
+    }
+    visit(*this, *loop.body());
+}
+
+/* Kernel nodes */
+void constant_folding::operator()(internal::prototype &proto) {
+    for (auto &[ty, v] : proto.args()) {
+        types_.declare(v.get(), ty);
+    }
+}
+void constant_folding::operator()(internal::function &fn) {
+    visit(*this, *fn.prototype());
+    visit(*this, *fn.body());
+}
+void constant_folding::operator()(internal::global_declaration &d) { visit(*this, *d.term()); }
+
+/* Program nodes */
+void constant_folding::operator()(internal::program &prg) {
+    for (auto &d : prg.declarations()) {
+        visit(*this, *d);
+    }
+}
+
+expr fold_constants(expr e) {
+    auto f = visit(constant_folding{}, *e);
+    return f ? f : e;
+}
+void fold_constants(stmt s) { visit(constant_folding{}, *s); }
+void fold_constants(func k) { visit(constant_folding{}, *k); }
+void fold_constants(prog p) { visit(constant_folding{}, *p); }
+
+} // namespace clir
@@ -0,0 +1,650 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "clir/visitor/dead_store.hpp"
+#include "side_effects.hpp"
+#include "type_properties.hpp"
+#include "variable_usage.hpp"
+#include "clir/func.hpp"
+#include "clir/prog.hpp"
+#include "clir/stmt.hpp"
+#include "clir/var.hpp"
+#include "clir/visit.hpp"
+#include "clir/visitor/equal_expr.hpp"
+#include "clir/visitor/to_imm.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <map>
+#include <optional>
+#include <variant>
+#include <vector>
+
+namespace clir {
+
+namespace {
+
+using node_set = std::unordered_set<internal::expr_node const *>;
+
+auto constant_index(expr &e) -> std::optional<std::int64_t> {
+    auto imm = get_imm(e);
+    if (auto i = std::get_if<int64_t>(&imm); i) {
+        return *i;
+    }
+    if (auto u = std::get_if<uint64_t>(&imm);
+        u && *u <= static_cast<uint64_t>(std::numeric_limits<std::int64_t>::max())) {
+        return static_cast<std::int64_t>(*u);
+    }
+    return std::nullopt;
+}
+
+//! Collects every variable that appears in an expression or statement
+class mentioned {
+  public:
+    mentioned(node_set &vars) : vars_(vars) {}
+
+    /* Expr nodes */
+    void operator()(internal::expr_node &) {}
+    void operator()(internal::variable &v) { vars_.insert(&v); }
+    void operator()(internal::unary_op &e) { visit(*this, *e.term()); }
+    void operator()(internal::binary_op &e) {
+        visit(*this, *e.lhs());
+        visit(*this, *e.rhs());
+    }
+    void operator()(internal::ternary_op &e) {
+        visit(*this, *e.term0());
+        visit(*this, *e.term1());
+        visit(*this, *e.term2());
+    }
+    void operator()(internal::access &e) {
+        visit(*this, *e.field());
+        visit(*this, *e.address());
+    }
+    void operator()(internal::call_builtin &fn) {
+        for (auto &arg : fn.args()) {
+            visit(*this, *arg);
+        }
+    }
+    void operator()(internal::call &fn) {
+        for (auto &arg : fn.args()) {
+            visit(*this, *arg);
+        }
+    }
+    void operator()(internal::cast &c) { visit(*this, *c.term()); }
+    void operator()(internal::swizzle &s) { visit(*this, *s.term()); }
+
+    /* Stmt nodes */
+    void operator()(internal::declaration &) {}
+    void operator()(internal::declaration_assignment &d) { visit(*this, *d.rhs()); }
+    void operator()(internal::expression_statement &e) { visit(*this, *e.term()); }
+    void operator()(internal::return_statement &e) { visit(*this, *e.term()); }
+    void operator()(internal::block &b) {
+        for (auto &s : b.stmts()) {
+            visit(*this, *s);
+        }
+    }
+    void operator()(internal::for_loop &loop) {
+        visit(*this, *loop.start());
+        visit(*this, *loop.condition());
+        visit(*this, *loop.step());
+        visit(*this, *loop.body());
+    }
+    void operator()(internal::if_selection &is) {
+        visit(*this, *is.condition());
+        visit(*this, *is.then());
+        if (is.otherwise()) {
+            visit(*this, **is.otherwise());
+        }
+    }
+    void operator()(internal::while_loop &loop) {
+        visit(*this, *loop.condition());
+        visit(*this, *loop.body());
+    }
+
+  private:
+    node_set &vars_;
+};
+
+//! Collects the variables declared in a statement
+class declared {
+  public:
+    declared(std::vector<internal::declaration *> &decls) : decls_(decls) {}
+
+    void operator()(internal::declaration &d) { decls_.emplace_back(&d); }
+    void operator()(internal::declaration_assignment &d) { decls_.emplace_back(&d.decl()); }
+    void operator()(internal::expression_statement &) {}
+    void operator()(internal::return_statement &) {}
+    void operator()(internal::block &b) {
+        for (auto &s : b.stmts()) {
+            visit(*this, *s);
+        }
+    }
+    void operator()(internal::for_loop &loop) {
+        visit(*this, *loop.start());
+        visit(*this, *loop.body());
+    }
+    void operator()(internal::if_selection &is) {
+        visit(*this, *is.then());
+        if (is.otherwise()) {
+            visit(*this, **is.otherwise());
+        }
+    }
+    void operator()(internal::while_loop &loop) { visit(*this, *loop.body()); }
+
+  private:
+    std::vector<internal::declaration *> &decls_;
+};
+
+/**
+ * @brief Adds the variables read by an expression to a live set
+ *
+ * Elements of tracked arrays that are accessed with a constant index are added individually.
+ * For statements, every variable mentioned is considered read, including stored ones.
+ */
+class reads {
+  public:
+    reads(node_set &whole, std::set<std::pair<internal::expr_node const *, std::int64_t>> &elements,
+          node_set const &arrays)
+        : whole_(whole), elements_(elements), arrays_(arrays) {}
+
+    void operator()(internal::expr_node &) {}
+    void operator()(internal::variable &v) { whole_.insert(&v); }
+    void operator()(internal::unary_op &e) { visit(*this, *e.term()); }
+    void operator()(internal::binary_op &e) {
+        visit(*this, *e.lhs());
+        visit(*this, *e.rhs());
+    }
+    void operator()(internal::ternary_op &e) {
+        visit(*this, *e.term0());
+        visit(*this, *e.term1());
+        visit(*this, *e.term2());
+    }
+    void operator()(internal::access &e) {
+        auto v = e.field().get();
+        if (arrays_.find(v) != arrays_.end()) {
+            if (auto index = constant_index(e.address()); index) {
+                elements_.emplace(v, *index);
+                return;
+            }
+        }
+        visit(*this, *e.field());
+        visit(*this, *e.address());
+    }
+    void operator()(internal::call_builtin &fn) {
+        for (auto &arg : fn.args()) {
+            visit(*this, *arg);
+        }
+    }
+    void operator()(internal::call &fn) {
+        for (auto &arg : fn.args()) {
+            visit(*this, *arg);
+        }
+    }
+    void operator()(internal::cast &c) { visit(*this, *c.term()); }
+    void operator()(internal::swizzle &s) { visit(*this, *s.term()); }
+
+    /* Stmt nodes */
+    void operator()(internal::declaration &) {}
+    void operator()(internal::declaration_assignment &d) { visit(*this, *d.rhs()); }
+    void operator()(internal::expression_statement &e) { visit(*this, *e.term()); }
+    void operator()(internal::return_statement &e) { visit(*this, *e.term()); }
+    void operator()(internal::block &b) {
+        for (auto &s : b.stmts()) {
+            visit(*this, *s);
+        }
+    }
+    void operator()(internal::for_loop &loop) {
+        visit(*this, *loop.start());
+        visit(*this, *loop.condition());
+        visit(*this, *loop.step());
+        visit(*this, *loop.body());
+    }
+    void operator()(internal::if_selection &is) {
+        visit(*this, *is.condition());
+        visit(*this, *is.then());
+        if (is.otherwise()) {
+            visit(*this, **is.otherwise());
+        }
+    }
+    void operator()(internal::while_loop &loop) {
+        visit(*this, *loop.condition());
+        visit(*this, *loop.body());
+    }
+
+  private:
+    node_set &whole_;
+    std::set<std::pair<internal::expr_node const *, std::int64_t>> &elements_;
+    node_set const &arrays_;
+};
+
+//! Removes declarations of variables that are not referenced
+class unused_declarations {
+  public:
+    unused_declarations(node_set const &referenced, node_set const &removable)
+        : referenced_(referenced), removable_(removable) {}
+
+    bool operator()(internal::declaration &d) { return unused(d); }
+    bool operator()(internal::declaration_assignment &d) {
+        return unused(d.decl()) && !has_side_effects(*d.rhs());
+    }
+    bool operator()(internal::expression_statement &) { return false; }
+    bool operator()(internal::return_statement &) { return false; }
+    bool operator()(internal::block &b) {
+        auto &stmts = b.stmts();
+        auto const size = stmts.size();
+        stmts.erase(std::remove_if(stmts.begin(), stmts.end(),
+                                   [this](stmt &s) { return visit(*this, *s); }),
+                    stmts.end());
+        changed = changed || stmts.size() != size;
+        return false;
+    }
+    bool operator()(internal::for_loop &loop) {
+        visit(*this, *loop.body());
+        return false;
+    }
+    bool operator()(internal::if_selection &is) {
+        visit(*this, *is.then());
+        if (is.otherwise()) {
+            visit(*this, **is.otherwise());
+        }
+        return false;
+    }
+    bool operator()(internal::while_loop &loop) {
+        visit(*this, *loop.body());
+        return false;
+    }
+
+    bool changed = false;
+
+  private:
+    bool unused(internal::declaration &d) {
+        auto v = d.variable().get();
+        return removable_.find(v) != removable_.end() && referenced_.find(v) == referenced_.end();
+    }
+
+    node_set const &referenced_;
+    node_set const &removable_;
+};
+
+/**
+ * @brief Forwards copies between private variables
+ *
+ * After a = b, where a and b are private variables or private array elements with constant
+ * index, reads of a are replaced by b until either is modified. The copy itself is then
+ * usually dead. Only straight-line code is tracked; nested statements start from scratch.
+ */
+class copy_forwarding {
+  public:
+    using location = std::pair<internal::expr_node const *, std::int64_t>;
+
+    copy_forwarding(node_set const &removable, node_set const &arrays)
+        : removable_(removable), arrays_(arrays) {}
+
+    /* Expr nodes */
+    void operator()(internal::expr_node &) {}
+    void operator()(internal::unary_op &e) { substitute(e.term()); }
+    void operator()(internal::binary_op &e) {
+        substitute(e.lhs());
+        substitute(e.rhs());
+    }
+    void operator()(internal::ternary_op &e) {
+        substitute(e.term0());
+        substitute(e.term1());
+        substitute(e.term2());
+    }
+    void operator()(internal::access &e) {
+        if (!dynamic_cast<internal::variable *>(e.field().get())) {
+            substitute(e.field());
+        }
+        substitute(e.address());
+    }
+    void operator()(internal::call_builtin &fn) {
+        for (auto &arg : fn.args()) {
+            substitute(arg);
+        }
+    }
+    void operator()(internal::call &fn) {
+        for (auto &arg : fn.args()) {
+            substitute(arg);
+        }
+    }
+    void operator()(internal::cast &c) { substitute(c.term()); }
+    void operator()(internal::swizzle &s) { substitute(s.term()); }
+
+    /* Stmt nodes */
+    void operator()(internal::declaration &d) { kill(d.variable().get()); }
+    void operator()(internal::declaration_assignment &d) {
+        if (has_side_effects(*d.rhs())) {
+            clear();
+            return;
+        }
+        substitute(d.rhs());
+        auto v = d.decl().variable().get();
+        kill(v);
+        if (arrays_.find(v) == arrays_.end()) {
+            record(tracked(*d.decl().variable()), d.rhs());
+        }
+    }
+    void operator()(internal::expression_statement &e) {
+        auto b = dynamic_cast<internal::binary_op *>(e.term().get());
+        if (!b || !is_assignment(b->op()) || has_side_effects(*b->rhs())) {
+            clear();
+            return;
+        }
+        substitute(b->rhs());
+        if (!dynamic_cast<internal::variable *>(b->lhs().get())) {
+            visit(*this, *b->lhs());
+        }
+        auto lhs = tracked(*b->lhs());
+        if (lhs) {
+            kill(*lhs);
+        } else {
+            invalidate(e);
+        }
+        if (b->op() == binary_operation::assignment) {
+            record(lhs, b->rhs());
+        }
+    }
+    void operator()(internal::return_statement &e) { substitute(e.term()); }
+    void operator()(internal::block &b) {
+        auto outer = std::move(copies_);
+        copies_ = {};
+        for (auto &s : b.stmts()) {
+            visit(*this, *s);
+        }
+        copies_ = std::move(outer);
+        invalidate(b);
+    }
+    void operator()(internal::for_loop &loop) { nested(loop, *loop.body()); }
+    void operator()(internal::if_selection &is) {
+        substitute(is.condition());
+        nested(is, *is.then());
+        if (is.otherwise()) {
+            nested(is, **is.otherwise());
+        }
+    }
+    void operator()(internal::while_loop &loop) { nested(loop, *loop.body()); }
+
+  private:
+    struct copy {
+        location source;
+        expr e;
+    };
+
+    //! Location of a private variable or a private array element with constant index
+    auto tracked(internal::expr_node &e) -> std::optional<location> {
+        if (removable_.find(&e) != removable_.end() && arrays_.find(&e) == arrays_.end()) {
+            return location{&e, std::numeric_limits<std::int64_t>::min()};
+        }
+        if (auto a = dynamic_cast<internal::access *>(&e); a) {
+            auto v = a->field().get();
+            auto index = constant_index(a->address());
+            if (index && removable_.find(v) != removable_.end() &&
+                arrays_.find(v) != arrays_.end()) {
+                return location{v, *index};
+            }
+        }
+        return std::nullopt;
+    }
+    void substitute(expr &e) {
+        if (auto l = tracked(*e); l) {
+            if (auto it = copies_.find(*l); it != copies_.end()) {
+                e = it->second.e;
+            }
+            return;
+        }
+        visit(*this, *e);
+    }
+    void record(std::optional<location> const &lhs, expr &rhs) {
+        auto source = tracked(*rhs);
+        if (lhs && source && *lhs != *source) {
+            copies_[*lhs] = copy{*source, rhs};
+        }
+    }
+    void kill(location const &l) {
+        for (auto it = copies_.begin(); it != copies_.end();) {
+            if (it->first == l || it->second.source == l ||
+                (l.second == std::numeric_limits<std::int64_t>::min() &&
+                 (it->first.first == l.first || it->second.source.first == l.first))) {
+                it = copies_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    void kill(internal::expr_node const *v) {
+        kill(location{v, std::numeric_limits<std::int64_t>::min()});
+    }
+    void invalidate(internal::stmt_node &node) {
+        auto assigned = node_set{};
+        auto stored = node_set{};
+        visit(variable_usage{assigned, stored}, node);
+        for (auto v : assigned) {
+            kill(v);
+        }
+        for (auto v : stored) {
+            kill(v);
+        }
+    }
+    void nested(internal::stmt_node &s, internal::stmt_node &body) {
+        auto outer = std::move(copies_);
+        copies_ = {};
+        visit(*this, body);
+        copies_ = std::move(outer);
+        invalidate(s);
+    }
+    void clear() { copies_.clear(); }
+
+    node_set const &removable_;
+    node_set const &arrays_;
+    std::map<location, copy> copies_;
+};
+
+} // namespace
+
+bool dead_store_elimination::is_live(internal::expr_node const *v) const {
+    if (live_.whole.find(v) != live_.whole.end()) {
+        return true;
+    }
+    auto it = live_.elements.lower_bound({v, std::numeric_limits<std::int64_t>::min()});
+    return it != live_.elements.end() && it->first == v;
+}
+
+bool dead_store_elimination::is_live(internal::expr_node const *v, std::int64_t index) const {
+    return live_.whole.find(v) != live_.whole.end() ||
+           live_.elements.find({v, index}) != live_.elements.end();
+}
+
+void dead_store_elimination::kill(internal::expr_node const *v) {
+    live_.whole.erase(v);
+    auto first = live_.elements.lower_bound({v, std::numeric_limits<std::int64_t>::min()});
+    auto last = first;
+    while (last != live_.elements.end() && last->first == v) {
+        ++last;
+    }
+    live_.elements.erase(first, last);
+}
+
+void dead_store_elimination::read(internal::expr_node &e) {
+    visit(reads{live_.whole, live_.elements, arrays_}, e);
+}
+
+void dead_store_elimination::loop(internal::stmt_node &s, internal::stmt_node &body) {
+    // Everything mentioned in the loop may be read by the next iteration, except for variables
+    // that are declared in the body
+    visit(reads{live_.whole, live_.elements, arrays_}, s);
+    auto decls = std::vector<internal::declaration *>{};
+    visit(declared{decls}, body);
+    for (auto d : decls) {
+        kill(d->variable().get());
+    }
+    auto const at_exit = live_;
+    visit(*this, body);
+    live_ = at_exit;
+}
+
+/* Stmt nodes */
+bool dead_store_elimination::operator()(internal::declaration &d) {
+    kill(d.variable().get());
+    return false;
+}
+
+bool dead_store_elimination::operator()(internal::declaration_assignment &d) {
+    auto v = d.decl().variable().get();
+    if (removable_.find(v) != removable_.end() && !is_live(v) && !has_side_effects(*d.rhs())) {
+        return true;
+    }
+    kill(v);
+    read(*d.rhs());
+    return false;
+}
+
+bool dead_store_elimination::operator()(internal::expression_statement &e) {
+    auto &term = *e.term();
+    if (!has_side_effects(term)) {
+        return true;
+    }
+    auto b = dynamic_cast<internal::binary_op *>(&term);
+    if (b && b->op() == binary_operation::assignment && !has_side_effects(*b->lhs()) &&
+        !has_side_effects(*b->rhs())) {
+        if (is_equivalent(b->lhs(), b->rhs())) {
+            return true;
+        }
+        auto lhs = b->lhs().get();
+        if (removable_.find(lhs) != removable_.end() && arrays_.find(lhs) == arrays_.end()) {
+            if (!is_live(lhs)) {
+                return true;
+            }
+            kill(lhs);
+            read(*b->rhs());
+            return false;
+        }
+        if (auto a = dynamic_cast<internal::access *>(lhs); a) {
+            auto v = a->field().get();
+            auto index = constant_index(a->address());
+            if (index && removable_.find(v) != removable_.end() &&
+                arrays_.find(v) != arrays_.end()) {
+                if (!is_live(v, *index)) {
+                    return true;
+                }
+                live_.elements.erase({v, *index});
+                read(*b->rhs());
+                return false;
+            }
+        }
+    }
+    read(term);
+    return false;
+}
+
+bool dead_store_elimination::operator()(internal::return_statement &e) {
+    // Nothing after the return statement is executed
+    live_ = {};
+    read(*e.term());
+    return false;
+}
+
+bool dead_store_elimination::operator()(internal::block &b) {
+    auto &stmts = b.stmts();
+    auto dead = std::vector<bool>(stmts.size(), false);
+    for (std::size_t i = stmts.size(); i-- > 0;) {
+        dead[i] = visit(*this, *stmts[i]);
+    }
+    auto kept = std::vector<stmt>{};
+    kept.reserve(stmts.size());
+    for (std::size_t i = 0; i < stmts.size(); ++i) {
+        if (!dead[i]) {
+            kept.emplace_back(std::move(stmts[i]));
+        } else if (auto d = dynamic_cast<internal::declaration_assignment *>(stmts[i].get()); d) {
+            // The variable may be assigned later; unreferenced declarations are removed separately
+            kept.emplace_back(std::make_shared<internal::declaration>(d->decl()));
+        }
+    }
+    changed_ = changed_ || std::find(dead.begin(), dead.end(), true) != dead.end();
+    stmts = std::move(kept);
+    return false;
+}
+
+bool dead_store_elimination::operator()(internal::for_loop &l) {
+    loop(l, *l.body());
+    return false;
+}
+
+bool dead_store_elimination::operator()(internal::if_selection &is) {
+    auto const after = live_;
+    visit(*this, *is.then());
+    if (is.otherwise()) {
+        auto then_live = std::move(live_);
+        live_ = after;
+        visit(*this, **is.otherwise());
+        live_.whole.insert(then_live.whole.begin(), then_live.whole.end());
+        live_.elements.insert(then_live.elements.begin(), then_live.elements.end());
+    } else {
+        live_.whole.insert(after.whole.begin(), after.whole.end());
+        live_.elements.insert(after.elements.begin(), after.elements.end());
+    }
+    read(*is.condition());
+    return false;
+}
+
+bool dead_store_elimination::operator()(internal::while_loop &l) {
+    loop(l, *l.body());
+    return false;
+}
+
+/* Kernel nodes */
+void dead_store_elimination::operator()(internal::prototype &) {}
+void dead_store_elimination::operator()(internal::function &fn) {
+    auto &body = *fn.body();
+    auto assigned = node_set{};
+    auto element_stored = node_set{};
+    auto address_taken = node_set{};
+    auto decayed = node_set{};
+    visit(variable_usage{assigned, element_stored, &address_taken, &decayed}, body);
+
+    auto decls = std::vector<internal::declaration *>{};
+    visit(declared{decls}, body);
+    removable_.clear();
+    arrays_.clear();
+    for (auto d : decls) {
+        auto v = d->variable().get();
+        auto p = get_properties(d->ty());
+        auto const is_private =
+            p.space == address_space::generic_t || p.space == address_space::private_t;
+        if (!is_private || address_taken.find(v) != address_taken.end() ||
+            (p.is_array && decayed.find(v) != decayed.end())) {
+            continue;
+        }
+        removable_.insert(v);
+        if (p.is_array) {
+            arrays_.insert(v);
+        }
+    }
+
+    do {
+        changed_ = false;
+        visit(copy_forwarding{removable_, arrays_}, body);
+        live_ = {};
+        visit(*this, body);
+
+        auto referenced = node_set{};
+        visit(mentioned{referenced}, body);
+        auto cleanup = unused_declarations{referenced, removable_};
+        visit(cleanup, body);
+        changed_ = changed_ || cleanup.changed;
+    } while (changed_);
+}
+void dead_store_elimination::operator()(internal::global_declaration &) {}
+
+/* Program nodes */
+void dead_store_elimination::operator()(internal::program &prg) {
+    for (auto &d : prg.declarations()) {
+        visit(*this, *d);
+    }
+}
+
+void eliminate_dead_stores(func k) { visit(dead_store_elimination{}, *k); }
+void eliminate_dead_stores(prog p) { visit(dead_store_elimination{}, *p); }
+
+} // namespace clir
@@ -75,6 +75,10 @@ bool equal_expr::operator()(internal::call_builtin &a, internal::call_builtin &b
 bool equal_expr::operator()(internal::cast &a, internal::cast &b) {
     return visit(*this, *a.target_ty(), *b.target_ty()) && visit(*this, *a.term(), *b.term());
 }
+bool equal_expr::operator()(internal::swizzle &a, internal::swizzle &b) {
+    return a.selector() == b.selector() && a.indices() == b.indices() &&
+           visit(*this, *a.term(), *b.term());
+}
 
 bool is_equivalent(data_type a, data_type b) { return visit(equal_expr{}, *a, *b); }
 bool is_equivalent(expr a, expr b) { return visit(equal_expr{}, *a, *b); }
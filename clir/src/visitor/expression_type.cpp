@@ -0,0 +1,369 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "clir/visitor/expression_type.hpp"
+#include "type_properties.hpp"
+#include "clir/builtin_function.hpp"
+#include "clir/visit.hpp"
+#include "clir/visitor/equal_expr.hpp"
+
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace clir {
+
+namespace {
+
+auto rank(builtin_type ty) -> int {
+    switch (ty) {
+    case builtin_type::bool_t:
+        return 0;
+    case builtin_type::char_t:
+    case builtin_type::uchar_t:
+        return 1;
+    case builtin_type::short_t:
+    case builtin_type::ushort_t:
+        return 2;
+    case builtin_type::int_t:
+    case builtin_type::uint_t:
+        return 3;
+    case builtin_type::long_t:
+    case builtin_type::ulong_t:
+    case builtin_type::size_t:
+    case builtin_type::ptrdiff_t:
+    case builtin_type::intptr_t:
+    case builtin_type::uintptr_t:
+        return 4;
+    default:
+        break;
+    }
+    return -1;
+}
+
+auto float_rank(builtin_type ty) -> int {
+    switch (ty) {
+    case builtin_type::half_t:
+        return 0;
+    case builtin_type::float_t:
+        return 1;
+    case builtin_type::double_t:
+        return 2;
+    default:
+        break;
+    }
+    return -1;
+}
+
+//! Scalar or vector type in the generic address space
+auto value_type(type_properties const &p) -> data_type {
+    if (p.is_pointer || p.components <= 0) {
+        return {};
+    }
+    return make_type(p.ty, p.components);
+}
+
+//! Signed integer type with the same size as the element type, as returned by relational ops
+auto relational_type(data_type operand) -> data_type {
+    auto p = get_properties(operand);
+    if (p.components <= 1) {
+        return p.is_pointer || p.components == 1 ? generic_int() : data_type{};
+    }
+    switch (size_of(p.ty)) {
+    case 1:
+        return generic_char(p.components);
+    case 2:
+        return generic_short(p.components);
+    case 4:
+        return generic_int(p.components);
+    case 8:
+        return generic_long(p.components);
+    default:
+        break;
+    }
+    return {};
+}
+
+auto arithmetic_type(data_type a, data_type b) -> data_type {
+    if (!a || !b) {
+        return {};
+    }
+    auto pa = get_properties(a);
+    auto pb = get_properties(b);
+    if (pa.is_pointer || pb.is_pointer) {
+        return {};
+    }
+    if (pa.components > 1 && pb.components > 1) {
+        return is_equivalent(a, b) ? a : data_type{};
+    }
+    if (pa.components > 1 || pb.components > 1) {
+        // The scalar is converted to the element type of the vector
+        return pa.components > 1 ? a : b;
+    }
+    auto ty = usual_arithmetic_conversion(pa.ty, pb.ty);
+    return ty != builtin_type::void_t ? data_type(ty) : data_type{};
+}
+
+auto promoted_type(data_type a) -> data_type {
+    auto p = get_properties(a);
+    if (p.components == 1) {
+        return data_type(integer_promotion(p.ty));
+    }
+    return p.components > 1 ? a : data_type{};
+}
+
+bool starts_with(std::string_view str, std::string_view prefix) {
+    return str.substr(0, prefix.size()) == prefix;
+}
+
+} // namespace
+
+auto integer_promotion(builtin_type ty) -> builtin_type {
+    auto r = rank(ty);
+    return r >= 0 && r < 3 ? builtin_type::int_t : ty;
+}
+
+bool is_signed(builtin_type ty) {
+    switch (ty) {
+    case builtin_type::char_t:
+    case builtin_type::short_t:
+    case builtin_type::int_t:
+    case builtin_type::long_t:
+    case builtin_type::ptrdiff_t:
+    case builtin_type::intptr_t:
+        return true;
+    default:
+        break;
+    }
+    return false;
+}
+
+auto usual_arithmetic_conversion(builtin_type a, builtin_type b) -> builtin_type {
+    auto fa = float_rank(a);
+    auto fb = float_rank(b);
+    if (fa >= 0 || fb >= 0) {
+        return fa >= fb ? a : b;
+    }
+    if (rank(a) < 0 || rank(b) < 0) {
+        return builtin_type::void_t;
+    }
+    a = integer_promotion(a);
+    b = integer_promotion(b);
+    if (a == b) {
+        return a;
+    }
+    auto ra = rank(a);
+    auto rb = rank(b);
+    if (is_signed(a) == is_signed(b)) {
+        if (ra == rb) {
+            // E.g. long and ptrdiff_t
+            return builtin_type::void_t;
+        }
+        return ra > rb ? a : b;
+    }
+    auto u = is_signed(a) ? b : a;
+    auto s = is_signed(a) ? a : b;
+    if (rank(u) >= rank(s)) {
+        return u;
+    }
+    // The signed type has higher rank and can represent all values of the unsigned type
+    return s;
+}
+
+void expression_type::declare(internal::expr_node const *v, data_type ty) {
+    types_[v] = std::move(ty);
+}
+
+auto expression_type::operator()(internal::expr_node &) -> data_type { return {}; }
+auto expression_type::operator()(internal::variable &v) -> data_type {
+    auto it = types_.find(&v);
+    if (it == types_.end()) {
+        return {};
+    }
+    auto p = get_properties(it->second);
+    return p.is_pointer ? it->second : value_type(p);
+}
+auto expression_type::operator()(internal::int_imm &i) -> data_type {
+    return i.bits() > 32 ? generic_long() : generic_int();
+}
+auto expression_type::operator()(internal::uint_imm &i) -> data_type {
+    return i.bits() > 32 ? generic_ulong() : generic_uint();
+}
+auto expression_type::operator()(internal::float_imm &i) -> data_type {
+    if (i.bits() == 16) {
+        return generic_half();
+    }
+    return i.bits() > 32 ? generic_double() : generic_float();
+}
+auto expression_type::operator()(internal::unary_op &op) -> data_type {
+    switch (op.op()) {
+    case unary_operation::minus:
+    case unary_operation::bitwise_not:
+        return promoted_type(visit(*this, *op.term()));
+    case unary_operation::logical_not:
+        return relational_type(visit(*this, *op.term()));
+    case unary_operation::indirection: {
+        auto p = get_properties(visit(*this, *op.term()));
+        if (p.is_pointer && !p.is_array && p.element) {
+            auto e = get_properties(p.element);
+            return e.is_pointer ? p.element : value_type(e);
+        }
+        return {};
+    }
+    case unary_operation::pre_increment:
+    case unary_operation::pre_decrement:
+    case unary_operation::post_increment:
+    case unary_operation::post_decrement:
+        return visit(*this, *op.term());
+    default:
+        break;
+    }
+    return {};
+}
+auto expression_type::operator()(internal::binary_op &op) -> data_type {
+    switch (op.op()) {
+    case binary_operation::add:
+    case binary_operation::subtract: {
+        auto lt = visit(*this, *op.lhs());
+        auto rt = visit(*this, *op.rhs());
+        auto pl = get_properties(lt);
+        auto pr = get_properties(rt);
+        if (pl.is_pointer && !pl.is_array && pr.components == 1) {
+            return lt;
+        }
+        if (op.op() == binary_operation::add && pr.is_pointer && !pr.is_array &&
+            pl.components == 1) {
+            return rt;
+        }
+        return arithmetic_type(std::move(lt), std::move(rt));
+    }
+    case binary_operation::multiply:
+    case binary_operation::divide:
+    case binary_operation::modulo:
+    case binary_operation::bitwise_and:
+    case binary_operation::bitwise_or:
+    case binary_operation::bitwise_xor:
+        return arithmetic_type(visit(*this, *op.lhs()), visit(*this, *op.rhs()));
+    case binary_operation::left_shift:
+    case binary_operation::right_shift:
+        return promoted_type(visit(*this, *op.lhs()));
+    case binary_operation::greater_than:
+    case binary_operation::less_than:
+    case binary_operation::greater_than_or_equal:
+    case binary_operation::less_than_or_equal:
+    case binary_operation::equal:
+    case binary_operation::not_equal:
+    case binary_operation::logical_and:
+    case binary_operation::logical_or: {
+        auto ty = arithmetic_type(visit(*this, *op.lhs()), visit(*this, *op.rhs()));
+        return relational_type(std::move(ty));
+    }
+    case binary_operation::comma:
+        return visit(*this, *op.rhs());
+    default:
+        break;
+    }
+    // Assignments
+    return visit(*this, *op.lhs());
+}
+auto expression_type::operator()(internal::ternary_op &op) -> data_type {
+    auto t1 = visit(*this, *op.term1());
+    auto t2 = visit(*this, *op.term2());
+    return t1 && t2 && is_equivalent(t1, t2) ? t1 : data_type{};
+}
+auto expression_type::operator()(internal::access &op) -> data_type {
+    auto p = get_properties(visit(*this, *op.field()));
+    if (p.is_pointer) {
+        if (!p.element) {
+            return {};
+        }
+        auto e = get_properties(p.element);
+        return e.is_pointer ? p.element : value_type(e);
+    }
+    return p.components > 1 ? data_type(p.ty) : data_type{};
+}
+auto expression_type::operator()(internal::call_builtin &fn) -> data_type {
+    auto const f = fn.fn();
+    switch (f) {
+    case builtin_function::get_global_size:
+    case builtin_function::get_global_id:
+    case builtin_function::get_local_size:
+    case builtin_function::get_enqueued_local_size:
+    case builtin_function::get_local_id:
+    case builtin_function::get_num_groups:
+    case builtin_function::get_group_id:
+    case builtin_function::get_global_offset:
+    case builtin_function::get_global_linear_id:
+    case builtin_function::get_local_linear_id:
+        return generic_size();
+    case builtin_function::get_work_dim:
+    case builtin_function::get_sub_group_size:
+    case builtin_function::get_max_sub_group_size:
+    case builtin_function::get_num_sub_groups:
+    case builtin_function::get_enqueued_num_sub_groups:
+    case builtin_function::get_sub_group_id:
+    case builtin_function::get_sub_group_local_id:
+        return generic_uint();
+    // Functions returning through a pointer argument or with a non-generic return type
+    case builtin_function::fract:
+    case builtin_function::frexp:
+    case builtin_function::ilogb:
+    case builtin_function::lgamma_r:
+    case builtin_function::modf:
+    case builtin_function::nan:
+    case builtin_function::remquo:
+    case builtin_function::sincos:
+        return {};
+    default:
+        break;
+    }
+
+    auto args = std::vector<data_type>{};
+    args.reserve(fn.args().size());
+    for (auto &a : fn.args()) {
+        args.emplace_back(visit(*this, *a));
+    }
+    if (args.empty() || !args[0]) {
+        return {};
+    }
+    auto const name = std::string_view(to_string(f));
+    if (starts_with(name, "intel_sub_group_shuffle") ||
+        f == builtin_function::sub_group_broadcast) {
+        return args[0];
+    }
+    if (starts_with(name, "intel_convert_")) {
+        auto const ty = starts_with(name, "intel_convert_as_bfloat16") ? builtin_type::float_t
+                                                                        : builtin_type::ushort_t;
+        auto const p = get_properties(args[0]);
+        return p.is_pointer || p.components <= 0 ? data_type{} : make_type(ty, p.components);
+    }
+    if (f >= builtin_function::acos && f <= builtin_function::native_tan) {
+        return is_floating(get_properties(args[0]).ty) ? args[0] : data_type{};
+    }
+    if (f == builtin_function::min || f == builtin_function::max ||
+        f == builtin_function::clamp) {
+        for (auto &a : args) {
+            if (!a || !is_equivalent(a, args[0])) {
+                return {};
+            }
+        }
+        return args[0];
+    }
+    return {};
+}
+auto expression_type::operator()(internal::cast &op) -> data_type {
+    auto p = get_properties(op.target_ty());
+    return p.is_pointer ? op.target_ty() : value_type(p);
+}
+auto expression_type::operator()(internal::swizzle &op) -> data_type {
+    auto p = get_properties(visit(*this, *op.term()));
+    if (p.is_pointer || p.components <= 1) {
+        return {};
+    }
+    auto n = op.selector() == internal::swizzle_selector::index
+                 ? static_cast<short>(op.indices().size())
+                 : static_cast<short>((p.components + 1) / 2);
+    return make_type(p.ty, n);
+}
+
+} // namespace clir
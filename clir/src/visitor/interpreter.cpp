@@ -0,0 +1,1211 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "clir/visitor/interpreter.hpp"
+#include "interpreter_executor.hpp"
+#include "type_properties.hpp"
+#include "clir/internal/attr_node.hpp"
+#include "clir/internal/program_node.hpp"
+#include "clir/visit.hpp"
+#include "clir/visitor/expression_type.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace clir {
+
+namespace interp {
+
+namespace {
+
+class function_finder {
+  public:
+    function_finder(std::string_view name) : name_(name) {}
+
+    void operator()(internal::prototype &) {}
+    void operator()(internal::function &fn) {
+        if (auto proto = dynamic_cast<internal::prototype *>(fn.prototype().get());
+            proto && proto->name() == name_) {
+            found_ = &fn;
+            proto_ = proto;
+        }
+    }
+    void operator()(internal::global_declaration &) {}
+
+    inline auto found() const { return found_; }
+    inline auto proto() const { return proto_; }
+
+  private:
+    std::string_view name_;
+    internal::function *found_ = nullptr;
+    internal::prototype *proto_ = nullptr;
+};
+
+class global_finder {
+  public:
+    void operator()(internal::prototype &) {}
+    void operator()(internal::function &) {}
+    void operator()(internal::global_declaration &d) { found_.emplace_back(&d); }
+
+    inline auto found() const -> std::vector<internal::global_declaration *> const & {
+        return found_;
+    }
+
+  private:
+    std::vector<internal::global_declaration *> found_;
+};
+
+auto swizzle_indices(internal::swizzle &s, short n) -> std::vector<short> {
+    if (s.selector() == internal::swizzle_selector::index) {
+        return s.indices();
+    }
+    // 3-component vectors behave like 4-component vectors
+    short const half = (n + 1) / 2;
+    auto idx = std::vector<short>(half);
+    for (short i = 0; i < half; ++i) {
+        switch (s.selector()) {
+        case internal::swizzle_selector::lo:
+            idx[i] = i;
+            break;
+        case internal::swizzle_selector::hi:
+            idx[i] = half + i;
+            break;
+        case internal::swizzle_selector::even:
+            idx[i] = 2 * i;
+            break;
+        case internal::swizzle_selector::odd:
+            idx[i] = 2 * i + 1;
+            break;
+        default:
+            break;
+        }
+    }
+    return idx;
+}
+
+bool is_comparison(binary_operation op) {
+    switch (op) {
+    case binary_operation::greater_than:
+    case binary_operation::less_than:
+    case binary_operation::greater_than_or_equal:
+    case binary_operation::less_than_or_equal:
+    case binary_operation::equal:
+    case binary_operation::not_equal:
+        return true;
+    default:
+        break;
+    }
+    return false;
+}
+
+auto compound_operation(binary_operation op) -> binary_operation {
+    switch (op) {
+    case binary_operation::add_into:
+        return binary_operation::add;
+    case binary_operation::subtract_from:
+        return binary_operation::subtract;
+    case binary_operation::multiply_into:
+        return binary_operation::multiply;
+    case binary_operation::divide_into:
+        return binary_operation::divide;
+    case binary_operation::modulus_into:
+        return binary_operation::modulo;
+    case binary_operation::left_shift_by:
+        return binary_operation::left_shift;
+    case binary_operation::right_shift_by:
+        return binary_operation::right_shift;
+    case binary_operation::and_into:
+        return binary_operation::bitwise_and;
+    case binary_operation::or_into:
+        return binary_operation::bitwise_or;
+    case binary_operation::xor_into:
+        return binary_operation::bitwise_xor;
+    default:
+        break;
+    }
+    return binary_operation::assignment;
+}
+
+auto promote(value_type const &t) -> value_type {
+    if (t.n == 1 && is_integer(t.ty)) {
+        return value_type{integer_promotion(t.ty), 1};
+    }
+    return t;
+}
+
+auto index_of(value const &idx, std::size_t lane) -> std::int64_t {
+    return is_signed(idx.t.ty) ? idx.at(lane, 0).i : static_cast<std::int64_t>(idx.at(lane, 0).u);
+}
+
+} // namespace
+
+class executor::mask_guard {
+  public:
+    mask_guard(executor &ex, mask_t mask) : ex_(ex), saved_(std::move(ex.mask_)) {
+        ex_.mask_ = std::move(mask);
+    }
+    ~mask_guard() {
+        ex_.mask_ = std::move(saved_);
+        // Work-items that returned stay inactive until the call ends
+        for (std::size_t l = 0; l < ex_.returned_.size(); ++l) {
+            if (ex_.returned_[l]) {
+                ex_.mask_[l] = 0;
+            }
+        }
+    }
+    mask_guard(mask_guard const &) = delete;
+    mask_guard &operator=(mask_guard const &) = delete;
+
+  private:
+    executor &ex_;
+    mask_t saved_;
+};
+
+class executor::lvalue_visitor {
+  public:
+    lvalue_visitor(executor &ex) : ex_(ex) {}
+
+    auto operator()(internal::expr_node &) -> lvalue {
+        throw std::runtime_error("interpreter: expression is not an lvalue");
+    }
+    auto operator()(internal::variable &v) -> lvalue {
+        auto &s = ex_.variable_storage(v);
+        auto lv = lvalue{s.ty, std::vector<std::uintptr_t>(ex_.lanes_)};
+        for (std::size_t l = 0; l < ex_.lanes_; ++l) {
+            lv.addr[l] = s.address(l);
+        }
+        return lv;
+    }
+    auto operator()(internal::unary_op &e) -> lvalue {
+        if (e.op() != unary_operation::indirection) {
+            return (*this)(static_cast<internal::expr_node &>(e));
+        }
+        auto p = ex_.eval(e.term());
+        if (!p.t.is_pointer()) {
+            throw std::runtime_error("interpreter: indirection requires a pointer operand");
+        }
+        auto lv = lvalue{p.t.pointee, std::vector<std::uintptr_t>(ex_.lanes_)};
+        for (std::size_t l = 0; l < ex_.lanes_; ++l) {
+            lv.addr[l] = p.at(l, 0).u;
+        }
+        return lv;
+    }
+    auto operator()(internal::access &e) -> lvalue {
+        auto f = ex_.eval(e.field());
+        auto idx = ex_.eval(e.address());
+        if (idx.t.n != 1 || !is_integer(idx.t.ty)) {
+            throw std::runtime_error("interpreter: array subscript is not an integer");
+        }
+        auto lv = lvalue{{}, std::vector<std::uintptr_t>(ex_.lanes_)};
+        if (f.t.is_pointer()) {
+            lv.ty = f.t.pointee;
+            auto const size = size_in_bytes(f.t.pointee);
+            for (std::size_t l = 0; l < ex_.lanes_; ++l) {
+                if (ex_.mask_[l]) {
+                    lv.addr[l] = f.at(l, 0).u + static_cast<std::uint64_t>(index_of(idx, l)) * size;
+                }
+            }
+            return lv;
+        }
+        // Subscript of a vector
+        auto base = visit(*this, *e.field());
+        auto vt = ex_.lvalue_type(base);
+        lv.ty = data_type(vt.ty);
+        auto const size = size_of(vt.ty);
+        for (std::size_t l = 0; l < ex_.lanes_; ++l) {
+            if (ex_.mask_[l]) {
+                auto c = index_of(idx, l);
+                if (c < 0 || c >= vt.width()) {
+                    throw std::runtime_error("interpreter: vector subscript out of range");
+                }
+                auto comp = base.comp.empty() ? c : base.comp[c];
+                lv.addr[l] = base.addr[l] + comp * size;
+            }
+        }
+        return lv;
+    }
+    auto operator()(internal::swizzle &s) -> lvalue {
+        auto base = visit(*this, *s.term());
+        auto idx = swizzle_indices(s, ex_.lvalue_type(base).n);
+        if (!base.comp.empty()) {
+            for (auto &i : idx) {
+                i = base.comp[i];
+            }
+        }
+        base.comp = std::move(idx);
+        return base;
+    }
+
+  private:
+    executor &ex_;
+};
+
+executor::executor(std::vector<func> &decls, std::vector<std::vector<std::uint8_t>> const &args)
+    : decls_(decls), args_(args) {}
+
+void executor::run(std::string_view kernel, std::array<std::size_t, 3> global_size,
+                   std::array<std::size_t, 3> local_size) {
+    name_ = std::string(kernel);
+    auto finder = function_finder(kernel);
+    auto globals = global_finder{};
+    for (auto &d : decls_) {
+        visit(finder, *d);
+        visit(globals, *d);
+    }
+    if (!finder.found()) {
+        throw std::runtime_error("interpreter: kernel " + name_ + " not found");
+    }
+    auto &proto = *finder.proto();
+
+    sgs_ = 1;
+    for (auto &a : proto.attributes()) {
+        if (auto sg = dynamic_cast<internal::attribute<internal::intel_reqd_sub_group_size> *>(
+                a.get());
+            sg) {
+            sgs_ = static_cast<std::size_t>(sg->args().arg());
+        } else if (auto wg =
+                       dynamic_cast<internal::attribute<internal::reqd_work_group_size> *>(a.get());
+                   wg) {
+            auto args = wg->args();
+            auto const same = [](int r, std::size_t s) { return static_cast<std::size_t>(r) == s; };
+            if (!std::equal(args.cbegin(), args.cend(), local_size.begin(), same)) {
+                throw std::runtime_error("interpreter: local size of " + name_ +
+                                         " does not match reqd_work_group_size");
+            }
+        }
+    }
+
+    auto &params = proto.args();
+    for (std::size_t i = 0; i < params.size(); ++i) {
+        auto const size = size_in_bytes(params[i].first);
+        if (i >= args_.size() || args_[i].empty()) {
+            throw std::runtime_error("interpreter: argument " + std::to_string(i) + " of " +
+                                     name_ + " is not set");
+        }
+        if (args_[i].size() != size) {
+            throw std::runtime_error("interpreter: argument " + std::to_string(i) + " of " +
+                                     name_ + " has size " + std::to_string(args_[i].size()) +
+                                     " but the parameter has size " + std::to_string(size));
+        }
+    }
+
+    std::size_t max_lanes = 1;
+    for (int d = 0; d < 3; ++d) {
+        if (local_size[d] == 0) {
+            throw std::runtime_error("interpreter: local size must not be zero");
+        }
+        num_groups_[d] = (global_size[d] + local_size[d] - 1) / local_size[d];
+        max_lanes *= local_size[d];
+    }
+    global_size_ = global_size;
+    enqueued_local_size_ = local_size;
+    vars_.clear();
+    locals_.clear();
+    max_lanes_ = max_lanes;
+    local_id_.reserve(max_lanes);
+
+    bool globals_initialized = false;
+    for (std::size_t gz = 0; gz < num_groups_[2]; ++gz) {
+        for (std::size_t gy = 0; gy < num_groups_[1]; ++gy) {
+            for (std::size_t gx = 0; gx < num_groups_[0]; ++gx) {
+                group_id_ = {gx, gy, gz};
+                lanes_ = 1;
+                for (int d = 0; d < 3; ++d) {
+                    local_size_[d] =
+                        std::min(local_size[d], global_size[d] - group_id_[d] * local_size[d]);
+                    lanes_ *= local_size_[d];
+                }
+                local_id_.resize(lanes_);
+                for (std::size_t z = 0; z < local_size_[2]; ++z) {
+                    for (std::size_t y = 0; y < local_size_[1]; ++y) {
+                        for (std::size_t x = 0; x < local_size_[0]; ++x) {
+                            local_id_[x + local_size_[0] * (y + local_size_[1] * z)] = {x, y, z};
+                        }
+                    }
+                }
+                for (auto &[v, s] : vars_) {
+                    if (!s.initialized_once) {
+                        std::fill(s.mem.begin(), s.mem.end(), ~std::uint64_t(0));
+                    }
+                }
+                ++epoch_;
+                mask_ = mask_t(lanes_, 1);
+
+                if (!globals_initialized) {
+                    program_scope_ = true;
+                    for (auto &g : globals.found()) {
+                        visit(*this, *g->term());
+                    }
+                    program_scope_ = false;
+                    globals_initialized = true;
+                }
+                for (std::size_t i = 0; i < params.size(); ++i) {
+                    auto &s = allocate(params[i].second.get(), params[i].first);
+                    for (std::size_t l = 0; l < lanes_; ++l) {
+                        std::memcpy(reinterpret_cast<void *>(s.address(l)), args_[i].data(),
+                                    args_[i].size());
+                    }
+                }
+                visit(*this, *finder.found()->body());
+            }
+        }
+    }
+}
+
+/* Expr nodes */
+auto executor::operator()(internal::expr_node &) -> value { unsupported("expression"); }
+auto executor::operator()(internal::variable &v) -> value {
+    return load(lvalue_visitor{*this}(v));
+}
+auto executor::operator()(internal::int_imm &i) -> value {
+    auto ty = i.bits() > 32 ? builtin_type::long_t : builtin_type::int_t;
+    return uniform(value_type{ty, 1}, canonical(static_cast<std::uint64_t>(i.value()), ty));
+}
+auto executor::operator()(internal::uint_imm &i) -> value {
+    auto ty = i.bits() > 32 ? builtin_type::ulong_t : builtin_type::uint_t;
+    return uniform(value_type{ty, 1}, canonical(i.value(), ty));
+}
+auto executor::operator()(internal::float_imm &i) -> value {
+    auto ty = builtin_type::double_t;
+    if (i.bits() == 16) {
+        ty = builtin_type::half_t;
+    } else if (i.bits() <= 32) {
+        ty = builtin_type::float_t;
+    }
+    return uniform(value_type{ty, 1}, from_double(i.value(), ty));
+}
+auto executor::operator()(internal::cl_mem_fence_flags_imm &i) -> value {
+    std::uint64_t flag = 0;
+    switch (i.value()) {
+    case cl_mem_fence_flags::CLK_LOCAL_MEM_FENCE:
+        flag = 1;
+        break;
+    case cl_mem_fence_flags::CLK_GLOBAL_MEM_FENCE:
+        flag = 2;
+        break;
+    case cl_mem_fence_flags::CLK_IMAGE_MEM_FENCE:
+        flag = 4;
+        break;
+    }
+    return uniform(value_type{builtin_type::uint_t, 1}, canonical(flag, builtin_type::uint_t));
+}
+auto executor::operator()(internal::memory_scope_imm &i) -> value {
+    return uniform(value_type{builtin_type::int_t, 1},
+                   canonical(static_cast<std::uint64_t>(i.value()), builtin_type::int_t));
+}
+auto executor::operator()(internal::memory_order_imm &i) -> value {
+    return uniform(value_type{builtin_type::int_t, 1},
+                   canonical(static_cast<std::uint64_t>(i.value()), builtin_type::int_t));
+}
+auto executor::operator()(internal::unary_op &e) -> value {
+    switch (e.op()) {
+    case unary_operation::minus:
+    case unary_operation::bitwise_not: {
+        auto x = eval(e.term());
+        if (x.t.is_pointer() || x.t.is_void()) {
+            throw std::runtime_error("interpreter: invalid operand to unary " +
+                                     std::string(to_string(e.op())));
+        }
+        auto t = promote(x.t);
+        x = convert_value(x, t);
+        auto zero = canonical(0, t.ty);
+        for (std::size_t l = 0; l < lanes_; ++l) {
+            if (mask_[l]) {
+                for (short c = 0; c < t.width(); ++c) {
+                    auto &s = x.at(l, c);
+                    if (e.op() == unary_operation::minus) {
+                        if (is_floating(t.ty)) {
+                            s.f = -s.f;
+                        } else {
+                            s = arithmetic(binary_operation::subtract, zero, s, t.ty);
+                        }
+                    } else {
+                        if (is_floating(t.ty)) {
+                            throw std::runtime_error("interpreter: invalid operand to unary ~");
+                        }
+                        s = canonical(~s.u, t.ty);
+                    }
+                }
+            }
+        }
+        return x;
+    }
+    case unary_operation::logical_not: {
+        auto x = eval(e.term());
+        auto rt = relational_type(x.t);
+        auto r = make_value(rt, lanes_);
+        auto const ty = x.t.is_pointer() ? builtin_type::ulong_t : x.t.ty;
+        auto const true_bits = x.t.n > 1 ? ~std::uint64_t(0) : 1;
+        for (std::size_t l = 0; l < lanes_; ++l) {
+            if (mask_[l]) {
+                for (short c = 0; c < rt.width(); ++c) {
+                    r.at(l, c) = canonical(is_true(x.at(l, c), ty) ? 0 : true_bits, rt.ty);
+                }
+            }
+        }
+        return r;
+    }
+    case unary_operation::indirection:
+        return load(lvalue_of(e));
+    case unary_operation::address: {
+        auto lv = lvalue_of(*e.term());
+        auto t = lvalue_type(lv);
+        auto pointee = lv.ty;
+        std::uint64_t offset = 0;
+        if (!lv.comp.empty()) {
+            pointee = data_type(t.ty);
+            offset = lv.comp[0] * size_of(t.ty);
+        }
+        auto r = make_value(value_type{builtin_type::void_t, 0, pointee}, lanes_);
+        for (std::size_t l = 0; l < lanes_; ++l) {
+            r.at(l, 0).u = lv.addr[l] + offset;
+        }
+        return r;
+    }
+    case unary_operation::pre_increment:
+    case unary_operation::pre_decrement:
+    case unary_operation::post_increment:
+    case unary_operation::post_decrement: {
+        auto lv = lvalue_of(*e.term());
+        auto old = load(lv);
+        auto one = uniform(value_type{builtin_type::int_t, 1}, canonical(1, builtin_type::int_t));
+        bool inc = e.op() == unary_operation::pre_increment ||
+                   e.op() == unary_operation::post_increment;
+        auto updated = convert_value(
+            binary(inc ? binary_operation::add : binary_operation::subtract, old, one), old.t);
+        store(lv, updated);
+        bool pre = e.op() == unary_operation::pre_increment ||
+                   e.op() == unary_operation::pre_decrement;
+        return pre ? updated : old;
+    }
+    }
+    unsupported("unary operation");
+}
+auto executor::operator()(internal::binary_op &e) -> value {
+    auto const op = e.op();
+    switch (op) {
+    case binary_operation::assignment: {
+        auto x = eval(e.rhs());
+        auto lv = lvalue_of(*e.lhs());
+        auto y = convert_value(x, lvalue_type(lv));
+        store(lv, y);
+        return y;
+    }
+    case binary_operation::add_into:
+    case binary_operation::subtract_from:
+    case binary_operation::multiply_into:
+    case binary_operation::divide_into:
+    case binary_operation::modulus_into:
+    case binary_operation::left_shift_by:
+    case binary_operation::right_shift_by:
+    case binary_operation::and_into:
+    case binary_operation::or_into:
+    case binary_operation::xor_into: {
+        auto x = eval(e.rhs());
+        auto lv = lvalue_of(*e.lhs());
+        auto old = load(lv);
+        auto y = convert_value(binary(compound_operation(op), old, x), old.t);
+        store(lv, y);
+        return y;
+    }
+    case binary_operation::comma:
+        eval(e.lhs());
+        return eval(e.rhs());
+    case binary_operation::logical_and:
+    case binary_operation::logical_or: {
+        bool const is_and = op == binary_operation::logical_and;
+        auto a = eval(e.lhs());
+        if (a.t.n > 1) {
+            // No short-circuit evaluation for vectors
+            auto b = eval(e.rhs());
+            auto ct = common_type(a.t, b.t);
+            auto rt = relational_type(ct);
+            auto x = convert_value(a, ct);
+            auto y = convert_value(b, ct);
+            auto r = make_value(rt, lanes_);
+            for (std::size_t l = 0; l < lanes_; ++l) {
+                if (mask_[l]) {
+                    for (short c = 0; c < rt.n; ++c) {
+                        bool tx = is_true(x.at(l, c), ct.ty);
+                        bool ty = is_true(y.at(l, c), ct.ty);
+                        bool t = is_and ? tx && ty : tx || ty;
+                        r.at(l, c) = canonical(t ? ~std::uint64_t(0) : 0, rt.ty);
+                    }
+                }
+            }
+            return r;
+        }
+        auto const aty = a.t.is_pointer() ? builtin_type::ulong_t : a.t.ty;
+        auto rhs_mask = mask_t(lanes_, 0);
+        for (std::size_t l = 0; l < lanes_; ++l) {
+            if (mask_[l]) {
+                rhs_mask[l] = is_true(a.at(l, 0), aty) == is_and;
+            }
+        }
+        value b;
+        {
+            auto guard = mask_guard(*this, rhs_mask);
+            b = eval(e.rhs());
+        }
+        auto const bty = b.t.is_pointer() ? builtin_type::ulong_t : b.t.ty;
+        auto r = make_value(value_type{builtin_type::int_t, 1}, lanes_);
+        for (std::size_t l = 0; l < lanes_; ++l) {
+            if (mask_[l]) {
+                bool t = rhs_mask[l] ? is_true(b.at(l, 0), bty) : !is_and;
+                r.at(l, 0).u = t ? 1 : 0;
+            }
+        }
+        return r;
+    }
+    default:
+        break;
+    }
+    auto a = eval(e.lhs());
+    auto b = eval(e.rhs());
+    return binary(op, a, b);
+}
+auto executor::operator()(internal::ternary_op &e) -> value {
+    auto c = eval(e.term0());
+    if (c.t.n > 1) {
+        // Component-wise selection based on the most significant bit
+        auto x = eval(e.term1());
+        auto y = eval(e.term2());
+        auto ct = common_type(x.t, y.t);
+        x = convert_value(x, ct);
+        y = convert_value(y, ct);
+        auto r = make_value(ct, lanes_);
+        for (std::size_t l = 0; l < lanes_; ++l) {
+            if (mask_[l]) {
+                for (short i = 0; i < ct.width(); ++i) {
+                    r.at(l, i) = c.at(l, i).i < 0 ? x.at(l, i) : y.at(l, i);
+                }
+            }
+        }
+        return r;
+    }
+    auto const cty = c.t.is_pointer() ? builtin_type::ulong_t : c.t.ty;
+    auto m1 = mask_t(lanes_, 0);
+    auto m2 = mask_t(lanes_, 0);
+    for (std::size_t l = 0; l < lanes_; ++l) {
+        if (mask_[l]) {
+            bool t = is_true(c.at(l, 0), cty);
+            m1[l] = t;
+            m2[l] = !t;
+        }
+    }
+    value x, y;
+    {
+        auto guard = mask_guard(*this, std::move(m1));
+        x = eval(e.term1());
+    }
+    {
+        auto guard = mask_guard(*this, std::move(m2));
+        y = eval(e.term2());
+    }
+    value_type ct;
+    if (x.t.is_pointer() || y.t.is_pointer()) {
+        ct = x.t.is_pointer() ? x.t : y.t;
+    } else if (x.t.is_void() && y.t.is_void()) {
+        return value{};
+    } else {
+        ct = common_type(x.t, y.t);
+    }
+    x = convert_value(x, ct);
+    y = convert_value(y, ct);
+    auto r = make_value(ct, lanes_);
+    for (std::size_t l = 0; l < lanes_; ++l) {
+        if (mask_[l]) {
+            auto &src = is_true(c.at(l, 0), cty) ? x : y;
+            for (short i = 0; i < ct.width(); ++i) {
+                r.at(l, i) = src.at(l, i);
+            }
+        }
+    }
+    return r;
+}
+auto executor::operator()(internal::access &e) -> value { return load(lvalue_of(e)); }
+auto executor::operator()(internal::call &fn) -> value {
+    auto finder = function_finder(fn.name());
+    for (auto &d : decls_) {
+        visit(finder, *d);
+    }
+    if (!finder.found()) {
+        throw std::runtime_error("interpreter: call of unknown function " + std::string(fn.name()));
+    }
+    auto &params = finder.proto()->args();
+    if (params.size() != fn.args().size()) {
+        throw std::runtime_error("interpreter: wrong number of arguments in call of " +
+                                 std::string(fn.name()));
+    }
+    auto args = std::vector<value>{};
+    args.reserve(params.size());
+    for (auto &a : fn.args()) {
+        args.emplace_back(eval(a));
+    }
+    for (std::size_t i = 0; i < params.size(); ++i) {
+        allocate(params[i].second.get(), params[i].first);
+        auto lv = visit(lvalue_visitor{*this}, *params[i].second);
+        store(lv, convert_value(args[i], lvalue_type(lv)));
+    }
+    auto const rt = to_value_type(finder.proto()->return_type());
+    auto result = value{};
+    {
+        auto guard = mask_guard(*this, mask_);
+        auto caller_returned = std::exchange(returned_, mask_t(lanes_, 0));
+        auto caller_value = std::exchange(return_value_, make_value(rt, lanes_));
+        visit(*this, *finder.found()->body());
+        returned_ = std::move(caller_returned);
+        result = std::exchange(return_value_, std::move(caller_value));
+    }
+    return result;
+}
+auto executor::operator()(internal::cast &c) -> value {
+    auto t = to_value_type(c.target_ty());
+    if (t.n > 1) {
+        if (auto list = dynamic_cast<internal::binary_op *>(c.term().get());
+            list && list->op() == binary_operation::comma) {
+            return vector_literal(t, *list);
+        }
+    }
+    return convert_value(eval(c.term()), t);
+}
+auto executor::operator()(internal::swizzle &s) -> value {
+    auto x = eval(s.term());
+    if (x.t.is_pointer() || x.t.is_void()) {
+        throw std::runtime_error("interpreter: swizzle requires a vector operand");
+    }
+    auto idx = swizzle_indices(s, x.t.n);
+    auto rt = value_type{x.t.ty, static_cast<short>(idx.size())};
+    auto r = make_value(rt, lanes_);
+    for (std::size_t l = 0; l < lanes_; ++l) {
+        if (mask_[l]) {
+            for (short j = 0; j < rt.n; ++j) {
+                if (idx[j] < x.t.width()) {
+                    r.at(l, j) = x.at(l, idx[j]);
+                }
+            }
+        }
+    }
+    return r;
+}
+
+/* Stmt nodes */
+void executor::operator()(internal::declaration &d) {
+    allocate(d.variable().get(), d.ty());
+}
+void executor::operator()(internal::declaration_assignment &d) {
+    (*this)(d.decl());
+    auto lv = visit(lvalue_visitor{*this}, *d.decl().variable());
+    if (get_properties(lv.ty).is_array) {
+        unsupported("array initializer");
+    }
+    store(lv, convert_value(eval(d.rhs()), lvalue_type(lv)));
+}
+void executor::operator()(internal::expression_statement &e) { eval(e.term()); }
+void executor::operator()(internal::return_statement &e) {
+    if (returned_.empty()) {
+        throw std::runtime_error("interpreter: return statement in kernel");
+    }
+    auto const &t = return_value_.t;
+    if (t.is_void()) {
+        throw std::runtime_error("interpreter: return of a value from a void function");
+    }
+    auto x = convert_value(eval(e.term()), t);
+    for (std::size_t l = 0; l < lanes_; ++l) {
+        if (mask_[l]) {
+            for (short c = 0; c < t.width(); ++c) {
+                return_value_.at(l, c) = x.at(l, c);
+            }
+            returned_[l] = 1;
+            mask_[l] = 0;
+        }
+    }
+}
+void executor::operator()(internal::block &b) {
+    for (auto &s : b.stmts()) {
+        visit(*this, *s);
+    }
+}
+void executor::operator()(internal::for_loop &loop) {
+    if (loop.start()) {
+        visit(*this, *loop.start());
+    }
+    auto guard = mask_guard(*this, mask_);
+    for (;;) {
+        if (loop.condition()) {
+            auto c = eval(loop.condition());
+            auto const ty = c.t.is_pointer() ? builtin_type::ulong_t : c.t.ty;
+            for (std::size_t l = 0; l < lanes_; ++l) {
+                if (mask_[l] && !is_true(c.at(l, 0), ty)) {
+                    mask_[l] = 0;
+                }
+            }
+        }
+        if (!any_active()) {
+            break;
+        }
+        visit(*this, *loop.body());
+        if (loop.step()) {
+            eval(loop.step());
+        }
+    }
+}
+void executor::operator()(internal::if_selection &is) {
+    auto c = eval(is.condition());
+    auto const ty = c.t.is_pointer() ? builtin_type::ulong_t : c.t.ty;
+    auto then_mask = mask_t(lanes_, 0);
+    auto else_mask = mask_t(lanes_, 0);
+    bool any_then = false, any_else = false;
+    for (std::size_t l = 0; l < lanes_; ++l) {
+        if (mask_[l]) {
+            bool t = is_true(c.at(l, 0), ty);
+            then_mask[l] = t;
+            else_mask[l] = !t;
+            any_then = any_then || t;
+            any_else = any_else || !t;
+        }
+    }
+    if (any_then) {
+        auto guard = mask_guard(*this, std::move(then_mask));
+        visit(*this, *is.then());
+    }
+    if (is.otherwise() && any_else) {
+        auto guard = mask_guard(*this, std::move(else_mask));
+        visit(*this, **is.otherwise());
+    }
+}
+void executor::operator()(internal::while_loop &loop) {
+    auto guard = mask_guard(*this, mask_);
+    bool first = true;
+    for (;;) {
+        if (!first || !loop.is_do_while()) {
+            auto c = eval(loop.condition());
+            auto const ty = c.t.is_pointer() ? builtin_type::ulong_t : c.t.ty;
+            for (std::size_t l = 0; l < lanes_; ++l) {
+                if (mask_[l] && !is_true(c.at(l, 0), ty)) {
+                    mask_[l] = 0;
+                }
+            }
+        }
+        first = false;
+        if (!any_active()) {
+            break;
+        }
+        visit(*this, *loop.body());
+    }
+}
+
+/* Expressions */
+auto executor::eval(expr &e) -> value { return visit(*this, *e); }
+
+auto executor::lvalue_of(internal::expr_node &e) -> lvalue {
+    return visit(lvalue_visitor{*this}, e);
+}
+
+auto executor::lvalue_type(lvalue const &lv) -> value_type {
+    auto t = to_value_type(lv.ty);
+    if (!lv.comp.empty()) {
+        if (t.is_pointer() || t.is_void()) {
+            throw std::runtime_error("interpreter: swizzle requires a vector operand");
+        }
+        t.n = static_cast<short>(lv.comp.size());
+    }
+    return t;
+}
+
+auto executor::load(lvalue const &lv) -> value {
+    auto t = lvalue_type(lv);
+    auto r = make_value(t, lanes_);
+    if (get_properties(lv.ty).is_array) {
+        // Arrays decay to a pointer to their first element
+        for (std::size_t l = 0; l < lanes_; ++l) {
+            r.at(l, 0).u = lv.addr[l];
+        }
+        return r;
+    }
+    if (t.is_void()) {
+        throw std::runtime_error("interpreter: cannot load void");
+    }
+    auto const ty = t.is_pointer() ? builtin_type::ulong_t : t.ty;
+    auto const size = size_of(ty);
+    for (std::size_t l = 0; l < lanes_; ++l) {
+        if (mask_[l]) {
+            for (short c = 0; c < t.width(); ++c) {
+                auto off = lv.comp.empty() ? c : lv.comp[c];
+                r.at(l, c) = load_scalar(lv.addr[l] + off * size, ty, l);
+            }
+        }
+    }
+    return r;
+}
+
+void executor::store(lvalue const &lv, value const &x) {
+    if (get_properties(lv.ty).is_array) {
+        throw std::runtime_error("interpreter: cannot assign to an array");
+    }
+    auto t = lvalue_type(lv);
+    auto const ty = t.is_pointer() ? builtin_type::ulong_t : t.ty;
+    auto const size = size_of(ty);
+    for (std::size_t l = 0; l < lanes_; ++l) {
+        if (mask_[l]) {
+            for (short c = 0; c < t.width(); ++c) {
+                auto off = lv.comp.empty() ? c : lv.comp[c];
+                store_scalar(lv.addr[l] + off * size, ty, x.at(l, c), l);
+            }
+        }
+    }
+}
+
+auto executor::convert_value(value const &x, value_type const &t) -> value {
+    if (t.is_void()) {
+        return value{};
+    }
+    if (x.t.is_void()) {
+        throw std::runtime_error("interpreter: void value is not ignored");
+    }
+    auto r = make_value(t, lanes_);
+    if (t.is_pointer()) {
+        if (!x.t.is_pointer() && !(x.t.n == 1 && is_integer(x.t.ty))) {
+            throw std::runtime_error("interpreter: invalid conversion to pointer");
+        }
+        for (std::size_t l = 0; l < lanes_; ++l) {
+            r.at(l, 0).u = x.at(l, 0).u;
+        }
+        return r;
+    }
+    if (x.t.is_pointer()) {
+        if (t.n != 1 || !is_integer(t.ty)) {
+            throw std::runtime_error("interpreter: invalid conversion of pointer");
+        }
+        for (std::size_t l = 0; l < lanes_; ++l) {
+            r.at(l, 0) = canonical(x.at(l, 0).u, t.ty);
+        }
+        return r;
+    }
+    if (x.t.ty == t.ty && x.t.n == t.n) {
+        return x;
+    }
+    if (x.t.n != 1 && x.t.n != t.n) {
+        throw std::runtime_error("interpreter: invalid conversion between vectors of length " +
+                                 std::to_string(x.t.n) + " and " + std::to_string(t.n));
+    }
+    for (std::size_t l = 0; l < lanes_; ++l) {
+        if (mask_[l]) {
+            for (short c = 0; c < t.width(); ++c) {
+                r.at(l, c) = convert(x.at(l, x.t.n == 1 ? 0 : c), x.t.ty, t.ty);
+            }
+        }
+    }
+    return r;
+}
+
+auto executor::common_type(value_type const &a, value_type const &b) -> value_type {
+    if (a.is_pointer() || b.is_pointer() || a.is_void() || b.is_void()) {
+        throw std::runtime_error("interpreter: invalid operands of arithmetic type");
+    }
+    if (a.n > 1 && b.n > 1) {
+        if (a.n != b.n || a.ty != b.ty) {
+            throw std::runtime_error("interpreter: mismatched vector operands");
+        }
+        return a;
+    }
+    if (a.n > 1 || b.n > 1) {
+        // The scalar is converted to the element type of the vector
+        return a.n > 1 ? a : b;
+    }
+    auto ty = usual_arithmetic_conversion(a.ty, b.ty);
+    if (ty == builtin_type::void_t) {
+        throw std::runtime_error("interpreter: invalid operands of arithmetic type");
+    }
+    return value_type{ty, 1};
+}
+
+auto executor::binary(binary_operation op, value const &a, value const &b) -> value {
+    if (a.t.is_pointer() || b.t.is_pointer()) {
+        return pointer_binary(op, a, b);
+    }
+    bool const shift = op == binary_operation::left_shift || op == binary_operation::right_shift;
+    auto ct = shift ? promote(a.t) : common_type(a.t, b.t);
+    if (shift && (b.t.is_void() || (b.t.n > 1 && b.t.n != ct.n))) {
+        throw std::runtime_error("interpreter: invalid shift count");
+    }
+    auto x = convert_value(a, ct);
+    auto y = convert_value(b, shift ? value_type{ct.ty, b.t.n} : ct);
+    bool const rel = is_comparison(op);
+    auto rt = rel ? relational_type(ct) : ct;
+    auto const true_bits = ct.n > 1 ? ~std::uint64_t(0) : 1;
+    auto r = make_value(rt, lanes_);
+    for (std::size_t l = 0; l < lanes_; ++l) {
+        if (mask_[l]) {
+            for (short c = 0; c < ct.width(); ++c) {
+                auto ys = y.at(l, y.t.n == 1 ? 0 : c);
+                if (rel) {
+                    r.at(l, c) = canonical(compare(op, x.at(l, c), ys, ct.ty) ? true_bits : 0,
+                                           rt.ty);
+                } else {
+                    r.at(l, c) = arithmetic(op, x.at(l, c), ys, ct.ty);
+                }
+            }
+        }
+    }
+    return r;
+}
+
+auto executor::pointer_binary(binary_operation op, value const &a, value const &b) -> value {
+    auto const offset_of = [](value const &x, std::size_t l) {
+        return is_signed(x.t.ty) ? x.at(l, 0).i : static_cast<std::int64_t>(x.at(l, 0).u);
+    };
+    auto const element_size = [](value const &p) -> std::int64_t {
+        auto size = size_in_bytes(p.t.pointee);
+        return size > 0 ? static_cast<std::int64_t>(size) : 1;
+    };
+    bool const a_int = a.t.n == 1 && is_integer(a.t.ty);
+    bool const b_int = b.t.n == 1 && is_integer(b.t.ty);
+    if (op == binary_operation::add || op == binary_operation::subtract) {
+        if (a.t.is_pointer() && b_int) {
+            auto r = make_value(a.t, lanes_);
+            auto const size = element_size(a);
+            for (std::size_t l = 0; l < lanes_; ++l) {
+                if (mask_[l]) {
+                    auto off = offset_of(b, l) * size;
+                    r.at(l, 0).u = a.at(l, 0).u + static_cast<std::uint64_t>(
+                                                      op == binary_operation::add ? off : -off);
+                }
+            }
+            return r;
+        }
+        if (op == binary_operation::add && b.t.is_pointer() && a_int) {
+            return pointer_binary(op, b, a);
+        }
+        if (op == binary_operation::subtract && a.t.is_pointer() && b.t.is_pointer()) {
+            auto r = make_value(value_type{builtin_type::long_t, 1}, lanes_);
+            auto const size = element_size(a);
+            for (std::size_t l = 0; l < lanes_; ++l) {
+                if (mask_[l]) {
+                    r.at(l, 0).i = static_cast<std::int64_t>(a.at(l, 0).u - b.at(l, 0).u) / size;
+                }
+            }
+            return r;
+        }
+    } else if (is_comparison(op) && (a.t.is_pointer() || a_int) && (b.t.is_pointer() || b_int)) {
+        auto r = make_value(value_type{builtin_type::int_t, 1}, lanes_);
+        for (std::size_t l = 0; l < lanes_; ++l) {
+            if (mask_[l]) {
+                r.at(l, 0).u = compare(op, a.at(l, 0), b.at(l, 0), builtin_type::ulong_t) ? 1 : 0;
+            }
+        }
+        return r;
+    }
+    throw std::runtime_error("interpreter: invalid pointer operands to binary " +
+                             std::string(to_string(op)));
+}
+
+auto executor::uniform(value_type t, scalar s) -> value {
+    auto r = make_value(std::move(t), lanes_);
+    std::fill(r.v.begin(), r.v.end(), s);
+    return r;
+}
+
+auto executor::vector_literal(value_type const &t, internal::binary_op &list) -> value {
+    auto parts = std::vector<internal::expr_node *>{};
+    internal::expr_node *e = &list;
+    while (auto b = dynamic_cast<internal::binary_op *>(e)) {
+        if (b->op() != binary_operation::comma) {
+            break;
+        }
+        parts.emplace_back(b->rhs().get());
+        e = b->lhs().get();
+    }
+    parts.emplace_back(e);
+    std::reverse(parts.begin(), parts.end());
+
+    auto r = make_value(t, lanes_);
+    short k = 0;
+    for (auto &p : parts) {
+        auto x = visit(*this, *p);
+        if (x.t.is_pointer() || x.t.is_void()) {
+            throw std::runtime_error("interpreter: invalid vector literal");
+        }
+        for (short c = 0; c < x.t.n; ++c, ++k) {
+            if (k >= t.n) {
+                throw std::runtime_error("interpreter: too many components in vector literal");
+            }
+            for (std::size_t l = 0; l < lanes_; ++l) {
+                if (mask_[l]) {
+                    r.at(l, k) = convert(x.at(l, c), x.t.ty, t.ty);
+                }
+            }
+        }
+    }
+    if (k != t.n) {
+        throw std::runtime_error("interpreter: too few components in vector literal");
+    }
+    return r;
+}
+
+/* Memory */
+auto executor::allocate(internal::expr_node const *v, data_type ty) -> storage & {
+    if (auto it = vars_.find(v); it != vars_.end()) {
+        return it->second;
+    }
+    auto const bytes = size_in_bytes(ty);
+    if (bytes == 0) {
+        throw std::runtime_error("interpreter: cannot allocate variable of unknown size");
+    }
+    auto const p = get_properties(ty);
+    // The address space of pointers refers to the pointee
+    bool const local = (!p.is_pointer || p.is_array) && p.space == address_space::local_t;
+    bool const shared = local || program_scope_;
+    auto const words = (bytes + 7) / 8;
+    auto s = storage{ty, shared ? 0 : 8 * words,
+                     std::vector<std::uint64_t>(shared ? words : words * max_lanes_,
+                                                ~std::uint64_t(0)),
+                     program_scope_};
+    auto &result = vars_.emplace(v, std::move(s)).first->second;
+    if (local) {
+        auto begin = result.address(0);
+        locals_.emplace_back(local_region{begin, begin + bytes,
+                                          std::vector<local_region::access>(bytes)});
+    }
+    return result;
+}
+
+auto executor::variable_storage(internal::variable &v) -> storage & {
+    auto it = vars_.find(&v);
+    if (it == vars_.end()) {
+        throw std::runtime_error("interpreter: use of undeclared variable " +
+                                 std::string(v.name()));
+    }
+    return it->second;
+}
+
+auto executor::find_local(std::uintptr_t addr) -> local_region * {
+    for (auto &r : locals_) {
+        if (addr >= r.begin && addr < r.end) {
+            return &r;
+        }
+    }
+    return nullptr;
+}
+
+void executor::check_access(std::uintptr_t addr, std::size_t bytes, std::size_t lane,
+                            bool write) {
+    if (addr == 0) {
+        throw std::runtime_error("interpreter: null pointer dereference in " + name_);
+    }
+    auto r = find_local(addr);
+    if (!r) {
+        return;
+    }
+    if (addr + bytes > r->end) {
+        throw std::runtime_error("interpreter: local memory access out of bounds in " + name_);
+    }
+    int const sg = static_cast<int>(sub_group_of(lane));
+    for (auto b = addr - r->begin; b < addr - r->begin + bytes; ++b) {
+        auto &a = r->shadow[b];
+        if (a.epoch != epoch_) {
+            a = local_region::access{epoch_, -1, -1};
+        }
+        bool race = a.writer != -1 && a.writer != sg;
+        if (write) {
+            race = race || (a.reader != -1 && a.reader != sg);
+            a.writer = sg;
+        } else {
+            a.reader = a.reader == -1 || a.reader == sg ? sg : -2;
+        }
+        if (race) {
+            throw std::runtime_error("interpreter: local memory race between sub-groups in " +
+                                     name_ + "; a barrier is missing");
+        }
+    }
+}
+
+auto executor::load_scalar(std::uintptr_t addr, builtin_type ty, std::size_t lane) -> scalar {
+    check_access(addr, size_of(ty), lane, false);
+    return interp::load(reinterpret_cast<void const *>(addr), ty);
+}
+
+void executor::store_scalar(std::uintptr_t addr, builtin_type ty, scalar x, std::size_t lane) {
+    check_access(addr, size_of(ty), lane, true);
+    interp::store(reinterpret_cast<void *>(addr), ty, x);
+}
+
+/* Work-items */
+auto executor::any_active() const -> bool {
+    return std::any_of(mask_.begin(), mask_.end(), [](char m) { return m != 0; });
+}
+
+auto executor::sub_group_size(std::size_t sg) const -> std::size_t {
+    return std::min(sgs_, lanes_ - sg * sgs_);
+}
+
+bool executor::check_work_group_uniform(builtin_function f) const {
+    auto const active =
+        static_cast<std::size_t>(std::count_if(mask_.begin(), mask_.end(), [](char m) {
+            return m != 0;
+        }));
+    if (active != 0 && active != lanes_) {
+        throw std::runtime_error("interpreter: " + std::string(to_string(f)) +
+                                 " is not reached by all work-items of the work-group in " +
+                                 name_);
+    }
+    return active != 0;
+}
+
+void executor::check_sub_group_uniform(builtin_function f) const {
+    for (std::size_t begin = 0; begin < lanes_; begin += sgs_) {
+        auto end = std::min(begin + sgs_, lanes_);
+        auto active = std::count_if(mask_.begin() + begin, mask_.begin() + end,
+                                    [](char m) { return m != 0; });
+        if (active != 0 && static_cast<std::size_t>(active) != end - begin) {
+            throw std::runtime_error("interpreter: " + std::string(to_string(f)) +
+                                     " is not reached by all work-items of the sub-group in " +
+                                     name_);
+        }
+    }
+}
+
+void executor::unsupported(std::string const &what) const {
+    throw std::runtime_error("interpreter: unsupported " + what + " in " + name_);
+}
+
+} // namespace interp
+
+namespace {
+
+class program_collector {
+  public:
+    program_collector(std::vector<func> &decls) : decls_(decls) {}
+    void operator()(internal::program &p) { decls_ = p.declarations(); }
+
+  private:
+    std::vector<func> &decls_;
+};
+
+} // namespace
+
+interpreter::interpreter(prog p) {
+    if (p) {
+        visit(program_collector{decls_}, *p);
+    }
+}
+interpreter::interpreter(func f) : decls_{std::move(f)} {}
+
+void interpreter::set_arg(std::size_t index, std::size_t size, void const *value) {
+    if (index >= args_.size()) {
+        args_.resize(index + 1);
+    }
+    auto const bytes = static_cast<std::uint8_t const *>(value);
+    args_[index].assign(bytes, bytes + size);
+}
+
+void interpreter::launch(std::string_view kernel, std::array<std::size_t, 3> global_size,
+                         std::array<std::size_t, 3> local_size) {
+    auto ex = interp::executor(decls_, args_);
+    ex.run(kernel, global_size, local_size);
+}
+
+} // namespace clir
@@ -0,0 +1,1545 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "interpreter_executor.hpp"
+#include "type_properties.hpp"
+#include "clir/builtin_function.hpp"
+#include "clir/visitor/expression_type.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace clir::interp {
+
+namespace {
+
+constexpr double pi = 3.141592653589793238462643383279502884;
+
+bool starts_with(std::string_view s, std::string_view prefix) {
+    return s.substr(0, prefix.size()) == prefix;
+}
+
+//! Removes prefix from s and returns the vector width given by the following digits
+auto consume_width(std::string_view &s) -> short {
+    short n = 0;
+    while (!s.empty() && s.front() >= '0' && s.front() <= '9') {
+        n = 10 * n + (s.front() - '0');
+        s.remove_prefix(1);
+    }
+    return n > 0 ? n : 1;
+}
+
+auto bits_of(builtin_type ty) -> int { return static_cast<int>(size_of(ty) * 8); }
+
+auto to_unsigned(builtin_type ty) -> builtin_type {
+    switch (ty) {
+    case builtin_type::char_t:
+        return builtin_type::uchar_t;
+    case builtin_type::short_t:
+        return builtin_type::ushort_t;
+    case builtin_type::int_t:
+        return builtin_type::uint_t;
+    case builtin_type::long_t:
+        return builtin_type::ulong_t;
+    default:
+        break;
+    }
+    return ty;
+}
+
+auto to_scalar_type(std::string_view name) -> builtin_type {
+    constexpr builtin_type types[] = {
+        builtin_type::char_t, builtin_type::uchar_t, builtin_type::short_t,
+        builtin_type::ushort_t, builtin_type::int_t, builtin_type::uint_t,
+        builtin_type::long_t, builtin_type::ulong_t, builtin_type::half_t,
+        builtin_type::float_t, builtin_type::double_t};
+    for (auto ty : types) {
+        if (name == to_string(ty)) {
+            return ty;
+        }
+    }
+    return builtin_type::void_t;
+}
+
+auto poison(builtin_type ty) -> scalar {
+    if (is_floating(ty)) {
+        return from_double(std::numeric_limits<double>::quiet_NaN(), ty);
+    }
+    return canonical(~std::uint64_t(0), ty);
+}
+
+//! Most significant bit, which selects components in select and any/all
+bool msb(scalar x, builtin_type ty) {
+    return (to_bits(x, ty) >> (bits_of(ty) - 1)) & 1;
+}
+
+auto min_of(builtin_type ty) -> std::int64_t {
+    int const w = bits_of(ty);
+    return is_signed(ty) ? -static_cast<std::int64_t>(std::uint64_t(1) << (w - 1)) : 0;
+}
+
+auto max_of(builtin_type ty) -> std::uint64_t {
+    int const w = bits_of(ty) - (is_signed(ty) ? 1 : 0);
+    return w >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << w) - 1;
+}
+
+//! Clamps x to the range of ty; x must be exact, i.e. bits_of(ty) < 64
+auto saturate(std::int64_t x, builtin_type ty) -> scalar {
+    auto const lo = min_of(ty);
+    auto const hi = static_cast<std::int64_t>(max_of(ty));
+    return canonical(static_cast<std::uint64_t>(std::min(std::max(x, lo), hi)), ty);
+}
+
+auto mul_hi_u64(std::uint64_t a, std::uint64_t b) -> std::uint64_t {
+    auto const a0 = a & 0xffffffff, a1 = a >> 32;
+    auto const b0 = b & 0xffffffff, b1 = b >> 32;
+    auto const p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    auto const mid = (p00 >> 32) + (p01 & 0xffffffff) + (p10 & 0xffffffff);
+    return p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+}
+
+auto mul_hi_s64(std::int64_t a, std::int64_t b) -> std::int64_t {
+    auto hi = mul_hi_u64(static_cast<std::uint64_t>(a), static_cast<std::uint64_t>(b));
+    if (a < 0) {
+        hi -= static_cast<std::uint64_t>(b);
+    }
+    if (b < 0) {
+        hi -= static_cast<std::uint64_t>(a);
+    }
+    return static_cast<std::int64_t>(hi);
+}
+
+//! sin(pi x) with exact argument reduction
+auto sinpi(double x) -> double {
+    if (!std::isfinite(x)) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    auto const r = std::fmod(x, 2.0);
+    auto const n = std::nearbyint(2.0 * r);
+    auto const f = pi * (r - 0.5 * n);
+    switch ((static_cast<int>(n) % 4 + 4) % 4) {
+    case 1:
+        return std::cos(f);
+    case 2:
+        return -std::sin(f);
+    case 3:
+        return -std::cos(f);
+    default:
+        break;
+    }
+    return std::sin(f);
+}
+
+//! cos(pi x) with exact argument reduction
+auto cospi(double x) -> double {
+    if (!std::isfinite(x)) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    auto const r = std::fmod(x, 2.0);
+    auto const n = std::nearbyint(2.0 * r);
+    auto const f = pi * (r - 0.5 * n);
+    switch ((static_cast<int>(n) % 4 + 4) % 4) {
+    case 1:
+        return -std::sin(f);
+    case 2:
+        return -std::cos(f);
+    case 3:
+        return std::sin(f);
+    default:
+        break;
+    }
+    return std::cos(f);
+}
+
+auto next_after(double x, double y, builtin_type ty) -> double {
+    if (std::isnan(x) || std::isnan(y)) {
+        return x + y;
+    }
+    if (x == y) {
+        return y;
+    }
+    auto const sign = std::uint64_t(1) << (bits_of(ty) - 1);
+    scalar s;
+    s.f = x;
+    auto bits = to_bits(s, ty);
+    if (x == 0.0) {
+        bits = y > 0.0 ? 1 : sign | 1;
+    } else if ((x < y) == (x > 0.0)) {
+        ++bits;
+    } else {
+        --bits;
+    }
+    return from_bits(bits, ty).f;
+}
+
+bool is_normal(double x, builtin_type ty) {
+    if (!std::isfinite(x)) {
+        return false;
+    }
+    switch (ty) {
+    case builtin_type::half_t:
+        return std::fabs(x) >= 0x1p-14;
+    case builtin_type::float_t:
+        return std::fabs(x) >= 0x1p-126;
+    default:
+        break;
+    }
+    return std::isnormal(x);
+}
+
+} // namespace
+
+auto executor::operator()(internal::call_builtin &fn) -> value {
+    using bf = builtin_function;
+    auto const f = fn.fn();
+    auto const name = std::string_view(to_string(f));
+    auto args = std::vector<value>{};
+    args.reserve(fn.args().size());
+    for (auto &a : fn.args()) {
+        args.emplace_back(eval(a));
+    }
+
+    if (starts_with(name, "get_") && f != bf::get_fence) {
+        return work_item_query(f, args);
+    }
+    if (starts_with(name, "vload") || starts_with(name, "vstore")) {
+        return vector_memory(f, args);
+    }
+    if (starts_with(name, "intel_sub_group_")) {
+        return sub_group_extension(f, args);
+    }
+    if (starts_with(name, "intel_convert_")) {
+        return bfloat16_conversion(f, args);
+    }
+    if (starts_with(name, "atomic_")) {
+        return atomic(f, args);
+    }
+    if (starts_with(name, "as_")) {
+        return reinterpret(f, args);
+    }
+    auto const pointer_arg = [&](std::size_t i) {
+        if (i >= args.size() || !args[i].t.is_pointer()) {
+            throw std::runtime_error("interpreter: " + std::string(name) +
+                                     " requires a pointer argument");
+        }
+        return args[i];
+    };
+    bool const integer_args = !args.empty() && !args[0].t.is_pointer() &&
+                              !args[0].t.is_void() && is_integer(args[0].t.ty);
+    switch (f) {
+    case bf::barrier:
+    case bf::work_group_barrier:
+    case bf::sub_group_barrier:
+    case bf::async_work_group_copy:
+    case bf::async_work_group_strided_copy:
+    case bf::wait_group_events:
+    case bf::prefetch:
+        return synchronization(f, args);
+    case bf::isequal:
+    case bf::isnotequal:
+    case bf::isgreater:
+    case bf::isgreaterequal:
+    case bf::isless:
+    case bf::islessequal:
+    case bf::islessgreater:
+    case bf::isfinite:
+    case bf::isinf:
+    case bf::isnan:
+    case bf::isnormal:
+    case bf::isordered:
+    case bf::isunordered:
+    case bf::signbit:
+    case bf::any:
+    case bf::all:
+    case bf::bitselect:
+    case bf::select:
+        return relational(f, args);
+    case bf::abs:
+    case bf::abs_diff:
+    case bf::add_sat:
+    case bf::hadd:
+    case bf::rhadd:
+    case bf::clz:
+    case bf::ctz:
+    case bf::mad_hi:
+    case bf::mul_hi:
+    case bf::mad_sat:
+    case bf::rotate:
+    case bf::sub_sat:
+    case bf::upsample:
+    case bf::popcount:
+    case bf::mad24:
+    case bf::mul24:
+        return integer(f, args);
+    case bf::min:
+    case bf::max:
+    case bf::clamp:
+        return integer_args ? integer(f, args) : math(f, args);
+    case bf::to_global:
+    case bf::to_local:
+    case bf::to_private: {
+        auto p = pointer_arg(0);
+        for (std::size_t l = 0; l < lanes_; ++l) {
+            if (mask_[l] && f != bf::to_private &&
+                (find_local(p.at(l, 0).u) != nullptr) != (f == bf::to_local)) {
+                p.at(l, 0).u = 0;
+            }
+        }
+        return p;
+    }
+    case bf::get_fence: {
+        auto p = pointer_arg(0);
+        auto r = make_value(value_type{builtin_type::uint_t, 1}, lanes_);
+        for (std::size_t l = 0; l < lanes_; ++l) {
+            r.at(l, 0).u = find_local(p.at(l, 0).u) ? 1 : 2;
+        }
+        return r;
+    }
+    case bf::vec_step: {
+        auto const n = args[0].t.n == 3 ? 4 : args[0].t.width();
+        return uniform(value_type{builtin_type::int_t, 1}, canonical(n, builtin_type::int_t));
+    }
+    case bf::shuffle:
+    case bf::shuffle2: {
+        auto const &x = args[0];
+        auto const &mask = args.back();
+        auto const &y = f == bf::shuffle2 ? args[1] : args[0];
+        auto const n = x.t.width();
+        auto r = make_value(value_type{x.t.ty, mask.t.n}, lanes_);
+        for (std::size_t l = 0; l < lanes_; ++l) {
+            if (mask_[l]) {
+                for (short c = 0; c < mask.t.width(); ++c) {
+                    auto j = mask.at(l, c).u % (f == bf::shuffle2 ? 2 * n : n);
+                    r.at(l, c) = j < static_cast<std::uint64_t>(n) ? x.at(l, j) : y.at(l, j - n);
+                }
+            }
+        }
+        return r;
+    }
+    default:
+        break;
+    }
+    if (starts_with(name, "work_group_") || starts_with(name, "sub_group_")) {
+        return collective(f, args);
+    }
+    return math(f, args);
+}
+
+auto executor::work_item_query(builtin_function f, std::vector<value> const &args) -> value {
+    using bf = builtin_function;
+    auto const ulong = value_type{builtin_type::ulong_t, 1};
+    auto const uint = value_type{builtin_type::uint_t, 1};
+    bool const sizes = f == bf::get_global_size || f == bf::get_local_size ||
+                       f == bf::get_enqueued_local_size || f == bf::get_num_groups;
+    auto r = make_value(f == bf::get_global_id || f == bf::get_local_id ||
+                                f == bf::get_group_id || f == bf::get_global_offset ||
+                                f == bf::get_global_linear_id || f == bf::get_local_linear_id ||
+                                sizes
+                            ? ulong
+                            : uint,
+                        lanes_);
+    for (std::size_t l = 0; l < lanes_; ++l) {
+        auto const d = args.empty() ? 0 : args[0].at(l, 0).u;
+        if (d >= 3) {
+            r.at(l, 0).u = sizes ? 1 : 0;
+            continue;
+        }
+        auto const global_id = [&](std::size_t d) {
+            return group_id_[d] * enqueued_local_size_[d] + local_id_[l][d];
+        };
+        std::uint64_t x = 0;
+        switch (f) {
+        case bf::get_work_dim:
+            x = 3;
+            break;
+        case bf::get_global_size:
+            x = global_size_[d];
+            break;
+        case bf::get_global_id:
+            x = global_id(d);
+            break;
+        case bf::get_local_size:
+            x = local_size_[d];
+            break;
+        case bf::get_enqueued_local_size:
+            x = enqueued_local_size_[d];
+            break;
+        case bf::get_local_id:
+            x = local_id_[l][d];
+            break;
+        case bf::get_num_groups:
+            x = num_groups_[d];
+            break;
+        case bf::get_group_id:
+            x = group_id_[d];
+            break;
+        case bf::get_global_offset:
+            x = 0;
+            break;
+        case bf::get_global_linear_id:
+            x = global_id(0) + global_size_[0] * (global_id(1) + global_size_[1] * global_id(2));
+            break;
+        case bf::get_local_linear_id:
+            x = l;
+            break;
+        case bf::get_sub_group_size:
+            x = sub_group_size(sub_group_of(l));
+            break;
+        case bf::get_max_sub_group_size:
+            x = sgs_;
+            break;
+        case bf::get_num_sub_groups:
+            x = (lanes_ + sgs_ - 1) / sgs_;
+            break;
+        case bf::get_enqueued_num_sub_groups:
+            x = (max_lanes_ + sgs_ - 1) / sgs_;
+            break;
+        case bf::get_sub_group_id:
+            x = sub_group_of(l);
+            break;
+        case bf::get_sub_group_local_id:
+            x = l % sgs_;
+            break;
+        default:
+            unsupported(to_string(f));
+        }
+        r.at(l, 0) = canonical(x, r.t.ty);
+    }
+    return r;
+}
+
+auto executor::math(builtin_function f, std::vector<value> &args) -> value {
+    using bf = builtin_function;
+    short n = 1;
+    auto ty = builtin_type::void_t;
+    std::size_t ptr = args.size();
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        auto const &t = args[i].t;
+        if (t.is_pointer()) {
+            ptr = i;
+        } else if (!t.is_void()) {
+            n = std::max(n, t.n);
+            if (ty == builtin_type::void_t && is_floating(t.ty)) {
+                ty = t.ty;
+            }
+        }
+    }
+    if (f == bf::nan && !args.empty()) {
+        ty = size_of(args[0].t.ty) == 8   ? builtin_type::double_t
+             : size_of(args[0].t.ty) == 2 ? builtin_type::half_t
+                                          : builtin_type::float_t;
+    }
+    if (ty == builtin_type::void_t) {
+        throw std::runtime_error("interpreter: invalid argument type of " +
+                                 std::string(to_string(f)));
+    }
+    auto const arg = [&](std::size_t i, std::size_t l, short c) {
+        auto const &a = args[i];
+        return to_double(a.at(l, a.t.n == 1 ? 0 : c), a.t.ty);
+    };
+    auto const num_args = std::min(ptr, args.size());
+
+    // Geometric functions
+    switch (f) {
+    case bf::dot:
+    case bf::length:
+    case bf::distance:
+    case bf::normalize:
+    case bf::fast_length:
+    case bf::fast_distance:
+    case bf::fast_normalize:
+    case bf::cross: {
+        bool const normal = f == bf::normalize || f == bf::fast_normalize;
+        auto r = make_value(value_type{ty, normal || f == bf::cross ? n : short(1)}, lanes_);
+        for (std::size_t l = 0; l < lanes_; ++l) {
+            if (!mask_[l]) {
+                continue;
+            }
+            auto const component = [&](short c) {
+                if (f == bf::distance || f == bf::fast_distance) {
+                    return arg(0, l, c) - arg(1, l, c);
+                }
+                return arg(0, l, c);
+            };
+            if (f == bf::cross) {
+                auto const cr = [&](short i, short j) {
+                    return arg(0, l, i) * arg(1, l, j) - arg(0, l, j) * arg(1, l, i);
+                };
+                r.at(l, 0) = from_double(cr(1, 2), ty);
+                r.at(l, 1) = from_double(cr(2, 0), ty);
+                r.at(l, 2) = from_double(cr(0, 1), ty);
+                continue;
+            }
+            double sum = 0.0;
+            for (short c = 0; c < n; ++c) {
+                sum += f == bf::dot ? arg(0, l, c) * arg(1, l, c) : component(c) * component(c);
+            }
+            if (f == bf::dot) {
+                r.at(l, 0) = from_double(sum, ty);
+            } else if (!normal) {
+                r.at(l, 0) = from_double(std::sqrt(sum), ty);
+            } else {
+                for (short c = 0; c < n; ++c) {
+                    r.at(l, c) = from_double(component(c) / std::sqrt(sum), ty);
+                }
+            }
+        }
+        return r;
+    }
+    default:
+        break;
+    }
+
+    auto rt = value_type{f == bf::ilogb ? builtin_type::int_t : ty, n};
+    auto r = make_value(rt, lanes_);
+    auto pt = ptr < args.size() ? to_value_type(args[ptr].t.pointee) : value_type{};
+    for (std::size_t l = 0; l < lanes_; ++l) {
+        if (!mask_[l]) {
+            continue;
+        }
+        for (short c = 0; c < n; ++c) {
+            double const a = num_args > 0 ? arg(0, l, c) : 0.0;
+            double const b = num_args > 1 ? arg(1, l, c) : 0.0;
+            double const d = num_args > 2 ? arg(2, l, c) : 0.0;
+            double y = 0.0, out = 0.0;
+            switch (f) {
+            case bf::acos:
+                y = std::acos(a);
+                break;
+            case bf::acosh:
+                y = std::acosh(a);
+                break;
+            case bf::acospi:
+                y = std::acos(a) / pi;
+                break;
+            case bf::asin:
+                y = std::asin(a);
+                break;
+            case bf::asinh:
+                y = std::asinh(a);
+                break;
+            case bf::asinpi:
+                y = std::asin(a) / pi;
+                break;
+            case bf::atan:
+                y = std::atan(a);
+                break;
+            case bf::atan2:
+                y = std::atan2(a, b);
+                break;
+            case bf::atanh:
+                y = std::atanh(a);
+                break;
+            case bf::atanpi:
+                y = std::atan(a) / pi;
+                break;
+            case bf::atan2pi:
+                y = std::atan2(a, b) / pi;
+                break;
+            case bf::cbrt:
+                y = std::cbrt(a);
+                break;
+            case bf::ceil:
+                y = std::ceil(a);
+                break;
+            case bf::copysign:
+                y = std::copysign(a, b);
+                break;
+            case bf::cos:
+            case bf::half_cos:
+            case bf::native_cos:
+                y = std::cos(a);
+                break;
+            case bf::cosh:
+                y = std::cosh(a);
+                break;
+            case bf::cospi:
+                y = cospi(a);
+                break;
+            case bf::erfc:
+                y = std::erfc(a);
+                break;
+            case bf::erf:
+                y = std::erf(a);
+                break;
+            case bf::exp:
+            case bf::half_exp:
+            case bf::native_exp:
+                y = std::exp(a);
+                break;
+            case bf::exp2:
+            case bf::half_exp2:
+            case bf::native_exp2:
+                y = std::exp2(a);
+                break;
+            case bf::exp10:
+            case bf::half_exp10:
+            case bf::native_exp10:
+                y = std::pow(10.0, a);
+                break;
+            case bf::expm1:
+                y = std::expm1(a);
+                break;
+            case bf::fabs:
+                y = std::fabs(a);
+                break;
+            case bf::fdim:
+                y = std::fdim(a, b);
+                break;
+            case bf::floor:
+                y = std::floor(a);
+                break;
+            case bf::fma:
+                y = std::fma(a, b, d);
+                break;
+            case bf::mad:
+                y = a * b + d;
+                break;
+            case bf::fmax:
+            case bf::max:
+                y = std::fmax(a, b);
+                break;
+            case bf::fmin:
+            case bf::min:
+                y = std::fmin(a, b);
+                break;
+            case bf::clamp:
+                y = std::fmin(std::fmax(a, b), d);
+                break;
+            case bf::fmod:
+                y = std::fmod(a, b);
+                break;
+            case bf::trunc:
+                y = std::trunc(a);
+                break;
+            case bf::fract: {
+                out = std::floor(a);
+                y = a - out;
+                auto const below_one = from_bits(to_bits(from_double(1.0, ty), ty) - 1, ty).f;
+                y = std::isnan(a) ? a : std::isinf(a) ? std::copysign(0.0, a) : y;
+                if (from_double(y, ty).f >= 1.0) {
+                    y = below_one;
+                }
+                break;
+            }
+            case bf::frexp: {
+                int e = 0;
+                y = std::frexp(a, &e);
+                out = e;
+                break;
+            }
+            case bf::hypot:
+                y = std::hypot(a, b);
+                break;
+            case bf::ilogb:
+                r.at(l, c) = canonical(static_cast<std::uint64_t>(std::ilogb(a)), rt.ty);
+                continue;
+            case bf::ldexp:
+                y = std::ldexp(a, static_cast<int>(b));
+                break;
+            case bf::lgamma:
+                y = std::lgamma(a);
+                break;
+            case bf::lgamma_r:
+                y = std::lgamma(a);
+                out = std::tgamma(a) < 0.0 ? -1.0 : 1.0;
+                break;
+            case bf::log:
+            case bf::half_log:
+            case bf::native_log:
+                y = std::log(a);
+                break;
+            case bf::log2:
+            case bf::half_log2:
+            case bf::native_log2:
+                y = std::log2(a);
+                break;
+            case bf::log10:
+            case bf::half_log10:
+            case bf::native_log10:
+                y = std::log10(a);
+                break;
+            case bf::log1p:
+                y = std::log1p(a);
+                break;
+            case bf::logb:
+                y = std::logb(a);
+                break;
+            case bf::maxmag:
+                y = std::fabs(a) > std::fabs(b)   ? a
+                    : std::fabs(b) > std::fabs(a) ? b
+                                                  : std::fmax(a, b);
+                break;
+            case bf::minmag:
+                y = std::fabs(a) < std::fabs(b)   ? a
+                    : std::fabs(b) < std::fabs(a) ? b
+                                                  : std::fmin(a, b);
+                break;
+            case bf::modf:
+                y = std::modf(a, &out);
+                break;
+            case bf::nan:
+                y = std::numeric_limits<double>::quiet_NaN();
+                break;
+            case bf::nextafter:
+                y = next_after(a, b, ty);
+                break;
+            case bf::pow:
+            case bf::pown:
+                y = std::pow(a, b);
+                break;
+            case bf::powr:
+            case bf::half_powr:
+            case bf::native_powr:
+                y = a < 0.0 ? std::numeric_limits<double>::quiet_NaN() : std::pow(a, b);
+                break;
+            case bf::remainder:
+                y = std::remainder(a, b);
+                break;
+            case bf::remquo: {
+                int q = 0;
+                y = std::remquo(a, b, &q);
+                out = q;
+                break;
+            }
+            case bf::rint:
+                y = std::nearbyint(a);
+                break;
+            case bf::rootn:
+                y = a < 0.0 && static_cast<std::int64_t>(b) % 2 != 0
+                        ? -std::pow(-a, 1.0 / b)
+                        : std::pow(a, 1.0 / b);
+                break;
+            case bf::round:
+                y = std::round(a);
+                break;
+            case bf::rsqrt:
+            case bf::half_rsqrt:
+            case bf::native_rsqrt:
+                y = 1.0 / std::sqrt(a);
+                break;
+            case bf::sin:
+            case bf::half_sin:
+            case bf::native_sin:
+                y = std::sin(a);
+                break;
+            case bf::sincos:
+                y = std::sin(a);
+                out = std::cos(a);
+                break;
+            case bf::sinh:
+                y = std::sinh(a);
+                break;
+            case bf::sinpi:
+                y = sinpi(a);
+                break;
+            case bf::sqrt:
+            case bf::half_sqrt:
+            case bf::native_sqrt:
+                y = std::sqrt(a);
+                break;
+            case bf::tan:
+            case bf::half_tan:
+            case bf::native_tan:
+                y = std::tan(a);
+                break;
+            case bf::tanh:
+                y = std::tanh(a);
+                break;
+            case bf::tanpi:
+                y = sinpi(a) / cospi(a);
+                break;
+            case bf::tgamma:
+                y = std::tgamma(a);
+                break;
+            case bf::half_divide:
+            case bf::native_divide:
+                y = a / b;
+                break;
+            case bf::half_recip:
+            case bf::native_recip:
+                y = 1.0 / a;
+                break;
+            case bf::degrees:
+                y = a * (180.0 / pi);
+                break;
+            case bf::radians:
+                y = a * (pi / 180.0);
+                break;
+            case bf::mix:
+                y = a + (b - a) * d;
+                break;
+            case bf::step:
+                y = b < a ? 0.0 : 1.0;
+                break;
+            case bf::smoothstep: {
+                auto t = std::fmin(std::fmax((d - a) / (b - a), 0.0), 1.0);
+                y = t * t * (3.0 - 2.0 * t);
+                break;
+            }
+            case bf::sign:
+                y = std::isnan(a) ? 0.0 : a > 0.0 ? 1.0 : a < 0.0 ? -1.0 : a;
+                break;
+            default:
+                unsupported(std::string("builtin ") + to_string(f));
+            }
+            r.at(l, c) = from_double(y, ty);
+            if (ptr < args.size()) {
+                auto const addr = args[ptr].at(l, 0).u + c * size_of(pt.ty);
+                auto const o = is_floating(pt.ty)
+                                   ? from_double(out, pt.ty)
+                                   : canonical(static_cast<std::uint64_t>(
+                                                   static_cast<std::int64_t>(out)),
+                                               pt.ty);
+                store_scalar(addr, pt.ty, o, l);
+            }
+        }
+    }
+    return r;
+}
+
+auto executor::integer(builtin_function f, std::vector<value> &args) -> value {
+    using bf = builtin_function;
+    short n = 1;
+    for (auto const &a : args) {
+        if (a.t.is_pointer() || a.t.is_void()) {
+            throw std::runtime_error("interpreter: invalid argument type of " +
+                                     std::string(to_string(f)));
+        }
+        n = std::max(n, a.t.n);
+    }
+    auto const ty = args[0].t.ty;
+    if (!is_integer(ty)) {
+        throw std::runtime_error("interpreter: invalid argument type of " +
+                                 std::string(to_string(f)));
+    }
+    int const w = bits_of(ty);
+    bool const s = is_signed(ty);
+    auto rt = value_type{ty, n};
+    if (f == bf::abs || f == bf::abs_diff) {
+        rt.ty = to_unsigned(ty);
+    } else if (f == bf::upsample) {
+        switch (ty) {
+        case builtin_type::char_t:
+        case builtin_type::uchar_t:
+            rt.ty = s ? builtin_type::short_t : builtin_type::ushort_t;
+            break;
+        case builtin_type::short_t:
+        case builtin_type::ushort_t:
+            rt.ty = s ? builtin_type::int_t : builtin_type::uint_t;
+            break;
+        case builtin_type::int_t:
+        case builtin_type::uint_t:
+            rt.ty = s ? builtin_type::long_t : builtin_type::ulong_t;
+            break;
+        default:
+            throw std::runtime_error("interpreter: invalid argument type of upsample");
+        }
+    } else if (f == bf::mad_sat && w == 64) {
+        unsupported("mad_sat for 64-bit integers");
+    }
+    auto const mask = w >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << w) - 1;
+    auto const arg = [&](std::size_t i, std::size_t l, short c) {
+        auto const &a = args[i];
+        return convert(a.at(l, a.t.n == 1 ? 0 : c), a.t.ty, ty);
+    };
+    auto const less = [&](scalar a, scalar b) {
+        return compare(binary_operation::less_than, a, b, ty);
+    };
+    auto r = make_value(rt, lanes_);
+    for (std::size_t l = 0; l < lanes_; ++l) {
+        if (!mask_[l]) {
+            continue;
+        }
+        for (short c = 0; c < n; ++c) {
+            auto const a = arg(0, l, c);
+            auto const b = args.size() > 1 ? arg(1, l, c) : scalar{0};
+            auto const d = args.size() > 2 ? arg(2, l, c) : scalar{0};
+            auto const x = a.u & mask;
+            std::uint64_t bits = 0;
+            switch (f) {
+            case bf::abs:
+                bits = s && a.i < 0 ? 0 - a.u : a.u;
+                break;
+            case bf::abs_diff:
+                bits = less(a, b) ? b.u - a.u : a.u - b.u;
+                break;
+            case bf::add_sat:
+            case bf::sub_sat: {
+                bool const add = f == bf::add_sat;
+                if (w < 64) {
+                    r.at(l, c) = saturate(add ? a.i + b.i : a.i - b.i, ty);
+                    continue;
+                }
+                if (s) {
+                    std::int64_t y;
+                    bool overflow = add ? __builtin_add_overflow(a.i, b.i, &y)
+                                        : __builtin_sub_overflow(a.i, b.i, &y);
+                    r.at(l, c).i = overflow ? (b.i < 0) == add ? min_of(ty)
+                                                               : static_cast<std::int64_t>(
+                                                                     max_of(ty))
+                                            : y;
+                } else {
+                    std::uint64_t y;
+                    bool overflow = add ? __builtin_add_overflow(a.u, b.u, &y)
+                                        : __builtin_sub_overflow(a.u, b.u, &y);
+                    r.at(l, c).u = overflow ? (add ? ~std::uint64_t(0) : 0) : y;
+                }
+                continue;
+            }
+            case bf::hadd:
+            case bf::rhadd: {
+                auto const round = f == bf::hadd ? a.u & b.u & 1 : (a.u | b.u) & 1;
+                bits = s ? static_cast<std::uint64_t>((a.i >> 1) + (b.i >> 1)) + round
+                         : (a.u >> 1) + (b.u >> 1) + round;
+                break;
+            }
+            case bf::clamp:
+                bits = less(a, b) ? b.u : less(d, a) ? d.u : a.u;
+                break;
+            case bf::min:
+                bits = less(b, a) ? b.u : a.u;
+                break;
+            case bf::max:
+                bits = less(a, b) ? b.u : a.u;
+                break;
+            case bf::clz:
+                while (static_cast<int>(bits) < w && !((x >> (w - 1 - bits)) & 1)) {
+                    ++bits;
+                }
+                break;
+            case bf::ctz:
+                while (static_cast<int>(bits) < w && !((x >> bits) & 1)) {
+                    ++bits;
+                }
+                break;
+            case bf::popcount:
+                for (int i = 0; i < w; ++i) {
+                    bits += (x >> i) & 1;
+                }
+                break;
+            case bf::mul_hi:
+            case bf::mad_hi:
+                if (w < 64) {
+                    bits = s ? static_cast<std::uint64_t>(a.i * b.i >> w) : a.u * b.u >> w;
+                } else {
+                    bits = s ? static_cast<std::uint64_t>(mul_hi_s64(a.i, b.i))
+                             : mul_hi_u64(a.u, b.u);
+                }
+                if (f == bf::mad_hi) {
+                    bits += d.u;
+                }
+                break;
+            case bf::mad_sat:
+                if (s) {
+                    r.at(l, c) = saturate(a.i * b.i + d.i, ty);
+                } else {
+                    auto y = a.u * b.u + d.u;
+                    r.at(l, c) = canonical(std::min(y, max_of(ty)), ty);
+                }
+                continue;
+            case bf::rotate: {
+                auto const k = b.u % static_cast<std::uint64_t>(w);
+                bits = k == 0 ? x : (x << k) | (x >> (w - k));
+                break;
+            }
+            case bf::upsample:
+                bits = (a.u << w) | (b.u & mask);
+                break;
+            case bf::mad24:
+            case bf::mul24:
+                bits = a.u * b.u + (f == bf::mad24 ? d.u : 0);
+                break;
+            default:
+                unsupported(std::string("builtin ") + to_string(f));
+            }
+            r.at(l, c) = canonical(bits, rt.ty);
+        }
+    }
+    return r;
+}
+
+auto executor::relational(builtin_function f, std::vector<value> &args) -> value {
+    using bf = builtin_function;
+    for (auto const &a : args) {
+        if (a.t.is_pointer() || a.t.is_void()) {
+            throw std::runtime_error("interpreter: invalid argument type of " +
+                                     std::string(to_string(f)));
+        }
+    }
+    auto const &x = args[0];
+    switch (f) {
+    case bf::any:
+    case bf::all: {
+        auto r = make_value(value_type{builtin_type::int_t, 1}, lanes_);
+        for (std::size_t l = 0; l < lanes_; ++l) {
+            if (mask_[l]) {
+                bool t = f == bf::all;
+                for (short c = 0; c < x.t.n; ++c) {
+                    t = f == bf::all ? t && msb(x.at(l, c), x.t.ty) : t || msb(x.at(l, c), x.t.ty);
+                }
+                r.at(l, 0).u = t ? 1 : 0;
+            }
+        }
+        return r;
+    }
+    case bf::bitselect:
+    case bf::select: {
+        auto const &y = args[1];
+        auto const &z = args[2];
+        auto r = make_value(x.t, lanes_);
+        for (std::size_t l = 0; l < lanes_; ++l) {
+            if (!mask_[l]) {
+                continue;
+            }
+            for (short c = 0; c < x.t.n; ++c) {
+                auto const yc = convert(y.at(l, y.t.n == 1 ? 0 : c), y.t.ty, x.t.ty);
+                if (f == bf::bitselect) {
+                    auto const zc = convert(z.at(l, z.t.n == 1 ? 0 : c), z.t.ty, x.t.ty);
+                    auto const m = to_bits(zc, x.t.ty);
+                    auto const bits = (to_bits(x.at(l, c), x.t.ty) & ~m) |
+                                      (to_bits(yc, x.t.ty) & m);
+                    r.at(l, c) = from_bits(bits, x.t.ty);
+                } else {
+                    bool const pick = z.t.n > 1 ? msb(z.at(l, c), z.t.ty)
+                                                : is_true(z.at(l, 0), z.t.ty);
+                    r.at(l, c) = pick ? yc : x.at(l, c);
+                }
+            }
+        }
+        return r;
+    }
+    default:
+        break;
+    }
+    short n = 1;
+    for (auto const &a : args) {
+        n = std::max(n, a.t.n);
+    }
+    auto const ty = x.t.ty;
+    auto rt = n > 1 ? value_type{relational_type(ty), n} : value_type{builtin_type::int_t, 1};
+    auto const true_bits = n > 1 ? ~std::uint64_t(0) : 1;
+    auto r = make_value(rt, lanes_);
+    for (std::size_t l = 0; l < lanes_; ++l) {
+        if (!mask_[l]) {
+            continue;
+        }
+        for (short c = 0; c < n; ++c) {
+            double const a = to_double(x.at(l, x.t.n == 1 ? 0 : c), ty);
+            double const b =
+                args.size() > 1 ? to_double(args[1].at(l, args[1].t.n == 1 ? 0 : c), args[1].t.ty)
+                                : 0.0;
+            bool t = false;
+            switch (f) {
+            case bf::isequal:
+                t = a == b;
+                break;
+            case bf::isnotequal:
+                t = a != b;
+                break;
+            case bf::isgreater:
+                t = a > b;
+                break;
+            case bf::isgreaterequal:
+                t = a >= b;
+                break;
+            case bf::isless:
+                t = a < b;
+                break;
+            case bf::islessequal:
+                t = a <= b;
+                break;
+            case bf::islessgreater:
+                t = a < b || a > b;
+                break;
+            case bf::isfinite:
+                t = std::isfinite(a);
+                break;
+            case bf::isinf:
+                t = std::isinf(a);
+                break;
+            case bf::isnan:
+                t = std::isnan(a);
+                break;
+            case bf::isnormal:
+                t = is_normal(a, ty);
+                break;
+            case bf::isordered:
+                t = !std::isnan(a) && !std::isnan(b);
+                break;
+            case bf::isunordered:
+                t = std::isnan(a) || std::isnan(b);
+                break;
+            case bf::signbit:
+                t = std::signbit(a);
+                break;
+            default:
+                unsupported(std::string("builtin ") + to_string(f));
+            }
+            r.at(l, c) = canonical(t ? true_bits : 0, rt.ty);
+        }
+    }
+    return r;
+}
+
+auto executor::vector_memory(builtin_function f, std::vector<value> &args) -> value {
+    auto name = std::string_view(to_string(f));
+    bool const is_store = starts_with(name, "vstore");
+    name.remove_prefix(is_store ? 6 : 5);
+    bool const aligned = starts_with(name, "a");
+    if (aligned) {
+        name.remove_prefix(1);
+    }
+    bool const half = starts_with(name, "_half");
+    if (half) {
+        name.remove_prefix(5);
+    }
+    auto const n = consume_width(name);
+    auto mode = rounding::rte;
+    if (name == "_rtz") {
+        mode = rounding::rtz;
+    } else if (name == "_rtp") {
+        mode = rounding::rtp;
+    } else if (name == "_rtn") {
+        mode = rounding::rtn;
+    }
+
+    auto const &offset = args[is_store ? 1 : 0];
+    auto const &p = args[is_store ? 2 : 1];
+    if (!p.t.is_pointer() || offset.t.n != 1 || !is_integer(offset.t.ty)) {
+        throw std::runtime_error("interpreter: invalid arguments of " +
+                                 std::string(to_string(f)));
+    }
+    auto const ety = half ? builtin_type::ushort_t : to_value_type(p.t.pointee).ty;
+    auto const esize = size_of(ety);
+    auto const stride = static_cast<std::uint64_t>(aligned && n == 3 ? 4 : n);
+    auto const address = [&](std::size_t l, short c) {
+        return p.at(l, 0).u + (convert(offset.at(l, 0), offset.t.ty, builtin_type::ulong_t).u *
+                                   stride +
+                               c) *
+                                  esize;
+    };
+    if (is_store) {
+        auto const &x = args[0];
+        for (std::size_t l = 0; l < lanes_; ++l) {
+            if (mask_[l]) {
+                for (short c = 0; c < n; ++c) {
+                    auto const xc = x.at(l, x.t.n == 1 ? 0 : c);
+                    auto const y =
+                        half ? canonical(double_to_half(to_double(xc, x.t.ty), mode), ety)
+                             : convert(xc, x.t.ty, ety);
+                    store_scalar(address(l, c), ety, y, l);
+                }
+            }
+        }
+        return value{};
+    }
+    auto r = make_value(value_type{half ? builtin_type::float_t : ety, n}, lanes_);
+    for (std::size_t l = 0; l < lanes_; ++l) {
+        if (mask_[l]) {
+            for (short c = 0; c < n; ++c) {
+                auto const y = load_scalar(address(l, c), ety, l);
+                r.at(l, c) = half ? from_double(half_to_double(static_cast<std::uint16_t>(y.u)),
+                                                builtin_type::float_t)
+                                  : y;
+            }
+        }
+    }
+    return r;
+}
+
+auto executor::synchronization(builtin_function f, std::vector<value> &args) -> value {
+    using bf = builtin_function;
+    switch (f) {
+    case bf::barrier:
+    case bf::work_group_barrier:
+        if (check_work_group_uniform(f)) {
+            ++epoch_;
+        }
+        break;
+    case bf::sub_group_barrier:
+        check_sub_group_uniform(f);
+        break;
+    case bf::async_work_group_copy:
+    case bf::async_work_group_strided_copy: {
+        auto const event = uniform(value_type{builtin_type::int_t, 1}, scalar{0});
+        if (!check_work_group_uniform(f)) {
+            return event;
+        }
+        // The copy is performed by the work-group as a whole and does not take part in race
+        // detection; the result is visible after wait_group_events
+        auto const &dst = args[0];
+        auto const &src = args[1];
+        auto const size = size_in_bytes(dst.t.pointee);
+        auto const num = convert(args[2].at(0, 0), args[2].t.ty, builtin_type::ulong_t).u;
+        auto stride = std::uint64_t(1);
+        if (f == bf::async_work_group_strided_copy) {
+            stride = convert(args[3].at(0, 0), args[3].t.ty, builtin_type::ulong_t).u;
+        }
+        bool const to_local = find_local(dst.at(0, 0).u) != nullptr;
+        for (std::uint64_t i = 0; i < num; ++i) {
+            auto const d = dst.at(0, 0).u + (to_local ? i : i * stride) * size;
+            auto const s = src.at(0, 0).u + (to_local ? i * stride : i) * size;
+            std::memmove(reinterpret_cast<void *>(d), reinterpret_cast<void const *>(s), size);
+        }
+        return event;
+    }
+    case bf::wait_group_events:
+    case bf::prefetch:
+        break;
+    default:
+        unsupported(std::string("builtin ") + to_string(f));
+    }
+    return value{};
+}
+
+auto executor::collective(builtin_function f, std::vector<value> &args) -> value {
+    auto name = std::string_view(to_string(f));
+    bool const wg = starts_with(name, "work_group_");
+    name.remove_prefix(wg ? 11 : 10);
+    auto const &x = args[0];
+    if (x.t.is_pointer() || x.t.is_void() || x.t.n != 1) {
+        throw std::runtime_error("interpreter: " + std::string(to_string(f)) +
+                                 " requires a scalar argument");
+    }
+    bool const predicate = name == "all" || name == "any";
+    auto r = make_value(predicate ? value_type{builtin_type::int_t, 1} : x.t, lanes_);
+    if (wg) {
+        if (!check_work_group_uniform(f)) {
+            return r;
+        }
+    } else {
+        check_sub_group_uniform(f);
+    }
+
+    auto const group_size = wg ? lanes_ : sgs_;
+    auto lanes = std::vector<std::size_t>{};
+    for (std::size_t begin = 0; begin < lanes_; begin += group_size) {
+        if (!mask_[begin]) {
+            continue;
+        }
+        lanes.clear();
+        for (std::size_t l = begin; l < std::min(begin + group_size, lanes_); ++l) {
+            lanes.emplace_back(l);
+        }
+        if (predicate) {
+            bool const all = name == "all";
+            bool t = all;
+            for (auto l : lanes) {
+                t = all ? t && is_true(x.at(l, 0), x.t.ty) : t || is_true(x.at(l, 0), x.t.ty);
+            }
+            for (auto l : lanes) {
+                r.at(l, 0).u = t ? 1 : 0;
+            }
+        } else if (name == "broadcast") {
+            std::uint64_t id = 0;
+            std::uint64_t extent = 1;
+            for (std::size_t i = 1; i < args.size(); ++i) {
+                auto const &a = args[i];
+                auto const li = convert(a.at(begin, 0), a.t.ty, builtin_type::ulong_t).u;
+                id += li * extent;
+                extent *= wg ? local_size_[i - 1] : group_size;
+            }
+            if (id >= lanes.size()) {
+                throw std::runtime_error("interpreter: " + std::string(to_string(f)) +
+                                         " index out of range in " + name_);
+            }
+            for (auto l : lanes) {
+                r.at(l, 0) = x.at(begin + id, 0);
+            }
+        } else {
+            bool const scan = starts_with(name, "scan_");
+            bool const inclusive = starts_with(name, "scan_inclusive_");
+            auto op = binary_operation::add;
+            if (name.substr(name.size() - 3) == "min") {
+                op = binary_operation::less_than;
+            } else if (name.substr(name.size() - 3) == "max") {
+                op = binary_operation::greater_than;
+            }
+            reduce(op, x, lanes, inclusive, scan, r);
+        }
+    }
+    return r;
+}
+
+void executor::reduce(binary_operation op, value const &x, std::vector<std::size_t> const &lanes,
+                      bool inclusive, bool scan, value &result) {
+    auto const ty = x.t.ty;
+    scalar acc;
+    if (op == binary_operation::add) {
+        acc = from_double(0.0, ty);
+    } else if (is_floating(ty)) {
+        acc = from_double(op == binary_operation::less_than
+                              ? std::numeric_limits<double>::infinity()
+                              : -std::numeric_limits<double>::infinity(),
+                          ty);
+    } else {
+        acc = op == binary_operation::less_than
+                  ? canonical(max_of(ty), ty)
+                  : canonical(static_cast<std::uint64_t>(min_of(ty)), ty);
+    }
+    auto const combine = [&](scalar a, scalar b) {
+        if (op == binary_operation::add) {
+            return arithmetic(op, a, b, ty);
+        }
+        return compare(op, b, a, ty) ? b : a;
+    };
+    for (auto l : lanes) {
+        auto const next = combine(acc, x.at(l, 0));
+        if (scan) {
+            result.at(l, 0) = inclusive ? next : acc;
+        }
+        acc = next;
+    }
+    if (!scan) {
+        for (auto l : lanes) {
+            result.at(l, 0) = acc;
+        }
+    }
+}
+
+auto executor::sub_group_extension(builtin_function f, std::vector<value> &args) -> value {
+    auto name = std::string_view(to_string(f));
+    name.remove_prefix(16);
+    check_sub_group_uniform(f);
+
+    if (starts_with(name, "shuffle")) {
+        name.remove_prefix(7);
+        bool const two_sources = name == "_down" || name == "_up";
+        auto const &idx = args[two_sources ? 2 : 1];
+        auto t = args[0].t;
+        if (two_sources) {
+            t = common_type(args[0].t, args[1].t);
+        }
+        auto const x = convert_value(args[0], t);
+        auto const y = two_sources ? convert_value(args[1], t) : x;
+        auto r = make_value(t, lanes_);
+        for (std::size_t begin = 0; begin < lanes_; begin += sgs_) {
+            if (!mask_[begin]) {
+                continue;
+            }
+            auto const size = static_cast<std::int64_t>(sub_group_size(sub_group_of(begin)));
+            for (std::int64_t k = 0; k < size; ++k) {
+                auto const l = begin + k;
+                auto const i = static_cast<std::int64_t>(
+                    convert(idx.at(l, 0), idx.t.ty, builtin_type::uint_t).u);
+                value const *src = nullptr;
+                std::int64_t j = -1;
+                if (name == "_down") {
+                    j = k + i;
+                    src = j < size ? &x : &y;
+                    j = j < size ? j : j - size;
+                } else if (name == "_up") {
+                    j = k - i;
+                    src = j >= 0 ? &y : &x;
+                    j = j >= 0 ? j : j + size;
+                } else {
+                    j = name == "_xor" ? k ^ i : i;
+                    src = &x;
+                }
+                for (short c = 0; c < t.width(); ++c) {
+                    r.at(l, c) = j >= 0 && j < size ? src->at(begin + j, c) : poison(t.ty);
+                }
+            }
+        }
+        return r;
+    }
+
+    bool const read = starts_with(name, "block_read");
+    name.remove_prefix(read ? 10 : 11);
+    auto ety = builtin_type::uint_t;
+    if (starts_with(name, "_ul")) {
+        ety = builtin_type::ulong_t;
+    } else if (starts_with(name, "_us")) {
+        ety = builtin_type::ushort_t;
+    }
+    if (starts_with(name, "_")) {
+        name.remove_prefix(3);
+    }
+    auto const n = consume_width(name);
+    if (args.size() != (read ? 1u : 2u) || !args[0].t.is_pointer()) {
+        unsupported(std::string("image block access ") + to_string(f));
+    }
+    auto const &p = args[0];
+    auto const esize = size_of(ety);
+    auto const t = value_type{ety, n};
+    auto const data = read ? value{} : convert_value(args[1], t);
+    auto r = read ? make_value(t, lanes_) : value{};
+    for (std::size_t begin = 0; begin < lanes_; begin += sgs_) {
+        if (!mask_[begin]) {
+            continue;
+        }
+        auto const size = sub_group_size(sub_group_of(begin));
+        for (std::size_t k = 0; k < size; ++k) {
+            auto const l = begin + k;
+            if (p.at(l, 0).u != p.at(begin, 0).u) {
+                throw std::runtime_error("interpreter: pointer passed to " +
+                                         std::string(to_string(f)) +
+                                         " differs within the sub-group in " + name_);
+            }
+            for (short c = 0; c < n; ++c) {
+                auto const addr = p.at(l, 0).u + (c * sgs_ + k) * esize;
+                if (read) {
+                    r.at(l, c) = load_scalar(addr, ety, l);
+                } else {
+                    store_scalar(addr, ety, data.at(l, c), l);
+                }
+            }
+        }
+    }
+    return r;
+}
+
+auto executor::bfloat16_conversion(builtin_function f, std::vector<value> &args) -> value {
+    bool const to_float = starts_with(to_string(f), "intel_convert_as_bfloat16");
+    auto const &x = args[0];
+    auto rt = value_type{to_float ? builtin_type::float_t : builtin_type::ushort_t, x.t.n};
+    auto r = make_value(rt, lanes_);
+    for (std::size_t l = 0; l < lanes_; ++l) {
+        if (mask_[l]) {
+            for (short c = 0; c < rt.width(); ++c) {
+                if (to_float) {
+                    r.at(l, c).f = bfloat16_to_float(static_cast<std::uint16_t>(x.at(l, c).u));
+                } else {
+                    r.at(l, c).u = float_to_bfloat16(static_cast<float>(x.at(l, c).f));
+                }
+            }
+        }
+    }
+    return r;
+}
+
+auto executor::atomic(builtin_function f, std::vector<value> &args) -> value {
+    using bf = builtin_function;
+    if (f == bf::atomic_work_item_fence) {
+        return value{};
+    }
+    auto name = std::string_view(to_string(f));
+    name.remove_prefix(7);
+    if (auto pos = name.find("_explicit"); pos != std::string_view::npos) {
+        name = name.substr(0, pos);
+    }
+    auto const &p = args[0];
+    if (!p.t.is_pointer()) {
+        throw std::runtime_error("interpreter: " + std::string(to_string(f)) +
+                                 " requires a pointer argument");
+    }
+    auto const ty = to_value_type(p.t.pointee).ty;
+    bool const flag = starts_with(name, "flag_");
+    bool const cmpxchg = starts_with(name, "compare_exchange");
+    bool const returns_old = name == "load" || name == "exchange" || starts_with(name, "fetch_");
+    auto r = make_value(returns_old             ? value_type{ty, 1}
+                        : flag || cmpxchg       ? value_type{builtin_type::bool_t, 1}
+                                                : value_type{},
+                        lanes_);
+    if (name == "flag_clear") {
+        r = value{};
+    }
+    auto const operand = [&](std::size_t i, std::size_t l) {
+        return convert(args[i].at(l, 0), args[i].t.ty, ty);
+    };
+    // Atomic operations of the work-items are applied in the order of their local linear id
+    for (std::size_t l = 0; l < lanes_; ++l) {
+        if (!mask_[l]) {
+            continue;
+        }
+        auto const addr = p.at(l, 0).u;
+        if (addr == 0) {
+            throw std::runtime_error("interpreter: null pointer dereference in " + name_);
+        }
+        auto *obj = reinterpret_cast<void *>(addr);
+        auto const old = interp::load(obj, ty);
+        if (name == "init" || name == "store") {
+            interp::store(obj, ty, operand(1, l));
+        } else if (name == "load") {
+            r.at(l, 0) = old;
+        } else if (name == "exchange") {
+            interp::store(obj, ty, operand(1, l));
+            r.at(l, 0) = old;
+        } else if (cmpxchg) {
+            auto *expected = reinterpret_cast<void *>(args[1].at(l, 0).u);
+            auto const current = interp::load(expected, ty);
+            bool const equal = compare(binary_operation::equal, old, current, ty);
+            if (equal) {
+                interp::store(obj, ty, operand(2, l));
+            } else {
+                interp::store(expected, ty, old);
+            }
+            r.at(l, 0).u = equal ? 1 : 0;
+        } else if (flag) {
+            if (name == "flag_test_and_set") {
+                r.at(l, 0).u = old.u != 0 ? 1 : 0;
+            }
+            interp::store(obj, ty, canonical(name == "flag_test_and_set" ? 1 : 0, ty));
+        } else {
+            auto const v = operand(1, l);
+            scalar y;
+            if (name == "fetch_add") {
+                y = arithmetic(binary_operation::add, old, v, ty);
+            } else if (name == "fetch_sub") {
+                y = arithmetic(binary_operation::subtract, old, v, ty);
+            } else if (name == "fetch_or") {
+                y = arithmetic(binary_operation::bitwise_or, old, v, ty);
+            } else if (name == "fetch_xor") {
+                y = arithmetic(binary_operation::bitwise_xor, old, v, ty);
+            } else if (name == "fetch_and") {
+                y = arithmetic(binary_operation::bitwise_and, old, v, ty);
+            } else if (name == "fetch_min") {
+                y = compare(binary_operation::less_than, v, old, ty) ? v : old;
+            } else if (name == "fetch_max") {
+                y = compare(binary_operation::greater_than, v, old, ty) ? v : old;
+            } else {
+                unsupported(std::string("builtin ") + to_string(f));
+            }
+            interp::store(obj, ty, y);
+            r.at(l, 0) = old;
+        }
+    }
+    return r;
+}
+
+auto executor::reinterpret(builtin_function f, std::vector<value> &args) -> value {
+    auto name = std::string_view(to_string(f));
+    name.remove_prefix(3);
+    auto digits = name.find_first_of("0123456789");
+    auto const ty = to_scalar_type(name.substr(0, digits));
+    name.remove_prefix(digits == std::string_view::npos ? name.size() : digits);
+    auto const n = consume_width(name);
+    auto const &x = args[0];
+    auto const xty = x.t.is_pointer() ? builtin_type::ulong_t : x.t.ty;
+    if (ty == builtin_type::void_t || x.t.is_void()) {
+        throw std::runtime_error("interpreter: invalid argument of " + std::string(to_string(f)));
+    }
+    // 3-component vectors have the size of 4-component vectors
+    auto const padded = [](short n) -> std::size_t { return n == 3 ? 4 : n; };
+    auto const src_size = size_of(xty) * padded(x.t.width());
+    auto const dst_size = size_of(ty) * padded(n);
+    if (src_size != dst_size) {
+        throw std::runtime_error("interpreter: " + std::string(to_string(f)) +
+                                 " requires an argument of " + std::to_string(dst_size) +
+                                 " bytes");
+    }
+    auto r = make_value(value_type{ty, n}, lanes_);
+    auto buffer = std::vector<std::uint64_t>((src_size + 7) / 8);
+    auto *bytes = reinterpret_cast<unsigned char *>(buffer.data());
+    for (std::size_t l = 0; l < lanes_; ++l) {
+        if (!mask_[l]) {
+            continue;
+        }
+        std::fill(buffer.begin(), buffer.end(), 0);
+        for (short c = 0; c < x.t.width(); ++c) {
+            interp::store(bytes + c * size_of(xty), xty, x.at(l, c));
+        }
+        for (short c = 0; c < n; ++c) {
+            r.at(l, c) = interp::load(bytes + c * size_of(ty), ty);
+        }
+    }
+    return r;
+}
+
+} // namespace clir::interp
@@ -0,0 +1,166 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef INTERPRETER_EXECUTOR_20240502_HPP
+#define INTERPRETER_EXECUTOR_20240502_HPP
+
+#include "interpreter_value.hpp"
+#include "clir/data_type.hpp"
+#include "clir/func.hpp"
+#include "clir/internal/expr_node.hpp"
+#include "clir/internal/function_node.hpp"
+#include "clir/internal/stmt_node.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace clir::interp {
+
+using mask_t = std::vector<char>;
+
+//! Object in memory referenced by an expression
+struct lvalue {
+    data_type ty;                     ///< Type of the object
+    std::vector<std::uintptr_t> addr; ///< Address of the object per lane
+    std::vector<short> comp = {};     ///< Selected vector components; empty selects all
+};
+
+//! Memory of a variable
+struct storage {
+    data_type ty;
+    std::size_t stride;               ///< Bytes between lanes; 0 if shared by the work-group
+    std::vector<std::uint64_t> mem;   ///< 8-byte words such that doubles and longs are aligned
+    bool initialized_once = false;    ///< Program scope variables are initialized once per launch
+
+    inline auto address(std::size_t lane) const -> std::uintptr_t {
+        return reinterpret_cast<std::uintptr_t>(mem.data()) + lane * stride;
+    }
+};
+
+//! Shared local memory with the last accesses per byte for race detection
+struct local_region {
+    struct access {
+        std::uint64_t epoch = 0; ///< Barrier interval of the accesses
+        int writer = -1;         ///< Sub-group that wrote; -1 if none
+        int reader = -1;         ///< Sub-group that read; -1 if none, -2 if several
+    };
+    std::uintptr_t begin, end;
+    std::vector<access> shadow;
+};
+
+/**
+ * @brief Executes the work-groups of an ND-range
+ *
+ * Expressions are evaluated for all work-items of the work-group at once; only work-items whose
+ * mask entry is set perform memory accesses and side effects.
+ */
+class executor {
+  public:
+    executor(std::vector<func> &decls, std::vector<std::vector<std::uint8_t>> const &args);
+
+    void run(std::string_view kernel, std::array<std::size_t, 3> global_size,
+             std::array<std::size_t, 3> local_size);
+
+    /* Expr nodes */
+    auto operator()(internal::expr_node &e) -> value;
+    auto operator()(internal::variable &v) -> value;
+    auto operator()(internal::int_imm &i) -> value;
+    auto operator()(internal::uint_imm &i) -> value;
+    auto operator()(internal::float_imm &i) -> value;
+    auto operator()(internal::cl_mem_fence_flags_imm &i) -> value;
+    auto operator()(internal::memory_scope_imm &i) -> value;
+    auto operator()(internal::memory_order_imm &i) -> value;
+    auto operator()(internal::unary_op &e) -> value;
+    auto operator()(internal::binary_op &e) -> value;
+    auto operator()(internal::ternary_op &e) -> value;
+    auto operator()(internal::access &e) -> value;
+    auto operator()(internal::call_builtin &fn) -> value;
+    auto operator()(internal::call &fn) -> value;
+    auto operator()(internal::cast &c) -> value;
+    auto operator()(internal::swizzle &s) -> value;
+
+    /* Stmt nodes */
+    void operator()(internal::declaration &d);
+    void operator()(internal::declaration_assignment &d);
+    void operator()(internal::expression_statement &e);
+    void operator()(internal::return_statement &e);
+    void operator()(internal::block &b);
+    void operator()(internal::for_loop &loop);
+    void operator()(internal::if_selection &is);
+    void operator()(internal::while_loop &loop);
+
+  private:
+    class lvalue_visitor;
+    class mask_guard;
+
+    /* Expressions */
+    auto eval(expr &e) -> value;
+    auto lvalue_of(internal::expr_node &e) -> lvalue;
+    auto load(lvalue const &lv) -> value;
+    void store(lvalue const &lv, value const &x);
+    auto lvalue_type(lvalue const &lv) -> value_type;
+    auto convert_value(value const &x, value_type const &t) -> value;
+    auto binary(binary_operation op, value const &a, value const &b) -> value;
+    auto pointer_binary(binary_operation op, value const &a, value const &b) -> value;
+    auto common_type(value_type const &a, value_type const &b) -> value_type;
+    auto uniform(value_type t, scalar s) -> value;
+    auto vector_literal(value_type const &t, internal::binary_op &list) -> value;
+
+    /* Builtins */
+    auto work_item_query(builtin_function f, std::vector<value> const &args) -> value;
+    auto math(builtin_function f, std::vector<value> &args) -> value;
+    auto integer(builtin_function f, std::vector<value> &args) -> value;
+    auto relational(builtin_function f, std::vector<value> &args) -> value;
+    auto vector_memory(builtin_function f, std::vector<value> &args) -> value;
+    auto synchronization(builtin_function f, std::vector<value> &args) -> value;
+    auto collective(builtin_function f, std::vector<value> &args) -> value;
+    auto sub_group_extension(builtin_function f, std::vector<value> &args) -> value;
+    auto bfloat16_conversion(builtin_function f, std::vector<value> &args) -> value;
+    auto atomic(builtin_function f, std::vector<value> &args) -> value;
+    auto reinterpret(builtin_function f, std::vector<value> &args) -> value;
+    void reduce(binary_operation op, value const &x, std::vector<std::size_t> const &lanes,
+                bool inclusive, bool scan, value &result);
+
+    /* Memory */
+    auto allocate(internal::expr_node const *v, data_type ty) -> storage &;
+    auto variable_storage(internal::variable &v) -> storage &;
+    void check_access(std::uintptr_t addr, std::size_t bytes, std::size_t lane, bool write);
+    auto load_scalar(std::uintptr_t addr, builtin_type ty, std::size_t lane) -> scalar;
+    void store_scalar(std::uintptr_t addr, builtin_type ty, scalar x, std::size_t lane);
+    auto find_local(std::uintptr_t addr) -> local_region *;
+
+    /* Work-items */
+    auto any_active() const -> bool;
+    auto sub_group_of(std::size_t lane) const -> std::size_t { return lane / sgs_; }
+    auto sub_group_size(std::size_t sg) const -> std::size_t;
+    //! Returns true if all work-items of the work-group are active and false if none is
+    bool check_work_group_uniform(builtin_function f) const;
+    //! Throws unless every sub-group is either fully active or fully inactive
+    void check_sub_group_uniform(builtin_function f) const;
+    [[noreturn]] void unsupported(std::string const &what) const;
+
+    std::vector<func> &decls_;
+    std::vector<std::vector<std::uint8_t>> const &args_;
+    std::string name_;
+    std::array<std::size_t, 3> global_size_ = {}, enqueued_local_size_ = {}, local_size_ = {},
+                               num_groups_ = {}, group_id_ = {};
+    std::size_t lanes_ = 0, max_lanes_ = 0;
+    std::size_t sgs_ = 1;
+    std::vector<std::array<std::size_t, 3>> local_id_;
+    mask_t mask_;
+    mask_t returned_;     ///< Work-items that executed a return statement in the current call
+    value return_value_;  ///< Value returned by the current call
+    std::unordered_map<internal::expr_node const *, storage> vars_;
+    std::vector<local_region> locals_;
+    std::uint64_t epoch_ = 0;
+    bool program_scope_ = false;
+};
+
+} // namespace clir::interp
+
+#endif // INTERPRETER_EXECUTOR_20240502_HPP
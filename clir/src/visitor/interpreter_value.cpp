@@ -0,0 +1,540 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "interpreter_value.hpp"
+#include "type_properties.hpp"
+#include "clir/visitor/expression_type.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace clir::interp {
+
+namespace {
+
+auto bits_of(builtin_type ty) -> int { return static_cast<int>(size_of(ty) * 8); }
+
+template <typename T> auto read(void const *p) -> T {
+    T t;
+    std::memcpy(&t, p, sizeof(T));
+    return t;
+}
+template <typename T> void write(void *p, T t) { std::memcpy(p, &t, sizeof(T)); }
+
+auto round_quantum(double q, bool positive, rounding r) -> double {
+    switch (r) {
+    case rounding::rtz:
+        return std::floor(q);
+    case rounding::rtp:
+        return positive ? std::ceil(q) : std::floor(q);
+    case rounding::rtn:
+        return positive ? std::floor(q) : std::ceil(q);
+    default:
+        break;
+    }
+    auto fl = std::floor(q);
+    auto d = q - fl;
+    if (d > 0.5 || (d == 0.5 && std::fmod(fl, 2.0) != 0.0)) {
+        return fl + 1.0;
+    }
+    return fl;
+}
+
+auto round_to_half(double x, rounding r) -> double {
+    if (std::isnan(x) || std::isinf(x) || x == 0.0) {
+        return x;
+    }
+    auto a = std::fabs(x);
+    int e;
+    std::frexp(a, &e);
+    // a lies in [2^(e-1), 2^e); half has 10 fraction bits and a minimum exponent of -14
+    int const q_exp = (e - 1 < -14 ? -14 : e - 1) - 10;
+    auto y = std::ldexp(round_quantum(std::ldexp(a, -q_exp), x > 0.0, r), q_exp);
+    if (y > 65504.0) {
+        bool to_inf = r == rounding::rte || (r == rounding::rtp && x > 0.0) ||
+                      (r == rounding::rtn && x < 0.0);
+        y = to_inf ? std::numeric_limits<double>::infinity() : 65504.0;
+    }
+    return std::copysign(y, x);
+}
+
+} // namespace
+
+auto make_value(value_type t, std::size_t lanes) -> value {
+    auto w = t.is_void() ? 0 : t.width();
+    return value{std::move(t), std::vector<scalar>(lanes * w, scalar{0})};
+}
+
+auto normalize(builtin_type ty) -> builtin_type {
+    switch (ty) {
+    case builtin_type::size_t:
+    case builtin_type::uintptr_t:
+    case builtin_type::atomic_ulong_t:
+    case builtin_type::atomic_uintptr_t:
+    case builtin_type::atomic_size_t:
+        return builtin_type::ulong_t;
+    case builtin_type::ptrdiff_t:
+    case builtin_type::intptr_t:
+    case builtin_type::atomic_long_t:
+    case builtin_type::atomic_intptr_t:
+    case builtin_type::atomic_ptrdiff_t:
+        return builtin_type::long_t;
+    case builtin_type::cl_mem_fence_flags_t:
+    case builtin_type::memory_scope_t:
+    case builtin_type::memory_order_t:
+    case builtin_type::atomic_flag_t:
+    case builtin_type::atomic_int_t:
+        return builtin_type::int_t;
+    case builtin_type::atomic_uint_t:
+        return builtin_type::uint_t;
+    case builtin_type::atomic_float_t:
+        return builtin_type::float_t;
+    case builtin_type::atomic_double_t:
+        return builtin_type::double_t;
+    case builtin_type::atomic_half_t:
+        return builtin_type::half_t;
+    default:
+        break;
+    }
+    return ty;
+}
+
+auto to_value_type(data_type ty) -> value_type {
+    auto p = get_properties(ty);
+    if (p.is_pointer) {
+        return value_type{builtin_type::void_t, 0, p.element};
+    }
+    if (p.ty == builtin_type::void_t) {
+        return value_type{};
+    }
+    return value_type{normalize(p.ty), p.components};
+}
+
+auto to_data_type(value_type const &t) -> data_type {
+    if (t.is_pointer()) {
+        return pointer_to(t.pointee);
+    }
+    return make_type(t.ty, t.n);
+}
+
+bool is_integer(builtin_type ty) {
+    switch (ty) {
+    case builtin_type::bool_t:
+    case builtin_type::char_t:
+    case builtin_type::uchar_t:
+    case builtin_type::short_t:
+    case builtin_type::ushort_t:
+    case builtin_type::int_t:
+    case builtin_type::uint_t:
+    case builtin_type::long_t:
+    case builtin_type::ulong_t:
+        return true;
+    default:
+        break;
+    }
+    return false;
+}
+
+auto relational_type(builtin_type ty) -> builtin_type {
+    switch (size_of(ty)) {
+    case 1:
+        return builtin_type::char_t;
+    case 2:
+        return builtin_type::short_t;
+    case 8:
+        return builtin_type::long_t;
+    default:
+        break;
+    }
+    return builtin_type::int_t;
+}
+
+auto relational_type(value_type const &t) -> value_type {
+    if (t.n > 1) {
+        return value_type{relational_type(t.ty), t.n};
+    }
+    return value_type{builtin_type::int_t, 1};
+}
+
+auto canonical(std::uint64_t bits, builtin_type ty) -> scalar {
+    scalar r;
+    if (ty == builtin_type::bool_t) {
+        r.u = bits != 0 ? 1 : 0;
+        return r;
+    }
+    int const w = bits_of(ty);
+    if (w > 0 && w < 64) {
+        auto const m = (std::uint64_t(1) << w) - 1;
+        bits &= m;
+        if (is_signed(ty) && ((bits >> (w - 1)) & 1)) {
+            bits |= ~m;
+        }
+    }
+    r.u = bits;
+    return r;
+}
+
+auto convert(scalar x, builtin_type from, builtin_type to) -> scalar {
+    if (from == to) {
+        return x;
+    }
+    scalar r;
+    if (to == builtin_type::bool_t) {
+        r.u = is_true(x, from) ? 1 : 0;
+        return r;
+    }
+    if (is_floating(to)) {
+        if (is_floating(from)) {
+            r.f = round_to(x.f, to);
+        } else if (to == builtin_type::float_t) {
+            r.f = is_signed(from) ? static_cast<float>(x.i) : static_cast<float>(x.u);
+        } else {
+            r.f = round_to(is_signed(from) ? static_cast<double>(x.i) : static_cast<double>(x.u),
+                           to);
+        }
+        return r;
+    }
+    if (is_floating(from)) {
+        // Out-of-range conversions are undefined in OpenCL C; they saturate here
+        auto t = std::trunc(x.f);
+        int const w = bits_of(to);
+        if (std::isnan(t)) {
+            r.u = 0;
+        } else if (is_signed(to)) {
+            auto const hi = std::ldexp(1.0, w - 1);
+            if (t >= hi) {
+                r.u = (std::uint64_t(1) << (w - 1)) - 1;
+            } else if (t <= -hi) {
+                r.u = std::uint64_t(1) << (w - 1);
+            } else {
+                r.i = static_cast<std::int64_t>(t);
+            }
+        } else {
+            if (t <= 0.0) {
+                r.u = 0;
+            } else if (t >= std::ldexp(1.0, w)) {
+                r.u = ~std::uint64_t(0);
+            } else {
+                r.u = static_cast<std::uint64_t>(t);
+            }
+        }
+        return canonical(r.u, to);
+    }
+    return canonical(x.u, to);
+}
+
+auto round_to(double x, builtin_type ty, rounding r) -> double {
+    switch (ty) {
+    case builtin_type::half_t:
+        return round_to_half(x, r);
+    case builtin_type::float_t:
+        if (r == rounding::rte) {
+            return static_cast<float>(x);
+        } else {
+            auto y = static_cast<float>(x);
+            auto yd = static_cast<double>(y);
+            if (yd == x || std::isnan(x)) {
+                return yd;
+            }
+            bool up = (r == rounding::rtp) || (r == rounding::rtz && x < 0.0);
+            bool down = (r == rounding::rtn) || (r == rounding::rtz && x > 0.0);
+            if (up && yd < x) {
+                y = std::nextafter(y, std::numeric_limits<float>::infinity());
+            } else if (down && yd > x) {
+                y = std::nextafter(y, -std::numeric_limits<float>::infinity());
+            }
+            return y;
+        }
+    default:
+        break;
+    }
+    return x;
+}
+
+auto to_double(scalar x, builtin_type ty) -> double {
+    if (is_floating(ty)) {
+        return x.f;
+    }
+    return is_signed(ty) ? static_cast<double>(x.i) : static_cast<double>(x.u);
+}
+
+auto from_double(double x, builtin_type ty) -> scalar {
+    scalar s;
+    s.f = x;
+    return convert(s, builtin_type::double_t, ty);
+}
+
+bool is_true(scalar x, builtin_type ty) { return is_floating(ty) ? x.f != 0.0 : x.u != 0; }
+
+auto arithmetic(binary_operation op, scalar a, scalar b, builtin_type ty) -> scalar {
+    scalar r;
+    if (ty == builtin_type::float_t) {
+        auto x = static_cast<float>(a.f);
+        auto y = static_cast<float>(b.f);
+        switch (op) {
+        case binary_operation::add:
+            r.f = x + y;
+            return r;
+        case binary_operation::subtract:
+            r.f = x - y;
+            return r;
+        case binary_operation::multiply:
+            r.f = x * y;
+            return r;
+        case binary_operation::divide:
+            r.f = x / y;
+            return r;
+        default:
+            break;
+        }
+        throw std::runtime_error("interpreter: invalid operands to binary " +
+                                 std::string(to_string(op)));
+    }
+    if (is_floating(ty)) {
+        switch (op) {
+        case binary_operation::add:
+            r.f = round_to(a.f + b.f, ty);
+            return r;
+        case binary_operation::subtract:
+            r.f = round_to(a.f - b.f, ty);
+            return r;
+        case binary_operation::multiply:
+            r.f = round_to(a.f * b.f, ty);
+            return r;
+        case binary_operation::divide:
+            r.f = round_to(a.f / b.f, ty);
+            return r;
+        default:
+            break;
+        }
+        throw std::runtime_error("interpreter: invalid operands to binary " +
+                                 std::string(to_string(op)));
+    }
+
+    int const w = bits_of(ty);
+    bool const s = is_signed(ty);
+    std::uint64_t bits = 0;
+    switch (op) {
+    case binary_operation::add:
+        bits = a.u + b.u;
+        break;
+    case binary_operation::subtract:
+        bits = a.u - b.u;
+        break;
+    case binary_operation::multiply:
+        bits = a.u * b.u;
+        break;
+    case binary_operation::divide:
+    case binary_operation::modulo: {
+        bool div = op == binary_operation::divide;
+        // Division by zero is undefined in OpenCL C and yields 0 here
+        if (b.u == 0) {
+            bits = 0;
+        } else if (s) {
+            if (b.i == -1) {
+                bits = div ? 0 - a.u : 0;
+            } else {
+                bits = static_cast<std::uint64_t>(div ? a.i / b.i : a.i % b.i);
+            }
+        } else {
+            bits = div ? a.u / b.u : a.u % b.u;
+        }
+        break;
+    }
+    case binary_operation::bitwise_and:
+        bits = a.u & b.u;
+        break;
+    case binary_operation::bitwise_or:
+        bits = a.u | b.u;
+        break;
+    case binary_operation::bitwise_xor:
+        bits = a.u ^ b.u;
+        break;
+    case binary_operation::left_shift:
+    case binary_operation::right_shift: {
+        // OpenCL C uses the shift count modulo the number of bits
+        auto count = b.u & static_cast<std::uint64_t>(w - 1);
+        if (op == binary_operation::left_shift) {
+            bits = a.u << count;
+        } else {
+            bits = s ? static_cast<std::uint64_t>(a.i >> count) : a.u >> count;
+        }
+        break;
+    }
+    default:
+        throw std::runtime_error("interpreter: invalid operands to binary " +
+                                 std::string(to_string(op)));
+    }
+    return canonical(bits, ty);
+}
+
+bool compare(binary_operation op, scalar a, scalar b, builtin_type ty) {
+    auto const cmp = [op](auto x, auto y) {
+        switch (op) {
+        case binary_operation::greater_than:
+            return x > y;
+        case binary_operation::less_than:
+            return x < y;
+        case binary_operation::greater_than_or_equal:
+            return x >= y;
+        case binary_operation::less_than_or_equal:
+            return x <= y;
+        case binary_operation::equal:
+            return x == y;
+        case binary_operation::not_equal:
+            return x != y;
+        default:
+            break;
+        }
+        throw std::runtime_error("interpreter: invalid comparison " + std::string(to_string(op)));
+    };
+    if (is_floating(ty)) {
+        return cmp(a.f, b.f);
+    }
+    return is_signed(ty) ? cmp(a.i, b.i) : cmp(a.u, b.u);
+}
+
+auto to_bits(scalar x, builtin_type ty) -> std::uint64_t {
+    std::uint64_t bits = 0;
+    store(&bits, ty, x);
+    return bits;
+}
+
+auto from_bits(std::uint64_t bits, builtin_type ty) -> scalar { return load(&bits, ty); }
+
+auto load(void const *p, builtin_type ty) -> scalar {
+    scalar r;
+    switch (ty) {
+    case builtin_type::bool_t:
+        r.u = read<std::uint8_t>(p) != 0 ? 1 : 0;
+        break;
+    case builtin_type::char_t:
+        r.i = read<std::int8_t>(p);
+        break;
+    case builtin_type::uchar_t:
+        r.u = read<std::uint8_t>(p);
+        break;
+    case builtin_type::short_t:
+        r.i = read<std::int16_t>(p);
+        break;
+    case builtin_type::ushort_t:
+        r.u = read<std::uint16_t>(p);
+        break;
+    case builtin_type::int_t:
+        r.i = read<std::int32_t>(p);
+        break;
+    case builtin_type::uint_t:
+        r.u = read<std::uint32_t>(p);
+        break;
+    case builtin_type::long_t:
+        r.i = read<std::int64_t>(p);
+        break;
+    case builtin_type::ulong_t:
+        r.u = read<std::uint64_t>(p);
+        break;
+    case builtin_type::half_t:
+        r.f = half_to_double(read<std::uint16_t>(p));
+        break;
+    case builtin_type::float_t:
+        r.f = read<float>(p);
+        break;
+    case builtin_type::double_t:
+        r.f = read<double>(p);
+        break;
+    default:
+        throw std::runtime_error("interpreter: cannot load " + std::string(to_string(ty)));
+    }
+    return r;
+}
+
+void store(void *p, builtin_type ty, scalar x) {
+    switch (ty) {
+    case builtin_type::bool_t:
+        write<std::uint8_t>(p, x.u != 0 ? 1 : 0);
+        break;
+    case builtin_type::char_t:
+    case builtin_type::uchar_t:
+        write(p, static_cast<std::uint8_t>(x.u));
+        break;
+    case builtin_type::short_t:
+    case builtin_type::ushort_t:
+        write(p, static_cast<std::uint16_t>(x.u));
+        break;
+    case builtin_type::int_t:
+    case builtin_type::uint_t:
+        write(p, static_cast<std::uint32_t>(x.u));
+        break;
+    case builtin_type::long_t:
+    case builtin_type::ulong_t:
+        write(p, x.u);
+        break;
+    case builtin_type::half_t:
+        write(p, double_to_half(x.f));
+        break;
+    case builtin_type::float_t:
+        write(p, static_cast<float>(x.f));
+        break;
+    case builtin_type::double_t:
+        write(p, x.f);
+        break;
+    default:
+        throw std::runtime_error("interpreter: cannot store " + std::string(to_string(ty)));
+    }
+}
+
+auto half_to_double(std::uint16_t bits) -> double {
+    int const e = (bits >> 10) & 0x1f;
+    int const m = bits & 0x3ff;
+    double v;
+    if (e == 0) {
+        v = std::ldexp(static_cast<double>(m), -24);
+    } else if (e == 31) {
+        v = m != 0 ? std::numeric_limits<double>::quiet_NaN()
+                   : std::numeric_limits<double>::infinity();
+    } else {
+        v = std::ldexp(static_cast<double>(m + 1024), e - 25);
+    }
+    return (bits & 0x8000) ? -v : v;
+}
+
+auto double_to_half(double x, rounding r) -> std::uint16_t {
+    std::uint16_t const sign = std::signbit(x) ? 0x8000 : 0;
+    if (std::isnan(x)) {
+        return sign | 0x7e00;
+    }
+    auto a = std::fabs(round_to_half(x, r));
+    if (std::isinf(a)) {
+        return sign | 0x7c00;
+    }
+    if (a == 0.0) {
+        return sign;
+    }
+    int e;
+    std::frexp(a, &e);
+    if (e - 1 < -14) {
+        return sign | static_cast<std::uint16_t>(std::ldexp(a, 24));
+    }
+    auto const m = static_cast<std::uint16_t>(std::ldexp(a, 11 - e) - 1024.0);
+    return sign | static_cast<std::uint16_t>((e + 14) << 10) | m;
+}
+
+auto bfloat16_to_float(std::uint16_t bits) -> float {
+    auto const u = static_cast<std::uint32_t>(bits) << 16;
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+auto float_to_bfloat16(float x) -> std::uint16_t {
+    std::uint32_t u;
+    std::memcpy(&u, &x, sizeof(u));
+    if (std::isnan(x)) {
+        return static_cast<std::uint16_t>((u >> 16) | 0x40);
+    }
+    u += 0x7fff + ((u >> 16) & 1);
+    return static_cast<std::uint16_t>(u >> 16);
+}
+
+} // namespace clir::interp
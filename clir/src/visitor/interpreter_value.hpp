@@ -0,0 +1,90 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef INTERPRETER_VALUE_20240502_HPP
+#define INTERPRETER_VALUE_20240502_HPP
+
+#include "clir/builtin_type.hpp"
+#include "clir/data_type.hpp"
+#include "clir/op.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace clir::interp {
+
+/**
+ * @brief Component of a value
+ *
+ * Signed integers are sign-extended, unsigned integers, bools, and pointers are zero-extended,
+ * and floating point numbers are stored as double that are exactly representable in their type.
+ */
+union scalar {
+    std::int64_t i;
+    std::uint64_t u;
+    double f;
+};
+
+enum class rounding { rte, rtz, rtp, rtn };
+
+//! Type of a value
+struct value_type {
+    builtin_type ty = builtin_type::void_t; ///< Element type; void_t for pointers and void
+    short n = 0;                            ///< Number of components; 0 for pointers and void
+    data_type pointee = {};                 ///< Referenced type of pointers
+
+    inline bool is_pointer() const { return bool(pointee); }
+    inline bool is_void() const { return n == 0 && !pointee; }
+    inline short width() const { return n > 0 ? n : 1; }
+};
+
+//! Value of an expression for all work-items of a work-group
+struct value {
+    value_type t = {};
+    std::vector<scalar> v = {}; ///< Component c of lane l is stored at l * t.width() + c
+
+    inline scalar &at(std::size_t lane, short c) { return v[lane * t.width() + c]; }
+    inline scalar const &at(std::size_t lane, short c) const { return v[lane * t.width() + c]; }
+};
+
+auto make_value(value_type t, std::size_t lanes) -> value;
+
+//! Maps aliases such as size_t or atomic_int to the builtin type with the same representation
+auto normalize(builtin_type ty) -> builtin_type;
+//! Value type of an expression of the given data type; arrays decay to pointers
+auto to_value_type(data_type ty) -> value_type;
+auto to_data_type(value_type const &t) -> data_type;
+bool is_integer(builtin_type ty);
+//! Signed integer type with the same size as ty, as returned by relational functions
+auto relational_type(builtin_type ty) -> builtin_type;
+//! Type returned by vector relational operations; int for scalars
+auto relational_type(value_type const &t) -> value_type;
+
+//! Truncates bits to the size of ty and extends the result to 64 bits
+auto canonical(std::uint64_t bits, builtin_type ty) -> scalar;
+//! Implicit conversion; floats are truncated and saturated when converted to integers
+auto convert(scalar x, builtin_type from, builtin_type to) -> scalar;
+auto round_to(double x, builtin_type ty, rounding r = rounding::rte) -> double;
+auto to_double(scalar x, builtin_type ty) -> double;
+auto from_double(double x, builtin_type ty) -> scalar;
+bool is_true(scalar x, builtin_type ty);
+
+//! Arithmetic, bitwise, or shift operation with both operands of type ty
+auto arithmetic(binary_operation op, scalar a, scalar b, builtin_type ty) -> scalar;
+bool compare(binary_operation op, scalar a, scalar b, builtin_type ty);
+
+//! Bit pattern of x in memory
+auto to_bits(scalar x, builtin_type ty) -> std::uint64_t;
+auto from_bits(std::uint64_t bits, builtin_type ty) -> scalar;
+auto load(void const *p, builtin_type ty) -> scalar;
+void store(void *p, builtin_type ty, scalar x);
+
+auto half_to_double(std::uint16_t bits) -> double;
+auto double_to_half(double x, rounding r = rounding::rte) -> std::uint16_t;
+auto bfloat16_to_float(std::uint16_t bits) -> float;
+auto float_to_bfloat16(float x) -> std::uint16_t;
+
+} // namespace clir::interp
+
+#endif // INTERPRETER_VALUE_20240502_HPP
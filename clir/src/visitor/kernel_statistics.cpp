@@ -0,0 +1,362 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "clir/visitor/kernel_statistics.hpp"
+#include "type_properties.hpp"
+#include "clir/builtin_function.hpp"
+#include "clir/builtin_type.hpp"
+#include "clir/func.hpp"
+#include "clir/prog.hpp"
+#include "clir/visit.hpp"
+
+#include <ostream>
+#include <string_view>
+#include <utility>
+
+namespace clir {
+
+namespace {
+
+//! Returns the operand type that determines the type of a binary arithmetic operation
+auto common_type(data_type a, data_type b) -> data_type {
+    if (!a) {
+        return b;
+    }
+    if (!b) {
+        return a;
+    }
+    auto pa = get_properties(a);
+    auto pb = get_properties(b);
+    if (pa.is_pointer || pb.is_pointer) {
+        return pa.is_pointer ? a : b;
+    }
+    if (pa.components != pb.components) {
+        return pa.components > pb.components ? a : b;
+    }
+    if (is_floating(pa.ty) != is_floating(pb.ty)) {
+        return is_floating(pa.ty) ? a : b;
+    }
+    return size_of(pb.ty) > size_of(pa.ty) ? b : a;
+}
+
+bool starts_with(std::string_view str, std::string_view prefix) {
+    return str.substr(0, prefix.size()) == prefix;
+}
+
+//! Vector width encoded in the name of vloadN and friends
+auto trailing_width(std::string_view name) -> short {
+    auto pos = name.find_last_not_of("0123456789");
+    short n = 0;
+    for (auto c : name.substr(pos + 1)) {
+        n = 10 * n + (c - '0');
+    }
+    return n > 0 ? n : 1;
+}
+
+} // namespace
+
+std::ostream &operator<<(std::ostream &os, kernel_statistics const &stats) {
+    os << stats.name << ": flops=" << stats.flops << " global_loads=" << stats.global_loads
+       << " global_stores=" << stats.global_stores << " local_loads=" << stats.local_loads
+       << " local_stores=" << stats.local_stores << " barriers=" << stats.barriers
+       << " sub_group_shuffles=" << stats.sub_group_shuffles
+       << " private_array_bytes=" << stats.private_array_bytes
+       << " local_memory_bytes=" << stats.local_memory_bytes;
+    return os;
+}
+
+void statistics_counter::count_access(data_type &element, lvalue_mode mode) {
+    auto space = get_properties(element).space;
+    if (space == address_space::global_t || space == address_space::constant_t) {
+        stats_.global_loads += mode != lvalue_mode::store ? 1 : 0;
+        stats_.global_stores += mode != lvalue_mode::none ? 1 : 0;
+    } else if (space == address_space::local_t) {
+        stats_.local_loads += mode != lvalue_mode::store ? 1 : 0;
+        stats_.local_stores += mode != lvalue_mode::none ? 1 : 0;
+    }
+}
+
+void statistics_counter::count_flops(data_type &ty, std::size_t per_component) {
+    auto p = get_properties(ty);
+    if (!p.is_pointer && is_floating(p.ty)) {
+        stats_.flops += per_component * p.components;
+    }
+}
+
+/* Expr nodes */
+auto statistics_counter::operator()(internal::expr_node &) -> data_type { return {}; }
+auto statistics_counter::operator()(internal::variable &v) -> data_type {
+    auto it = types_.find(&v);
+    return it != types_.end() ? it->second : data_type{};
+}
+auto statistics_counter::operator()(internal::int_imm &i) -> data_type {
+    return i.bits() > 32 ? generic_long() : generic_int();
+}
+auto statistics_counter::operator()(internal::uint_imm &i) -> data_type {
+    return i.bits() > 32 ? generic_ulong() : generic_uint();
+}
+auto statistics_counter::operator()(internal::float_imm &i) -> data_type {
+    if (i.bits() == 16) {
+        return generic_half();
+    }
+    return i.bits() > 32 ? generic_double() : generic_float();
+}
+auto statistics_counter::operator()(internal::unary_op &op) -> data_type {
+    auto mode = std::exchange(lvalue_, lvalue_mode::none);
+    switch (op.op()) {
+    case unary_operation::indirection: {
+        auto p = get_properties(visit(*this, *op.term()));
+        if (p.is_pointer) {
+            count_access(p.element, mode);
+        }
+        return p.element;
+    }
+    case unary_operation::address: {
+        auto ty = visit(*this, *op.term());
+        return ty ? pointer_to(std::move(ty)) : data_type{};
+    }
+    case unary_operation::pre_increment:
+    case unary_operation::pre_decrement:
+    case unary_operation::post_increment:
+    case unary_operation::post_decrement: {
+        lvalue_ = lvalue_mode::load_store;
+        auto ty = visit(*this, *op.term());
+        lvalue_ = lvalue_mode::none;
+        return ty;
+    }
+    case unary_operation::logical_not:
+        visit(*this, *op.term());
+        return generic_int();
+    default:
+        break;
+    }
+    // Negation is a source modifier and not counted as flop
+    return visit(*this, *op.term());
+}
+auto statistics_counter::operator()(internal::binary_op &op) -> data_type {
+    switch (op.op()) {
+    case binary_operation::assignment:
+    case binary_operation::add_into:
+    case binary_operation::subtract_from:
+    case binary_operation::multiply_into:
+    case binary_operation::divide_into:
+    case binary_operation::modulus_into:
+    case binary_operation::left_shift_by:
+    case binary_operation::right_shift_by:
+    case binary_operation::and_into:
+    case binary_operation::or_into:
+    case binary_operation::xor_into: {
+        bool const is_plain = op.op() == binary_operation::assignment;
+        lvalue_ = is_plain ? lvalue_mode::store : lvalue_mode::load_store;
+        auto lt = visit(*this, *op.lhs());
+        lvalue_ = lvalue_mode::none;
+        visit(*this, *op.rhs());
+        if (op.op() == binary_operation::add_into || op.op() == binary_operation::subtract_from ||
+            op.op() == binary_operation::multiply_into ||
+            op.op() == binary_operation::divide_into) {
+            count_flops(lt, 1);
+        }
+        return lt;
+    }
+    default:
+        break;
+    }
+    lvalue_ = lvalue_mode::none;
+    auto lt = visit(*this, *op.lhs());
+    auto rt = visit(*this, *op.rhs());
+    switch (op.op()) {
+    case binary_operation::add:
+    case binary_operation::subtract:
+    case binary_operation::multiply:
+    case binary_operation::divide: {
+        auto ty = common_type(std::move(lt), std::move(rt));
+        count_flops(ty, 1);
+        return ty;
+    }
+    case binary_operation::greater_than:
+    case binary_operation::less_than:
+    case binary_operation::greater_than_or_equal:
+    case binary_operation::less_than_or_equal:
+    case binary_operation::equal:
+    case binary_operation::not_equal:
+    case binary_operation::logical_and:
+    case binary_operation::logical_or:
+        return generic_int();
+    case binary_operation::comma:
+        return rt;
+    default:
+        break;
+    }
+    return common_type(std::move(lt), std::move(rt));
+}
+auto statistics_counter::operator()(internal::ternary_op &op) -> data_type {
+    lvalue_ = lvalue_mode::none;
+    visit(*this, *op.term0());
+    auto t1 = visit(*this, *op.term1());
+    auto t2 = visit(*this, *op.term2());
+    return common_type(std::move(t1), std::move(t2));
+}
+auto statistics_counter::operator()(internal::access &op) -> data_type {
+    auto mode = std::exchange(lvalue_, lvalue_mode::none);
+    auto p = get_properties(visit(*this, *op.field()));
+    visit(*this, *op.address());
+    if (p.is_pointer) {
+        count_access(p.element, mode);
+        return p.element;
+    }
+    // Component of a vector in private memory
+    return p.components > 0 ? data_type(p.ty) : data_type{};
+}
+auto statistics_counter::operator()(internal::call_builtin &fn) -> data_type {
+    lvalue_ = lvalue_mode::none;
+    auto args = std::vector<data_type>{};
+    args.reserve(fn.args().size());
+    for (auto &a : fn.args()) {
+        args.emplace_back(visit(*this, *a));
+    }
+    auto arg = [&args](std::size_t i) { return i < args.size() ? args[i] : data_type{}; };
+    auto const f = fn.fn();
+    auto const name = std::string_view(to_string(f));
+
+    if (f == builtin_function::barrier || f == builtin_function::work_group_barrier) {
+        ++stats_.barriers;
+    } else if (starts_with(name, "intel_sub_group_shuffle") ||
+               f == builtin_function::sub_group_broadcast) {
+        ++stats_.sub_group_shuffles;
+        return arg(0);
+    } else if (starts_with(name, "vload")) {
+        auto p = get_properties(args[1]);
+        if (p.is_pointer) {
+            count_access(p.element, lvalue_mode::none);
+            auto e = get_properties(p.element);
+            auto ty = e.ty == builtin_type::half_t ? builtin_type::float_t : e.ty;
+            return make_type(ty, trailing_width(name));
+        }
+    } else if (starts_with(name, "vstore")) {
+        auto p = get_properties(args[2]);
+        if (p.is_pointer) {
+            count_access(p.element, lvalue_mode::store);
+        }
+    } else if (starts_with(name, "intel_sub_group_block_read") ||
+               starts_with(name, "intel_sub_group_block_write")) {
+        auto p = get_properties(args[0]);
+        if (p.is_pointer) {
+            bool is_write = starts_with(name, "intel_sub_group_block_write");
+            count_access(p.element, is_write ? lvalue_mode::store : lvalue_mode::none);
+        }
+    } else if (f == builtin_function::fma || f == builtin_function::mad) {
+        auto ty = arg(0);
+        count_flops(ty, 2);
+        return ty;
+    } else if (f >= builtin_function::acos && f <= builtin_function::native_tan) {
+        auto ty = arg(0);
+        count_flops(ty, 1);
+        return ty;
+    }
+    return {};
+}
+auto statistics_counter::operator()(internal::call &fn) -> data_type {
+    lvalue_ = lvalue_mode::none;
+    for (auto &arg : fn.args()) {
+        visit(*this, *arg);
+    }
+    return {};
+}
+auto statistics_counter::operator()(internal::cast &op) -> data_type {
+    lvalue_ = lvalue_mode::none;
+    visit(*this, *op.term());
+    return op.target_ty();
+}
+auto statistics_counter::operator()(internal::swizzle &op) -> data_type {
+    auto p = get_properties(visit(*this, *op.term()));
+    if (p.components == 0) {
+        return {};
+    }
+    auto n = op.selector() == internal::swizzle_selector::index
+                 ? static_cast<short>(op.indices().size())
+                 : static_cast<short>(p.components / 2);
+    return make_type(p.ty, n);
+}
+
+/* Stmt nodes */
+void statistics_counter::operator()(internal::declaration &d) {
+    types_[d.variable().get()] = d.ty();
+    auto p = get_properties(d.ty());
+    if (p.is_pointer && !p.is_array) {
+        return;
+    }
+    auto bytes = size_in_bytes(d.ty());
+    if (p.space == address_space::local_t) {
+        stats_.local_memory_bytes += bytes;
+    } else if (p.is_array &&
+               (p.space == address_space::generic_t || p.space == address_space::private_t)) {
+        stats_.private_array_bytes += bytes;
+    }
+}
+void statistics_counter::operator()(internal::declaration_assignment &d) {
+    (*this)(d.decl());
+    visit(*this, *d.rhs());
+}
+void statistics_counter::operator()(internal::expression_statement &e) { visit(*this, *e.term()); }
+void statistics_counter::operator()(internal::return_statement &e) { visit(*this, *e.term()); }
+void statistics_counter::operator()(internal::block &b) {
+    for (auto &s : b.stmts()) {
+        visit(*this, *s);
+    }
+}
+void statistics_counter::operator()(internal::for_loop &loop) {
+    visit(*this, *loop.start());
+    visit(*this, *loop.condition());
+    visit(*this, *loop.step());
+    visit(*this, *loop.body());
+}
+void statistics_counter::operator()(internal::if_selection &is) {
+    visit(*this, *is.condition());
+    visit(*this, *is.then());
+    if (is.otherwise()) {
+        visit(*this, **is.otherwise());
+    }
+}
+void statistics_counter::operator()(internal::while_loop &loop) {
+    visit(*this, *loop.condition());
+    visit(*this, *loop.body());
+}
+
+/* Kernel nodes */
+void statistics_counter::operator()(internal::prototype &proto) {
+    stats_.name = std::string(proto.name());
+    is_kernel_ = test(proto.qualifiers() & function_qualifier::kernel_t);
+    for (auto &[ty, v] : proto.args()) {
+        types_[v.get()] = ty;
+    }
+}
+void statistics_counter::operator()(internal::function &fn) {
+    stats_ = {};
+    visit(*this, *fn.prototype());
+    visit(*this, *fn.body());
+    if (is_kernel_) {
+        kernels_.emplace_back(stats_);
+    }
+    is_kernel_ = false;
+}
+void statistics_counter::operator()(internal::global_declaration &d) { visit(*this, *d.term()); }
+
+/* Program nodes */
+void statistics_counter::operator()(internal::program &prg) {
+    for (auto &d : prg.declarations()) {
+        visit(*this, *d);
+    }
+}
+
+auto get_kernel_statistics(func k) -> kernel_statistics {
+    auto c = statistics_counter{};
+    visit(c, *k);
+    return c.statistics();
+}
+auto get_kernel_statistics(prog p) -> std::vector<kernel_statistics> {
+    auto c = statistics_counter{};
+    visit(c, *p);
+    return c.kernels();
+}
+
+} // namespace clir
@@ -32,6 +32,9 @@ void required_extensions::operator()(internal::call_builtin &fn) {
         throw std::logic_error("Unknown extension");
     }
     needs_ext_[static_cast<int>(ext)] = true;
+    for (auto &arg : fn.args()) {
+        visit(*this, *arg);
+    }
 }
 void required_extensions::operator()(internal::call &fn) {
     for (auto &arg : fn.args()) {
@@ -47,6 +50,7 @@ void required_extensions::operator()(internal::declaration_assignment &d) {
     visit(*this, *d.rhs());
 }
 void required_extensions::operator()(internal::expression_statement &e) { visit(*this, *e.term()); }
+void required_extensions::operator()(internal::return_statement &e) { visit(*this, *e.term()); }
 void required_extensions::operator()(internal::block &b) {
     for (auto &s : b.stmts()) {
         visit(*this, *s);
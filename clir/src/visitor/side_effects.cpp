@@ -0,0 +1,103 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "side_effects.hpp"
+#include "clir/op.hpp"
+#include "clir/visit.hpp"
+
+#include <string_view>
+
+namespace clir {
+
+namespace {
+
+class side_effects {
+  public:
+    bool operator()(internal::expr_node &) { return false; }
+    bool operator()(internal::unary_op &e) {
+        switch (e.op()) {
+        case unary_operation::pre_increment:
+        case unary_operation::pre_decrement:
+        case unary_operation::post_increment:
+        case unary_operation::post_decrement:
+            return true;
+        default:
+            break;
+        }
+        return visit(*this, *e.term());
+    }
+    bool operator()(internal::binary_op &e) {
+        switch (e.op()) {
+        case binary_operation::assignment:
+        case binary_operation::add_into:
+        case binary_operation::subtract_from:
+        case binary_operation::multiply_into:
+        case binary_operation::divide_into:
+        case binary_operation::modulus_into:
+        case binary_operation::left_shift_by:
+        case binary_operation::right_shift_by:
+        case binary_operation::and_into:
+        case binary_operation::or_into:
+        case binary_operation::xor_into:
+            return true;
+        default:
+            break;
+        }
+        return visit(*this, *e.lhs()) || visit(*this, *e.rhs());
+    }
+    bool operator()(internal::ternary_op &e) {
+        return visit(*this, *e.term0()) || visit(*this, *e.term1()) || visit(*this, *e.term2());
+    }
+    bool operator()(internal::access &e) {
+        return visit(*this, *e.field()) || visit(*this, *e.address());
+    }
+    bool operator()(internal::call_builtin &fn) {
+        if (has_side_effects(fn.fn())) {
+            return true;
+        }
+        for (auto &arg : fn.args()) {
+            if (visit(*this, *arg)) {
+                return true;
+            }
+        }
+        return false;
+    }
+    bool operator()(internal::call &) { return true; }
+    bool operator()(internal::cast &c) { return visit(*this, *c.term()); }
+    bool operator()(internal::swizzle &s) { return visit(*this, *s.term()); }
+};
+
+bool starts_with(std::string_view str, std::string_view prefix) {
+    return str.substr(0, prefix.size()) == prefix;
+}
+
+} // namespace
+
+bool has_side_effects(internal::expr_node &e) { return visit(side_effects{}, e); }
+
+bool has_side_effects(builtin_function fn) {
+    switch (fn) {
+    case builtin_function::fract:
+    case builtin_function::frexp:
+    case builtin_function::lgamma_r:
+    case builtin_function::modf:
+    case builtin_function::remquo:
+    case builtin_function::sincos:
+    case builtin_function::barrier:
+    case builtin_function::work_group_barrier:
+    case builtin_function::sub_group_barrier:
+    case builtin_function::async_work_group_copy:
+    case builtin_function::async_work_group_strided_copy:
+    case builtin_function::wait_group_events:
+    case builtin_function::prefetch:
+    case builtin_function::printf:
+        return true;
+    default:
+        break;
+    }
+    auto const name = std::string_view(to_string(fn));
+    return starts_with(name, "vstore") || starts_with(name, "atomic_") ||
+           starts_with(name, "intel_sub_group_block_write");
+}
+
+} // namespace clir
@@ -0,0 +1,23 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef SIDE_EFFECTS_20240502_HPP
+#define SIDE_EFFECTS_20240502_HPP
+
+#include "clir/builtin_function.hpp"
+#include "clir/internal/expr_node.hpp"
+
+namespace clir {
+
+/**
+ * @brief Checks whether evaluating an expression modifies state
+ *
+ * Assignments, increments, calls of user functions, and builtins that write memory or
+ * synchronize (barriers, atomics, stores, printf, ...) have side effects. Loads do not.
+ */
+bool has_side_effects(internal::expr_node &e);
+bool has_side_effects(builtin_function fn);
+
+} // namespace clir
+
+#endif // SIDE_EFFECTS_20240502_HPP
@@ -0,0 +1,90 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "type_properties.hpp"
+#include "clir/internal/data_type_node.hpp"
+#include "clir/visit.hpp"
+
+namespace clir {
+
+namespace {
+
+class properties {
+  public:
+    auto operator()(internal::scalar_data_type &t) -> type_properties {
+        return {t.type(), 1, t.space()};
+    }
+    auto operator()(internal::vector_data_type &t) -> type_properties {
+        return {t.type(), t.size(), t.space()};
+    }
+    auto operator()(internal::pointer &t) -> type_properties {
+        return {builtin_type::void_t, 0, t.space(), true, false, t.ty()};
+    }
+    auto operator()(internal::array &t) -> type_properties {
+        auto p = t.ty() ? visit(*this, *t.ty()) : type_properties{};
+        p.is_pointer = true;
+        p.is_array = true;
+        p.element = t.ty();
+        return p;
+    }
+};
+
+class bytes {
+  public:
+    auto operator()(internal::scalar_data_type &t) -> std::size_t { return size_of(t.type()); }
+    auto operator()(internal::vector_data_type &t) -> std::size_t {
+        // 3-component vectors are aligned like 4-component vectors
+        return size_of(t.type()) * (t.size() == 3 ? 4 : t.size());
+    }
+    auto operator()(internal::pointer &) -> std::size_t { return 8; }
+    auto operator()(internal::array &t) -> std::size_t {
+        return t.ty() ? t.size() * visit(*this, *t.ty()) : 0;
+    }
+};
+
+} // namespace
+
+auto get_properties(data_type ty) -> type_properties {
+    return ty ? visit(properties{}, *ty) : type_properties{};
+}
+
+auto size_in_bytes(data_type ty) -> std::size_t { return ty ? visit(bytes{}, *ty) : 0; }
+
+auto size_of(builtin_type ty) -> std::size_t {
+    switch (ty) {
+    case builtin_type::bool_t:
+    case builtin_type::char_t:
+    case builtin_type::uchar_t:
+        return 1;
+    case builtin_type::short_t:
+    case builtin_type::ushort_t:
+    case builtin_type::half_t:
+        return 2;
+    case builtin_type::int_t:
+    case builtin_type::uint_t:
+    case builtin_type::float_t:
+        return 4;
+    case builtin_type::long_t:
+    case builtin_type::ulong_t:
+    case builtin_type::double_t:
+    case builtin_type::size_t:
+    case builtin_type::ptrdiff_t:
+    case builtin_type::intptr_t:
+    case builtin_type::uintptr_t:
+        return 8;
+    default:
+        break;
+    }
+    return 0;
+}
+
+bool is_floating(builtin_type ty) {
+    return ty == builtin_type::half_t || ty == builtin_type::float_t ||
+           ty == builtin_type::double_t;
+}
+
+auto make_type(builtin_type ty, short components) -> data_type {
+    return components > 1 ? data_type(ty, components) : data_type(ty);
+}
+
+} // namespace clir
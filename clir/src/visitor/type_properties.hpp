@@ -0,0 +1,37 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef TYPE_PROPERTIES_20240502_HPP
+#define TYPE_PROPERTIES_20240502_HPP
+
+#include "clir/builtin_type.hpp"
+#include "clir/data_type.hpp"
+
+#include <cstddef>
+
+namespace clir {
+
+/**
+ * @brief Flattened view of a data type
+ *
+ * Scalars have one component and pointers have zero components.
+ * Arrays report the properties of their innermost element type.
+ */
+struct type_properties {
+    builtin_type ty = builtin_type::void_t;
+    short components = 0;
+    address_space space = address_space::generic_t;
+    bool is_pointer = false; ///< True for pointers and arrays
+    bool is_array = false;
+    data_type element = {}; ///< Element type of pointers and arrays
+};
+
+auto get_properties(data_type ty) -> type_properties;
+auto size_in_bytes(data_type ty) -> std::size_t;
+auto size_of(builtin_type ty) -> std::size_t;
+bool is_floating(builtin_type ty);
+auto make_type(builtin_type ty, short components) -> data_type;
+
+} // namespace clir
+
+#endif // TYPE_PROPERTIES_20240502_HPP
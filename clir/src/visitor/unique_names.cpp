@@ -68,6 +68,7 @@ void unique_names::operator()(internal::declaration &d) { make_unique_name(d.var
 void unique_names::operator()(internal::declaration_assignment &d) { operator()(d.decl()); }
 
 void unique_names::operator()(internal::expression_statement &e) { visit(*this, *e.term()); }
+void unique_names::operator()(internal::return_statement &e) { visit(*this, *e.term()); }
 
 void unique_names::operator()(internal::block &b) {
     push_scope();
@@ -168,6 +168,11 @@ void unsafe_simplification::operator()(internal::expression_statement &e) {
         e.term(std::move(r));
     }
 }
+void unsafe_simplification::operator()(internal::return_statement &e) {
+    if (auto r = visit(*this, *e.term()); r) {
+        e.term(std::move(r));
+    }
+}
 
 void unsafe_simplification::operator()(internal::block &b) {
     for (auto &s : b.stmts()) {
@@ -0,0 +1,147 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "variable_usage.hpp"
+#include "clir/visit.hpp"
+
+namespace clir {
+
+namespace {
+
+class root_finder {
+  public:
+    auto operator()(internal::expr_node &) -> internal::expr_node * { return nullptr; }
+    auto operator()(internal::variable &v) -> internal::expr_node * { return &v; }
+    auto operator()(internal::access &a) -> internal::expr_node * {
+        return lvalue_root(*a.field());
+    }
+    auto operator()(internal::swizzle &s) -> internal::expr_node * {
+        return lvalue_root(*s.term());
+    }
+};
+
+} // namespace
+
+auto lvalue_root(internal::expr_node &e) -> internal::expr_node * {
+    return visit(root_finder{}, e);
+}
+
+bool is_assignment(binary_operation op) {
+    switch (op) {
+    case binary_operation::assignment:
+    case binary_operation::add_into:
+    case binary_operation::subtract_from:
+    case binary_operation::multiply_into:
+    case binary_operation::divide_into:
+    case binary_operation::modulus_into:
+    case binary_operation::left_shift_by:
+    case binary_operation::right_shift_by:
+    case binary_operation::and_into:
+    case binary_operation::or_into:
+    case binary_operation::xor_into:
+        return true;
+    default:
+        break;
+    }
+    return false;
+}
+
+variable_usage::variable_usage(set_t &assigned, set_t &element_stored, set_t *address_taken,
+                               set_t *decayed)
+    : assigned_(assigned), element_stored_(element_stored), address_taken_(address_taken),
+      decayed_(decayed) {}
+
+/* Expr nodes */
+void variable_usage::operator()(internal::expr_node &) {}
+void variable_usage::operator()(internal::variable &v) {
+    if (decayed_) {
+        decayed_->insert(&v);
+    }
+}
+void variable_usage::operator()(internal::unary_op &e) {
+    switch (e.op()) {
+    case unary_operation::address:
+        if (auto r = lvalue_root(*e.term()); r && address_taken_) {
+            address_taken_->insert(r);
+        }
+        break;
+    case unary_operation::pre_increment:
+    case unary_operation::pre_decrement:
+    case unary_operation::post_increment:
+    case unary_operation::post_decrement:
+        store(*e.term());
+        break;
+    default:
+        break;
+    }
+    visit(*this, *e.term());
+}
+void variable_usage::operator()(internal::binary_op &e) {
+    if (is_assignment(e.op())) {
+        store(*e.lhs());
+    }
+    visit(*this, *e.lhs());
+    visit(*this, *e.rhs());
+}
+void variable_usage::operator()(internal::ternary_op &e) {
+    visit(*this, *e.term0());
+    visit(*this, *e.term1());
+    visit(*this, *e.term2());
+}
+void variable_usage::operator()(internal::access &e) {
+    if (!dynamic_cast<internal::variable *>(e.field().get())) {
+        visit(*this, *e.field());
+    }
+    visit(*this, *e.address());
+}
+void variable_usage::operator()(internal::call_builtin &fn) {
+    for (auto &arg : fn.args()) {
+        visit(*this, *arg);
+    }
+}
+void variable_usage::operator()(internal::call &fn) {
+    for (auto &arg : fn.args()) {
+        visit(*this, *arg);
+    }
+}
+void variable_usage::operator()(internal::cast &c) { visit(*this, *c.term()); }
+void variable_usage::operator()(internal::swizzle &s) { visit(*this, *s.term()); }
+
+/* Stmt nodes */
+void variable_usage::operator()(internal::declaration &) {}
+void variable_usage::operator()(internal::declaration_assignment &d) { visit(*this, *d.rhs()); }
+void variable_usage::operator()(internal::expression_statement &e) { visit(*this, *e.term()); }
+void variable_usage::operator()(internal::return_statement &e) { visit(*this, *e.term()); }
+void variable_usage::operator()(internal::block &b) {
+    for (auto &s : b.stmts()) {
+        visit(*this, *s);
+    }
+}
+void variable_usage::operator()(internal::for_loop &loop) {
+    visit(*this, *loop.start());
+    visit(*this, *loop.condition());
+    visit(*this, *loop.step());
+    visit(*this, *loop.body());
+}
+void variable_usage::operator()(internal::if_selection &is) {
+    visit(*this, *is.condition());
+    visit(*this, *is.then());
+    if (is.otherwise()) {
+        visit(*this, **is.otherwise());
+    }
+}
+void variable_usage::operator()(internal::while_loop &loop) {
+    visit(*this, *loop.condition());
+    visit(*this, *loop.body());
+}
+
+void variable_usage::store(internal::expr_node &lhs) {
+    if (auto v = dynamic_cast<internal::variable *>(&lhs); v) {
+        assigned_.insert(v);
+    } else if (auto r = lvalue_root(lhs); r) {
+        auto s = dynamic_cast<internal::swizzle *>(&lhs);
+        (s && s->term().get() == r ? assigned_ : element_stored_).insert(r);
+    }
+}
+
+} // namespace clir
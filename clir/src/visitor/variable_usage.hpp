@@ -0,0 +1,67 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef VARIABLE_USAGE_20240502_HPP
+#define VARIABLE_USAGE_20240502_HPP
+
+#include "clir/internal/expr_node.hpp"
+#include "clir/internal/stmt_node.hpp"
+#include "clir/op.hpp"
+
+#include <unordered_set>
+
+namespace clir {
+
+//! Returns the variable that is modified when storing to e or nullptr if e is not rooted at one
+auto lvalue_root(internal::expr_node &e) -> internal::expr_node *;
+//! Checks whether op is = or a compound assignment
+bool is_assignment(binary_operation op);
+
+/**
+ * @brief Collects how variables are used
+ *
+ * Variables are recorded as assigned if they are the target of an assignment, increment or
+ * decrement, as element stored if one of their elements is assigned, as address taken if the
+ * address operator is applied, and as decayed if they appear other than as array of an access.
+ */
+class variable_usage {
+  public:
+    using set_t = std::unordered_set<internal::expr_node const *>;
+
+    variable_usage(set_t &assigned, set_t &element_stored, set_t *address_taken = nullptr,
+                   set_t *decayed = nullptr);
+
+    /* Expr nodes */
+    void operator()(internal::expr_node &);
+    void operator()(internal::variable &v);
+    void operator()(internal::unary_op &e);
+    void operator()(internal::binary_op &e);
+    void operator()(internal::ternary_op &e);
+    void operator()(internal::access &e);
+    void operator()(internal::call_builtin &fn);
+    void operator()(internal::call &fn);
+    void operator()(internal::cast &c);
+    void operator()(internal::swizzle &s);
+
+    /* Stmt nodes */
+    void operator()(internal::declaration &);
+    void operator()(internal::declaration_assignment &d);
+    void operator()(internal::expression_statement &e);
+    void operator()(internal::return_statement &e);
+    void operator()(internal::block &b);
+    void operator()(internal::for_loop &loop);
+    void operator()(internal::if_selection &is);
+    void operator()(internal::while_loop &loop);
+
+  private:
+    void store(internal::expr_node &lhs);
+
+    set_t &assigned_;
+    set_t &element_stored_;
+    set_t *address_taken_;
+    set_t *decayed_;
+};
+
+} // namespace clir
+
+#endif // VARIABLE_USAGE_20240502_HPP
@@ -1,6 +1,7 @@
 // Copyright (C) 2022 Intel Corporation
 // SPDX-License-Identifier: BSD-3-Clause
 
+#include "clir/attr_defs.hpp"
 #include "clir/builder.hpp"
 #include "clir/builtin_function.hpp"
 #include "clir/builtin_type.hpp"
@@ -10,16 +11,26 @@
 #include "clir/internal/function_node.hpp"
 #include "clir/visit.hpp"
 #include "clir/visitor/codegen_opencl.hpp"
+#include "clir/visitor/common_subexpression.hpp"
+#include "clir/visitor/constant_folding.hpp"
+#include "clir/visitor/dead_store.hpp"
 #include "clir/visitor/equal_expr.hpp"
+#include "clir/visitor/interpreter.hpp"
+#include "clir/visitor/kernel_statistics.hpp"
 #include "clir/visitor/required_extensions.hpp"
 #include "clir/visitor/to_imm.hpp"
 #include "clir/visitor/unsafe_simplification.hpp"
 
 #include "doctest/doctest.h"
 
+#include <array>
 #include <cstdint>
+#include <limits>
 #include <sstream>
+#include <stdexcept>
+#include <string>
 #include <variant>
+#include <vector>
 
 using namespace clir;
 
@@ -254,4 +265,285 @@ TEST_CASE("Required extensions") {
     CHECK(ext.size() == 2);
     CHECK(ext == std::vector<extension>{extension::cl_intel_subgroups,
                                         extension::cl_intel_subgroups_short});
+
+    // Extensions in the arguments of builtin functions
+    auto fb2 = function_builder("test2");
+    auto x = var("x");
+    fb2.argument(pointer_to(global_ushort()), x);
+    fb2.body([&](block_builder &bb) {
+        bb.add(vstore2(intel_convert_bfloat162_as_ushort2(vload2(0, x)), 0, x));
+    });
+    CHECK(get_required_extensions(fb2.get_product()) ==
+          std::vector<extension>{extension::cl_intel_bfloat16_conversions});
+}
+
+TEST_CASE("Kernel statistics") {
+    auto in = var("in");
+    auto out = var("out");
+    auto fb = kernel_builder("test");
+    fb.argument(pointer_to(global_float(2)), in);
+    fb.argument(pointer_to(global_float(2)), out);
+    fb.body([&](block_builder &bb) {
+        auto i = bb.declare_assign(generic_uint(), "i", get_sub_group_local_id());
+        auto x = bb.declare(array_of(generic_float(2), 4), "x");
+        auto s = bb.declare(array_of(local_float(2), 64), "s");
+        bb.assign(x[0], in[i]);
+        bb.assign(s[i], x[0] * 2.0f + x[1]);
+        bb.add(barrier(cl_mem_fence_flags::CLK_LOCAL_MEM_FENCE));
+        bb.assign(x[1], intel_sub_group_shuffle_xor(s[i + 1u], 1u));
+        bb.assign(out[i], fma(x[0], x[1], x[1]));
+        bb.add(add_into(out[i], x[1]));
+    });
+    auto stats = get_kernel_statistics(fb.get_product());
+    CHECK(stats.name == "test");
+    CHECK(stats.flops == 10);
+    CHECK(stats.global_loads == 2);
+    CHECK(stats.global_stores == 2);
+    CHECK(stats.local_loads == 1);
+    CHECK(stats.local_stores == 1);
+    CHECK(stats.barriers == 1);
+    CHECK(stats.sub_group_shuffles == 1);
+    CHECK(stats.private_array_bytes == 32);
+    CHECK(stats.local_memory_bytes == 512);
+}
+
+TEST_CASE("Constant folding") {
+    auto e2s = [](expr e) {
+        std::stringstream s;
+        generate_opencl(s, fold_constants(std::move(e)));
+        return s.str();
+    };
+    auto const long_max = std::numeric_limits<int64_t>::max();
+
+    CHECK(e2s(expr(2) * 3 + 4) == "10");
+    CHECK(e2s(expr(16) * expr(2u)) == "32u");
+    CHECK(e2s(expr(7) / 2 - (expr(1) << 3)) == "-5");
+    CHECK(e2s(expr(1) < expr(2)) == "1");
+    CHECK(e2s(expr(1.5f) * expr(2.0f)) == "0x1.8p+1f");
+    CHECK(e2s(-(-expr(3))) == "3");
+
+    /* Not representable or undefined */
+    CHECK(e2s(expr(long_max) + expr(int64_t(1), 64)).find(" + ") != std::string::npos);
+    CHECK(e2s(expr(-long_max) - expr(int64_t(2), 64)).find(" - ") != std::string::npos);
+    CHECK(e2s(expr(long_max) * expr(int64_t(-2), 64)).find(" * ") != std::string::npos);
+    CHECK(e2s(expr(long_max) - expr(int64_t(1), 64)) == e2s(expr(long_max - 1)));
+    CHECK(e2s(expr(1) / 0) == "1 / 0");
+    CHECK(e2s(expr(1) << 32) == "1 << 32");
+    CHECK(e2s(expr(1.5f) * expr(2.0)) == "0x1.8p+0f * 0x1p+1");
+
+    auto fb = kernel_builder("fold");
+    auto out = var("out");
+    auto a = var("a");
+    fb.argument(pointer_to(global_float(2)), out);
+    fb.argument(generic_int(), a);
+    fb.body([&](block_builder &bb) {
+        auto x = bb.declare_assign(generic_float(2), "x", out[0]);
+        bb.assign(out[(a + 2) - 1], x * -1.0f);
+        bb.assign(out[(2 * a) * 3], init_vector(generic_float(2), {x.s(0), x.s(1)}));
+        bb.assign(out[a + 0], x[0] + x[1] * -2.0f);
+    });
+    auto f = fb.get_product();
+    fold_constants(f);
+    std::stringstream s;
+    generate_opencl(s, f);
+    auto const code = s.str();
+    CHECK(code.find("out[a + 1] = -x;") != std::string::npos);
+    CHECK(code.find("out[a * 6] = x;") != std::string::npos);
+    CHECK(code.find("out[a] = x[0] - x[1] * 0x1p+1f;") != std::string::npos);
+}
+
+TEST_CASE("Common subexpression elimination") {
+    auto out = var("out");
+    auto a = var("a");
+    auto c = var("c");
+    auto fb = kernel_builder("cse");
+    fb.argument(pointer_to(global_int()), out);
+    fb.argument(generic_int(), a);
+    fb.argument(generic_int(), c);
+    fb.body([&](block_builder &bb) {
+        auto b = bb.declare_assign(generic_int(), "b", a * 3);
+        bb.assign(out[a * 16 + 1], out[a * 16]);
+        bb.assign(out[a * 3], b);
+        bb.assign(out[c * 7], 0);
+        bb.add(add_into(c, 1));
+        bb.assign(out[c * 7], 1);
+        bb.assign(out[0], ternary_conditional(a < c, a * 5, a * 5));
+        auto i = var("i");
+        bb.add(for_loop_builder(declaration_assignment(generic_int(), i, 0), i < 4, add_into(i, 1))
+                   .body([&](block_builder &bb) {
+                       bb.assign(out[a * 16 + i], i * 2);
+                       bb.assign(out[i * 2 + 1], 0);
+                   })
+                   .get_product());
+    });
+    auto f = fb.get_product();
+    eliminate_common_subexpressions(f);
+    std::stringstream s;
+    generate_opencl(s, f);
+    auto const code = s.str();
+    CHECK(code.find("int cse = a * 16;") != std::string::npos);
+    CHECK(code.find("out[cse + 1] = out[cse];") != std::string::npos);
+    CHECK(code.find("out[b] = b;") != std::string::npos);
+    CHECK(code.find("out[c * 7] = 0;") != std::string::npos);
+    CHECK(code.find("out[c * 7] = 1;") != std::string::npos);
+    CHECK(code.find("a * 5 : a * 5") != std::string::npos);
+    CHECK(code.find("out[cse + i] = ") != std::string::npos);
+    CHECK(code.find("out[cse1 + 1] = 0;") != std::string::npos);
+}
+
+TEST_CASE("Dead store elimination") {
+    auto out = var("out");
+    auto fb = kernel_builder("dse");
+    fb.argument(pointer_to(global_float()), out);
+    fb.body([&](block_builder &bb) {
+        auto x = bb.declare(array_of(generic_float(), 4), "x");
+        auto y = bb.declare(array_of(generic_float(), 2), "y");
+        auto t = bb.declare_assign(generic_float(), "t", out[0]);
+        bb.assign(x[0], out[1]);
+        bb.assign(x[1], out[2]);
+        bb.assign(x[3], out[3]);
+        bb.assign(y[0], x[0] + x[1]);
+        bb.assign(y[1], x[0] - x[1]);
+        bb.assign(x[0], y[0]);
+        bb.assign(x[0], x[0]);
+        bb.assign(x[2], t);
+        bb.assign(out[0], x[0]);
+        auto i = var("i");
+        bb.add(for_loop_builder(declaration_assignment(generic_int(), i, 0), i < 4, add_into(i, 1))
+                   .body([&](block_builder &bb) {
+                       bb.assign(out[i], x[3]);
+                       bb.assign(x[3], out[i + 1]);
+                   })
+                   .get_product());
+    });
+    auto f = fb.get_product();
+    eliminate_dead_stores(f);
+    std::stringstream s;
+    generate_opencl(s, f);
+    auto const code = s.str();
+    CHECK(code.find("x[0] = out[1];") != std::string::npos);
+    CHECK(code.find("y[0] = x[0] + x[1];") != std::string::npos);
+    CHECK(code.find("out[0] = y[0];") != std::string::npos);
+    CHECK(code.find("x[3] = out[3];") != std::string::npos);
+    CHECK(code.find("x[3] = out[i + 1];") != std::string::npos);
+    CHECK(code.find("y[1]") == std::string::npos);
+    CHECK(code.find("x[2]") == std::string::npos);
+    CHECK(code.find(" t") == std::string::npos);
+    CHECK(code.find("x[0] = y[0];") == std::string::npos);
+
+    // A dead initializer is removed but the declaration is kept for later assignments
+    auto fb2 = kernel_builder("dse_decl");
+    fb2.argument(pointer_to(global_float()), out);
+    fb2.body([&](block_builder &bb) {
+        auto a = bb.declare_assign(generic_float(), "a", out[0]);
+        auto b = bb.declare_assign(generic_float(), "b", a);
+        bb.assign(b, b + out[1]);
+        bb.assign(out[0], b);
+    });
+    f = fb2.get_product();
+    eliminate_dead_stores(f);
+    s = std::stringstream{};
+    generate_opencl(s, f);
+    auto const code2 = s.str();
+    CHECK(code2.find("float b;") != std::string::npos);
+    CHECK(code2.find("b = a + out[1];") != std::string::npos);
+}
+
+TEST_CASE("Interpreter") {
+    auto make_kernel = [](bool with_barrier) {
+        auto in = var("in");
+        auto out = var("out");
+        auto fb = kernel_builder("reverse");
+        fb.argument(pointer_to(global_float()), in);
+        fb.argument(pointer_to(global_float()), out);
+        fb.attribute(intel_reqd_sub_group_size(4));
+        fb.body([&](block_builder &bb) {
+            auto slm = bb.declare(array_of(local_float(), 8), "slm");
+            auto lid = bb.declare_assign(generic_int(), "lid", get_local_id(0));
+            auto gid = bb.declare_assign(generic_int(), "gid", get_global_id(0));
+            bb.assign(slm[lid], in[gid]);
+            if (with_barrier) {
+                bb.add(barrier(cl_mem_fence_flags::CLK_LOCAL_MEM_FENCE));
+            }
+            auto x = bb.declare_assign(generic_float(), "x", slm[7 - lid]);
+            auto y = bb.declare_assign(
+                generic_float(), "y",
+                intel_sub_group_shuffle(x, (get_sub_group_local_id() + 1) % 4));
+            bb.add(if_selection_builder(gid < 10)
+                       .then([&](block_builder &bb) { bb.assign(out[gid], x + 0.5f * y); })
+                       .get_product());
+        });
+        return fb.get_product();
+    };
+
+    auto in = std::vector<float>(16);
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        in[i] = static_cast<float>(i);
+    }
+    auto out = std::vector<float>(16, -1.0f);
+    auto run = [&](bool with_barrier) {
+        auto ip = interpreter(make_kernel(with_barrier));
+        float *in_ptr = in.data();
+        float *out_ptr = out.data();
+        ip.set_arg(0, sizeof(in_ptr), &in_ptr);
+        ip.set_arg(1, sizeof(out_ptr), &out_ptr);
+        ip.launch("reverse", {16, 1, 1}, {8, 1, 1});
+    };
+
+    run(true);
+    for (int i = 0; i < 16; ++i) {
+        auto const group = i / 8 * 8;
+        auto const x = static_cast<float>(group + 7 - i % 8);
+        auto const y = static_cast<float>(group + 7 - (i / 4 * 4 + (i + 1) % 4) % 8);
+        CHECK(out[i] == (i < 10 ? x + 0.5f * y : -1.0f));
+    }
+    CHECK_THROWS_AS(run(false), std::runtime_error);
+
+    auto f = kernel_builder("diverge");
+    auto p = var("p");
+    f.argument(pointer_to(global_int()), p);
+    f.body([&](block_builder &bb) {
+        bb.add(if_selection_builder(get_local_id(0) < 2)
+                   .then([&](block_builder &bb) {
+                       bb.add(barrier(cl_mem_fence_flags::CLK_LOCAL_MEM_FENCE));
+                   })
+                   .get_product());
+    });
+    auto ip = interpreter(f.get_product());
+    int *ptr = nullptr;
+    ip.set_arg(0, sizeof(ptr), &ptr);
+    CHECK_THROWS_AS(ip.launch("diverge", {4, 1, 1}, {4, 1, 1}), std::runtime_error);
+
+    auto x = var("x");
+    auto fn = function_builder("clamp_positive");
+    fn.return_type(generic_float());
+    fn.argument(generic_float(), x);
+    fn.body([&](block_builder &bb) {
+        bb.add(if_selection_builder(x < 0.0f)
+                   .then([&](block_builder &bb) { bb.return_value(0.0f); })
+                   .get_product());
+        bb.return_value(x);
+    });
+    auto k = kernel_builder("call");
+    auto q = var("q");
+    k.argument(pointer_to(global_float()), q);
+    k.body([&](block_builder &bb) {
+        auto i = bb.declare_assign(generic_int(), "i", get_global_id(0));
+        bb.assign(q[i], call("clamp_positive", {q[i] - 2.0f}));
+    });
+    auto pb = program_builder{};
+    pb.add(fn.get_product());
+    pb.add(k.get_product());
+    auto prg = pb.get_product();
+    std::stringstream code;
+    generate_opencl(code, prg);
+    CHECK(code.str().find("float clamp_positive(float x)") != std::string::npos);
+    CHECK(code.str().find("return x;") != std::string::npos);
+
+    auto data = std::vector<float>{0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+    auto ipr = interpreter(prg);
+    float *data_ptr = data.data();
+    ipr.set_arg(0, sizeof(data_ptr), &data_ptr);
+    ipr.launch("call", {6, 1, 1}, {3, 1, 1});
+    CHECK(data == std::vector<float>{0.0f, 0.0f, 0.0f, 1.0f, 2.0f, 3.0f});
 }
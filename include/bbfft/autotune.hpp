@@ -0,0 +1,87 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef AUTOTUNE_20240502_HPP
+#define AUTOTUNE_20240502_HPP
+
+#include "bbfft/configuration.hpp"
+#include "bbfft/device_info.hpp"
+#include "bbfft/export.hpp"
+
+#include <cstddef>
+#include <iosfwd>
+#include <vector>
+
+namespace bbfft {
+
+/**
+ * @brief Algorithm selected by a tuning candidate
+ */
+enum class BBFFT_EXPORT tuning_algorithm {
+    automatic,   ///< Heuristic algorithm and parameter selection
+    small_batch, ///< One DFT per work-item in registers
+    factor2_slm, ///< DFT split in two factors that are exchanged via shared local memory
+    subgroup     ///< One DFT per sub-group in registers that are exchanged via shuffles
+};
+
+/**
+ * @brief Kernel parameters of a 1d FFT that are subject to autotuning
+ *
+ * The default constructed candidate selects the heuristics.
+ */
+struct BBFFT_EXPORT tuning_candidate {
+    tuning_algorithm algorithm = tuning_algorithm::automatic; ///< Algorithm
+    std::size_t Mb = 0;             ///< M block size (not used by subgroup)
+    std::size_t Kb = 0;             ///< K block size
+    std::size_t Nb = 0;             ///< N block size (factor2_slm only)
+    std::size_t sgs = 0;            ///< Sub-group size
+    std::vector<int> factorization; ///< Factorization of the DFT length (factor2_slm only)
+
+    bool operator==(tuning_candidate const &other) const; ///< equality check
+    bool operator!=(tuning_candidate const &other) const; ///< inequality check
+};
+
+/**
+ * @brief Convert tuning candidate to string
+ *
+ * @param os output stream
+ * @param tc tuning candidate
+ *
+ * @return Reference to os
+ */
+BBFFT_EXPORT std::ostream &operator<<(std::ostream &os, tuning_candidate const &tc);
+
+/**
+ * @brief Tuning candidate that is selected by the heuristics
+ *
+ * An entry of the installed wisdom takes precedence over the heuristics.
+ *
+ * @param cfg configuration
+ * @param info Properties of target device
+ *
+ * @return Heuristic candidate; the automatic candidate if cfg cannot be tuned
+ */
+BBFFT_EXPORT auto default_tuning_candidate(configuration const &cfg, device_info const &info)
+    -> tuning_candidate;
+
+/**
+ * @brief Enumerate the kernel parameters that are tried by the autotuner
+ *
+ * The search space covers the small batch and the factor2 SLM algorithm for 1d c2c, r2c, and
+ * c2r FFTs without callbacks, and the sub-group algorithm where it is applicable. The
+ * candidates vary the sub-group size, the block sizes, and the factorization; every candidate
+ * respects the work-group size and shared local memory limits of the device. The heuristic
+ * candidate is always the first entry. An empty search space is returned if cfg cannot be
+ * tuned.
+ *
+ * @param cfg configuration
+ * @param info Properties of target device
+ *
+ * @return Tuning candidates
+ */
+BBFFT_EXPORT auto tuning_search_space(configuration const &cfg, device_info const &info)
+    -> std::vector<tuning_candidate>;
+
+} // namespace bbfft
+
+#endif // AUTOTUNE_20240502_HPP
@@ -4,16 +4,22 @@
 #ifndef CL_MAKE_PLAN_20221205_HPP
 #define CL_MAKE_PLAN_20221205_HPP
 
+#include "bbfft/autotune.hpp"
 #include "bbfft/configuration.hpp"
+#include "bbfft/convolution_configuration.hpp"
 #include "bbfft/export.hpp"
 #include "bbfft/jit_cache.hpp"
 #include "bbfft/plan.hpp"
+#include "bbfft/ragged_configuration.hpp"
 
 #include <CL/cl.h>
+#include <vector>
 
 namespace bbfft {
 
 using opencl_plan = plan<cl_event>;
+using opencl_convolution_plan = convolution_plan<cl_event>;
+using opencl_plan_group = plan_group<cl_event>;
 
 /**
  * @brief Create a plan for the configuration
@@ -40,6 +46,112 @@ BBFFT_EXPORT auto make_plan(configuration const &cfg, cl_command_queue queue,
 BBFFT_EXPORT auto make_plan(configuration const &cfg, cl_command_queue queue, cl_context context,
                             cl_device_id device, jit_cache *cache = nullptr) -> opencl_plan;
 
+/**
+ * @brief Create a plan with tuned kernel parameters
+ *
+ * @param cfg configuration
+ * @param tc tuning candidate, e.g. from the autotuner of the SYCL backend
+ * @param queue queue handle
+ * @param cache optional kernel cache
+ *
+ * @return plan
+ */
+BBFFT_EXPORT auto make_plan(configuration const &cfg, tuning_candidate const &tc,
+                            cl_command_queue queue, jit_cache *cache = nullptr) -> opencl_plan;
+/**
+ * @brief Create a plan with tuned kernel parameters
+ *
+ * @param cfg configuration
+ * @param tc tuning candidate, e.g. from the autotuner of the SYCL backend
+ * @param queue queue handle
+ * @param context context handle
+ * @param device device handle
+ * @param cache optional kernel cache
+ *
+ * @return plan
+ */
+BBFFT_EXPORT auto make_plan(configuration const &cfg, tuning_candidate const &tc,
+                            cl_command_queue queue, cl_context context, cl_device_id device,
+                            jit_cache *cache = nullptr) -> opencl_plan;
+
+/**
+ * @brief Create a plan for a ragged batch
+ *
+ * @param cfg ragged configuration
+ * @param queue queue handle
+ * @param cache optional kernel cache
+ *
+ * @return plan
+ */
+BBFFT_EXPORT auto make_plan(ragged_configuration const &cfg, cl_command_queue queue,
+                            jit_cache *cache = nullptr) -> opencl_plan;
+/**
+ * @brief Create a plan for a ragged batch
+ *
+ * @param cfg ragged configuration
+ * @param queue queue handle
+ * @param context context handle
+ * @param device device handle
+ * @param cache optional kernel cache
+ *
+ * @return plan
+ */
+BBFFT_EXPORT auto make_plan(ragged_configuration const &cfg, cl_command_queue queue,
+                            cl_context context, cl_device_id device, jit_cache *cache = nullptr)
+    -> opencl_plan;
+
+/**
+ * @brief Create a plan for a fused convolution
+ *
+ * @param cfg convolution configuration
+ * @param queue queue handle
+ * @param cache optional kernel cache
+ *
+ * @return convolution plan
+ */
+BBFFT_EXPORT auto make_plan(convolution_configuration const &cfg, cl_command_queue queue,
+                            jit_cache *cache = nullptr) -> opencl_convolution_plan;
+/**
+ * @brief Create a plan for a fused convolution
+ *
+ * @param cfg convolution configuration
+ * @param queue queue handle
+ * @param context context handle
+ * @param device device handle
+ * @param cache optional kernel cache
+ *
+ * @return convolution plan
+ */
+BBFFT_EXPORT auto make_plan(convolution_configuration const &cfg, cl_command_queue queue,
+                            cl_context context, cl_device_id device, jit_cache *cache = nullptr)
+    -> opencl_convolution_plan;
+
+/**
+ * @brief Create a plan group that computes the FFTs of all configurations with one kernel launch
+ *
+ * @param cfgs configurations of the members
+ * @param queue queue handle
+ * @param cache optional kernel cache
+ *
+ * @return plan group
+ */
+BBFFT_EXPORT auto make_plan_group(std::vector<configuration> const &cfgs, cl_command_queue queue,
+                                  jit_cache *cache = nullptr) -> opencl_plan_group;
+/**
+ * @brief Create a plan group that computes the FFTs of all configurations with one kernel launch
+ *
+ * @param cfgs configurations of the members
+ * @param queue queue handle
+ * @param context context handle
+ * @param device device handle
+ * @param cache optional kernel cache
+ *
+ * @return plan group
+ */
+BBFFT_EXPORT auto make_plan_group(std::vector<configuration> const &cfgs, cl_command_queue queue,
+                                  cl_context context, cl_device_id device,
+                                  jit_cache *cache = nullptr) -> opencl_plan_group;
+
 } // namespace bbfft
 
 #endif // CL_MAKE_PLAN_20221205_HPP
@@ -16,13 +16,37 @@ namespace bbfft {
 /**
  * @brief Floating-point precision
  *
- * The value is the number of bytes needed to store one floating-point number,
- * e.g. static_cast<int>(precision::f32) = 4.
+ * The lowest byte of the value is the number of bytes needed to store one floating-point number,
+ * e.g. static_cast<int>(precision::f32) = 4. Use size_in_bytes to query the storage size.
+ *
+ * The 16-bit precisions f16 and bf16 are storage precisions: input and output data is stored
+ * with 16 bits but the FFT is computed in single precision.
  */
 enum class precision : int {
-    f32 = 4, ///< 32-bit (single)
-    f64 = 8  ///< 64-bit (double)
+    f16 = 2,      ///< 16-bit (half) storage, 32-bit compute
+    bf16 = 0x102, ///< 16-bit (bfloat16) storage, 32-bit compute
+    f32 = 4,      ///< 32-bit (single)
+    f64 = 8       ///< 64-bit (double)
 };
+BBFFT_EXPORT char const *to_string(precision fp); ///< Convert precision to string
+/**
+ * @brief Number of bytes needed to store one floating-point number
+ *
+ * @param fp precision
+ *
+ * @return Storage size in bytes
+ */
+inline std::size_t size_in_bytes(precision fp) { return static_cast<int>(fp) & 0xff; }
+/**
+ * @brief Precision used for arithmetic
+ *
+ * @param fp precision
+ *
+ * @return f32 for the 16-bit storage precisions and fp otherwise
+ */
+inline precision compute_precision(precision fp) {
+    return fp == precision::f16 || fp == precision::bf16 ? precision::f32 : fp;
+}
 
 /**
  * @brief Convert C++ type to precision enum
@@ -74,13 +98,32 @@ enum class direction : int {
  *
  * In practice, input data is often real-valued. Optimised plans for real-valued input or output
  * data can be selected with transform_type.
+ *
+ * The real-to-real transforms follow the unnormalized conventions of FFTW (REDFT10, REDFT01,
+ * RODFT10, RODFT01). Type II transforms must use the forward direction and type III transforms
+ * must use the backward direction. Type III is the inverse of type II up to a factor of 2N.
  */
 enum class transform_type : int {
-    c2c, ///< complex input, complex output
-    r2c, ///< real input, complex output
-    c2r  ///< complex input, real input
+    c2c,  ///< complex input, complex output
+    r2c,  ///< real input, complex output
+    c2r,  ///< complex input, real input
+    dct2, ///< real input, real output, discrete cosine transform of type II
+    dct3, ///< real input, real output, discrete cosine transform of type III
+    dst2, ///< real input, real output, discrete sine transform of type II
+    dst3  ///< real input, real output, discrete sine transform of type III
 };
 BBFFT_EXPORT char const *to_string(transform_type type); ///< Convert transform type to string
+/**
+ * @brief Check whether transform type is a real-to-real transform
+ *
+ * @param type transform type
+ *
+ * @return True for DCT and DST types
+ */
+inline bool is_r2r(transform_type type) {
+    return type == transform_type::dct2 || type == transform_type::dct3 ||
+           type == transform_type::dst2 || type == transform_type::dst3;
+}
 
 /**
  * @brief Maximum supported FFT dimension
@@ -111,6 +154,8 @@ constexpr unsigned max_tensor_dim = max_fft_dim + 2;
  * computation goes according to the stride computation for c2c but with every instance of \f$N_1\f$
  * replaced with \f$N_1''\f$.
  *
+ * For **real-to-real** transforms the strides are the same as for c2c transforms.
+ *
  * @param dim FFT dimension
  * @param shape Input tensor Shape
  * @param type complex or real-valued FFT
@@ -165,19 +210,42 @@ struct BBFFT_EXPORT configuration {
                                   * \f[m s_0 + \sum_{i=1}^dn_i s_i + k s_{d+1},\f]
                                   * where \f$s_i\f$ are the entries of *istride*.
                                   * The offset is measured in real if the input tensor is real
-                                  * and measured in complex if the input tensor is complex.
-                                  *
-                                  * **Note:** \f$s_0\neq 1\f$ currently not supported. */
+                                  * and measured in complex if the input tensor is complex. */
     std::array<std::size_t, max_tensor_dim> ostride = default_ostride(
         dim, shape, type, true); /**< Stride used for address calculation of the output array.
                                   * For index \f$(m,n_1,...,n_d,k)\f$ the offset is calculated as
                                   * \f[m s_0 + \sum_{i=1}^dn_i s_i + k s_{d+1},\f]
                                   * where \f$s_i\f$ are the entries of *ostride*.
                                   * The offset is measured in real if the output tensor is real
-                                  * and measured in complex if the output tensor is complex.
-                                  *
-                                  * **Note:** \f$s_0\neq 1\f$ currently not supported. */
+                                  * and measured in complex if the output tensor is complex. */
     user_module callbacks = {};  ///< User-provided load and store functions
+    std::array<std::size_t, 2> planar_offset = {
+        0, 0}; /**< Split-complex (planar) layout of the complex input and output tensor.
+                * Entry 0 refers to the input tensor and entry 1 refers to the output tensor.
+                * Zero selects the interleaved layout. Otherwise, the real parts are stored at the
+                * pointer passed to execute and the imaginary parts are stored at the pointer
+                * plus planar_offset reals.
+                * Both parts are addressed with the same strides.
+                * The kernel receives the imaginary parts as separate pointer argument, hence
+                * the value of the offset does not affect the generated code.
+                *
+                * **Note:** Planar layouts are currently only supported for 1d FFTs without
+                * user callbacks. */
+    double scale = 1.0; /**< Factor that multiplies the result of the transform.
+                         * The factor is applied in registers before the result is stored, e.g.
+                         * set scale to 1/N to normalize the backward transform without an extra
+                         * pass over the output tensor. */
+    std::size_t input_length = 0; /**< Pruned input: only the first input_length points of the
+                                   * N_1-mode are read and the remaining points are taken as zero.
+                                   * Zero selects N_1. The strides are not modified, i.e. set
+                                   * istride accordingly if the input tensor is packed.
+                                   *
+                                   * **Note:** Pruning is currently only supported for 1d c2c
+                                   * FFTs that are computed by the small batch algorithm. */
+    std::size_t output_length = 0; /**< Pruned output: only the first output_length points of the
+                                    * N_1-mode are stored. Zero selects N_1. The strides are not
+                                    * modified, i.e. set ostride accordingly if the output tensor
+                                    * is packed. */
 
     /**
      * @brief Compute and set strides from shape assuming the default data layout.
@@ -0,0 +1,48 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef CONVOLUTION_CONFIGURATION_20240502_HPP
+#define CONVOLUTION_CONFIGURATION_20240502_HPP
+
+#include "bbfft/configuration.hpp"
+#include "bbfft/export.hpp"
+
+#include <array>
+#include <cstddef>
+
+namespace bbfft {
+
+/**
+ * @brief Point-wise operation applied to the spectra
+ */
+enum class convolution_type {
+    convolution = 0, ///< multiply signal spectrum with filter spectrum
+    correlation = 1  ///< multiply signal spectrum with complex conjugate of filter spectrum
+};
+
+/**
+ * @brief Configuration for batched circular convolution or correlation of complex signals
+ *
+ * The input tensor of shape M x N x K is transformed along the N-mode with the forward FFT,
+ * multiplied point-wise with the filter spectrum, and transformed back with the backward FFT.
+ * All three steps are computed in a single kernel.
+ * As with the plain FFTs the result is not normalized, i.e. it is N times the circular
+ * convolution; the factor 1/N can be folded into the filter spectrum.
+ *
+ * A real filter has a Hermitian spectrum, hence two real signals can be convolved with a real
+ * filter at once by storing them in the real and imaginary part of a complex signal.
+ *
+ * The filter spectrum, i.e. the N complex numbers of the forward DFT of the filter, is passed
+ * to execute together with the input and output tensor.
+ *
+ * Tensors are stored in packed column-major layout, i.e. with strides 1, M, and MN.
+ */
+struct BBFFT_EXPORT convolution_configuration {
+    precision fp;                     ///< Floating-point precision (f32 or f64)
+    std::array<std::size_t, 3> shape; ///< Tensor shape M x N x K
+    convolution_type type = convolution_type::convolution; ///< Convolution or correlation
+};
+
+} // namespace bbfft
+
+#endif // CONVOLUTION_CONFIGURATION_20240502_HPP
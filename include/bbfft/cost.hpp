@@ -0,0 +1,119 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef COST_20240502_HPP
+#define COST_20240502_HPP
+
+#include "bbfft/autotune.hpp"
+#include "bbfft/configuration.hpp"
+#include "bbfft/device_info.hpp"
+#include "bbfft/export.hpp"
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace bbfft {
+
+/**
+ * @brief Throughput of a device that converts a cost estimate to a run-time
+ *
+ * The defaults describe a data center GPU; only the ratios matter when costs are compared.
+ */
+struct BBFFT_EXPORT device_throughput {
+    double global_bandwidth = 1.0e12; ///< Global memory bandwidth in bytes per second
+    double slm_bandwidth = 1.0e13;    ///< Shared local memory bandwidth in bytes per second
+    double flop_rate = 2.0e13;        ///< Floating point operations per second
+    double launch_latency = 5.0e-6;   ///< Overhead per kernel launch in seconds
+};
+
+/**
+ * @brief Estimated resource usage of a single kernel launch
+ */
+struct BBFFT_EXPORT kernel_cost {
+    std::string name;                   ///< Kernel identifier
+    std::size_t global_bytes = 0;       ///< Bytes loaded from and stored to global memory
+    std::size_t slm_bytes = 0;          ///< Bytes stored to and loaded from shared local memory
+    double flops = 0.0;                 ///< Nominal floating point operation count
+    std::size_t register_bytes = 0;     ///< Register footprint of the FFT data per work-item
+    std::size_t spill_bytes = 0;        ///< Part of register_bytes that exceeds the register file
+    std::size_t work_group_size = 0;    ///< Number of work-items per work-group
+    std::size_t slm_per_work_group = 0; ///< Shared local memory per work-group in bytes
+    std::size_t num_work_groups = 0;    ///< Number of work-groups
+    double occupancy = 0.0; ///< Fraction of the work-items of a compute unit that are active
+};
+
+/**
+ * @brief Estimated cost of an FFT plan
+ *
+ * The aggregate functions sum up or combine the per-kernel estimates.
+ */
+struct BBFFT_EXPORT cost_estimate {
+    std::vector<kernel_cost> kernels; ///< One entry per kernel launch in execution order
+    std::size_t scratch_bytes = 0;    ///< Device memory allocated by the plan for temporaries
+
+    std::size_t global_bytes() const;   ///< Total global memory traffic in bytes
+    std::size_t slm_bytes() const;      ///< Total shared local memory traffic in bytes
+    double flops() const;               ///< Total nominal floating point operation count
+    std::size_t register_bytes() const; ///< Maximum register footprint per work-item
+    double occupancy() const;           ///< Minimum occupancy of all kernels
+    /**
+     * @brief Estimate the run-time with a roofline model
+     *
+     * The run-time of a kernel is the launch latency plus the maximum of the time spent on
+     * global memory traffic, shared local memory traffic, and floating point operations.
+     * Kernels with an occupancy below 1/2 are assumed to attain a proportionally smaller
+     * throughput.
+     *
+     * @param tp Throughput of the device
+     *
+     * @return Run-time in seconds
+     */
+    double time(device_throughput const &tp = {}) const;
+};
+
+/**
+ * @brief Estimate the cost of a plan without a device
+ *
+ * The estimate models the algorithm and the kernel parameters that make_plan selects for the
+ * device. Global memory traffic assumes that every tensor entry is transferred once per kernel
+ * and register spills are counted as additional global memory traffic. Flops are counted as
+ * 5 N log2(N) per complex FFT of length N (half of that for real FFTs) plus the point-wise
+ * operations of the algorithm.
+ *
+ * @param cfg configuration
+ * @param info Properties of target device
+ *
+ * @return Cost estimate
+ */
+BBFFT_EXPORT auto estimate_cost(configuration const &cfg, device_info const &info)
+    -> cost_estimate;
+
+/**
+ * @brief Estimate the cost of a plan with the kernel parameters of a tuning candidate
+ *
+ * @param cfg configuration
+ * @param info Properties of target device
+ * @param tc tuning candidate; the automatic candidate selects the heuristics
+ *
+ * @return Cost estimate
+ *
+ * @throws bad_configuration if the tuning candidate cannot be applied to the configuration
+ */
+BBFFT_EXPORT auto estimate_cost(configuration const &cfg, device_info const &info,
+                                tuning_candidate const &tc) -> cost_estimate;
+
+/**
+ * @brief Print cost estimate with one line per kernel
+ *
+ * @param os output stream
+ * @param cost cost estimate
+ *
+ * @return Reference to os
+ */
+BBFFT_EXPORT std::ostream &operator<<(std::ostream &os, cost_estimate const &cost);
+
+} // namespace bbfft
+
+#endif // COST_20240502_HPP
@@ -4,12 +4,16 @@
 #ifndef SMALL_BATCH_FFT_GENERATOR_20230202_HPP
 #define SMALL_BATCH_FFT_GENERATOR_20230202_HPP
 
+#include "bbfft/autotune.hpp"
 #include "bbfft/configuration.hpp"
+#include "bbfft/convolution_configuration.hpp"
 #include "bbfft/device_info.hpp"
 #include "bbfft/export.hpp"
+#include "bbfft/ragged_configuration.hpp"
 
 #include <algorithm>
 #include <array>
+#include <complex>
 #include <cstdint>
 #include <iosfwd>
 #include <string>
@@ -37,9 +41,34 @@ struct BBFFT_EXPORT small_batch_configuration {
     bool inplace_unsupported;            ///< true if inplace not available
     char const *load_function;           ///< user provided load callback name
     char const *store_function;          ///< user provided store callback name
+    std::array<std::size_t, 2u> planar_offset = {0, 0}; ///< non-zero selects the planar layout
+    double scale = 1.0;                                  ///< factor applied to the result
+    std::size_t input_length = 0;  ///< number of non-zero input points (0: N)
+    std::size_t output_length = 0; ///< number of stored output points (0: N)
 
     std::string identifier() const; ///< convert configuration to identification string
 };
+/**
+ * @brief Check whether the small batch algorithm should be used for a 1d FFT
+ *
+ * Returns true if one DFT per work-item fits into half of the register space.
+ *
+ * @param cfg configuration
+ * @param info Properties of target device
+ *
+ * @return True if small batch FFT is preferred
+ */
+BBFFT_EXPORT bool prefer_small_batch_fft(configuration const &cfg, device_info const &info);
+/**
+ * @brief Register space that the small batch algorithm requires per sub-group
+ *
+ * @param cfg configuration
+ * @param info Properties of target device
+ *
+ * @return Register space in bytes
+ */
+BBFFT_EXPORT std::size_t small_batch_register_space(configuration const &cfg,
+                                                    device_info const &info);
 /**
  * @brief Configure small batch FFT algorithm
  *
@@ -50,9 +79,24 @@ struct BBFFT_EXPORT small_batch_configuration {
  */
 BBFFT_EXPORT small_batch_configuration configure_small_batch_fft(configuration const &cfg,
                                                                  device_info const &info);
+/**
+ * @brief Configure small batch FFT algorithm with tuned parameters
+ *
+ * @param cfg configuration
+ * @param info Properties of target device
+ * @param tc Tuning candidate; must select the small batch algorithm
+ *
+ * @return small_batch_configuration
+ */
+BBFFT_EXPORT small_batch_configuration configure_small_batch_fft(configuration const &cfg,
+                                                                 device_info const &info,
+                                                                 tuning_candidate const &tc);
 /**
  * @brief Generate OpenCL C code for small batch FFT algorithm
  *
+ * The kernel takes the arguments in, out, and K. For planar tensors, the pointers in_im and
+ * out_im to the imaginary parts follow K.
+ *
  * @param os Output stream (e.g. std::cout)
  * @param cfg small batch configuration
  * @param name Override default kernel name
@@ -60,6 +104,40 @@ BBFFT_EXPORT small_batch_configuration configure_small_batch_fft(configuration c
 BBFFT_EXPORT void generate_small_batch_fft(std::ostream &os, small_batch_configuration const &cfg,
                                            std::string_view name = {});
 
+/**
+ * @brief Configuration for fused convolution with the small batch algorithm
+ *
+ * @attention Do not set values directly but use ::configure_convolution_fft
+ */
+struct BBFFT_EXPORT convolution_fft_configuration {
+    small_batch_configuration fft; ///< Configuration of the forward c2c FFT
+    convolution_type type;         ///< Convolution or correlation
+
+    std::string identifier() const; ///< convert configuration to identification string
+};
+/**
+ * @brief Configure fused convolution
+ *
+ * @param cfg convolution configuration
+ * @param info Properties of target device
+ *
+ * @return convolution_fft_configuration
+ */
+BBFFT_EXPORT convolution_fft_configuration
+configure_convolution_fft(convolution_configuration const &cfg, device_info const &info);
+/**
+ * @brief Generate OpenCL C code for fused convolution
+ *
+ * The kernel takes the arguments in, out, K, and filter.
+ *
+ * @param os Output stream (e.g. std::cout)
+ * @param cfg convolution configuration
+ * @param name Override default kernel name
+ */
+BBFFT_EXPORT void generate_convolution_fft(std::ostream &os,
+                                           convolution_fft_configuration const &cfg,
+                                           std::string_view name = {});
+
 /**
  * @brief Configuration for two factor FFT
  *
@@ -83,6 +161,8 @@ struct BBFFT_EXPORT factor2_slm_configuration {
     bool inplace_unsupported;            ///< true if inplace not available
     char const *load_function;           ///< user provided load callback name
     char const *store_function;          ///< user provided store callback name
+    std::array<std::size_t, 2u> planar_offset = {0, 0}; ///< non-zero selects the planar layout
+    double scale = 1.0;                                  ///< factor applied to the result
 
     std::string identifier() const; ///< convert configuration to identification string
 };
@@ -96,9 +176,37 @@ struct BBFFT_EXPORT factor2_slm_configuration {
  */
 BBFFT_EXPORT factor2_slm_configuration configure_factor2_slm_fft(configuration const &cfg,
                                                                  device_info const &info);
+/**
+ * @brief Configure two factor FFT algorithm with tuned parameters
+ *
+ * @param cfg configuration
+ * @param info Properties of target device
+ * @param tc Tuning candidate; must select the factor2 SLM algorithm
+ *
+ * @return factor2_slm_configuration
+ */
+BBFFT_EXPORT factor2_slm_configuration configure_factor2_slm_fft(configuration const &cfg,
+                                                                 device_info const &info,
+                                                                 tuning_candidate const &tc);
+/**
+ * @brief Compute the twiddle table for two factor FFT
+ *
+ * The table contains the twiddle factors of all factors but the first one, followed by
+ * the N twiddle factors of the real-to-complex pre- or post-processing if the transform is
+ * real and N is even.
+ *
+ * @param cfg two factor configuration
+ *
+ * @return Twiddle table
+ */
+BBFFT_EXPORT std::vector<std::complex<double>>
+factor2_slm_twiddle_table(factor2_slm_configuration const &cfg);
 /**
  * @brief Generate OpenCL C code for two factor FFT algorithm
  *
+ * The kernel takes the arguments in, out, twiddle, and K. For planar tensors, the pointers in_im
+ * and out_im to the imaginary parts follow K.
+ *
  * @param os Output stream (e.g. std::cout)
  * @param cfg small batch configuration
  * @param name Override default kernel name
@@ -106,6 +214,507 @@ BBFFT_EXPORT factor2_slm_configuration configure_factor2_slm_fft(configuration c
 BBFFT_EXPORT void generate_factor2_slm_fft(std::ostream &os, factor2_slm_configuration const &cfg,
                                            std::string_view name = {});
 
+/**
+ * @brief Configuration for ragged batch FFT
+ *
+ * Every work-group computes one record with the two factor FFT algorithm. The kernel contains
+ * one code path per transform length, selected with the length stored in the record.
+ *
+ * @attention Do not set values directly but use ::configure_ragged_batch_fft
+ */
+struct BBFFT_EXPORT ragged_batch_configuration {
+    int direction;                                ///< -1 or +1
+    std::vector<std::size_t> lengths;             ///< Transform lengths in ascending order
+    std::vector<std::vector<int>> factorizations; ///< Factorization of each transform length
+    std::size_t Nb;                               ///< Number of work-items per record
+    std::size_t sgs;                              ///< sub group size
+    precision fp;                                 ///< floating-point precision
+
+    std::string identifier() const; ///< convert configuration to identification string
+};
+/**
+ * @brief Configure ragged batch FFT algorithm
+ *
+ * @param cfg ragged configuration
+ * @param info Properties of target device
+ *
+ * @return ragged_batch_configuration
+ */
+BBFFT_EXPORT ragged_batch_configuration configure_ragged_batch_fft(ragged_configuration const &cfg,
+                                                                   device_info const &info);
+/**
+ * @brief Two factor configuration of the code path for the i-th transform length
+ *
+ * @param cfg ragged batch configuration
+ * @param i Index into lengths
+ *
+ * @return factor2_slm_configuration for a single record
+ */
+BBFFT_EXPORT factor2_slm_configuration
+ragged_batch_record_configuration(ragged_batch_configuration const &cfg, std::size_t i);
+/**
+ * @brief Compute the twiddle table for ragged batch FFT
+ *
+ * The table is the concatenation of the two factor twiddle tables of all transform lengths.
+ *
+ * @param cfg ragged batch configuration
+ *
+ * @return Twiddle table
+ */
+BBFFT_EXPORT std::vector<std::complex<double>>
+ragged_batch_twiddle_table(ragged_batch_configuration const &cfg);
+/**
+ * @brief Generate OpenCL C code for ragged batch FFT algorithm
+ *
+ * @param os Output stream (e.g. std::cout)
+ * @param cfg ragged batch configuration
+ * @param name Override default kernel name
+ */
+BBFFT_EXPORT void generate_ragged_batch_fft(std::ostream &os, ragged_batch_configuration const &cfg,
+                                            std::string_view name = {});
+
+/**
+ * @brief Configuration for a group of small batch FFTs
+ *
+ * The FFTs of all members are computed by a single kernel. All members share the work-group
+ * size Mb x Kb. The work-groups are enumerated along the third dimension; the first num_groups[0]
+ * work-groups compute the first member, the next num_groups[1] work-groups the second member,
+ * and so on.
+ *
+ * @attention Do not set values directly but use ::configure_plan_group_fft
+ */
+struct BBFFT_EXPORT plan_group_configuration {
+    std::vector<small_batch_configuration> members; ///< Small batch configuration of each member
+    std::vector<std::size_t> K;                     ///< Batch size of each member
+    std::vector<std::size_t> num_groups;            ///< Number of work-groups of each member
+
+    std::string identifier() const; ///< convert configuration to identification string
+};
+/**
+ * @brief Configure plan group
+ *
+ * Every configuration must be a 1d FFT that is computed with the small batch algorithm.
+ *
+ * @param cfgs configurations of the members
+ * @param info Properties of target device
+ *
+ * @return plan_group_configuration
+ */
+BBFFT_EXPORT plan_group_configuration
+configure_plan_group_fft(std::vector<configuration> const &cfgs, device_info const &info);
+/**
+ * @brief Generate OpenCL C code for a plan group
+ *
+ * The kernel takes the arguments in_0, out_0, K_0, in_1, out_1, K_1, ..., i.e. one pair of
+ * pointers and the batch size per member. Members with planar tensors additionally take in_im_i
+ * and out_im_i after K_i.
+ *
+ * @param os Output stream (e.g. std::cout)
+ * @param cfg plan group configuration
+ * @param name Override default kernel name
+ */
+BBFFT_EXPORT void generate_plan_group_fft(std::ostream &os, plan_group_configuration const &cfg,
+                                          std::string_view name = {});
+
+/**
+ * @brief Configuration for Bluestein FFT
+ *
+ * Bluestein's algorithm re-expresses a DFT of length N as a cyclic convolution of length L,
+ * where L is a power of two with L >= 2N-1.
+ * The convolution is evaluated with two c2c FFTs of length L that are planned separately;
+ * the pre-multiplication, the point-wise filter, and the post-multiplication with the chirp
+ * are generated here.
+ *
+ * @attention Do not set values directly but use ::configure_bluestein_fft
+ */
+struct BBFFT_EXPORT bluestein_configuration {
+    int direction;                       ///< -1 or +1
+    std::size_t M;                       ///< M
+    std::size_t Mb;                      ///< M block size
+    std::size_t N;                       ///< Number of points in DFT
+    std::size_t L;                       ///< Length of cyclic convolution (power of 2 >= 2N-1)
+    std::size_t Nb;                      ///< N block size
+    precision fp;                        ///< floating-point precision
+    transform_type type;                 ///< transform type (c2c, r2c, c2r)
+    std::array<std::size_t, 3u> istride; ///< stride of input tensor
+    std::array<std::size_t, 3u> ostride; ///< stride of output tensor
+    char const *load_function;           ///< user provided load callback name
+    char const *store_function;          ///< user provided store callback name
+    double scale = 1.0;                  ///< factor applied to the result
+
+    std::string identifier() const; ///< convert configuration to identification string
+};
+/**
+ * @brief Check whether Bluestein's algorithm should be used
+ *
+ * Returns true if the largest prime factor of the DFT length is too large to be computed in
+ * registers without spilling.
+ *
+ * @param cfg configuration
+ * @param info Properties of target device
+ *
+ * @return True if Bluestein FFT is preferred
+ */
+BBFFT_EXPORT bool prefer_bluestein_fft(configuration const &cfg, device_info const &info);
+/**
+ * @brief Configure Bluestein FFT algorithm
+ *
+ * @param cfg configuration
+ * @param info Properties of target device
+ *
+ * @return bluestein_configuration
+ */
+BBFFT_EXPORT bluestein_configuration configure_bluestein_fft(configuration const &cfg,
+                                                             device_info const &info);
+/**
+ * @brief Compute the twiddle table for Bluestein FFT
+ *
+ * The first N entries contain the chirp exp(direction * pi * i * n^2 / N) and the following L
+ * entries contain the DFT of the conjugate chirp, zero-padded to length L and scaled by 1/L.
+ *
+ * @param cfg Bluestein configuration
+ *
+ * @return Table of size N + L
+ */
+BBFFT_EXPORT std::vector<std::complex<double>>
+bluestein_twiddle_table(bluestein_configuration const &cfg);
+/**
+ * @brief Generate OpenCL C code for Bluestein FFT algorithm
+ *
+ * Generates the three kernels "<name>_pre", "<name>_mul", and "<name>_post".
+ *
+ * @param os Output stream (e.g. std::cout)
+ * @param cfg Bluestein configuration
+ * @param name Override default kernel name prefix
+ */
+BBFFT_EXPORT void generate_bluestein_fft(std::ostream &os, bluestein_configuration const &cfg,
+                                         std::string_view name = {});
+
+/**
+ * @brief Configuration for four-step FFT
+ *
+ * The FFT of length N = N1 * N2 is computed with two passes.
+ * The first pass computes N1 * M FFTs of length N2 and multiplies with twiddle factors.
+ * The second pass computes N2 * M FFTs of length N1.
+ * The twiddle multiplication and the transposition are fused into the first pass via
+ * a store callback.
+ *
+ * @attention Do not set values directly but use ::configure_four_step_fft
+ */
+struct BBFFT_EXPORT four_step_configuration {
+    int direction;  ///< -1 or +1
+    std::size_t M;  ///< M
+    std::size_t N1; ///< Length of FFTs in second pass
+    std::size_t N2; ///< Length of FFTs in first pass
+    precision fp;   ///< floating-point precision
+
+    std::string identifier() const; ///< convert configuration to identification string
+};
+/**
+ * @brief Check whether the four-step FFT should be used
+ *
+ * Returns true if a single FFT does not fit into shared local memory.
+ *
+ * @param cfg configuration
+ * @param info Properties of target device
+ *
+ * @return True if four-step FFT is preferred
+ */
+BBFFT_EXPORT bool prefer_four_step_fft(configuration const &cfg, device_info const &info);
+/**
+ * @brief Configure four-step FFT algorithm
+ *
+ * @param cfg configuration
+ * @param info Properties of target device
+ *
+ * @return four_step_configuration
+ */
+BBFFT_EXPORT four_step_configuration configure_four_step_fft(configuration const &cfg,
+                                                             device_info const &info);
+/**
+ * @brief Generate OpenCL C code for the store callback of the first pass
+ *
+ * The callback has the signature void name(global T2* out, size_t offset, T2 value) and is
+ * intended to be used as store_function of the first pass.
+ *
+ * @param os Output stream (e.g. std::cout)
+ * @param cfg four-step configuration
+ * @param name Override default callback name
+ */
+BBFFT_EXPORT void generate_four_step_fft_twiddle(std::ostream &os,
+                                                 four_step_configuration const &cfg,
+                                                 std::string_view name = {});
+
+/**
+ * @brief Configuration for sub-group FFT
+ *
+ * One DFT of length N = sgs * r is distributed over the lanes of a sub-group such that every
+ * lane holds r points in registers. The DFTs of length r are computed per lane; the DFTs of
+ * length sgs across the lanes exchange data with sub-group shuffles. Neither shared local memory
+ * nor barriers are used.
+ *
+ * @attention Do not set values directly but use ::configure_subgroup_fft
+ */
+struct BBFFT_EXPORT subgroup_configuration {
+    int direction;                       ///< -1 or +1
+    std::size_t N;                       ///< Number of points in DFT
+    std::size_t Kb;                      ///< Number of sub-groups per work-group
+    std::size_t sgs;                     ///< sub group size
+    precision fp;                        ///< floating-point precision
+    std::array<std::size_t, 3u> istride; ///< stride of input tensor
+    std::array<std::size_t, 3u> ostride; ///< stride of output tensor
+    double scale = 1.0;                  ///< factor applied to the result
+
+    std::string identifier() const; ///< convert configuration to identification string
+};
+/**
+ * @brief Check whether the sub-group FFT should be used
+ *
+ * Returns true for c2c FFTs with M = 1 if N = sgs * r for a sub-group size of the device and
+ * 2 <= r <= 16.
+ * Callbacks, the planar layout, 16-bit storage precisions, and pruning are not supported.
+ *
+ * @param cfg configuration
+ * @param info Properties of target device
+ *
+ * @return True if sub-group FFT is preferred
+ */
+BBFFT_EXPORT bool prefer_subgroup_fft(configuration const &cfg, device_info const &info);
+/**
+ * @brief Configure sub-group FFT algorithm
+ *
+ * @param cfg configuration
+ * @param info Properties of target device
+ *
+ * @return subgroup_configuration
+ */
+BBFFT_EXPORT subgroup_configuration configure_subgroup_fft(configuration const &cfg,
+                                                           device_info const &info);
+/**
+ * @brief Configure sub-group FFT algorithm with tuned parameters
+ *
+ * @param cfg configuration
+ * @param info Properties of target device
+ * @param tc Tuning candidate; must select the sub-group algorithm
+ *
+ * @return subgroup_configuration
+ */
+BBFFT_EXPORT subgroup_configuration configure_subgroup_fft(configuration const &cfg,
+                                                           device_info const &info,
+                                                           tuning_candidate const &tc);
+/**
+ * @brief Generate OpenCL C code for sub-group FFT algorithm
+ *
+ * @param os Output stream (e.g. std::cout)
+ * @param cfg sub-group configuration
+ * @param name Override default kernel name
+ */
+BBFFT_EXPORT void generate_subgroup_fft(std::ostream &os, subgroup_configuration const &cfg,
+                                        std::string_view name = {});
+
+/**
+ * @brief Algorithms for 1D FFTs
+ */
+enum class algorithm_1d { small_batch, factor2_slm, subgroup, bluestein, four_step };
+/**
+ * @brief Select the algorithm for a 1D FFT
+ *
+ * A tuned algorithm from the wisdom takes precedence over the prefer_* heuristics.
+ *
+ * @param cfg configuration
+ * @param info Properties of target device
+ *
+ * @return Algorithm
+ */
+BBFFT_EXPORT algorithm_1d select_algorithm_1d(configuration const &cfg, device_info const &info);
+
+/**
+ * @brief Configuration for multi-dimensional shared local memory FFT
+ *
+ * All FFT dimensions are computed in a single kernel. The work-group loads the
+ * whole N_1 x ... x N_d tensor into shared local memory and computes the 1D FFTs of each
+ * dimension in registers, separated by barriers.
+ *
+ * @attention Do not set values directly but use ::configure_nd_slm_fft
+ */
+struct BBFFT_EXPORT nd_slm_configuration {
+    int direction;                                   ///< -1 or +1
+    unsigned dim;                                    ///< FFT dimension
+    std::size_t M;                                   ///< M
+    std::size_t Mb;                                  ///< M block size
+    std::array<std::size_t, max_fft_dim> N;          ///< Number of points in DFT per dimension
+    std::size_t Nt;                                  ///< Number of work-items per M
+    std::size_t sgs;                                 ///< sub group size
+    precision fp;                                    ///< floating-point precision
+    std::array<std::size_t, max_tensor_dim> istride; ///< stride of input tensor
+    std::array<std::size_t, max_tensor_dim> ostride; ///< stride of output tensor
+    char const *load_function;                       ///< user provided load callback name
+    char const *store_function;                      ///< user provided store callback name
+    double scale = 1.0;                              ///< factor applied to the result
+
+    std::string identifier() const; ///< convert configuration to identification string
+};
+/**
+ * @brief Check whether the multi-dimensional shared local memory FFT is applicable
+ *
+ * Returns true for c2c FFTs with dim >= 2 if the whole transform fits into shared local memory
+ * and every 1D FFT fits into registers.
+ *
+ * @param cfg configuration
+ * @param info Properties of target device
+ *
+ * @return True if nd slm FFT is preferred
+ */
+BBFFT_EXPORT bool prefer_nd_slm_fft(configuration const &cfg, device_info const &info);
+/**
+ * @brief Configure multi-dimensional shared local memory FFT algorithm
+ *
+ * @param cfg configuration
+ * @param info Properties of target device
+ *
+ * @return nd_slm_configuration
+ */
+BBFFT_EXPORT nd_slm_configuration configure_nd_slm_fft(configuration const &cfg,
+                                                       device_info const &info);
+/**
+ * @brief Generate OpenCL C code for multi-dimensional shared local memory FFT algorithm
+ *
+ * @param os Output stream (e.g. std::cout)
+ * @param cfg nd slm configuration
+ * @param name Override default kernel name
+ */
+BBFFT_EXPORT void generate_nd_slm_fft(std::ostream &os, nd_slm_configuration const &cfg,
+                                      std::string_view name = {});
+
+/**
+ * @brief Configuration for callbacks that map the packed tensor layout to a strided layout
+ *
+ * The offset passed to the callback refers to the packed tensor of the given shape.
+ * The callback accesses the entry at the same multi-index in the tensor with the given stride.
+ * If user_function is set, then the user's load or store function is called with the strided
+ * offset instead of accessing the tensor directly.
+ */
+struct BBFFT_EXPORT layout_callback_configuration {
+    unsigned dim;                                   ///< FFT dimension
+    std::array<std::size_t, max_tensor_dim> shape;  ///< packed shape (M, N_1, ..., N_d, K)
+    std::array<std::size_t, max_tensor_dim> stride; ///< stride of the strided tensor
+    precision fp;                                   ///< floating-point precision
+    bool is_complex;                                ///< true if tensor entries are complex
+    char const *user_function = nullptr;            ///< user provided load or store callback name
+
+    std::string identifier() const; ///< convert configuration to identification string
+};
+/**
+ * @brief Generate OpenCL C code for a load callback that reads from a strided tensor
+ *
+ * @param os Output stream (e.g. std::cout)
+ * @param cfg layout callback configuration
+ * @param name Override default callback name
+ */
+BBFFT_EXPORT void generate_layout_load_callback(std::ostream &os,
+                                                layout_callback_configuration const &cfg,
+                                                std::string_view name = {});
+/**
+ * @brief Generate OpenCL C code for a store callback that writes to a strided tensor
+ *
+ * @param os Output stream (e.g. std::cout)
+ * @param cfg layout callback configuration
+ * @param name Override default callback name
+ */
+BBFFT_EXPORT void generate_layout_store_callback(std::ostream &os,
+                                                 layout_callback_configuration const &cfg,
+                                                 std::string_view name = {});
+
+/**
+ * @brief Configuration for multi-dimensional FFT with one pass of 1D FFTs per dimension
+ *
+ * Intermediate results are stored in the packed out-of-place layout. Strided input and output
+ * tensors are read in the first pass and written in the last pass through layout callbacks.
+ *
+ * @attention Do not set values directly but use ::configure_nd_fft
+ */
+struct BBFFT_EXPORT nd_fft_configuration {
+    unsigned dim;                                  ///< FFT dimension
+    std::array<configuration, max_fft_dim> passes; ///< 1D FFTs in execution order
+    bool load_layout;                              ///< true if the first pass reads through lin
+    bool store_layout;                             ///< true if the last pass writes through lout
+    layout_callback_configuration lin;             ///< layout of the input tensor
+    layout_callback_configuration lout;            ///< layout of the output tensor
+    std::size_t scratch_bytes; ///< size of temporary buffer (0: output buffer holds temporaries)
+};
+/**
+ * @brief Configure multi-dimensional FFT with one pass per dimension
+ *
+ * The passes do not have callbacks; the user's load callback and the input layout callback
+ * belong to the first pass and the user's store callback and the output layout callback belong
+ * to the last pass.
+ *
+ * @param cfg configuration
+ *
+ * @return nd_fft_configuration
+ */
+BBFFT_EXPORT nd_fft_configuration configure_nd_fft(configuration const &cfg);
+
+/**
+ * @brief Configuration for real-to-real transforms
+ *
+ * Type II transforms are computed with an r2c FFT and type III transforms are computed
+ * with a c2r FFT of the same length. The pre-processing is fused into the load callback
+ * and the post-processing is fused into the store callback of the real FFT.
+ *
+ * @attention Do not set values directly but use ::configure_r2r_fft
+ */
+struct BBFFT_EXPORT r2r_configuration {
+    transform_type type;                ///< dct2, dct3, dst2, or dst3
+    std::size_t M;                      ///< M
+    std::size_t N;                      ///< Number of points in transform
+    precision fp;                       ///< floating-point precision
+    std::array<std::size_t, 3> istride; ///< stride of input tensor
+    std::array<std::size_t, 3> ostride; ///< stride of output tensor
+    char const *load_function;          ///< user provided load callback name
+    char const *store_function;         ///< user provided store callback name
+
+    std::string identifier() const; ///< convert configuration to identification string
+};
+/**
+ * @brief Configure real-to-real transform
+ *
+ * @param cfg configuration
+ *
+ * @return r2r_configuration
+ */
+BBFFT_EXPORT r2r_configuration configure_r2r_fft(configuration const &cfg);
+/**
+ * @brief Configuration of the real FFT used to compute the real-to-real transform
+ *
+ * The returned configuration has packed strides and no callbacks.
+ *
+ * @param cfg r2r configuration
+ * @param K Size of K-mode
+ *
+ * @return r2c configuration for type II and c2r configuration for type III
+ */
+BBFFT_EXPORT configuration r2r_fft_inner_configuration(r2r_configuration const &cfg,
+                                                       std::size_t K);
+/**
+ * @brief Generate OpenCL C code for the load callback of a real-to-real transform
+ *
+ * @param os Output stream (e.g. std::cout)
+ * @param cfg r2r configuration
+ * @param name Override default callback name
+ */
+BBFFT_EXPORT void generate_r2r_load_callback(std::ostream &os, r2r_configuration const &cfg,
+                                             std::string_view name = {});
+/**
+ * @brief Generate OpenCL C code for the store callback of a real-to-real transform
+ *
+ * @param os Output stream (e.g. std::cout)
+ * @param cfg r2r configuration
+ * @param name Override default callback name
+ */
+BBFFT_EXPORT void generate_r2r_store_callback(std::ostream &os, r2r_configuration const &cfg,
+                                              std::string_view name = {});
+
 } // namespace bbfft
 
 #endif // SMALL_BATCH_FFT_GENERATOR_20230202_HPP
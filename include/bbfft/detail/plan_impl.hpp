@@ -89,6 +89,115 @@ template <typename EventT> class plan_unmanaged_event_impl {
     virtual void execute(void const *in, void *out, event_t signal_event,
                          std::uint32_t num_wait_events, event_t *wait_events) = 0;
 };
+
+/**
+ * @brief Interface for convolution plan implementations
+ *
+ * @tparam EventT Event type of underlying run-time
+ */
+template <typename EventT> class convolution_plan_impl {
+  public:
+    using event_t = EventT; ///< event type
+    /**
+     * @brief Dtor
+     */
+    virtual ~convolution_plan_impl() {}
+
+    /**
+     * @brief Execute convolution plan
+     *
+     * @param in Pointer to input tensor
+     * @param filter Pointer to filter spectrum
+     * @param out Pointer to output tensor
+     * @param dep_events Events to wait on before launching
+     *
+     * @return Completion event
+     */
+    virtual auto execute(void const *in, void const *filter, void *out,
+                         std::vector<event_t> const &dep_events) -> event_t = 0;
+};
+
+/**
+ * @brief Interface for convolution plan implementations with unmanaged events
+ *
+ * @tparam EventT Event type of underlying run-time
+ */
+template <typename EventT> class convolution_plan_unmanaged_event_impl {
+  public:
+    using event_t = EventT; ///< event type
+    /**
+     * @brief Dtor
+     */
+    virtual ~convolution_plan_unmanaged_event_impl() {}
+
+    /**
+     * @brief Execute convolution plan
+     *
+     * @param in Pointer to input tensor
+     * @param filter Pointer to filter spectrum
+     * @param out Pointer to output tensor
+     * @param signal_event Event signaled on completion [Optional]
+     * @param num_wait_events Number of events to wait on before launch; must be zero if wait_events
+     * == nullptr [Optional]
+     * @param wait_events Pointer to events to wait on before launch; must point to at least
+     * num_wait_events [Optional]
+     */
+    virtual void execute(void const *in, void const *filter, void *out, event_t signal_event,
+                         std::uint32_t num_wait_events, event_t *wait_events) = 0;
+};
+
+/**
+ * @brief Interface for plan group implementations
+ *
+ * @tparam EventT Event type of underlying run-time
+ */
+template <typename EventT> class plan_group_impl {
+  public:
+    using event_t = EventT; ///< event type
+    /**
+     * @brief Dtor
+     */
+    virtual ~plan_group_impl() {}
+
+    /**
+     * @brief Execute plan group
+     *
+     * @param args Pointers to input and output tensor of every member
+     * @param dep_events Events to wait on before launching
+     *
+     * @return Completion event
+     */
+    virtual auto execute(std::vector<std::pair<void const *, void *>> const &args,
+                         std::vector<event_t> const &dep_events) -> event_t = 0;
+};
+
+/**
+ * @brief Interface for plan group implementations with unmanaged events
+ *
+ * @tparam EventT Event type of underlying run-time
+ */
+template <typename EventT> class plan_group_unmanaged_event_impl {
+  public:
+    using event_t = EventT; ///< event type
+    /**
+     * @brief Dtor
+     */
+    virtual ~plan_group_unmanaged_event_impl() {}
+
+    /**
+     * @brief Execute plan group
+     *
+     * @param args Pointers to input and output tensor of every member
+     * @param signal_event Event signaled on FFT completion [Optional]
+     * @param num_wait_events Number of events to wait on before launch; must be zero if wait_events
+     * == nullptr [Optional]
+     * @param wait_events Pointer to events to wait on before launch; must point to at least
+     * num_wait_events [Optional]
+     */
+    virtual void execute(std::vector<std::pair<void const *, void *>> const &args,
+                         event_t signal_event, std::uint32_t num_wait_events,
+                         event_t *wait_events) = 0;
+};
 } // namespace detail
 } // namespace bbfft
 
@@ -8,12 +8,32 @@
 #include "bbfft/device_info.hpp"
 #include "bbfft/export.hpp"
 
+#include <cstddef>
 #include <iosfwd>
 #include <string>
 #include <vector>
 
 namespace bbfft {
 
+/**
+ * @brief Static operation counts of a generated kernel
+ *
+ * Every operation is counted once per occurrence in the kernel source, that is, loop bodies are not
+ * multiplied by their trip count. Flops are counted per vector component.
+ */
+struct BBFFT_EXPORT kernel_statistics {
+    std::string name;                    ///< Kernel name
+    std::size_t flops = 0;               ///< Floating point operations
+    std::size_t global_loads = 0;        ///< Loads from global or constant memory
+    std::size_t global_stores = 0;       ///< Stores to global memory
+    std::size_t local_loads = 0;         ///< Loads from shared local memory
+    std::size_t local_stores = 0;        ///< Stores to shared local memory
+    std::size_t barriers = 0;            ///< Work-group barriers
+    std::size_t sub_group_shuffles = 0;  ///< Sub-group shuffles and broadcasts
+    std::size_t private_array_bytes = 0; ///< Bytes of arrays declared in private memory
+    std::size_t local_memory_bytes = 0;  ///< Shared local memory per work-group in bytes
+};
+
 /**
  * @brief Generate FFT kernel code for configuration and device
  *
@@ -27,6 +47,30 @@ BBFFT_EXPORT std::vector<std::string> generate_fft_kernels(std::ostream &os,
                                                            std::vector<configuration> const &cfgs,
                                                            device_info const &info);
 
+/**
+ * @brief Static statistics of the FFT kernels for configuration and device
+ *
+ * The kernels are the ones generate_fft_kernels emits for the same arguments.
+ *
+ * @param cfgs configurations
+ * @param info Properties of target device
+ *
+ * @return One entry per kernel
+ */
+BBFFT_EXPORT auto generate_fft_kernel_statistics(std::vector<configuration> const &cfgs,
+                                                 device_info const &info)
+    -> std::vector<kernel_statistics>;
+
+/**
+ * @brief Print kernel statistics in a single line
+ *
+ * @param os output stream
+ * @param stats kernel statistics
+ *
+ * @return Reference to os
+ */
+BBFFT_EXPORT std::ostream &operator<<(std::ostream &os, kernel_statistics const &stats);
+
 } // namespace bbfft
 
 #endif // GENERATOR_20230202_HPP
@@ -4,6 +4,7 @@
 #ifndef PARSER_20230419_HPP
 #define PARSER_20230419_HPP
 
+#include "bbfft/autotune.hpp"
 #include "bbfft/configuration.hpp"
 #include "bbfft/device_info.hpp"
 #include "bbfft/export.hpp"
@@ -32,6 +33,16 @@ BBFFT_EXPORT configuration parse_fft_descriptor(std::string_view desc);
  * @return device info
  */
 BBFFT_EXPORT device_info parse_device_info(std::string_view desc);
+/**
+ * @brief Parses a tuning candidate
+ *
+ * Accepts the output format of operator<<(std::ostream&, tuning_candidate const&)
+ *
+ * @param desc descriptor
+ *
+ * @return tuning candidate
+ */
+BBFFT_EXPORT tuning_candidate parse_tuning_candidate(std::string_view desc);
 
 } // namespace bbfft
 
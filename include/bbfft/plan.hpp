@@ -183,6 +183,191 @@ class plan_unmanaged_event : public base_plan<detail::plan_unmanaged_event_impl<
     }
 };
 
+/**
+ * @brief A convolution plan computes batched circular convolutions with a single kernel launch.
+ *
+ * The filter spectrum is an argument of execute, hence one plan serves any number of filters.
+ * Convolution plan objects are not created directly but via ::make_plan.
+ *
+ * @tparam EventT event type of the compute runtime
+ */
+template <typename EventT>
+class convolution_plan : public base_plan<detail::convolution_plan_impl<EventT>> {
+  public:
+    using base_plan<detail::convolution_plan_impl<EventT>>::base_plan;
+
+    /**
+     * @brief Event type returned by execute functions
+     */
+    using event_t = EventT;
+
+    /**
+     * @brief Execute plan (out-of-place)
+     *
+     * @param in Pointer to input tensor
+     * @param filter Pointer to the N complex numbers of the filter spectrum
+     * @param out Pointer to output tensor
+     * @param dep_events Events to wait on before launching
+     *
+     * @return Completion event
+     */
+    auto execute(void const *in, void const *filter, void *out,
+                 std::vector<event_t> const &dep_events = {}) -> event_t {
+        return this->impl_->execute(in, filter, out, dep_events);
+    }
+    /**
+     * @brief Execute plan (out-of-place)
+     *
+     * @param in Pointer to input tensor
+     * @param filter Pointer to the N complex numbers of the filter spectrum
+     * @param out Pointer to output tensor
+     * @param dep_event Event to wait on before launching
+     *
+     * @return Completion event
+     */
+    auto execute(void const *in, void const *filter, void *out, event_t dep_event) -> event_t {
+        return this->impl_->execute(in, filter, out, std::vector<event_t>{std::move(dep_event)});
+    }
+    /**
+     * @brief Execute plan (in-place)
+     *
+     * @param inout Pointer to input and output tensor
+     * @param filter Pointer to the N complex numbers of the filter spectrum
+     * @param dep_events Events to wait on before launching
+     *
+     * @return Completion event
+     */
+    auto execute(void *inout, void const *filter, std::vector<event_t> const &dep_events = {})
+        -> event_t {
+        return this->impl_->execute(inout, filter, inout, dep_events);
+    }
+};
+
+/**
+ * @brief Convolution plan with unmanaged events
+ *
+ * @tparam EventT event type of the compute runtime
+ */
+template <typename EventT>
+class convolution_plan_unmanaged_event
+    : public base_plan<detail::convolution_plan_unmanaged_event_impl<EventT>> {
+  public:
+    using base_plan<detail::convolution_plan_unmanaged_event_impl<EventT>>::base_plan;
+
+    /**
+     * @brief Event type returned by execute functions
+     */
+    using event_t = EventT;
+
+    /**
+     * @brief Execute plan (out-of-place)
+     *
+     * @param in Pointer to input tensor
+     * @param filter Pointer to the N complex numbers of the filter spectrum
+     * @param out Pointer to output tensor
+     * @param signal_event Event signaled on completion [Optional]
+     * @param num_wait_events Number of events to wait on before launch; must be zero if wait_events
+     * == nullptr [Optional]
+     * @param wait_events Pointer to events to wait on before launch; must point to at least
+     * num_wait_events [Optional]
+     */
+    void execute(void const *in, void const *filter, void *out, event_t signal_event = nullptr,
+                 std::uint32_t num_wait_events = 0, event_t *wait_events = nullptr) {
+        this->impl_->execute(in, filter, out, signal_event, num_wait_events, wait_events);
+    }
+    /**
+     * @brief Execute plan (in-place)
+     *
+     * @param inout Pointer to input and output tensor
+     * @param filter Pointer to the N complex numbers of the filter spectrum
+     * @param signal_event Event signaled on completion [Optional]
+     * @param num_wait_events Number of events to wait on before launch; must be zero if wait_events
+     * == nullptr [Optional]
+     * @param wait_events Pointer to events to wait on before launch; must point to at least
+     * num_wait_events [Optional]
+     */
+    void execute(void *inout, void const *filter, event_t signal_event = nullptr,
+                 std::uint32_t num_wait_events = 0, event_t *wait_events = nullptr) {
+        this->impl_->execute(inout, filter, inout, signal_event, num_wait_events, wait_events);
+    }
+};
+
+/**
+ * @brief A plan group computes the FFTs of several configurations with a single kernel launch.
+ *
+ * Plan group objects are not created directly but via ::make_plan_group.
+ *
+ * @tparam EventT event type of the compute runtime
+ */
+template <typename EventT> class plan_group : public base_plan<detail::plan_group_impl<EventT>> {
+  public:
+    using base_plan<detail::plan_group_impl<EventT>>::base_plan;
+
+    /**
+     * @brief Event type returned by execute functions
+     */
+    using event_t = EventT;
+
+    /**
+     * @brief Execute plan group
+     *
+     * @param args Pointers to input and output tensor of every member, in the order of the
+     * configurations passed to ::make_plan_group; set both pointers equal for in-place transforms
+     * @param dep_events Events to wait on before launching
+     *
+     * @return Completion event
+     */
+    auto execute(std::vector<std::pair<void const *, void *>> const &args,
+                 std::vector<event_t> const &dep_events = {}) -> event_t {
+        return this->impl_->execute(args, dep_events);
+    }
+    /**
+     * @brief Execute plan group
+     *
+     * @param args Pointers to input and output tensor of every member
+     * @param dep_event Event to wait on before launching
+     *
+     * @return Completion event
+     */
+    auto execute(std::vector<std::pair<void const *, void *>> const &args, event_t dep_event)
+        -> event_t {
+        return this->impl_->execute(args, std::vector<event_t>{std::move(dep_event)});
+    }
+};
+
+/**
+ * @brief Plan group with unmanaged events
+ *
+ * @tparam EventT event type of the compute runtime
+ */
+template <typename EventT>
+class plan_group_unmanaged_event
+    : public base_plan<detail::plan_group_unmanaged_event_impl<EventT>> {
+  public:
+    using base_plan<detail::plan_group_unmanaged_event_impl<EventT>>::base_plan;
+
+    /**
+     * @brief Event type returned by execute functions
+     */
+    using event_t = EventT;
+
+    /**
+     * @brief Execute plan group
+     *
+     * @param args Pointers to input and output tensor of every member
+     * @param signal_event Event signaled on FFT completion [Optional]
+     * @param num_wait_events Number of events to wait on before launch; must be zero if wait_events
+     * == nullptr [Optional]
+     * @param wait_events Pointer to events to wait on before launch; must point to at least
+     * num_wait_events [Optional]
+     */
+    void execute(std::vector<std::pair<void const *, void *>> const &args,
+                 event_t signal_event = nullptr, std::uint32_t num_wait_events = 0,
+                 event_t *wait_events = nullptr) {
+        this->impl_->execute(args, signal_event, num_wait_events, wait_events);
+    }
+};
+
 } // namespace bbfft
 
 #endif // PLAN_20220412_HPP
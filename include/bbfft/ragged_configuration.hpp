@@ -0,0 +1,48 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef RAGGED_CONFIGURATION_20240502_HPP
+#define RAGGED_CONFIGURATION_20240502_HPP
+
+#include "bbfft/configuration.hpp"
+#include "bbfft/export.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bbfft {
+
+/**
+ * @brief Describes one transform of a ragged batch
+ *
+ * The transform reads the N complex numbers starting at in + offset and writes the N complex
+ * numbers starting at out + offset, where in and out are the pointers passed to execute.
+ */
+struct ragged_record {
+    std::uint64_t offset; ///< Offset of the first entry, measured in complex numbers
+    std::uint64_t N;      ///< Transform length; must be one of the lengths of the configuration
+};
+
+/**
+ * @brief Configuration for a batch of 1d c2c FFTs with variable transform lengths
+ *
+ * All transforms of the batch are computed with a single kernel launch.
+ * The set of possible transform lengths is fixed when the plan is created, whereas the records
+ * are read from device memory whenever the plan is executed. Thus, the records may be updated
+ * between executions as long as their number does not change.
+ *
+ * Each work-group computes one record, hence the work-group size is determined by the largest
+ * transform length. Records whose length is not listed in lengths are skipped.
+ */
+struct BBFFT_EXPORT ragged_configuration {
+    precision fp;                     ///< Floating-point precision (f32 or f64)
+    direction dir;                    ///< Forward or backward transform
+    std::vector<std::size_t> lengths; ///< Transform lengths that may occur in the records
+    std::size_t num_records;          ///< Number of records; must be positive
+    ragged_record const *records;     ///< Device pointer to num_records records
+};
+
+} // namespace bbfft
+
+#endif // RAGGED_CONFIGURATION_20240502_HPP
@@ -4,16 +4,22 @@
 #ifndef SYCL_MAKE_PLAN_20221205_HPP
 #define SYCL_MAKE_PLAN_20221205_HPP
 
+#include "bbfft/autotune.hpp"
 #include "bbfft/configuration.hpp"
+#include "bbfft/convolution_configuration.hpp"
 #include "bbfft/export.hpp"
 #include "bbfft/jit_cache.hpp"
 #include "bbfft/plan.hpp"
+#include "bbfft/ragged_configuration.hpp"
 
 #include <CL/sycl.hpp>
+#include <vector>
 
 namespace bbfft {
 
 using sycl_plan = plan<::sycl::event>;
+using sycl_convolution_plan = convolution_plan<::sycl::event>;
+using sycl_plan_group = plan_group<::sycl::event>;
 
 /**
  * @brief Create a plan for the configuration
@@ -40,6 +46,127 @@ BBFFT_EXPORT auto make_plan(configuration const &cfg, ::sycl::queue queue,
 BBFFT_EXPORT auto make_plan(configuration const &cfg, ::sycl::queue queue, ::sycl::context context,
                             ::sycl::device device, jit_cache *cache = nullptr) -> sycl_plan;
 
+/**
+ * @brief Create a plan with tuned kernel parameters
+ *
+ * @param cfg configuration
+ * @param tc tuning candidate, e.g. returned by ::autotune
+ * @param queue queue handle
+ * @param cache optional kernel cache
+ *
+ * @return plan
+ */
+BBFFT_EXPORT auto make_plan(configuration const &cfg, tuning_candidate const &tc,
+                            ::sycl::queue queue, jit_cache *cache = nullptr) -> sycl_plan;
+/**
+ * @brief Create a plan with tuned kernel parameters
+ *
+ * @param cfg configuration
+ * @param tc tuning candidate, e.g. returned by ::autotune
+ * @param queue queue handle
+ * @param context context handle
+ * @param device device handle
+ * @param cache optional kernel cache
+ *
+ * @return plan
+ */
+BBFFT_EXPORT auto make_plan(configuration const &cfg, tuning_candidate const &tc,
+                            ::sycl::queue queue, ::sycl::context context, ::sycl::device device,
+                            jit_cache *cache = nullptr) -> sycl_plan;
+
+/**
+ * @brief Find the fastest kernel parameters for the configuration
+ *
+ * Every candidate of the search space is compiled and timed on scratch buffers on the device of
+ * the queue.
+ *
+ * @param cfg configuration
+ * @param queue queue handle
+ * @param cache optional kernel cache; stores the kernels compiled during tuning
+ *
+ * @return fastest tuning candidate
+ */
+BBFFT_EXPORT auto autotune(configuration const &cfg, ::sycl::queue queue,
+                           jit_cache *cache = nullptr) -> tuning_candidate;
+
+/**
+ * @brief Create a plan for a ragged batch
+ *
+ * @param cfg ragged configuration
+ * @param queue queue handle
+ * @param cache optional kernel cache
+ *
+ * @return plan
+ */
+BBFFT_EXPORT auto make_plan(ragged_configuration const &cfg, ::sycl::queue queue,
+                            jit_cache *cache = nullptr) -> sycl_plan;
+/**
+ * @brief Create a plan for a ragged batch
+ *
+ * @param cfg ragged configuration
+ * @param queue queue handle
+ * @param context context handle
+ * @param device device handle
+ * @param cache optional kernel cache
+ *
+ * @return plan
+ */
+BBFFT_EXPORT auto make_plan(ragged_configuration const &cfg, ::sycl::queue queue,
+                            ::sycl::context context, ::sycl::device device,
+                            jit_cache *cache = nullptr) -> sycl_plan;
+
+/**
+ * @brief Create a plan for a fused convolution
+ *
+ * @param cfg convolution configuration
+ * @param queue queue handle
+ * @param cache optional kernel cache
+ *
+ * @return convolution plan
+ */
+BBFFT_EXPORT auto make_plan(convolution_configuration const &cfg, ::sycl::queue queue,
+                            jit_cache *cache = nullptr) -> sycl_convolution_plan;
+/**
+ * @brief Create a plan for a fused convolution
+ *
+ * @param cfg convolution configuration
+ * @param queue queue handle
+ * @param context context handle
+ * @param device device handle
+ * @param cache optional kernel cache
+ *
+ * @return convolution plan
+ */
+BBFFT_EXPORT auto make_plan(convolution_configuration const &cfg, ::sycl::queue queue,
+                            ::sycl::context context, ::sycl::device device,
+                            jit_cache *cache = nullptr) -> sycl_convolution_plan;
+
+/**
+ * @brief Create a plan group that computes the FFTs of all configurations with one kernel launch
+ *
+ * @param cfgs configurations of the members
+ * @param queue queue handle
+ * @param cache optional kernel cache
+ *
+ * @return plan group
+ */
+BBFFT_EXPORT auto make_plan_group(std::vector<configuration> const &cfgs, ::sycl::queue queue,
+                                  jit_cache *cache = nullptr) -> sycl_plan_group;
+/**
+ * @brief Create a plan group that computes the FFTs of all configurations with one kernel launch
+ *
+ * @param cfgs configurations of the members
+ * @param queue queue handle
+ * @param context context handle
+ * @param device device handle
+ * @param cache optional kernel cache
+ *
+ * @return plan group
+ */
+BBFFT_EXPORT auto make_plan_group(std::vector<configuration> const &cfgs, ::sycl::queue queue,
+                                  ::sycl::context context, ::sycl::device device,
+                                  jit_cache *cache = nullptr) -> sycl_plan_group;
+
 } // namespace bbfft
 
 #endif // SYCL_MAKE_PLAN_20221205_HPP
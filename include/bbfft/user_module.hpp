@@ -20,6 +20,10 @@ enum class kernel_language {
 
 /**
  * @brief Definition of user callbacks
+ *
+ * For the 16-bit storage precisions, the pointer passed to the callbacks has the scalar storage
+ * type (half or ushort) and the loaded or stored value has the single precision compute type
+ * (float or float2). The offset is given in units of the value type.
  */
 struct BBFFT_EXPORT user_module {
     char const *data = nullptr;                           ///< Source code string
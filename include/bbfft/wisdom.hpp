@@ -0,0 +1,116 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WISDOM_20240502_HPP
+#define WISDOM_20240502_HPP
+
+#include "bbfft/autotune.hpp"
+#include "bbfft/configuration.hpp"
+#include "bbfft/device_info.hpp"
+#include "bbfft/export.hpp"
+
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace bbfft {
+
+/**
+ * @brief Store of tuning candidates that override the heuristics
+ *
+ * An entry maps a configuration and a device info to a tuning candidate, e.g. the result of
+ * the autotuner.
+ * Wisdom is persisted in a text file with one entry per line that contains the device info,
+ * the FFT descriptor, and the tuning candidate, e.g.
+ *
+ * @code
+ * {1024, {16, 32}, 131072, gpu} scfo16*64 sb_Mb1_Kb4_sgs32
+ * @endcode
+ *
+ * Empty lines and lines starting with '#' are ignored.
+ */
+class BBFFT_EXPORT wisdom {
+  public:
+    /**
+     * @brief Add or replace entry
+     *
+     * @param cfg configuration
+     * @param info Properties of target device
+     * @param tc tuning candidate; the automatic candidate removes the entry
+     *
+     * @throws bad_configuration if the tuning candidate cannot be applied to the configuration
+     */
+    void insert(configuration const &cfg, device_info const &info, tuning_candidate const &tc);
+    /**
+     * @brief Look up entry
+     *
+     * @param cfg configuration
+     * @param info Properties of target device
+     *
+     * @return Stored tuning candidate; the automatic candidate if no entry exists
+     */
+    auto find(configuration const &cfg, device_info const &info) const -> tuning_candidate;
+    //! Number of entries
+    inline std::size_t size() const { return entries_.size(); }
+
+    /**
+     * @brief Read entries from stream
+     *
+     * Entries read from the stream replace existing entries with the same key.
+     * If an error occurs, no entry of the stream is added.
+     *
+     * @throws std::runtime_error if a line is malformed or its tuning candidate cannot be applied
+     */
+    void load(std::istream &is);
+    /**
+     * @brief Write all entries to stream
+     */
+    void save(std::ostream &os) const;
+    /**
+     * @brief Read entries from file
+     *
+     * @throws std::runtime_error if the file cannot be opened or a line is malformed or its tuning
+     * candidate cannot be applied
+     */
+    void load_file(std::string const &filename);
+    /**
+     * @brief Write all entries to file
+     *
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    void save_file(std::string const &filename) const;
+
+  private:
+    std::map<std::pair<std::string, std::string>, tuning_candidate> entries_;
+};
+
+/**
+ * @brief Install wisdom that is consulted by plan creation and kernel generation
+ *
+ * @param w wisdom; nullptr restores the heuristics
+ */
+BBFFT_EXPORT void set_wisdom(std::shared_ptr<wisdom const> w);
+/**
+ * @brief Get the installed wisdom
+ *
+ * @return Wisdom; nullptr if no wisdom is installed
+ */
+BBFFT_EXPORT auto get_wisdom() -> std::shared_ptr<wisdom const>;
+/**
+ * @brief Look up configuration in the installed wisdom
+ *
+ * @param cfg configuration
+ * @param info Properties of target device
+ *
+ * @return Stored tuning candidate; the automatic candidate if no wisdom is installed or no
+ * entry exists
+ */
+BBFFT_EXPORT auto lookup_wisdom(configuration const &cfg, device_info const &info)
+    -> tuning_candidate;
+
+} // namespace bbfft
+
+#endif // WISDOM_20240502_HPP
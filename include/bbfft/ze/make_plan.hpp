@@ -4,16 +4,22 @@
 #ifndef ZE_MAKE_PLAN_20221205_HPP
 #define ZE_MAKE_PLAN_20221205_HPP
 
+#include "bbfft/autotune.hpp"
 #include "bbfft/configuration.hpp"
+#include "bbfft/convolution_configuration.hpp"
 #include "bbfft/export.hpp"
 #include "bbfft/jit_cache.hpp"
 #include "bbfft/plan.hpp"
+#include "bbfft/ragged_configuration.hpp"
 
 #include <level_zero/ze_api.h>
+#include <vector>
 
 namespace bbfft {
 
 using level_zero_plan = plan_unmanaged_event<ze_event_handle_t>;
+using level_zero_convolution_plan = convolution_plan_unmanaged_event<ze_event_handle_t>;
+using level_zero_plan_group = plan_group_unmanaged_event<ze_event_handle_t>;
 
 /**
  * @brief Create a plan for the configuration
@@ -30,6 +36,69 @@ BBFFT_EXPORT auto make_plan(configuration const &cfg, ze_command_list_handle_t q
                             ze_context_handle_t context, ze_device_handle_t device,
                             jit_cache *cache = nullptr) -> level_zero_plan;
 
+/**
+ * @brief Create a plan with tuned kernel parameters
+ *
+ * @param cfg configuration
+ * @param tc tuning candidate, e.g. from the autotuner of the SYCL backend
+ * @param queue queue handle
+ * @param context context handle
+ * @param device device handle
+ * @param cache optional kernel cache
+ *
+ * @return plan
+ */
+BBFFT_EXPORT auto make_plan(configuration const &cfg, tuning_candidate const &tc,
+                            ze_command_list_handle_t queue, ze_context_handle_t context,
+                            ze_device_handle_t device, jit_cache *cache = nullptr)
+    -> level_zero_plan;
+
+/**
+ * @brief Create a plan for a ragged batch
+ *
+ * @param cfg ragged configuration
+ * @param queue queue handle
+ * @param context context handle
+ * @param device device handle
+ * @param cache optional kernel cache
+ *
+ * @return plan
+ */
+BBFFT_EXPORT auto make_plan(ragged_configuration const &cfg, ze_command_list_handle_t queue,
+                            ze_context_handle_t context, ze_device_handle_t device,
+                            jit_cache *cache = nullptr) -> level_zero_plan;
+
+/**
+ * @brief Create a plan for a fused convolution
+ *
+ * @param cfg convolution configuration
+ * @param queue queue handle
+ * @param context context handle
+ * @param device device handle
+ * @param cache optional kernel cache
+ *
+ * @return convolution plan
+ */
+BBFFT_EXPORT auto make_plan(convolution_configuration const &cfg, ze_command_list_handle_t queue,
+                            ze_context_handle_t context, ze_device_handle_t device,
+                            jit_cache *cache = nullptr) -> level_zero_convolution_plan;
+
+/**
+ * @brief Create a plan group that computes the FFTs of all configurations with one kernel launch
+ *
+ * @param cfgs configurations of the members
+ * @param queue queue handle
+ * @param context context handle
+ * @param device device handle
+ * @param cache optional kernel cache
+ *
+ * @return plan group
+ */
+BBFFT_EXPORT auto make_plan_group(std::vector<configuration> const &cfgs,
+                                  ze_command_list_handle_t queue, ze_context_handle_t context,
+                                  ze_device_handle_t device, jit_cache *cache = nullptr)
+    -> level_zero_plan_group;
+
 } // namespace bbfft
 
 #endif // ZE_MAKE_PLAN_20221205_HPP
@@ -0,0 +1,38 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "bbfft/autotune.hpp"
+#include "bbfft/configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
+#include "bbfft/device_info.hpp"
+#include "bbfft/wisdom.hpp"
+
+namespace bbfft {
+
+algorithm_1d select_algorithm_1d(configuration const &cfg, device_info const &info) {
+    switch (lookup_wisdom(cfg, info).algorithm) {
+    case tuning_algorithm::small_batch:
+        return algorithm_1d::small_batch;
+    case tuning_algorithm::factor2_slm:
+        return algorithm_1d::factor2_slm;
+    case tuning_algorithm::subgroup:
+        return algorithm_1d::subgroup;
+    case tuning_algorithm::automatic:
+        break;
+    }
+    if (prefer_bluestein_fft(cfg, info)) {
+        return algorithm_1d::bluestein;
+    }
+    if (prefer_four_step_fft(cfg, info)) {
+        return algorithm_1d::four_step;
+    }
+    if (prefer_subgroup_fft(cfg, info)) {
+        return algorithm_1d::subgroup;
+    }
+    if (!prefer_small_batch_fft(cfg, info)) {
+        return algorithm_1d::factor2_slm;
+    }
+    return algorithm_1d::small_batch;
+}
+
+} // namespace bbfft
@@ -0,0 +1,196 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "bbfft/autotune.hpp"
+#include "bbfft/bad_configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
+#include "bbfft/wisdom.hpp"
+#include "math.hpp"
+#include "prime_factorization.hpp"
+
+#include <algorithm>
+#include <ostream>
+#include <utility>
+
+namespace bbfft {
+
+namespace {
+
+bool is_tunable(configuration const &cfg, device_info const &info) {
+    return cfg.dim == 1 && !is_r2r(cfg.type) && !cfg.callbacks &&
+           !prefer_bluestein_fft(cfg, info) && !prefer_four_step_fft(cfg, info);
+}
+
+bool is_pruned(configuration const &cfg) {
+    return cfg.input_length != 0 || cfg.output_length != 0;
+}
+
+bool is_valid_subgroup_candidate(configuration const &cfg, device_info const &info,
+                                 tuning_candidate const &tc) {
+    try {
+        configure_subgroup_fft(cfg, info, tc);
+    } catch (bad_configuration const &) {
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool tuning_candidate::operator==(tuning_candidate const &other) const {
+    return algorithm == other.algorithm && Mb == other.Mb && Kb == other.Kb && Nb == other.Nb &&
+           sgs == other.sgs && factorization == other.factorization;
+}
+bool tuning_candidate::operator!=(tuning_candidate const &other) const {
+    return !(*this == other);
+}
+
+std::ostream &operator<<(std::ostream &os, tuning_candidate const &tc) {
+    switch (tc.algorithm) {
+    case tuning_algorithm::automatic:
+        os << "auto";
+        break;
+    case tuning_algorithm::small_batch:
+        os << "sb_Mb" << tc.Mb << "_Kb" << tc.Kb << "_sgs" << tc.sgs;
+        break;
+    case tuning_algorithm::factor2_slm: {
+        os << "f2_Mb" << tc.Mb << "_Nb" << tc.Nb << "_Kb" << tc.Kb << "_sgs" << tc.sgs << "_f";
+        auto it = tc.factorization.begin();
+        if (it != tc.factorization.end()) {
+            os << *it++;
+            for (; it != tc.factorization.end(); ++it) {
+                os << "x" << *it;
+            }
+        }
+        break;
+    }
+    case tuning_algorithm::subgroup:
+        os << "sg_Kb" << tc.Kb << "_sgs" << tc.sgs;
+        break;
+    }
+    return os;
+}
+
+auto default_tuning_candidate(configuration const &cfg, device_info const &info)
+    -> tuning_candidate {
+    if (!is_tunable(cfg, info)) {
+        return {};
+    }
+    if (auto tc = lookup_wisdom(cfg, info); tc.algorithm != tuning_algorithm::automatic) {
+        return tc;
+    }
+    if (prefer_subgroup_fft(cfg, info)) {
+        auto sgc = configure_subgroup_fft(cfg, info);
+        return {tuning_algorithm::subgroup, 0, sgc.Kb, 0, sgc.sgs, {}};
+    }
+    if (prefer_small_batch_fft(cfg, info)) {
+        auto sbc = configure_small_batch_fft(cfg, info);
+        return {tuning_algorithm::small_batch, sbc.Mb, sbc.Kb, 0, sbc.sgs, {}};
+    }
+    if (is_pruned(cfg)) {
+        return {};
+    }
+    auto f2c = configure_factor2_slm_fft(cfg, info);
+    return {tuning_algorithm::factor2_slm, f2c.Mb, f2c.Kb, f2c.Nb, f2c.sgs,
+            std::move(f2c.factorization)};
+}
+
+auto tuning_search_space(configuration const &cfg, device_info const &info)
+    -> std::vector<tuning_candidate> {
+    auto space = std::vector<tuning_candidate>{};
+    auto heuristic = default_tuning_candidate(cfg, info);
+    if (heuristic.algorithm == tuning_algorithm::automatic) {
+        return space;
+    }
+    auto const add = [&space](tuning_candidate tc) {
+        if (std::find(space.begin(), space.end(), tc) == space.end()) {
+            space.emplace_back(std::move(tc));
+        }
+    };
+    add(heuristic);
+
+    std::size_t M = cfg.shape[0];
+    std::size_t N = cfg.shape[1];
+    std::size_t K = cfg.shape[2];
+    std::size_t sizeof_real = size_in_bytes(compute_precision(cfg.fp));
+    bool is_real = cfg.type == transform_type::r2c || cfg.type == transform_type::c2r;
+    std::size_t max_Mb = std::min(min_power_of_2_greater_equal(M), info.max_subgroup_size());
+    // Real transforms support in-place only if a work-group covers the M-mode; candidates must
+    // not take away in-place support that the heuristic provides
+    std::size_t min_Mb = is_real && max_Mb >= M ? max_Mb : 1;
+
+    if (prefer_subgroup_fft(cfg, info)) {
+        for (auto const &sgs : info.subgroup_sizes) {
+            for (std::size_t Kb = 1; sgs * Kb <= info.max_work_group_size; Kb *= 2) {
+                auto tc =
+                    tuning_candidate{tuning_algorithm::subgroup, 0, std::min(K, Kb), 0, sgs, {}};
+                if (!is_valid_subgroup_candidate(cfg, info, tc)) {
+                    break;
+                }
+                add(std::move(tc));
+                if (Kb >= K) {
+                    break;
+                }
+            }
+        }
+    }
+
+    // The heuristic requires that the DFT fits into half of the register space
+    if (small_batch_register_space(cfg, info) < info.register_space_max()) {
+        std::size_t N_slm = is_real ? N / 2 + 1 : N;
+        for (auto const &sgs : info.subgroup_sizes) {
+            for (std::size_t Mb = min_Mb; Mb <= max_Mb; Mb *= 2) {
+                for (std::size_t Kb = 1; Mb * Kb <= info.max_work_group_size &&
+                                         Mb * Kb * N_slm * 2 * sizeof_real <=
+                                             info.local_memory_size;
+                     Kb *= 2) {
+                    add({tuning_algorithm::small_batch, Mb, std::min(K, Kb), 0, sgs, {}});
+                    if (Kb >= K) {
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    if (!is_pruned(cfg)) {
+        std::size_t N_fft = is_real && N % 2 == 0 ? N / 2 : N;
+        std::size_t N_slm = is_real ? N_fft + 1 : N_fft;
+        auto factorizations = std::vector<std::vector<int>>{};
+        for (unsigned index = 2; index <= 4; ++index) {
+            auto f = factor(N_fft, index);
+            auto fi = std::vector<int>(f.begin(), f.end());
+            if (fi.size() >= 2 && std::find(fi.begin(), fi.end(), 1) == fi.end() &&
+                std::find(factorizations.begin(), factorizations.end(), fi) ==
+                    factorizations.end()) {
+                factorizations.emplace_back(std::move(fi));
+            }
+        }
+        for (auto const &f : factorizations) {
+            auto Nf_max = *std::max_element(f.begin(), f.end());
+            std::size_t N_parallel_max = product(f.begin(), f.end(), 1) / Nf_max;
+            std::size_t max_Nb = min_power_of_2_greater_equal(N_parallel_max);
+            for (auto const &sgs : info.subgroup_sizes) {
+                for (std::size_t Nb = max_Nb; Nb >= std::max(std::size_t(1), max_Nb / 4);
+                     Nb /= 2) {
+                    for (std::size_t Mb = min_Mb;
+                         Mb <= max_Mb && Mb * Nb <= info.max_work_group_size &&
+                         2 * Mb * N_slm * sizeof_real <= info.local_memory_size;
+                         Mb *= 2) {
+                        std::size_t max_compute_Kb = info.max_work_group_size / (Mb * Nb);
+                        std::size_t max_slm_Kb =
+                            info.local_memory_size / (2 * Mb * N_slm * sizeof_real);
+                        std::size_t min_Kb = (sgs - 1) / (Mb * Nb) + 1;
+                        std::size_t Kb =
+                            std::min(K, std::min(min_Kb, std::min(max_compute_Kb, max_slm_Kb)));
+                        add({tuning_algorithm::factor2_slm, Mb, Kb, Nb, sgs, f});
+                    }
+                }
+            }
+        }
+    }
+
+    return space;
+}
+
+} // namespace bbfft
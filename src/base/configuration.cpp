@@ -3,12 +3,27 @@
 
 #include "bbfft/configuration.hpp"
 
+#include <limits>
 #include <ostream>
 #include <sstream>
 #include <stdexcept>
 
 namespace bbfft {
 
+char const *to_string(precision fp) {
+    switch (fp) {
+    case precision::f16:
+        return "f16";
+    case precision::bf16:
+        return "bf16";
+    case precision::f32:
+        return "f32";
+    case precision::f64:
+        return "f64";
+    };
+    return "unknown";
+}
+
 char const *to_string(transform_type type) {
     switch (type) {
     case transform_type::c2c:
@@ -17,6 +32,14 @@ char const *to_string(transform_type type) {
         return "r2c";
     case transform_type::c2r:
         return "c2r";
+    case transform_type::dct2:
+        return "dct2";
+    case transform_type::dct3:
+        return "dct3";
+    case transform_type::dst2:
+        return "dst2";
+    case transform_type::dst3:
+        return "dst3";
     };
     return "unknown";
 }
@@ -32,6 +55,10 @@ auto default_istride(unsigned dim, std::array<std::size_t, max_tensor_dim> const
         shape1 = shape[1] / 2 + 1;
         break;
     case transform_type::c2c:
+    case transform_type::dct2:
+    case transform_type::dct3:
+    case transform_type::dst2:
+    case transform_type::dst3:
         shape1 = shape[1];
         break;
     }
@@ -50,7 +77,11 @@ auto default_ostride(unsigned dim, std::array<std::size_t, max_tensor_dim> const
     case transform_type::c2r:
         return default_istride(dim, shape, transform_type::r2c, inplace);
     case transform_type::c2c:
-        return default_istride(dim, shape, transform_type::c2c, inplace);
+    case transform_type::dct2:
+    case transform_type::dct3:
+    case transform_type::dst2:
+    case transform_type::dst3:
+        return default_istride(dim, shape, type, inplace);
     }
     return {};
 }
@@ -69,6 +100,12 @@ std::string configuration::to_string() const {
 std::ostream &operator<<(std::ostream &os, configuration const &cfg) {
     // precision
     switch (cfg.fp) {
+    case precision::f16:
+        os << 'h';
+        break;
+    case precision::bf16:
+        os << 'b';
+        break;
     case precision::f32:
         os << 's';
         break;
@@ -88,6 +125,14 @@ std::ostream &operator<<(std::ostream &os, configuration const &cfg) {
     case transform_type::c2r:
         os << 'r';
         break;
+    case transform_type::dct2:
+    case transform_type::dct3:
+        os << 'e';
+        break;
+    case transform_type::dst2:
+    case transform_type::dst3:
+        os << 'o';
+        break;
     default:
         throw std::runtime_error("Unsupported transform type");
         break;
@@ -109,6 +154,13 @@ std::ostream &operator<<(std::ostream &os, configuration const &cfg) {
         throw std::runtime_error(
             "r2c direction must be forward and c2r direction must be backward");
     }
+    if (((cfg.type == transform_type::dct2 || cfg.type == transform_type::dst2) &&
+         cfg.dir == direction::backward) ||
+        ((cfg.type == transform_type::dct3 || cfg.type == transform_type::dst3) &&
+         cfg.dir == direction::forward)) {
+        throw std::runtime_error(
+            "type II direction must be forward and type III direction must be backward");
+    }
 
     // placement
     auto istride = cfg.istride;
@@ -156,6 +208,23 @@ std::ostream &operator<<(std::ostream &os, configuration const &cfg) {
         }
     }
 
+    // planar offset
+    if (cfg.planar_offset[0] != 0 || cfg.planar_offset[1] != 0) {
+        os << 'p' << cfg.planar_offset[0] << ',' << cfg.planar_offset[1];
+    }
+
+    // input and output length
+    if (cfg.input_length != 0 || cfg.output_length != 0) {
+        os << 'l' << cfg.input_length << ',' << cfg.output_length;
+    }
+
+    // scale
+    if (cfg.scale != 1.0) {
+        auto const prec = os.precision(std::numeric_limits<double>::max_digits10);
+        os << 's' << cfg.scale;
+        os.precision(prec);
+    }
+
     return os;
 }
 
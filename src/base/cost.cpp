@@ -0,0 +1,435 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "bbfft/cost.hpp"
+#include "bbfft/bad_configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <ostream>
+#include <string>
+#include <utility>
+
+namespace bbfft {
+
+namespace {
+
+bool is_real_type(transform_type type) {
+    return type == transform_type::r2c || type == transform_type::c2r;
+}
+
+std::size_t ceil_div(std::size_t a, std::size_t b) { return a == 0 ? 0 : (a - 1) / b + 1; }
+
+double fft_flops(std::size_t N, bool is_real) {
+    if (N <= 1) {
+        return 0.0;
+    }
+    double flops = 5.0 * N * std::log2(static_cast<double>(N));
+    return is_real ? flops / 2.0 : flops;
+}
+
+// Bytes of the input and the output of a single FFT (excluding the batch modes)
+auto fft_bytes(configuration const &cfg, precision fp) -> std::pair<std::size_t, std::size_t> {
+    bool is_real = is_real_type(cfg.type);
+    std::size_t N_real = 1;
+    std::size_t N_complex = 1;
+    for (unsigned d = 0; d < cfg.dim; ++d) {
+        std::size_t Nd = cfg.shape[d + 1];
+        N_real *= Nd;
+        N_complex *= d == 0 && is_real ? Nd / 2 + 1 : Nd;
+    }
+    std::size_t real_bytes = size_in_bytes(fp);
+    std::size_t in = cfg.type == transform_type::r2c ? N_real * real_bytes
+                                                     : N_complex * 2 * real_bytes;
+    std::size_t out = cfg.type == transform_type::c2r ? N_real * real_bytes
+                                                      : N_complex * 2 * real_bytes;
+    // Pruned FFTs only touch input_length and output_length entries of the N-mode
+    if (cfg.input_length != 0) {
+        in = in / cfg.shape[1] * cfg.input_length;
+    }
+    if (cfg.output_length != 0) {
+        out = out / cfg.shape[1] * cfg.output_length;
+    }
+    return {in, out};
+}
+
+std::size_t batch_size(configuration const &cfg) { return cfg.shape[0] * cfg.shape[cfg.dim + 1]; }
+
+void finish_kernel(kernel_cost &kc, device_info const &info, std::size_t sgs) {
+    std::size_t register_file = info.register_space_max() / sgs;
+    kc.spill_bytes = kc.register_bytes > register_file ? kc.register_bytes - register_file : 0;
+    // Spilled registers are stored to and loaded from scratch memory
+    kc.global_bytes += 2 * kc.spill_bytes * kc.work_group_size * kc.num_work_groups;
+
+    // A compute unit holds at most max_work_group_size work-items; work-groups occupy whole
+    // sub-groups
+    std::size_t resident = info.max_work_group_size / (ceil_div(kc.work_group_size, sgs) * sgs);
+    if (kc.slm_per_work_group > 0) {
+        resident = std::min(resident, info.local_memory_size / kc.slm_per_work_group);
+    }
+    resident = std::max(std::size_t(1), std::min(resident, kc.num_work_groups));
+    kc.occupancy = std::min(1.0, static_cast<double>(resident * kc.work_group_size) /
+                                     info.max_work_group_size);
+}
+
+auto small_batch_cost(configuration const &cfg, device_info const &info,
+                      small_batch_configuration const &sbc) -> kernel_cost {
+    bool is_real = is_real_type(cfg.type);
+    std::size_t N = sbc.N;
+    std::size_t N_fft = is_real && N % 2 == 0 ? N / 2 : N;
+    std::size_t N_slm = is_real ? N / 2 + 1 : N;
+    std::size_t real_bytes = size_in_bytes(compute_precision(cfg.fp));
+    std::size_t batch = batch_size(cfg);
+    auto [in_bytes, out_bytes] = fft_bytes(cfg, cfg.fp);
+    auto [in_slm_bytes, out_slm_bytes] = fft_bytes(cfg, compute_precision(cfg.fp));
+
+    auto kc = kernel_cost{};
+    kc.name = sbc.identifier();
+    kc.global_bytes = batch * (in_bytes + out_bytes);
+    // Input and output are staged through shared local memory
+    kc.slm_bytes = 2 * batch * (in_slm_bytes + out_slm_bytes);
+    kc.flops = batch * fft_flops(N, is_real);
+    if (cfg.scale != 1.0) {
+        kc.flops += 2.0 * batch * N_fft;
+    }
+    kc.register_bytes = 2 * real_bytes * N_fft;
+    kc.work_group_size = sbc.Mb * sbc.Kb;
+    kc.slm_per_work_group = sbc.Mb * sbc.Kb * N_slm * 2 * real_bytes;
+    kc.num_work_groups = ceil_div(sbc.M, sbc.Mb) * ceil_div(cfg.shape[2], sbc.Kb);
+    finish_kernel(kc, info, sbc.sgs);
+    return kc;
+}
+
+auto factor2_slm_cost(configuration const &cfg, device_info const &info,
+                      factor2_slm_configuration const &f2c) -> kernel_cost {
+    bool is_real = is_real_type(cfg.type);
+    std::size_t N = f2c.N;
+    std::size_t N_fft = is_real && N % 2 == 0 ? N / 2 : N;
+    std::size_t N_slm = is_real ? N_fft + 1 : N_fft;
+    std::size_t real_bytes = size_in_bytes(compute_precision(cfg.fp));
+    std::size_t batch = batch_size(cfg);
+    auto [in_bytes, out_bytes] = fft_bytes(cfg, cfg.fp);
+    auto [in_slm_bytes, out_slm_bytes] = fft_bytes(cfg, compute_precision(cfg.fp));
+    std::size_t num_exchanges = f2c.factorization.size() - 1;
+    int max_factor = *std::max_element(f2c.factorization.begin(), f2c.factorization.end());
+
+    auto kc = kernel_cost{};
+    kc.name = f2c.identifier();
+    kc.global_bytes = batch * (in_bytes + out_bytes);
+    // Input and output are staged through shared local memory and the factors exchange their
+    // intermediate results via shared local memory
+    std::size_t exchange_bytes = num_exchanges * N_slm * 2 * real_bytes;
+    kc.slm_bytes = 2 * batch * (in_slm_bytes + out_slm_bytes + exchange_bytes);
+    kc.flops = batch * fft_flops(N, is_real);
+    if (cfg.scale != 1.0) {
+        kc.flops += 2.0 * batch * N_fft;
+    }
+    kc.register_bytes = 2 * real_bytes * static_cast<std::size_t>(max_factor);
+    kc.work_group_size = f2c.Mb * f2c.Nb * f2c.Kb;
+    kc.slm_per_work_group = f2c.Mb * f2c.Kb * N_slm * 2 * real_bytes;
+    kc.num_work_groups = ceil_div(f2c.M, f2c.Mb) * ceil_div(cfg.shape[2], f2c.Kb);
+    finish_kernel(kc, info, f2c.sgs);
+    return kc;
+}
+
+auto subgroup_cost(configuration const &cfg, device_info const &info,
+                   subgroup_configuration const &sgc) -> kernel_cost {
+    std::size_t N = sgc.N;
+    std::size_t real_bytes = size_in_bytes(compute_precision(cfg.fp));
+    std::size_t batch = batch_size(cfg);
+    auto [in_bytes, out_bytes] = fft_bytes(cfg, cfg.fp);
+
+    auto kc = kernel_cost{};
+    kc.name = sgc.identifier();
+    kc.global_bytes = batch * (in_bytes + out_bytes);
+    // The lanes exchange data with sub-group shuffles instead of shared local memory
+    kc.flops = batch * fft_flops(N, false);
+    if (cfg.scale != 1.0) {
+        kc.flops += 2.0 * batch * N;
+    }
+    kc.register_bytes = 2 * real_bytes * (N / sgc.sgs);
+    kc.work_group_size = sgc.sgs * sgc.Kb;
+    kc.num_work_groups = ceil_div(cfg.shape[2], sgc.Kb);
+    finish_kernel(kc, info, sgc.sgs);
+    return kc;
+}
+
+void add_1d_cost(cost_estimate &cost, configuration const &cfg, device_info const &info);
+
+void add_bluestein_cost(cost_estimate &cost, configuration const &cfg, device_info const &info) {
+    auto bc = configure_bluestein_fft(cfg, info);
+    std::size_t M = cfg.shape[0];
+    std::size_t K = cfg.shape[2];
+    std::size_t L = bc.L;
+    std::size_t N_out = cfg.type == transform_type::r2c ? bc.N / 2 + 1 : bc.N;
+    std::size_t complex_bytes = 2 * size_in_bytes(compute_precision(cfg.fp));
+    std::size_t batch = M * K;
+    auto [in_bytes, out_bytes] = fft_bytes(cfg, cfg.fp);
+
+    auto const pointwise = [&](char const *suffix, std::size_t length, std::size_t global_bytes,
+                               double flops) {
+        auto kc = kernel_cost{};
+        kc.name = bc.identifier() + suffix;
+        kc.global_bytes = global_bytes;
+        kc.flops = flops;
+        kc.register_bytes = 2 * complex_bytes;
+        kc.work_group_size = bc.Mb * bc.Nb;
+        kc.num_work_groups = ceil_div(M, bc.Mb) * ceil_div(length, bc.Nb) * K;
+        finish_kernel(kc, info, info.min_subgroup_size());
+        cost.kernels.emplace_back(std::move(kc));
+    };
+
+    auto shape = std::array<std::size_t, max_tensor_dim>{M, L, K};
+    auto stride = std::array<std::size_t, max_tensor_dim>{1, M, M * L};
+    auto fwd_cfg =
+        configuration{1, shape, cfg.fp, direction::forward, transform_type::c2c, stride, stride};
+    auto bwd_cfg = fwd_cfg;
+    bwd_cfg.dir = direction::backward;
+
+    // Multiplication with the chirp and zero-padding to length L
+    pointwise("_pre", L, batch * (in_bytes + L * complex_bytes) + bc.N * complex_bytes,
+              6.0 * batch * bc.N);
+    add_1d_cost(cost, fwd_cfg, info);
+    pointwise("_mul", L, batch * 2 * L * complex_bytes + L * complex_bytes, 6.0 * batch * L);
+    add_1d_cost(cost, bwd_cfg, info);
+    pointwise("_post", N_out, batch * (N_out * complex_bytes + out_bytes) + bc.N * complex_bytes,
+              (cfg.scale != 1.0 ? 8.0 : 6.0) * batch * N_out);
+    cost.scratch_bytes += batch * L * complex_bytes;
+}
+
+void add_four_step_cost(cost_estimate &cost, configuration const &cfg, device_info const &info) {
+    auto fsc = configure_four_step_fft(cfg, info);
+    std::size_t M = cfg.shape[0];
+    std::size_t K = cfg.shape[2];
+    std::size_t N1 = fsc.N1;
+    std::size_t N2 = fsc.N2;
+    std::size_t N = N1 * N2;
+
+    auto first = configuration{1,
+                               {M * N1, N2, K},
+                               cfg.fp,
+                               cfg.dir,
+                               transform_type::c2c,
+                               {cfg.istride[0], N1 * cfg.istride[1], cfg.istride[2]},
+                               {1, M * N1, M * N}};
+    auto second = configuration{1,
+                                {M * N2, N1, K},
+                                cfg.fp,
+                                cfg.dir,
+                                transform_type::c2c,
+                                {1, M * N2, M * N},
+                                {cfg.ostride[0], N2 * cfg.ostride[1], cfg.ostride[2]}};
+    second.scale = cfg.scale;
+    add_1d_cost(cost, first, info);
+    // The store callback of the first pass multiplies with the twiddle factors
+    cost.kernels.back().flops += 6.0 * M * N * K;
+    add_1d_cost(cost, second, info);
+    cost.scratch_bytes += M * N * K * 2 * size_in_bytes(compute_precision(cfg.fp));
+}
+
+void add_1d_cost(cost_estimate &cost, configuration const &cfg, device_info const &info) {
+    switch (select_algorithm_1d(cfg, info)) {
+    case algorithm_1d::small_batch:
+        cost.kernels.emplace_back(
+            small_batch_cost(cfg, info, configure_small_batch_fft(cfg, info)));
+        break;
+    case algorithm_1d::factor2_slm:
+        cost.kernels.emplace_back(
+            factor2_slm_cost(cfg, info, configure_factor2_slm_fft(cfg, info)));
+        break;
+    case algorithm_1d::subgroup:
+        cost.kernels.emplace_back(subgroup_cost(cfg, info, configure_subgroup_fft(cfg, info)));
+        break;
+    case algorithm_1d::bluestein:
+        add_bluestein_cost(cost, cfg, info);
+        break;
+    case algorithm_1d::four_step:
+        add_four_step_cost(cost, cfg, info);
+        break;
+    }
+}
+
+void add_nd_slm_cost(cost_estimate &cost, configuration const &cfg, device_info const &info) {
+    auto nc = configure_nd_slm_fft(cfg, info);
+    std::size_t real_bytes = size_in_bytes(compute_precision(cfg.fp));
+    std::size_t batch = batch_size(cfg);
+    std::size_t N_total = 1;
+    std::size_t N_max = 1;
+    for (unsigned d = 0; d < cfg.dim; ++d) {
+        N_total *= nc.N[d];
+        N_max = std::max(N_max, nc.N[d]);
+    }
+    auto [in_bytes, out_bytes] = fft_bytes(cfg, cfg.fp);
+
+    auto kc = kernel_cost{};
+    kc.name = nc.identifier();
+    kc.global_bytes = batch * (in_bytes + out_bytes);
+    // Every dimension loads its 1D FFTs from and stores them to shared local memory
+    kc.slm_bytes = 2 * (cfg.dim + 1) * batch * N_total * 2 * real_bytes;
+    for (unsigned d = 0; d < cfg.dim; ++d) {
+        kc.flops += batch * (N_total / nc.N[d]) * fft_flops(nc.N[d], false);
+    }
+    if (cfg.scale != 1.0) {
+        kc.flops += 2.0 * batch * N_total;
+    }
+    kc.register_bytes = 2 * real_bytes * N_max;
+    kc.work_group_size = nc.Mb * nc.Nt;
+    kc.slm_per_work_group = nc.Mb * N_total * 2 * real_bytes;
+    kc.num_work_groups = ceil_div(nc.M, nc.Mb) * cfg.shape[cfg.dim + 1];
+    finish_kernel(kc, info, nc.sgs);
+    cost.kernels.emplace_back(std::move(kc));
+}
+
+void add_nd_cost(cost_estimate &cost, configuration const &cfg, device_info const &info) {
+    if (prefer_nd_slm_fft(cfg, info)) {
+        add_nd_slm_cost(cost, cfg, info);
+        return;
+    }
+
+    // One pass of 1D FFTs per dimension; intermediate results use the packed layout
+    auto ndc = configure_nd_fft(cfg);
+    // The algorithm selection only checks whether a pass has callbacks, not their source
+    static char const placeholder_source[] = "\n";
+    char const *load_function = ndc.load_layout ? "layout_load" : nullptr;
+    char const *store_function = ndc.store_layout ? "layout_store" : nullptr;
+    if (cfg.callbacks) {
+        load_function = load_function ? load_function : cfg.callbacks.load_function;
+        store_function = store_function ? store_function : cfg.callbacks.store_function;
+    }
+    if (load_function) {
+        ndc.passes[0].callbacks = {placeholder_source, 1, load_function};
+    }
+    if (store_function) {
+        ndc.passes[cfg.dim - 1].callbacks = {placeholder_source, 1, nullptr, store_function};
+    }
+    for (unsigned d = 0; d < cfg.dim; ++d) {
+        add_1d_cost(cost, ndc.passes[d], info);
+    }
+    cost.scratch_bytes += ndc.scratch_bytes;
+}
+
+void add_r2r_cost(cost_estimate &cost, configuration const &cfg, device_info const &info) {
+    auto rc = configure_r2r_fft(cfg);
+    std::size_t first = cost.kernels.size();
+    add_1d_cost(cost, r2r_fft_inner_configuration(rc, cfg.shape[2]), info);
+    // Pre-processing is fused into the load callback and post-processing into the store callback
+    std::size_t points = rc.M * rc.N * cfg.shape[2];
+    cost.kernels[first].flops += 2.0 * points;
+    cost.kernels.back().flops += 6.0 * points;
+}
+
+} // namespace
+
+std::size_t cost_estimate::global_bytes() const {
+    std::size_t sum = 0;
+    for (auto const &kc : kernels) {
+        sum += kc.global_bytes;
+    }
+    return sum;
+}
+
+std::size_t cost_estimate::slm_bytes() const {
+    std::size_t sum = 0;
+    for (auto const &kc : kernels) {
+        sum += kc.slm_bytes;
+    }
+    return sum;
+}
+
+double cost_estimate::flops() const {
+    double sum = 0.0;
+    for (auto const &kc : kernels) {
+        sum += kc.flops;
+    }
+    return sum;
+}
+
+std::size_t cost_estimate::register_bytes() const {
+    std::size_t max = 0;
+    for (auto const &kc : kernels) {
+        max = std::max(max, kc.register_bytes);
+    }
+    return max;
+}
+
+double cost_estimate::occupancy() const {
+    double min = kernels.empty() ? 0.0 : 1.0;
+    for (auto const &kc : kernels) {
+        min = std::min(min, kc.occupancy);
+    }
+    return min;
+}
+
+double cost_estimate::time(device_throughput const &tp) const {
+    double sum = 0.0;
+    for (auto const &kc : kernels) {
+        double busy = std::max({kc.global_bytes / tp.global_bandwidth,
+                                kc.slm_bytes / tp.slm_bandwidth, kc.flops / tp.flop_rate});
+        // Half of the work-items of a compute unit suffice to hide the latencies
+        double efficiency = std::min(1.0, 2.0 * kc.occupancy);
+        sum += tp.launch_latency + busy / efficiency;
+    }
+    return sum;
+}
+
+auto estimate_cost(configuration const &cfg, device_info const &info) -> cost_estimate {
+    if (cfg.dim < 1 || cfg.dim > max_fft_dim) {
+        throw bad_configuration("Unsupported FFT dimension: " + std::to_string(cfg.dim));
+    }
+    auto cost = cost_estimate{};
+    if (is_r2r(cfg.type)) {
+        add_r2r_cost(cost, cfg, info);
+    } else if (cfg.dim == 1) {
+        add_1d_cost(cost, cfg, info);
+    } else {
+        add_nd_cost(cost, cfg, info);
+    }
+    return cost;
+}
+
+auto estimate_cost(configuration const &cfg, device_info const &info, tuning_candidate const &tc)
+    -> cost_estimate {
+    if (tc.algorithm == tuning_algorithm::automatic) {
+        return estimate_cost(cfg, info);
+    }
+    if (default_tuning_candidate(cfg, info).algorithm == tuning_algorithm::automatic) {
+        throw bad_configuration("The configuration does not support tuning candidates.");
+    }
+    auto cost = cost_estimate{};
+    if (tc.algorithm == tuning_algorithm::small_batch) {
+        cost.kernels.emplace_back(
+            small_batch_cost(cfg, info, configure_small_batch_fft(cfg, info, tc)));
+    } else if (tc.algorithm == tuning_algorithm::subgroup) {
+        cost.kernels.emplace_back(subgroup_cost(cfg, info, configure_subgroup_fft(cfg, info, tc)));
+    } else {
+        if (cfg.input_length != 0 || cfg.output_length != 0) {
+            throw bad_configuration("Pruned FFTs require the small batch algorithm.");
+        }
+        cost.kernels.emplace_back(
+            factor2_slm_cost(cfg, info, configure_factor2_slm_fft(cfg, info, tc)));
+    }
+    return cost;
+}
+
+std::ostream &operator<<(std::ostream &os, cost_estimate const &cost) {
+    auto const print = [&os](std::size_t global_bytes, std::size_t slm_bytes, double flops,
+                             std::size_t register_bytes, double occupancy) {
+        os << "global=" << global_bytes << "B slm=" << slm_bytes << "B flops=" << flops
+           << " registers=" << register_bytes << "B occupancy=" << occupancy;
+    };
+    for (auto const &kc : cost.kernels) {
+        os << kc.name << ": ";
+        print(kc.global_bytes, kc.slm_bytes, kc.flops, kc.register_bytes, kc.occupancy);
+        os << " work_group_size=" << kc.work_group_size << " num_work_groups="
+           << kc.num_work_groups << std::endl;
+    }
+    os << "total: ";
+    print(cost.global_bytes(), cost.slm_bytes(), cost.flops(), cost.register_bytes(),
+          cost.occupancy());
+    return os << " scratch=" << cost.scratch_bytes << "B time=" << cost.time() << "s"
+              << std::endl;
+}
+
+} // namespace bbfft
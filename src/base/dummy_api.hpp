@@ -28,6 +28,7 @@ class dummy_api {
 
     inline device_info info() { return info_; }
     inline uint64_t device_id() { return 0; }
+    inline uint64_t context_id() { return 0; }
 
     inline auto build_module(std::string const &source) -> shared_handle<module_handle_t> {
         if (os_) {
@@ -51,6 +52,7 @@ class dummy_api {
         return nullptr;
     }
 
+    inline static void wait(event_type) {}
     inline static void release_event(event_type) {}
     inline static void release_buffer(buffer_type) {}
     inline static void release_kernel(kernel_type) {}
@@ -3,6 +3,7 @@
 //
 #include "algorithm.hpp"
 #include "dummy_api.hpp"
+#include "generator/utility.hpp"
 
 #include "bbfft/configuration.hpp"
 #include "bbfft/device_info.hpp"
@@ -10,6 +11,7 @@
 #include "bbfft/jit_cache_all.hpp"
 
 #include <ostream>
+#include <sstream>
 
 namespace bbfft {
 
@@ -24,4 +26,21 @@ std::vector<std::string> generate_fft_kernels(std::ostream &os,
     return cache.kernel_names();
 }
 
+auto generate_fft_kernel_statistics(std::vector<configuration> const &cfgs,
+                                    device_info const &info) -> std::vector<kernel_statistics> {
+    auto collector = kernel_statistics_collector{};
+    std::ostringstream discard;
+    generate_fft_kernels(discard, cfgs, info);
+    return collector.statistics();
+}
+
+std::ostream &operator<<(std::ostream &os, kernel_statistics const &stats) {
+    return os << stats.name << ": flops=" << stats.flops << " global_loads=" << stats.global_loads
+              << " global_stores=" << stats.global_stores << " local_loads=" << stats.local_loads
+              << " local_stores=" << stats.local_stores << " barriers=" << stats.barriers
+              << " sub_group_shuffles=" << stats.sub_group_shuffles
+              << " private_array=" << stats.private_array_bytes
+              << "B local_memory=" << stats.local_memory_bytes << "B";
+}
+
 } // namespace bbfft
@@ -0,0 +1,352 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "bbfft/bad_configuration.hpp"
+#include "bbfft/configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
+#include "generator/tensor_accessor.hpp"
+#include "generator/tensor_view.hpp"
+#include "generator/utility.hpp"
+#include "math.hpp"
+#include "mixed_radix_fft.hpp"
+#include "prime_factorization.hpp"
+#include "root_of_unity.hpp"
+
+#include "clir/attr_defs.hpp"
+#include "clir/builder.hpp"
+#include "clir/builtin_function.hpp"
+#include "clir/builtin_type.hpp"
+#include "clir/data_type.hpp"
+#include "clir/expr.hpp"
+#include "clir/func.hpp"
+#include "clir/var.hpp"
+#include "clir/visitor/unique_names.hpp"
+#include "clir/visitor/unsafe_simplification.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <utility>
+
+using namespace clir;
+
+namespace bbfft {
+
+bool prefer_bluestein_fft(configuration const &cfg, device_info const &info) {
+    bool const is_real = cfg.type == transform_type::r2c || cfg.type == transform_type::c2r;
+    std::size_t N_fft = cfg.shape[1];
+    if (is_real && N_fft % 2 == 0) {
+        N_fft /= 2;
+    }
+    if (N_fft < 2) {
+        return false;
+    }
+    auto factors = trial_division(static_cast<int>(N_fft));
+    auto p_max = static_cast<std::size_t>(*std::max_element(factors.begin(), factors.end()));
+
+    std::size_t sgs = info.min_subgroup_size();
+    std::size_t sizeof_real = size_in_bytes(compute_precision(cfg.fp));
+    std::size_t max_N_in_registers_without_spilling =
+        (info.register_space_max() / 2) / (2 * sizeof_real) / sgs;
+    return p_max > 2 * max_N_in_registers_without_spilling;
+}
+
+bluestein_configuration configure_bluestein_fft(configuration const &cfg,
+                                                device_info const &info) {
+    if (compute_precision(cfg.fp) != cfg.fp) {
+        throw bad_configuration("The Bluestein FFT does not support 16-bit storage precisions.");
+    }
+    if (cfg.planar_offset[0] != 0 || cfg.planar_offset[1] != 0) {
+        throw bad_configuration("The Bluestein FFT does not support the planar layout.");
+    }
+    std::size_t M = cfg.shape[0];
+    std::size_t N = cfg.shape[1];
+    std::size_t L = min_power_of_2_greater_equal(2 * N - 1);
+
+    std::size_t max_wgs = std::min(info.max_work_group_size, std::size_t(128));
+    std::size_t Mb = std::min(min_power_of_2_greater_equal(M), info.max_subgroup_size());
+    Mb = std::min(Mb, max_wgs);
+    std::size_t Nb = std::max(std::size_t(1), max_wgs / Mb);
+
+    auto istride = std::array<std::size_t, 3>{cfg.istride[0], cfg.istride[1], cfg.istride[2]};
+    auto ostride = std::array<std::size_t, 3>{cfg.ostride[0], cfg.ostride[1], cfg.ostride[2]};
+
+    return {
+        static_cast<int>(cfg.dir),   // direction
+        M,                           // M
+        Mb,                          // Mb
+        N,                           // N
+        L,                           // L
+        Nb,                          // Nb
+        cfg.fp,                      // precision
+        cfg.type,                    // transform_type
+        istride,                     // istride
+        ostride,                     // ostride
+        cfg.callbacks.load_function,  // load_function
+        cfg.callbacks.store_function, // store_function
+        cfg.scale                     // scale
+    };
+}
+
+std::string bluestein_configuration::identifier() const {
+    std::ostringstream oss;
+    oss << "bluestein_" << (direction < 0 ? 'm' : 'p') << std::abs(direction) << "_M" << M << "_Mb"
+        << Mb << "_N" << N << "_Nb" << Nb << "_" << to_string(fp) << '_'
+        << to_string(type) << "_is";
+    for (auto const &is : istride) {
+        oss << is << "_";
+    }
+    oss << "os";
+    for (auto const &os : ostride) {
+        oss << os << "_";
+    }
+    oss << "L" << L;
+    if (load_function) {
+        oss << "_" << load_function;
+    }
+    if (store_function) {
+        oss << "_" << store_function;
+    }
+    oss << scale_identifier(scale);
+    return oss.str();
+}
+
+std::vector<std::complex<double>> bluestein_twiddle_table(bluestein_configuration const &cfg) {
+    int const N = static_cast<int>(cfg.N);
+    int const L = static_cast<int>(cfg.L);
+    auto table = std::vector<std::complex<double>>(N + L, 0.0);
+
+    // Chirp c_n = exp(direction * pi * i * n^2 / N); n^2 is reduced modulo 2N
+    auto const two_N = 2 * static_cast<int64_t>(N);
+    for (int n = 0; n < N; ++n) {
+        auto k = static_cast<int>((static_cast<int64_t>(n) * n) % two_N);
+        table[n] = power_of_w(cfg.direction * k, 2 * N);
+    }
+
+    // Filter b_j = conj(c_j), wrapped around such that b_{L-j} = b_j
+    auto b = table.begin() + N;
+    b[0] = std::conj(table[0]);
+    for (int j = 1; j < N; ++j) {
+        b[j] = b[L - j] = std::conj(table[j]);
+    }
+
+    // In-place radix-2 forward DFT of the filter, scaled by 1/L
+    for (int i = 1, j = 0; i < L; ++i) {
+        int bit = L >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(b[i], b[j]);
+        }
+    }
+    for (int len = 2; len <= L; len *= 2) {
+        for (int i = 0; i < L; i += len) {
+            for (int j = 0; j < len / 2; ++j) {
+                auto u = b[i + j];
+                auto v = b[i + j + len / 2] * power_of_w(-j, len);
+                b[i + j] = u + v;
+                b[i + j + len / 2] = u - v;
+            }
+        }
+    }
+    for (int j = 0; j < L; ++j) {
+        b[j] /= static_cast<double>(L);
+    }
+    return table;
+}
+
+namespace {
+
+auto make_kernel_builder(bluestein_configuration const &cfg, std::string const &name) {
+    auto fb = kernel_builder{name};
+    fb.attribute(reqd_work_group_size(static_cast<int>(cfg.Mb), static_cast<int>(cfg.Nb), 1));
+    return fb;
+}
+
+auto make_tmp_view(bluestein_configuration const &cfg, expr tmp, data_type tmp_ty) {
+    return tensor_view(std::make_shared<array_accessor>(std::move(tmp), std::move(tmp_ty)),
+                       std::array<expr, 3u>{cfg.M, cfg.L, 0u},
+                       std::array<expr, 3u>{1u, cfg.M, cfg.M * cfg.L});
+}
+
+/**
+ * @brief Pre-multiplication: tmp(m,n,k) = c_n * x(m,n,k) for n < N and zero for N <= n < L
+ */
+func make_pre_kernel(bluestein_configuration const &cfg, std::string const &name) {
+    auto fph = precision_helper{cfg.fp};
+    short in_components = cfg.type == transform_type::r2c ? 1 : 2;
+    std::size_t N_in = cfg.type == transform_type::c2r ? cfg.N / 2 + 1 : cfg.N;
+
+    auto in = var("in");
+    auto tmp = var("tmp");
+    auto twiddle = var("twiddle");
+    auto in_ty = fph.type(in_components, address_space::global_t);
+    auto tmp_ty = fph.type(2, address_space::global_t);
+
+    auto fb = make_kernel_builder(cfg, name);
+    fb.argument(pointer_to(in_ty), in);
+    fb.argument(pointer_to(tmp_ty), tmp);
+    fb.argument(pointer_to(fph.type(2, address_space::global_t)), twiddle);
+
+    std::shared_ptr<tensor_accessor> in_acc;
+    if (cfg.load_function) {
+        in_acc = std::make_shared<callback_accessor>(in, in_ty, cfg.load_function);
+    } else {
+        in_acc = std::make_shared<array_accessor>(in, in_ty);
+    }
+
+    fb.body([&](block_builder &bb) {
+        auto m = bb.declare_assign(generic_size(), "m", get_global_id(0));
+        auto n = bb.declare_assign(generic_size(), "n", get_global_id(1));
+        auto k = bb.declare_assign(generic_size(), "k", get_global_id(2));
+        auto in_view =
+            tensor_view(in_acc, {cfg.M, N_in, 0u},
+                        std::array<expr, 3u>{cfg.istride[0], cfg.istride[1], cfg.istride[2]});
+        auto tmp_view = make_tmp_view(cfg, tmp, tmp_ty);
+
+        bb.add(
+            if_selection_builder(m < cfg.M && n < cfg.L)
+                .then([&](block_builder &bb) {
+                    auto x = bb.declare_assign(fph.type(2), "x", fph.zero());
+                    bb.add(if_selection_builder(n < cfg.N)
+                               .then([&](block_builder &bb) {
+                                   switch (cfg.type) {
+                                   case transform_type::r2c:
+                                       bb.assign(x, init_vector(fph.type(2),
+                                                                {in_view(m, n, k), fph.zero()}));
+                                       break;
+                                   case transform_type::c2r: {
+                                       // Extend conjugate even input to full length
+                                       auto j = bb.declare_assign(
+                                           generic_size(), "j",
+                                           ternary_conditional(n <= cfg.N / 2, n, expr(cfg.N) - n));
+                                       bb.assign(x, in_view(m, j, k));
+                                       bb.add(if_selection_builder(n > cfg.N / 2)
+                                                  .then([&](block_builder &bb) {
+                                                      bb.assign(x.s(1), -x.s(1));
+                                                  })
+                                                  .get_product());
+                                       bb.add(if_selection_builder(n == 0u || 2u * n == cfg.N)
+                                                  .then([&](block_builder &bb) {
+                                                      bb.assign(x.s(1), fph.zero());
+                                                  })
+                                                  .get_product());
+                                       break;
+                                   }
+                                   default:
+                                       bb.assign(x, in_view(m, n, k));
+                                       break;
+                                   }
+                                   bb.assign(x, complex_mul(fph)(x, twiddle[n]));
+                               })
+                               .get_product());
+                    bb.add(tmp_view.store(x, m, n, k));
+                })
+                .get_product());
+    });
+    return fb.get_product();
+}
+
+/**
+ * @brief Point-wise multiplication with filter: tmp(m,n,k) *= DFT(b)_n / L
+ */
+func make_mul_kernel(bluestein_configuration const &cfg, std::string const &name) {
+    auto fph = precision_helper{cfg.fp};
+
+    auto tmp = var("tmp");
+    auto twiddle = var("twiddle");
+    auto tmp_ty = fph.type(2, address_space::global_t);
+
+    auto fb = make_kernel_builder(cfg, name);
+    fb.argument(pointer_to(tmp_ty), tmp);
+    fb.argument(pointer_to(fph.type(2, address_space::global_t)), twiddle);
+
+    fb.body([&](block_builder &bb) {
+        auto m = bb.declare_assign(generic_size(), "m", get_global_id(0));
+        auto n = bb.declare_assign(generic_size(), "n", get_global_id(1));
+        auto k = bb.declare_assign(generic_size(), "k", get_global_id(2));
+        auto tmp_view = make_tmp_view(cfg, tmp, tmp_ty);
+
+        bb.add(if_selection_builder(m < cfg.M && n < cfg.L)
+                   .then([&](block_builder &bb) {
+                       auto x = bb.declare_assign(fph.type(2), "x", tmp_view(m, n, k));
+                       bb.add(tmp_view.store(complex_mul(fph)(x, twiddle[cfg.N + n]), m, n, k));
+                   })
+                   .get_product());
+    });
+    return fb.get_product();
+}
+
+/**
+ * @brief Post-multiplication: y(m,n,k) = c_n * tmp(m,n,k)
+ */
+func make_post_kernel(bluestein_configuration const &cfg, std::string const &name) {
+    auto fph = precision_helper{cfg.fp};
+    short out_components = cfg.type == transform_type::c2r ? 1 : 2;
+    std::size_t N_out = cfg.type == transform_type::r2c ? cfg.N / 2 + 1 : cfg.N;
+
+    auto tmp = var("tmp");
+    auto out = var("out");
+    auto twiddle = var("twiddle");
+    auto tmp_ty = fph.type(2, address_space::global_t);
+    auto out_ty = fph.type(out_components, address_space::global_t);
+
+    auto fb = make_kernel_builder(cfg, name);
+    fb.argument(pointer_to(tmp_ty), tmp);
+    fb.argument(pointer_to(out_ty), out);
+    fb.argument(pointer_to(fph.type(2, address_space::global_t)), twiddle);
+
+    std::shared_ptr<tensor_accessor> out_acc;
+    if (cfg.store_function) {
+        out_acc = std::make_shared<callback_accessor>(out, out_ty, nullptr, cfg.store_function);
+    } else {
+        out_acc = std::make_shared<array_accessor>(out, out_ty);
+    }
+
+    fb.body([&](block_builder &bb) {
+        auto m = bb.declare_assign(generic_size(), "m", get_global_id(0));
+        auto n = bb.declare_assign(generic_size(), "n", get_global_id(1));
+        auto k = bb.declare_assign(generic_size(), "k", get_global_id(2));
+        auto tmp_view = make_tmp_view(cfg, tmp, tmp_ty);
+        auto out_view =
+            tensor_view(out_acc, {cfg.M, N_out, 0u},
+                        std::array<expr, 3u>{cfg.ostride[0], cfg.ostride[1], cfg.ostride[2]});
+
+        bb.add(if_selection_builder(m < cfg.M && n < N_out)
+                   .then([&](block_builder &bb) {
+                       auto y = bb.declare_assign(fph.type(2), "y", tmp_view(m, n, k));
+                       bb.assign(y, complex_mul(fph)(y, twiddle[n]));
+                       if (cfg.scale != 1.0) {
+                           bb.assign(y, y * fph.constant(cfg.scale));
+                       }
+                       if (cfg.type == transform_type::c2r) {
+                           bb.add(out_view.store(y.s(0), m, n, k));
+                       } else {
+                           bb.add(out_view.store(y, m, n, k));
+                       }
+                   })
+                   .get_product());
+    });
+    return fb.get_product();
+}
+
+} // namespace
+
+void generate_bluestein_fft(std::ostream &os, bluestein_configuration const &cfg,
+                            std::string_view name) {
+    if (cfg.L < 2 * cfg.N - 1) {
+        throw bad_configuration("Convolution length must satisfy L >= 2N-1.");
+    }
+    auto prefix = name.empty() ? cfg.identifier() : std::string(name);
+    for (auto f : {make_pre_kernel(cfg, prefix + "_pre"), make_mul_kernel(cfg, prefix + "_mul"),
+                   make_post_kernel(cfg, prefix + "_post")}) {
+        make_names_unique(f);
+        unsafe_simplify(f);
+        generate_kernel(os, f);
+    }
+}
+
+} // namespace bbfft
@@ -0,0 +1,93 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "bbfft/bad_configuration.hpp"
+#include "bbfft/configuration.hpp"
+#include "bbfft/convolution_configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
+#include "generator/sbfft_gen.hpp"
+#include "generator/utility.hpp"
+
+#include "clir/attr_defs.hpp"
+#include "clir/builder.hpp"
+#include "clir/builtin_function.hpp"
+#include "clir/builtin_type.hpp"
+#include "clir/data_type.hpp"
+#include "clir/expr.hpp"
+#include "clir/var.hpp"
+#include "clir/visitor/unique_names.hpp"
+#include "clir/visitor/unsafe_simplification.hpp"
+
+#include <sstream>
+#include <string>
+#include <utility>
+
+using namespace clir;
+
+namespace bbfft {
+
+convolution_fft_configuration configure_convolution_fft(convolution_configuration const &cfg,
+                                                        device_info const &info) {
+    if (compute_precision(cfg.fp) != cfg.fp) {
+        throw bad_configuration("Convolutions do not support 16-bit storage precisions.");
+    }
+    auto fft_cfg = configuration{1, {cfg.shape[0], cfg.shape[1], cfg.shape[2]}, cfg.fp,
+                                 direction::forward};
+    if (prefer_bluestein_fft(fft_cfg, info) || prefer_four_step_fft(fft_cfg, info) ||
+        !prefer_small_batch_fft(fft_cfg, info)) {
+        throw bad_configuration("Convolutions are only supported for transform lengths that "
+                                "are computed in registers by the small batch algorithm.");
+    }
+    return {configure_small_batch_fft(fft_cfg, info), cfg.type};
+}
+
+std::string convolution_fft_configuration::identifier() const {
+    std::ostringstream oss;
+    // Replace the "sbfft_" prefix of the forward FFT
+    oss << (type == convolution_type::correlation ? "crfft_" : "cvfft_")
+        << fft.identifier().substr(6);
+    return oss.str();
+}
+
+void generate_convolution_fft(std::ostream &os, convolution_fft_configuration const &cfg,
+                              std::string_view name) {
+    auto const &sbc = cfg.fft;
+    if (sbc.type != transform_type::c2c) {
+        throw bad_configuration("Convolutions require a c2c transform.");
+    }
+    auto in = var("in");
+    auto out = var("out");
+    auto K = var("K");
+    auto filter = var("filter");
+
+    auto gen = sbfft_gen_c2c(sbc.N);
+    auto [in_ty, out_ty] = gen.argument_types(sbc);
+    auto fph = precision_helper{sbc.fp};
+
+    auto fb = kernel_builder{name.empty() ? cfg.identifier() : std::string(name)};
+    fb.argument(pointer_to(in_ty), in);
+    fb.argument(pointer_to(out_ty), out);
+    fb.argument(generic_ulong(), K);
+    fb.argument(pointer_to(fph.type(2, address_space::global_t)), filter);
+    fb.attribute(reqd_work_group_size(static_cast<int>(sbc.Mb), static_cast<int>(sbc.Kb), 1));
+    fb.attribute(intel_reqd_sub_group_size(static_cast<int>(sbc.sgs)));
+
+    auto [in_acc, out_acc] = gen.accessors(sbc, in, out);
+
+    fb.body([&](block_builder &bb) {
+        auto X1 =
+            bb.declare(array_of(fph.type(2, address_space::local_t), gen.slm_size(sbc)), "X1");
+        bool const correlation = cfg.type == convolution_type::correlation;
+        auto bp = sbfft_gen::body_params{
+            in_acc, out_acc, K, X1, get_group_id(0), get_group_id(1), filter, correlation};
+        gen.generate_body(bb, sbc, std::move(bp));
+    });
+
+    auto f = fb.get_product();
+    make_names_unique(f);
+    unsafe_simplify(f);
+
+    generate_kernel(os, f);
+}
+
+} // namespace bbfft
@@ -15,7 +15,6 @@
 #include "clir/expr.hpp"
 #include "clir/stmt.hpp"
 #include "clir/var.hpp"
-#include "clir/visitor/codegen_opencl.hpp"
 #include "clir/visitor/unique_names.hpp"
 #include "clir/visitor/unsafe_simplification.hpp"
 
@@ -45,37 +44,36 @@ void parallel_2d_loop(block_builder &bb, expr n_local, std::size_t Nb, std::size
 
 void f2fft_gen::generate(std::ostream &os, factor2_slm_configuration const &cfg,
                          std::string_view name) const {
-    if (cfg.factorization.size() < 2) {
-        throw bad_configuration("At least 2 factors are required.");
-    }
-
     auto in = var("in");
     auto out = var("out");
     auto twiddle = var("twiddle");
     auto K = var("K");
 
-    auto const tw2N_offset = [](std::vector<int> const &factorization) {
-        int N = factorization[0] * factorization[1];
-        int offset = N;
-        for (std::size_t k = 2; k < factorization.size(); ++k) {
-            N *= factorization[k];
-            offset += N;
-        }
-        return offset;
-    };
-
     auto fph = precision_helper{cfg.fp};
-    auto in_ty = fph.type(p_.in_components, address_space::global_t);
-    auto out_ty = fph.type(p_.out_components, address_space::global_t);
+    bool const planar_in = cfg.planar_offset[0] != 0;
+    bool const planar_out = cfg.planar_offset[1] != 0;
+    auto in_ty = planar_in ? fph.type(address_space::global_t)
+                           : fph.storage_type(p_.in_components, address_space::global_t);
+    auto out_ty = planar_out ? fph.type(address_space::global_t)
+                             : fph.storage_type(p_.out_components, address_space::global_t);
     auto slm_ty = fph.type(2, address_space::local_t);
 
-    auto fft_inplace = &generate_fft::pair_optimization_inplace;
-
     auto fb = kernel_builder{name.empty() ? cfg.identifier() : std::string(name)};
     fb.argument(pointer_to(in_ty), in);
     fb.argument(pointer_to(out_ty), out);
     fb.argument(pointer_to(fph.type(2, address_space::constant_t)), twiddle);
     fb.argument(generic_ulong(), K);
+    expr in_im = nullptr, out_im = nullptr;
+    if (planar_in) {
+        auto v = var("in_im");
+        fb.argument(pointer_to(in_ty), v);
+        in_im = std::move(v);
+    }
+    if (planar_out) {
+        auto v = var("out_im");
+        fb.argument(pointer_to(out_ty), v);
+        out_im = std::move(v);
+    }
     fb.attribute(reqd_work_group_size(static_cast<int>(cfg.Mb), static_cast<int>(cfg.Nb),
                                       static_cast<int>(cfg.Kb)));
     fb.attribute(intel_reqd_sub_group_size(static_cast<int>(cfg.sgs)));
@@ -83,11 +81,19 @@ void f2fft_gen::generate(std::ostream &os, factor2_slm_configuration const &cfg,
     std::shared_ptr<tensor_accessor> in_acc, out_acc;
     if (cfg.load_function) {
         in_acc = std::make_shared<callback_accessor>(in, in_ty, cfg.load_function);
+    } else if (planar_in) {
+        in_acc = std::make_shared<array_accessor>(in, in_im, cfg.fp);
+    } else if (fph.converts_storage()) {
+        in_acc = std::make_shared<storage_accessor>(in, cfg.fp, p_.in_components);
     } else {
         in_acc = std::make_shared<array_accessor>(in, in_ty);
     }
     if (cfg.store_function) {
         out_acc = std::make_shared<callback_accessor>(out, out_ty, nullptr, cfg.store_function);
+    } else if (planar_out) {
+        out_acc = std::make_shared<array_accessor>(out, out_im, cfg.fp);
+    } else if (fph.converts_storage()) {
+        out_acc = std::make_shared<storage_accessor>(out, cfg.fp, p_.out_components);
     } else {
         out_acc = std::make_shared<array_accessor>(out, out_ty);
     }
@@ -109,77 +115,106 @@ void f2fft_gen::generate(std::ostream &os, factor2_slm_configuration const &cfg,
             tensor_view(out_acc, {cfg.M, p_.N_out, K},
                         std::array<expr, 3u>{cfg.ostride[0], cfg.ostride[1], cfg.ostride[2]});
 
-        auto compute_stage = [&](block_builder &bb, int const f, int const J1, int const Nf,
-                                 int const J2, expr j1, expr j2, int const tw_offset) {
-            auto xy_ty_Nf = data_type(array_of(fph.type(2), Nf));
-            auto x = bb.declare(xy_ty_Nf, "x");
-            auto x_acc = std::make_shared<array_accessor>(x, xy_ty_Nf);
-            auto x_view = tensor_view(x_acc, std::array<expr, 1u>{Nf});
-
-            if (f == static_cast<int>(cfg.factorization.size() - 1)) {
-                load(bb, copy_params{cfg, fph, in_view, X1_view, x_view, x_acc, mm, kk, K, j1});
-            } else {
-                auto X1_view_1d = X1_view.reshaped_mode(0, std::array<expr, 3u>{J1, Nf, J2})
-                                      .subview(bb, j1, slice{}, j2);
-                copy_N_block(bb, X1_view_1d, x_view, Nf, Nf);
-            }
-
-            auto factor = trial_division(Nf);
-            expr tw_j1 = nullptr;
-            if (f > 0) {
-                tw_j1 = bb.declare_assign(pointer_to(fph.type(2, address_space::constant_t)),
-                                          "tw_j1", twiddle + tw_offset + j1 * Nf);
-            }
-            fft_inplace(bb, cfg.fp, cfg.direction, factor, x, tw_j1);
-
-            auto X1_view_1d = X1_view.reshaped_mode(0, std::array<expr, 3u>{J1, Nf, J2})
-                                  .subview(bb, j1, slice{}, j2);
-            copy_N_block_with_permutation(bb, x_view, X1_view_1d, Nf, unscrambler(factor));
-        };
-
-        preprocess(bb, prepost_params{cfg, fph, in_view, X1_view, mm, n_local, kk, K,
-                                      twiddle + tw2N_offset(cfg.factorization)});
-
-        int J1 = product(cfg.factorization.begin(), cfg.factorization.end(), 1);
-        int J2 = 1;
-        int tw_offset = 0;
-        int const L = cfg.factorization.size();
-        for (int f = L - 1; f >= 0; --f) {
-            int const Nf = cfg.factorization[f];
-            J1 /= Nf;
-
-            parallel_2d_loop(bb, n_local, cfg.Nb, J1 * J2, [&](expr &loop_var) {
-                return [&](block_builder &bb) {
-                    if (J2 == 1) {
-                        compute_stage(bb, f, J1, Nf, J2, loop_var, 0, tw_offset);
-                    } else if (J1 == 1) {
-                        compute_stage(bb, f, J1, Nf, J2, 0, loop_var, tw_offset);
-                    } else {
-                        auto j1 = bb.declare_assign(generic_short(), "j1", loop_var % J1);
-                        auto j2 = bb.declare_assign(generic_short(), "j2", loop_var / J1);
-                        compute_stage(bb, f, J1, Nf, J2, j1, j2, tw_offset);
-                    }
-                };
-            });
-
-            J2 *= Nf;
-            tw_offset += J1 * Nf;
-            bb.add(barrier(cl_mem_fence_flags::CLK_LOCAL_MEM_FENCE));
-        }
-
-        auto unscramble =
-            unscrambler<clir::expr>(cfg.factorization.begin(), cfg.factorization.end());
-        unscramble.in0toN(true);
-        postprocess(bb, prepost_params{cfg, fph, out_view, X1_view, mm, n_local, kk, K,
-                                       twiddle + tw2N_offset(cfg.factorization),
-                                       std::move(unscramble)});
+        generate_body(bb, cfg,
+                      body_params{in_view, out_view, X1_view, mm, kk, n_local, K, twiddle});
     });
 
     auto f = fb.get_product();
     make_names_unique(f);
     unsafe_simplify(f);
 
-    generate_opencl(os, f);
+    generate_kernel(os, f);
+}
+
+void f2fft_gen::generate_body(block_builder &bb, factor2_slm_configuration const &cfg,
+                              body_params bp) const {
+    if (cfg.factorization.size() < 2) {
+        throw bad_configuration("At least 2 factors are required.");
+    }
+
+    auto const tw2N_offset = [](std::vector<int> const &factorization) {
+        int N = factorization[0] * factorization[1];
+        int offset = N;
+        for (std::size_t k = 2; k < factorization.size(); ++k) {
+            N *= factorization[k];
+            offset += N;
+        }
+        return offset;
+    };
+
+    auto fph = precision_helper{cfg.fp};
+    auto fft_inplace = &generate_fft::pair_optimization_inplace;
+
+    auto compute_stage = [&](block_builder &bb, int const f, int const J1, int const Nf,
+                             int const J2, expr j1, expr j2, int const tw_offset) {
+        auto xy_ty_Nf = data_type(array_of(fph.type(2), Nf));
+        auto x = bb.declare(xy_ty_Nf, "x");
+        auto x_acc = std::make_shared<array_accessor>(x, xy_ty_Nf);
+        auto x_view = tensor_view(x_acc, std::array<expr, 1u>{Nf});
+
+        if (f == static_cast<int>(cfg.factorization.size() - 1)) {
+            load(bb, copy_params{cfg, fph, bp.in_view, bp.X1_view, x_view, x_acc, bp.mm, bp.kk,
+                                 bp.K, j1});
+        } else {
+            auto X1_view_1d = bp.X1_view.reshaped_mode(0, std::array<expr, 3u>{J1, Nf, J2})
+                                     .subview(bb, j1, slice{}, j2);
+            copy_N_block(bb, X1_view_1d, x_view, Nf, Nf);
+        }
+
+        auto factor = trial_division(Nf);
+        expr tw_j1 = nullptr;
+        if (f > 0) {
+            tw_j1 = bb.declare_assign(pointer_to(fph.type(2, address_space::constant_t)),
+                                      "tw_j1", bp.twiddle + tw_offset + j1 * Nf);
+        }
+        fft_inplace(bb, cfg.fp, cfg.direction, factor, x, tw_j1, 0);
+        // Fold the scale factor into the last stage
+        if (f == 0 && cfg.scale != 1.0) {
+            for (int i = 0; i < Nf; ++i) {
+                bb.assign(x[i], x[i] * fph.constant(cfg.scale));
+            }
+        }
+
+        auto X1_view_1d = bp.X1_view.reshaped_mode(0, std::array<expr, 3u>{J1, Nf, J2})
+                                 .subview(bb, j1, slice{}, j2);
+        copy_N_block_with_permutation(bb, x_view, X1_view_1d, Nf, unscrambler(factor));
+    };
+
+    preprocess(bb, prepost_params{cfg, fph, bp.in_view, bp.X1_view, bp.mm, bp.n_local, bp.kk,
+                                  bp.K, bp.twiddle + tw2N_offset(cfg.factorization)});
+
+    int J1 = product(cfg.factorization.begin(), cfg.factorization.end(), 1);
+    int J2 = 1;
+    int tw_offset = 0;
+    int const L = cfg.factorization.size();
+    for (int f = L - 1; f >= 0; --f) {
+        int const Nf = cfg.factorization[f];
+        J1 /= Nf;
+
+        parallel_2d_loop(bb, bp.n_local, cfg.Nb, J1 * J2, [&](expr &loop_var) {
+            return [&](block_builder &bb) {
+                if (J2 == 1) {
+                    compute_stage(bb, f, J1, Nf, J2, loop_var, 0, tw_offset);
+                } else if (J1 == 1) {
+                    compute_stage(bb, f, J1, Nf, J2, 0, loop_var, tw_offset);
+                } else {
+                    auto j1 = bb.declare_assign(generic_short(), "j1", loop_var % J1);
+                    auto j2 = bb.declare_assign(generic_short(), "j2", loop_var / J1);
+                    compute_stage(bb, f, J1, Nf, J2, j1, j2, tw_offset);
+                }
+            };
+        });
+
+        J2 *= Nf;
+        tw_offset += J1 * Nf;
+        bb.add(barrier(cl_mem_fence_flags::CLK_LOCAL_MEM_FENCE));
+    }
+
+    auto unscramble = unscrambler<clir::expr>(cfg.factorization.begin(), cfg.factorization.end());
+    unscramble.in0toN(true);
+    postprocess(bb, prepost_params{cfg, fph, bp.out_view, bp.X1_view, bp.mm, bp.n_local, bp.kk,
+                                   bp.K, bp.twiddle + tw2N_offset(cfg.factorization),
+                                   std::move(unscramble)});
 }
 
 void f2fft_gen::global_load(block_builder &bb, copy_params const &cp, expr k,
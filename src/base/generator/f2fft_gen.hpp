@@ -30,8 +30,27 @@ class f2fft_gen {
     f2fft_gen(gen_cfg p) : p_(p) {}
     virtual ~f2fft_gen() {}
 
+    struct body_params {
+        tensor_view<3u> const &in_view;
+        tensor_view<3u> const &out_view;
+        tensor_view<1u> const &X1_view;
+        clir::expr mm;
+        clir::expr kk;
+        clir::expr n_local;
+        clir::expr K;
+        clir::expr twiddle;
+    };
+
     void generate(std::ostream &os, factor2_slm_configuration const &cfg,
                   std::string_view name) const;
+    /**
+     * @brief Generate the FFT of one work-group into an existing function body
+     *
+     * The caller declares the shared local memory X1 at kernel scope and passes the views of
+     * the input, output, and X1 together with the batch indices and the twiddle table.
+     */
+    void generate_body(clir::block_builder &bb, factor2_slm_configuration const &cfg,
+                       body_params bp) const;
     inline auto const &p() const { return p_; }
 
   protected:
@@ -1,20 +1,28 @@
 // Copyright (C) 2022 Intel Corporation
 // SPDX-License-Identifier: BSD-3-Clause
 
+#include "bbfft/bad_configuration.hpp"
 #include "bbfft/configuration.hpp"
+#include "bbfft/wisdom.hpp"
 #include "generator/f2fft_gen.hpp"
+#include "generator/utility.hpp"
 #include "math.hpp"
 #include "prime_factorization.hpp"
+#include "root_of_unity.hpp"
 
 #include <algorithm>
 #include <cmath>
+#include <complex>
 #include <sstream>
 #include <stdexcept>
+#include <vector>
 
 namespace bbfft {
 
-factor2_slm_configuration configure_factor2_slm_fft(configuration const &cfg,
-                                                    device_info const &info) {
+namespace {
+
+factor2_slm_configuration heuristic_factor2_slm_configuration(configuration const &cfg,
+                                                              device_info const &info) {
     bool const is_real = cfg.type == transform_type::r2c || cfg.type == transform_type::c2r;
     std::size_t N = cfg.shape[1];
     std::size_t N_fft = N;
@@ -27,7 +35,7 @@ factor2_slm_configuration configure_factor2_slm_fft(configuration const &cfg,
     }
 
     std::size_t sgs = info.min_subgroup_size();
-    std::size_t sizeof_real = static_cast<std::size_t>(cfg.fp);
+    std::size_t sizeof_real = size_in_bytes(compute_precision(cfg.fp));
     unsigned max_N_in_registers_without_spilling =
         (info.register_space_max() / 2) / (2 * sizeof_real) / sgs;
 
@@ -81,10 +89,95 @@ factor2_slm_configuration configure_factor2_slm_fft(configuration const &cfg,
         ostride,                                                      // ostride
         inplace_unsupported,                                          // inplace_unsupported
         cfg.callbacks.load_function,                                  // load_function
-        cfg.callbacks.store_function                                  // store_function
+        cfg.callbacks.store_function,                                 // store_function
+        cfg.planar_offset,                                            // planar_offset
+        cfg.scale                                                     // scale
     };
 }
 
+} // namespace
+
+factor2_slm_configuration configure_factor2_slm_fft(configuration const &cfg,
+                                                    device_info const &info) {
+    if (auto tc = lookup_wisdom(cfg, info); tc.algorithm == tuning_algorithm::factor2_slm) {
+        return configure_factor2_slm_fft(cfg, info, tc);
+    }
+    return heuristic_factor2_slm_configuration(cfg, info);
+}
+
+factor2_slm_configuration configure_factor2_slm_fft(configuration const &cfg,
+                                                    device_info const &info,
+                                                    tuning_candidate const &tc) {
+    if (tc.algorithm != tuning_algorithm::factor2_slm) {
+        throw bad_configuration("The tuning candidate does not select the factor2 SLM algorithm.");
+    }
+    auto f2c = heuristic_factor2_slm_configuration(cfg, info);
+    bool const is_real = cfg.type == transform_type::r2c || cfg.type == transform_type::c2r;
+    std::size_t N_fft = is_real && f2c.N % 2 == 0 ? f2c.N / 2 : f2c.N;
+    std::size_t N_slm = is_real ? N_fft + 1 : N_fft;
+    std::size_t sizeof_real = size_in_bytes(compute_precision(cfg.fp));
+    if (tc.factorization.size() < 2 ||
+        product(tc.factorization.begin(), tc.factorization.end(), 1) !=
+            static_cast<int>(N_fft)) {
+        throw bad_configuration("The factorization of the tuning candidate does not match the "
+                                "transform length.");
+    }
+    if (std::find(info.subgroup_sizes.begin(), info.subgroup_sizes.end(), tc.sgs) ==
+            info.subgroup_sizes.end() ||
+        tc.Mb == 0 || tc.Nb == 0 || tc.Kb == 0 ||
+        tc.Mb * tc.Nb * tc.Kb > info.max_work_group_size ||
+        2 * tc.Mb * tc.Kb * N_slm * sizeof_real > info.local_memory_size) {
+        throw bad_configuration("The tuning candidate exceeds the limits of the device.");
+    }
+    f2c.Mb = tc.Mb;
+    f2c.Nb = tc.Nb;
+    f2c.Kb = tc.Kb;
+    f2c.sgs = tc.sgs;
+    f2c.factorization = tc.factorization;
+    f2c.inplace_unsupported = is_real && f2c.Mb < f2c.M;
+    return f2c;
+}
+
+std::vector<std::complex<double>>
+factor2_slm_twiddle_table(factor2_slm_configuration const &cfg) {
+    auto const &factorization = cfg.factorization;
+    if (factorization.size() < 2) {
+        throw bad_configuration("At least 2 factors are required.");
+    }
+    bool const is_real = cfg.type == transform_type::r2c || cfg.type == transform_type::c2r;
+    bool const have_2N = is_real && cfg.N % 2 == 0;
+
+    int N = factorization[0] * factorization[1];
+    int tw_size = N;
+    auto const L = factorization.size();
+    for (std::size_t k = 2; k < L; ++k) {
+        N *= factorization[k];
+        tw_size += N;
+    }
+    tw_size += have_2N * N;
+
+    auto twiddle = std::vector<std::complex<double>>(tw_size);
+    auto tw_ptr = twiddle.data();
+    int J1 = N;
+    for (int f = L - 1; f >= 1; --f) {
+        auto const Nf = factorization[f];
+        J1 /= Nf;
+        for (int i = 0; i < J1; ++i) {
+            for (int j = 0; j < Nf; ++j) {
+                tw_ptr[j + Nf * i] = power_of_w(cfg.direction * i * j, J1 * Nf);
+            }
+        }
+        tw_ptr += J1 * Nf;
+    }
+    if (have_2N) {
+        for (int i = 0; i < N; ++i) {
+            // pre-multiplied with sqrt(-1)
+            tw_ptr[i] = power_of_w(cfg.direction * i, 2 * N) * std::complex<double>{0.0, 1.0};
+        }
+    }
+    return twiddle;
+}
+
 std::string factor2_slm_configuration::identifier() const {
     std::ostringstream oss;
     oss << "f2fft_" << (direction < 0 ? 'm' : 'p') << std::abs(direction) << "_M" << M << "_Mb"
@@ -96,7 +189,7 @@ std::string factor2_slm_configuration::identifier() const {
             oss << "x" << *it;
         }
     }
-    oss << "_Nb" << Nb << "_Kb" << Kb << "_sgs" << sgs << "_f" << static_cast<int>(fp) * 8 << '_'
+    oss << "_Nb" << Nb << "_Kb" << Kb << "_sgs" << sgs << "_" << to_string(fp) << '_'
         << to_string(type) << "_is";
     for (auto const &is : istride) {
         oss << is << "_";
@@ -112,6 +205,10 @@ std::string factor2_slm_configuration::identifier() const {
     if (store_function) {
         oss << "_" << store_function;
     }
+    if (planar_offset[0] || planar_offset[1]) {
+        oss << "_pl" << (planar_offset[0] != 0) << (planar_offset[1] != 0);
+    }
+    oss << scale_identifier(scale);
     return oss.str();
 }
 
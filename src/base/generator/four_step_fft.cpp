@@ -0,0 +1,96 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "bbfft/bad_configuration.hpp"
+#include "bbfft/configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
+#include "generator/utility.hpp"
+#include "mixed_radix_fft.hpp"
+
+#include "clir/builder.hpp"
+#include "clir/builtin_function.hpp"
+#include "clir/builtin_type.hpp"
+#include "clir/data_type.hpp"
+#include "clir/expr.hpp"
+#include "clir/var.hpp"
+#include "clir/visitor/unique_names.hpp"
+#include "clir/visitor/unsafe_simplification.hpp"
+
+#include <cmath>
+#include <sstream>
+
+using namespace clir;
+
+namespace bbfft {
+
+bool prefer_four_step_fft(configuration const &cfg, device_info const &info) {
+    std::size_t N = cfg.shape[1];
+    std::size_t sizeof_complex = 2 * size_in_bytes(compute_precision(cfg.fp));
+    return N * sizeof_complex > info.local_memory_size;
+}
+
+four_step_configuration configure_four_step_fft(configuration const &cfg, device_info const &) {
+    if (compute_precision(cfg.fp) != cfg.fp) {
+        throw bad_configuration("The four-step FFT does not support 16-bit storage precisions.");
+    }
+    if (cfg.planar_offset[0] != 0 || cfg.planar_offset[1] != 0) {
+        throw bad_configuration("The four-step FFT does not support the planar layout.");
+    }
+    std::size_t N = cfg.shape[1];
+    std::size_t N2 = static_cast<std::size_t>(std::sqrt(static_cast<double>(N)));
+    while (N2 > 1 && N % N2 != 0) {
+        --N2;
+    }
+    return {
+        static_cast<int>(cfg.dir), // direction
+        cfg.shape[0],              // M
+        N / N2,                    // N1
+        N2,                        // N2
+        cfg.fp                     // precision
+    };
+}
+
+std::string four_step_configuration::identifier() const {
+    std::ostringstream oss;
+    oss << "four_step_" << (direction < 0 ? 'm' : 'p') << std::abs(direction) << "_M" << M
+        << "_N" << N1 << "x" << N2 << "_" << to_string(fp);
+    return oss.str();
+}
+
+void generate_four_step_fft_twiddle(std::ostream &os, four_step_configuration const &cfg,
+                                    std::string_view name) {
+    auto fph = precision_helper{cfg.fp};
+    auto out_ty = fph.type(2, address_space::global_t);
+    std::size_t const N = cfg.N1 * cfg.N2;
+
+    auto out = var("out");
+    auto offset = var("offset");
+    auto value = var("value");
+
+    auto fb = function_builder{name.empty() ? cfg.identifier() : std::string(name)};
+    fb.argument(pointer_to(out_ty), out);
+    fb.argument(generic_size(), offset);
+    fb.argument(fph.type(2), value);
+    fb.body([&](block_builder &bb) {
+        // offset = m + M * n1 + M * N1 * k1 + M * N * k
+        auto m = bb.declare_assign(generic_size(), "m", offset % cfg.M);
+        auto n1 = bb.declare_assign(generic_size(), "n1", offset / cfg.M % cfg.N1);
+        auto k1 = bb.declare_assign(generic_size(), "k1", offset / (cfg.M * cfg.N1) % cfg.N2);
+        auto k = bb.declare_assign(generic_size(), "k", offset / (cfg.M * N));
+        // w_N^(n1 * k1) with exact integer phase reduction
+        auto phi = bb.declare_assign(fph.type(), "phi",
+                                     cast(fph.type(), n1 * k1 % N) * fph.constant(2.0 / N));
+        auto w = bb.declare_assign(
+            fph.type(2), "w",
+            init_vector(fph.type(2), {cospi(phi), fph.constant(cfg.direction) * sinpi(phi)}));
+        // Transposed store: Y(m, k1, n1, k)
+        bb.assign(out[m + k1 * cfg.M + n1 * (cfg.M * cfg.N2) + k * (cfg.M * N)],
+                  complex_mul(fph)(value, w));
+    });
+    auto f = fb.get_product();
+    make_names_unique(f);
+    unsafe_simplify(f);
+    generate_kernel(os, f);
+}
+
+} // namespace bbfft
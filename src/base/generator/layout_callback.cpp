@@ -0,0 +1,102 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "bbfft/configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
+#include "generator/utility.hpp"
+
+#include "clir/builder.hpp"
+#include "clir/data_type.hpp"
+#include "clir/expr.hpp"
+#include "clir/var.hpp"
+
+#include <sstream>
+#include <utility>
+
+using namespace clir;
+
+namespace bbfft {
+
+std::string layout_callback_configuration::identifier() const {
+    std::ostringstream oss;
+    oss << "layout_" << (is_complex ? 'c' : 'r') << "_" << to_string(fp) << "_s"
+        << shape[0];
+    for (unsigned d = 1; d < dim + 2; ++d) {
+        oss << "x" << shape[d];
+    }
+    oss << "_st" << stride[0];
+    for (unsigned d = 1; d < dim + 2; ++d) {
+        oss << "_" << stride[d];
+    }
+    if (user_function) {
+        oss << "_" << user_function;
+    }
+    return oss.str();
+}
+
+namespace {
+
+expr strided_offset(layout_callback_configuration const &cfg, expr offset) {
+    expr result = nullptr;
+    std::size_t S = 1;
+    for (unsigned d = 0; d < cfg.dim + 2; ++d) {
+        if (cfg.shape[d] == 1) {
+            continue;
+        }
+        expr idx = S > 1 ? offset / S : offset;
+        if (d + 1 < cfg.dim + 2) {
+            idx = idx % cfg.shape[d];
+        }
+        idx = idx * cfg.stride[d];
+        result = result ? result + std::move(idx) : std::move(idx);
+        S *= cfg.shape[d];
+    }
+    return result ? result : expr(0);
+}
+
+void generate_layout_callback(std::ostream &os, layout_callback_configuration const &cfg,
+                              std::string_view name, bool is_store) {
+    auto fph = precision_helper{cfg.fp};
+    auto value_ty = fph.type(cfg.is_complex ? 2 : 1);
+    auto x = var(is_store ? "out" : "in");
+    auto offset = var("offset");
+    auto fb = function_builder(name.empty() ? cfg.identifier() + (is_store ? "_store" : "_load")
+                                            : std::string(name));
+    fb.argument(pointer_to(fph.type(cfg.is_complex ? 2 : 1, address_space::global_t)), x);
+    fb.argument(generic_size(), offset);
+    if (is_store) {
+        auto value = var("value");
+        fb.argument(value_ty, value);
+        fb.body([&](block_builder &bb) {
+            if (cfg.user_function) {
+                bb.add(call(cfg.user_function, {x, strided_offset(cfg, offset), value}));
+            } else {
+                bb.add(assignment(x[strided_offset(cfg, offset)], value));
+            }
+        });
+    } else {
+        fb.return_type(value_ty);
+        fb.body([&](block_builder &bb) {
+            if (cfg.user_function) {
+                bb.return_value(call(cfg.user_function, {x, strided_offset(cfg, offset)}));
+            } else {
+                bb.return_value(x[strided_offset(cfg, offset)]);
+            }
+        });
+    }
+    generate_function(os, fb.get_product());
+}
+
+} // namespace
+
+void generate_layout_load_callback(std::ostream &os, layout_callback_configuration const &cfg,
+                                   std::string_view name) {
+    generate_layout_callback(os, cfg, name, false);
+}
+
+void generate_layout_store_callback(std::ostream &os, layout_callback_configuration const &cfg,
+                                    std::string_view name) {
+    generate_layout_callback(os, cfg, name, true);
+}
+
+} // namespace bbfft
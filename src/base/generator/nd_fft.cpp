@@ -0,0 +1,123 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "bbfft/configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace bbfft {
+
+namespace {
+
+bool is_default_stride(configuration const &cfg, bool inplace) {
+    auto const def_istride = default_istride(cfg.dim, cfg.shape, cfg.type, inplace);
+    auto const def_ostride = default_ostride(cfg.dim, cfg.shape, cfg.type, inplace);
+    for (unsigned d = 0; d < cfg.dim + 2; ++d) {
+        if (cfg.istride[d] != def_istride[d] || cfg.ostride[d] != def_ostride[d]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool is_packed(layout_callback_configuration const &lc) {
+    std::size_t S = 1;
+    for (unsigned d = 0; d < lc.dim + 2; ++d) {
+        if (lc.shape[d] > 1 && lc.stride[d] != S) {
+            return false;
+        }
+        S *= lc.shape[d];
+    }
+    return true;
+}
+
+} // namespace
+
+nd_fft_configuration configure_nd_fft(configuration const &cfg) {
+    unsigned dim = cfg.dim;
+    // Non-default layouts are read and written in the first and last pass through
+    // callbacks; intermediate results are stored in the default out-of-place layout
+    bool strided_layout = !is_default_stride(cfg, false) && !is_default_stride(cfg, true);
+    bool inplace_layout = !strided_layout && is_default_stride(cfg, true);
+
+    bool is_real = cfg.type == transform_type::r2c || cfg.type == transform_type::c2r;
+    auto Nd_complex = [&](unsigned d) {
+        return d == 0 && is_real ? cfg.shape[1] / 2 + 1 : cfg.shape[d + 1];
+    };
+    auto Nd_real = [&](unsigned d) {
+        return d == 0 && is_real && inplace_layout ? 2 * (cfg.shape[1] / 2 + 1) : cfg.shape[d + 1];
+    };
+
+    std::size_t N = 1;
+    for (unsigned d = 0; d < dim; ++d) {
+        N *= Nd_complex(d);
+    }
+
+    auto ndc = nd_fft_configuration{};
+    ndc.dim = dim;
+    std::size_t M = cfg.shape[0];
+    std::size_t K = N * cfg.shape[dim + 1];
+    for (unsigned d = 0; d < dim; ++d) {
+        std::size_t Nd = cfg.shape[d + 1];
+        std::size_t Ndc = Nd_complex(d);
+        K /= Ndc;
+        auto shape = std::array<std::size_t, max_tensor_dim>{M, Nd, K};
+        auto istride = std::array<std::size_t, max_tensor_dim>{1, M, M * Nd_real(d)};
+        auto ostride = std::array<std::size_t, max_tensor_dim>{1, M, M * Ndc};
+        auto type = d == 0 ? cfg.type : transform_type::c2c;
+        ndc.passes[d] = {1, shape, cfg.fp, cfg.dir, type, istride, ostride};
+        M *= Ndc;
+    }
+    if (cfg.type == transform_type::c2r) {
+        for (unsigned d = 0; d < dim / 2; ++d) {
+            std::swap(ndc.passes[d], ndc.passes[dim - 1 - d]);
+        }
+        for (unsigned d = 0; d < dim; ++d) {
+            std::swap(ndc.passes[d].istride, ndc.passes[d].ostride);
+        }
+    }
+    // The last pass applies the scale factor
+    ndc.passes[dim - 1].scale = cfg.scale;
+
+    auto const make_layout_cfg = [&](std::array<std::size_t, max_tensor_dim> const &stride,
+                                     bool is_complex) {
+        auto lc = layout_callback_configuration{dim, {}, stride, cfg.fp, is_complex};
+        lc.shape[0] = cfg.shape[0];
+        lc.shape[1] = is_complex ? Nd_complex(0) : cfg.shape[1];
+        for (unsigned d = 2; d < dim + 2; ++d) {
+            lc.shape[d] = cfg.shape[d];
+        }
+        return lc;
+    };
+    ndc.lin = make_layout_cfg(cfg.istride, cfg.type != transform_type::r2c);
+    ndc.lout = make_layout_cfg(cfg.ostride, cfg.type != transform_type::c2r);
+    if (cfg.callbacks) {
+        ndc.lin.user_function = cfg.callbacks.load_function;
+        ndc.lout.user_function = cfg.callbacks.store_function;
+    }
+    ndc.load_layout = strided_layout && !is_packed(ndc.lin);
+    ndc.store_layout = strided_layout && !is_packed(ndc.lout);
+
+    std::size_t bytes_per_real = size_in_bytes(cfg.fp);
+    std::size_t bytes_per_complex = 2 * bytes_per_real;
+    auto ibytes = cfg.type == transform_type::r2c ? bytes_per_real : bytes_per_complex;
+    auto obytes = cfg.type == transform_type::c2r ? bytes_per_real : bytes_per_complex;
+    auto isize = cfg.istride[dim + 1] * cfg.shape[dim + 1] * ibytes;
+    auto osize = cfg.ostride[dim + 1] * cfg.shape[dim + 1] * obytes;
+    if (strided_layout) {
+        // in and out may alias with different layouts, so out cannot hold temporaries
+        ndc.scratch_bytes = N * cfg.shape[dim + 1] * cfg.shape[0] * bytes_per_complex;
+    } else if (isize > osize) {
+        // if the input buffer is larger than the output buffer than temporaries are larger than
+        // the output buffer and we cannot reuse the output buffer for temporaries
+        ndc.scratch_bytes = isize;
+    } else {
+        ndc.scratch_bytes = 0;
+    }
+    return ndc;
+}
+
+} // namespace bbfft
@@ -0,0 +1,237 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "bbfft/bad_configuration.hpp"
+#include "bbfft/configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
+#include "generator/tensor_accessor.hpp"
+#include "generator/utility.hpp"
+#include "math.hpp"
+#include "mixed_radix_fft.hpp"
+#include "prime_factorization.hpp"
+#include "scrambler.hpp"
+
+#include "clir/attr_defs.hpp"
+#include "clir/builder.hpp"
+#include "clir/builtin_function.hpp"
+#include "clir/builtin_type.hpp"
+#include "clir/data_type.hpp"
+#include "clir/expr.hpp"
+#include "clir/var.hpp"
+#include "clir/visitor/unique_names.hpp"
+#include "clir/visitor/unsafe_simplification.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <sstream>
+
+using namespace clir;
+
+namespace bbfft {
+
+bool prefer_nd_slm_fft(configuration const &cfg, device_info const &info) {
+    if (cfg.dim < 2 || cfg.dim > max_fft_dim || cfg.type != transform_type::c2c) {
+        return false;
+    }
+    std::size_t sizeof_real = size_in_bytes(compute_precision(cfg.fp));
+    std::size_t sgs = info.min_subgroup_size();
+    std::size_t N_total = 1;
+    for (unsigned d = 0; d < cfg.dim; ++d) {
+        std::size_t Nd = cfg.shape[d + 1];
+        // Same criterion as for the small batch FFT
+        if (2 * sizeof_real * Nd * sgs >= info.register_space_max() / 2) {
+            return false;
+        }
+        N_total *= Nd;
+    }
+    return 2 * sizeof_real * N_total <= info.local_memory_size;
+}
+
+nd_slm_configuration configure_nd_slm_fft(configuration const &cfg, device_info const &info) {
+    if (cfg.dim < 2 || cfg.dim > max_fft_dim) {
+        throw bad_configuration("The nd slm FFT requires 2 <= dim <= max_fft_dim.");
+    }
+    if (compute_precision(cfg.fp) != cfg.fp) {
+        throw bad_configuration("The nd slm FFT does not support 16-bit storage precisions.");
+    }
+    auto N = std::array<std::size_t, max_fft_dim>{};
+    std::size_t N_total = 1;
+    for (unsigned d = 0; d < cfg.dim; ++d) {
+        N[d] = cfg.shape[d + 1];
+        N_total *= N[d];
+    }
+    std::size_t max_count = 1;
+    for (unsigned d = 0; d < cfg.dim; ++d) {
+        max_count = std::max(max_count, N_total / N[d]);
+    }
+
+    std::size_t M = cfg.shape[0];
+    std::size_t sizeof_complex = 2 * size_in_bytes(compute_precision(cfg.fp));
+    std::size_t max_slm_Mb =
+        std::max(std::size_t(1), info.local_memory_size / (N_total * sizeof_complex));
+    std::size_t Mb = std::min(min_power_of_2_greater_equal(M), info.max_subgroup_size());
+    Mb = std::min(Mb, max_power_of_2_less_equal(max_slm_Mb));
+    std::size_t Nt = std::max(std::size_t(1), info.max_work_group_size / Mb);
+    Nt = std::min(Nt, min_power_of_2_greater_equal(max_count));
+
+    auto istride = std::array<std::size_t, max_tensor_dim>{};
+    auto ostride = std::array<std::size_t, max_tensor_dim>{};
+    for (unsigned d = 0; d < cfg.dim + 2; ++d) {
+        istride[d] = cfg.istride[d];
+        ostride[d] = cfg.ostride[d];
+    }
+
+    return {
+        static_cast<int>(cfg.dir),    // direction
+        cfg.dim,                      // dim
+        M,                            // M
+        Mb,                           // Mb
+        N,                            // N
+        Nt,                           // Nt
+        info.min_subgroup_size(),     // sgs
+        cfg.fp,                       // precision
+        istride,                      // istride
+        ostride,                      // ostride
+        cfg.callbacks.load_function,  // load_function
+        cfg.callbacks.store_function, // store_function
+        cfg.scale                     // scale
+    };
+}
+
+std::string nd_slm_configuration::identifier() const {
+    std::ostringstream oss;
+    oss << "ndslmfft_" << (direction < 0 ? 'm' : 'p') << std::abs(direction) << "_M" << M << "_Mb"
+        << Mb << "_N" << N[0];
+    for (unsigned d = 1; d < dim; ++d) {
+        oss << "x" << N[d];
+    }
+    oss << "_Nt" << Nt << "_sgs" << sgs << "_" << to_string(fp) << "_is"
+        << istride[0];
+    for (unsigned d = 1; d < dim + 2; ++d) {
+        oss << "_" << istride[d];
+    }
+    oss << "_os" << ostride[0];
+    for (unsigned d = 1; d < dim + 2; ++d) {
+        oss << "_" << ostride[d];
+    }
+    if (load_function) {
+        oss << "_" << load_function;
+    }
+    if (store_function) {
+        oss << "_" << store_function;
+    }
+    oss << scale_identifier(scale);
+    return oss.str();
+}
+
+void generate_nd_slm_fft(std::ostream &os, nd_slm_configuration const &cfg,
+                         std::string_view name) {
+    if (cfg.dim < 2 || cfg.dim > max_fft_dim) {
+        throw bad_configuration("The nd slm FFT requires 2 <= dim <= max_fft_dim.");
+    }
+    auto in = var("in");
+    auto out = var("out");
+
+    auto fph = precision_helper{cfg.fp};
+    auto in_ty = fph.type(2, address_space::global_t);
+    auto out_ty = fph.type(2, address_space::global_t);
+    auto slm_ty = fph.type(2, address_space::local_t);
+
+    std::size_t N_total = 1;
+    for (unsigned d = 0; d < cfg.dim; ++d) {
+        N_total *= cfg.N[d];
+    }
+
+    auto fb = kernel_builder{name.empty() ? cfg.identifier() : std::string(name)};
+    fb.argument(pointer_to(in_ty), in);
+    fb.argument(pointer_to(out_ty), out);
+    fb.attribute(reqd_work_group_size(static_cast<int>(cfg.Mb), static_cast<int>(cfg.Nt), 1));
+    fb.attribute(intel_reqd_sub_group_size(static_cast<int>(cfg.sgs)));
+
+    std::shared_ptr<tensor_accessor> in_acc, out_acc;
+    if (cfg.load_function) {
+        in_acc = std::make_shared<callback_accessor>(in, in_ty, cfg.load_function);
+    } else {
+        in_acc = std::make_shared<array_accessor>(in, in_ty);
+    }
+    if (cfg.store_function) {
+        out_acc = std::make_shared<callback_accessor>(out, out_ty, nullptr, cfg.store_function);
+    } else {
+        out_acc = std::make_shared<array_accessor>(out, out_ty);
+    }
+
+    fb.body([&](block_builder &bb) {
+        auto X1 = bb.declare(array_of(slm_ty, cfg.Mb * N_total), "X1");
+        auto m_local = bb.declare_assign(generic_size(), "m_local", get_local_id(0));
+        auto m = bb.declare_assign(generic_size(), "m", get_global_id(0));
+        auto t = bb.declare_assign(generic_size(), "t", get_local_id(1));
+        auto k = bb.declare_assign(generic_size(), "k", get_global_id(2));
+
+        // Offset of the N_1 x ... x N_d tensor in global memory, idx = n_1 + n_2 * N_1 + ...
+        auto const global_offset = [&](std::array<std::size_t, max_tensor_dim> const &stride,
+                                       expr idx) {
+            expr offset = m * stride[0] + k * stride[cfg.dim + 1];
+            std::size_t S = 1;
+            for (unsigned d = 0; d < cfg.dim; ++d) {
+                offset = offset + idx / S % cfg.N[d] * stride[d + 1];
+                S *= cfg.N[d];
+            }
+            return offset;
+        };
+        auto const parallel_loop = [&](block_builder &bb, std::size_t count, auto body) {
+            auto i = var("i");
+            bb.add(if_selection_builder(m < cfg.M)
+                       .then([&](block_builder &bb) {
+                           bb.add(for_loop_builder(declaration_assignment(generic_uint(), i, t),
+                                                   i < count, add_into(i, cfg.Nt))
+                                      .body([&](block_builder &bb) { body(bb, i); })
+                                      .get_product());
+                       })
+                       .get_product());
+        };
+        auto const slm = [&](expr idx) { return X1[m_local + idx * cfg.Mb]; };
+
+        parallel_loop(bb, N_total, [&](block_builder &bb, expr idx) {
+            bb.assign(slm(idx), (*in_acc)(global_offset(cfg.istride, idx)));
+        });
+        bb.add(barrier(cl_mem_fence_flags::CLK_LOCAL_MEM_FENCE));
+
+        std::size_t S = 1;
+        for (unsigned d = 0; d < cfg.dim; ++d) {
+            int const Nd = cfg.N[d];
+            parallel_loop(bb, N_total / Nd, [&](block_builder &bb, expr j) {
+                expr base_idx = S > 1 ? j % S + j / S * (S * Nd) : j * Nd;
+                auto base = bb.declare_assign(generic_uint(), "base", std::move(base_idx));
+                auto x = bb.declare(array_of(fph.type(2), Nd), "x");
+                for (int i = 0; i < Nd; ++i) {
+                    bb.assign(x[i], slm(base + i * S));
+                }
+                auto factorization = trial_division(Nd);
+                generate_fft::pair_optimization_inplace(bb, cfg.fp, cfg.direction, factorization,
+                                                        x);
+                auto P = unscrambler(factorization);
+                for (int i = 0; i < Nd; ++i) {
+                    bb.assign(slm(base + i * S), x[P(i)]);
+                }
+            });
+            bb.add(barrier(cl_mem_fence_flags::CLK_LOCAL_MEM_FENCE));
+            S *= Nd;
+        }
+
+        parallel_loop(bb, N_total, [&](block_builder &bb, expr idx) {
+            expr value = slm(idx);
+            if (cfg.scale != 1.0) {
+                value = value * fph.constant(cfg.scale);
+            }
+            bb.add(out_acc->store(std::move(value), global_offset(cfg.ostride, idx)));
+        });
+    });
+
+    auto f = fb.get_product();
+    make_names_unique(f);
+    unsafe_simplify(f);
+    generate_kernel(os, f);
+}
+
+} // namespace bbfft
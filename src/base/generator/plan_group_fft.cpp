@@ -0,0 +1,215 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "bbfft/bad_configuration.hpp"
+#include "bbfft/configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
+#include "generator/sbfft_gen.hpp"
+#include "generator/utility.hpp"
+#include "math.hpp"
+
+#include "clir/attr_defs.hpp"
+#include "clir/builder.hpp"
+#include "clir/builtin_function.hpp"
+#include "clir/builtin_type.hpp"
+#include "clir/data_type.hpp"
+#include "clir/expr.hpp"
+#include "clir/stmt.hpp"
+#include "clir/var.hpp"
+#include "clir/visitor/unique_names.hpp"
+#include "clir/visitor/unsafe_simplification.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+
+using namespace clir;
+
+namespace bbfft {
+
+plan_group_configuration configure_plan_group_fft(std::vector<configuration> const &cfgs,
+                                                  device_info const &info) {
+    if (cfgs.empty()) {
+        throw bad_configuration("A plan group requires at least one configuration.");
+    }
+
+    auto members = std::vector<small_batch_configuration>{};
+    auto K = std::vector<std::size_t>{};
+    members.reserve(cfgs.size());
+    K.reserve(cfgs.size());
+    std::size_t Mb = 1;
+    std::size_t max_Kng = 1;
+    for (auto const &cfg : cfgs) {
+        if (cfg.dim != 1 || is_r2r(cfg.type) || cfg.callbacks || prefer_bluestein_fft(cfg, info) ||
+            prefer_four_step_fft(cfg, info) || !prefer_small_batch_fft(cfg, info)) {
+            throw bad_configuration("Plan groups only support 1d c2c, r2c, and c2r FFTs without "
+                                    "callbacks that are computed by the small batch algorithm.");
+        }
+        members.emplace_back(configure_small_batch_fft(cfg, info));
+        K.emplace_back(cfg.shape[2]);
+        Mb = std::max(Mb, members.back().Mb);
+        bool is_real = cfg.type == transform_type::r2c || cfg.type == transform_type::c2r;
+        std::size_t Kng = is_real && cfg.shape[1] % 2 == 1 ? (cfg.shape[2] - 1) / 2 + 1
+                                                           : cfg.shape[2];
+        max_Kng = std::max(max_Kng, Kng);
+    }
+
+    // All members share the work-group size; members with smaller M or K leave work-items idle
+    std::size_t max_work_group_size = std::min(std::size_t(128), info.max_work_group_size);
+    std::size_t max_Kb = max_work_group_size / Mb;
+    for (auto const &sbc : members) {
+        bool is_real = sbc.type == transform_type::r2c || sbc.type == transform_type::c2r;
+        std::size_t N_slm = is_real ? sbc.N / 2 + 1 : sbc.N;
+        std::size_t sizeof_real = size_in_bytes(compute_precision(sbc.fp));
+        max_Kb = std::min(max_Kb, info.local_memory_size / (Mb * N_slm * 2 * sizeof_real));
+    }
+    if (max_Kb == 0) {
+        throw bad_configuration("The members of the plan group exceed the shared local memory.");
+    }
+    std::size_t Kb =
+        std::min(max_power_of_2_less_equal(max_Kb), min_power_of_2_greater_equal(max_Kng));
+    // The kernel has a single required sub-group size, e.g. if wisdom pins different sub-group
+    // sizes for the members, the smallest one is used for all members
+    std::size_t sgs = members.front().sgs;
+    for (auto const &sbc : members) {
+        sgs = std::min(sgs, sbc.sgs);
+    }
+
+    auto num_groups = std::vector<std::size_t>{};
+    num_groups.reserve(members.size());
+    for (std::size_t i = 0; i < members.size(); ++i) {
+        auto &sbc = members[i];
+        bool is_real = sbc.type == transform_type::r2c || sbc.type == transform_type::c2r;
+        sbc.Mb = Mb;
+        sbc.Kb = Kb;
+        sbc.sgs = sgs;
+        sbc.inplace_unsupported = is_real && Mb < sbc.M;
+        std::size_t Kng = is_real && sbc.N % 2 == 1 ? (K[i] - 1) / 2 + 1 : K[i];
+        std::size_t Mg = (sbc.M - 1) / Mb + 1;
+        std::size_t Kg = (Kng - 1) / Kb + 1;
+        num_groups.emplace_back(Mg * Kg);
+    }
+
+    return {
+        std::move(members),   // members
+        std::move(K),         // K
+        std::move(num_groups) // num_groups
+    };
+}
+
+std::string plan_group_configuration::identifier() const {
+    // The kernel name grows with the number of members, hence the member identifiers are hashed
+    // (64-bit FNV-1a); the batch sizes are kernel arguments and do not enter the identifier
+    std::uint64_t hash = 0xcbf29ce484222325;
+    for (auto const &sbc : members) {
+        for (auto const c : sbc.identifier() + ";") {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3;
+        }
+    }
+    std::ostringstream oss;
+    oss << "pgfft_n" << members.size() << "_" << std::hex << std::setw(16) << std::setfill('0')
+        << hash;
+    return oss.str();
+}
+
+void generate_plan_group_fft(std::ostream &os, plan_group_configuration const &cfg,
+                             std::string_view name) {
+    if (cfg.members.empty()) {
+        throw bad_configuration("A plan group requires at least one member.");
+    }
+    auto const &first = cfg.members.front();
+
+    auto gens = std::vector<std::unique_ptr<sbfft_gen>>{};
+    gens.reserve(cfg.members.size());
+    for (auto const &sbc : cfg.members) {
+        gens.emplace_back(make_sbfft_gen(sbc));
+    }
+
+    auto fb = kernel_builder{name.empty() ? cfg.identifier() : std::string(name)};
+    auto accessors = std::vector<std::pair<std::shared_ptr<tensor_accessor>,
+                                           std::shared_ptr<tensor_accessor>>>{};
+    auto K = std::vector<var>{};
+    for (std::size_t i = 0; i < cfg.members.size(); ++i) {
+        auto in = var("in_" + std::to_string(i));
+        auto out = var("out_" + std::to_string(i));
+        auto [in_ty, out_ty] = gens[i]->argument_types(cfg.members[i]);
+        fb.argument(pointer_to(in_ty), in);
+        fb.argument(pointer_to(out_ty), out);
+        K.emplace_back(var("K_" + std::to_string(i)));
+        fb.argument(generic_ulong(), K.back());
+        auto [in_im, out_im] =
+            gens[i]->planar_arguments(fb, cfg.members[i], "_" + std::to_string(i));
+        accessors.emplace_back(gens[i]->accessors(cfg.members[i], in, out, in_im, out_im));
+    }
+    fb.attribute(reqd_work_group_size(static_cast<int>(first.Mb), static_cast<int>(first.Kb), 1));
+    fb.attribute(intel_reqd_sub_group_size(static_cast<int>(first.sgs)));
+
+    // Local memory must be declared at kernel scope, hence all members share one array that is
+    // large enough and sufficiently aligned for every member
+    std::size_t slm_bytes = 0;
+    auto slm_fp = precision::f32;
+    for (std::size_t i = 0; i < cfg.members.size(); ++i) {
+        auto fp = compute_precision(cfg.members[i].fp);
+        slm_bytes =
+            std::max(slm_bytes, gens[i]->slm_size(cfg.members[i]) * 2 * size_in_bytes(fp));
+        if (fp == precision::f64) {
+            slm_fp = precision::f64;
+        }
+    }
+    std::size_t sizeof_slm_complex = 2 * size_in_bytes(slm_fp);
+
+    fb.body([&](block_builder &bb) {
+        auto X1 = bb.declare(array_of(precision_helper{slm_fp}.type(2, address_space::local_t),
+                                      (slm_bytes - 1) / sizeof_slm_complex + 1),
+                             "X1");
+        auto g = bb.declare_assign(generic_size(), "g", get_group_id(2));
+
+        // The number of work-groups of a member depends on its batch size, which is only known
+        // at run-time
+        auto group_offset = std::vector<expr>{};
+        group_offset.reserve(cfg.members.size() + 1);
+        group_offset.emplace_back(bb.declare_assign(generic_size(), "group_offset", 0));
+        for (std::size_t i = 0; i < cfg.members.size(); ++i) {
+            auto const &sbc = cfg.members[i];
+            bool is_real = sbc.type == transform_type::r2c || sbc.type == transform_type::c2r;
+            std::size_t Mg = (sbc.M - 1) / sbc.Mb + 1;
+            auto Kng = is_real && sbc.N % 2 == 1 ? (K[i] - 1) / 2 + 1 : expr(K[i]);
+            group_offset.emplace_back(
+                bb.declare_assign(generic_size(), "group_offset",
+                                  group_offset.back() + Mg * ((Kng - 1) / sbc.Kb + 1)));
+        }
+
+        // The member is uniform within the work-group, therefore the barriers in the branches
+        // are reached by all work-items
+        stmt dispatch = nullptr;
+        for (std::size_t i = cfg.members.size(); i-- > 0;) {
+            auto const &sbc = cfg.members[i];
+            auto branch = if_selection_builder(g < group_offset[i + 1]);
+            branch.then([&](block_builder &bb) {
+                std::size_t Mg = (sbc.M - 1) / sbc.Mb + 1;
+                auto gi = bb.declare_assign(generic_size(), "gi", g - group_offset[i]);
+                auto bp = sbfft_gen::body_params{accessors[i].first, accessors[i].second,
+                                                 K[i],               X1,
+                                                 gi % Mg,            gi / Mg};
+                gens[i]->generate_body(bb, sbc, std::move(bp));
+            });
+            if (dispatch) {
+                branch.otherwise(std::move(dispatch));
+            }
+            dispatch = branch.get_product();
+        }
+        bb.add(std::move(dispatch));
+    });
+
+    auto f = fb.get_product();
+    make_names_unique(f);
+    unsafe_simplify(f);
+
+    generate_kernel(os, f);
+}
+
+} // namespace bbfft
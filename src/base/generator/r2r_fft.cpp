@@ -0,0 +1,241 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "generator/utility.hpp"
+
+#include "bbfft/bad_configuration.hpp"
+#include "bbfft/configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
+#include "clir/builder.hpp"
+#include "clir/builtin_function.hpp"
+#include "clir/data_type.hpp"
+#include "clir/expr.hpp"
+#include "clir/var.hpp"
+
+#include <ostream>
+#include <sstream>
+#include <utility>
+
+using namespace clir;
+
+namespace bbfft {
+
+r2r_configuration configure_r2r_fft(configuration const &cfg) {
+    if (!is_r2r(cfg.type)) {
+        throw bad_configuration("Transform type is not a real-to-real transform.");
+    }
+    if (cfg.dim != 1) {
+        throw bad_configuration("Real-to-real transforms are only supported in 1d.");
+    }
+    if (compute_precision(cfg.fp) != cfg.fp) {
+        throw bad_configuration(
+            "Real-to-real transforms do not support 16-bit storage precisions.");
+    }
+    bool const type2 = cfg.type == transform_type::dct2 || cfg.type == transform_type::dst2;
+    if ((type2 && cfg.dir != direction::forward) || (!type2 && cfg.dir != direction::backward)) {
+        throw bad_configuration(
+            "Type II direction must be forward and type III direction must be backward.");
+    }
+    return {
+        cfg.type,                                         // type
+        cfg.shape[0],                                     // M
+        cfg.shape[1],                                     // N
+        cfg.fp,                                           // precision
+        {cfg.istride[0], cfg.istride[1], cfg.istride[2]}, // istride
+        {cfg.ostride[0], cfg.ostride[1], cfg.ostride[2]}, // ostride
+        cfg.callbacks.load_function,                      // load_function
+        cfg.callbacks.store_function                      // store_function
+    };
+}
+
+configuration r2r_fft_inner_configuration(r2r_configuration const &cfg, std::size_t K) {
+    bool const type2 = cfg.type == transform_type::dct2 || cfg.type == transform_type::dst2;
+    std::size_t const Nc = cfg.N / 2 + 1;
+    auto real_stride = std::array<std::size_t, max_tensor_dim>{1, cfg.M, cfg.M * cfg.N};
+    auto complex_stride = std::array<std::size_t, max_tensor_dim>{1, cfg.M, cfg.M * Nc};
+    auto const shape = std::array<std::size_t, max_tensor_dim>{cfg.M, cfg.N, K};
+    if (type2) {
+        return configuration{
+            1, shape, cfg.fp, direction::forward, transform_type::r2c, real_stride, complex_stride};
+    }
+    return configuration{
+        1, shape, cfg.fp, direction::backward, transform_type::c2r, complex_stride, real_stride};
+}
+
+std::string r2r_configuration::identifier() const {
+    std::ostringstream oss;
+    oss << "r2r_" << to_string(type) << "_M" << M << "_N" << N << "_" << to_string(fp)
+        << "_is" << istride[0] << "_" << istride[1] << "_" << istride[2] << "_os" << ostride[0]
+        << "_" << ostride[1] << "_" << ostride[2];
+    if (load_function) {
+        oss << "_" << load_function;
+    }
+    if (store_function) {
+        oss << "_" << store_function;
+    }
+    return oss.str();
+}
+
+namespace {
+
+bool is_type2(r2r_configuration const &cfg) {
+    return cfg.type == transform_type::dct2 || cfg.type == transform_type::dst2;
+}
+bool is_sine(r2r_configuration const &cfg) {
+    return cfg.type == transform_type::dst2 || cfg.type == transform_type::dst3;
+}
+
+/**
+ * @brief Indices of the packed offset
+ */
+struct packed_index {
+    expr m, n, k;
+};
+
+/**
+ * @brief Declares "m", "n", and "k" that decompose the packed offset
+ */
+auto decompose_offset(block_builder &bb, expr offset, std::size_t M, std::size_t N)
+    -> packed_index {
+    return {bb.declare_assign(generic_size(), "m", offset % M),
+            bb.declare_assign(generic_size(), "n", offset / M % N),
+            bb.declare_assign(generic_size(), "k", offset / (M * N))};
+}
+
+/**
+ * @brief Returns the user tensor offset at index idx of the N-mode
+ */
+expr user_offset(std::array<std::size_t, 3> const &stride, packed_index const &p, expr idx) {
+    return p.m * stride[0] + std::move(idx) * stride[1] + p.k * stride[2];
+}
+
+expr user_load(r2r_configuration const &cfg, expr x, packed_index const &p, expr idx) {
+    auto offset = user_offset(cfg.istride, p, std::move(idx));
+    if (cfg.load_function) {
+        return call(cfg.load_function, {std::move(x), std::move(offset)});
+    }
+    return std::move(x)[std::move(offset)];
+}
+
+expr user_store(r2r_configuration const &cfg, expr y, packed_index const &p, expr idx,
+                expr value) {
+    auto offset = user_offset(cfg.ostride, p, std::move(idx));
+    if (cfg.store_function) {
+        return call(cfg.store_function, {std::move(y), std::move(offset), std::move(value)});
+    }
+    return assignment(std::move(y)[std::move(offset)], std::move(value));
+}
+
+/**
+ * @brief Declares "c" and "s", which are the real and imaginary part of exp(i pi n / (2N))
+ */
+auto twiddle(block_builder &bb, r2r_configuration const &cfg, precision_helper const &fph,
+             expr n) -> std::pair<expr, expr> {
+    auto phi = bb.declare_assign(fph.type(), "phi",
+                                 cast(fph.type(), std::move(n)) / fph.constant(2.0 * cfg.N));
+    return {bb.declare_assign(fph.type(), "c", cospi(phi)),
+            bb.declare_assign(fph.type(), "s", sinpi(phi))};
+}
+
+/**
+ * @brief Even indices in ascending order followed by odd indices in descending order
+ */
+expr even_odd_permutation(std::size_t N, expr n) {
+    return ternary_conditional(n < (N + 1) / 2, 2 * n, (2 * N - 1) - 2 * n);
+}
+
+} // namespace
+
+void generate_r2r_load_callback(std::ostream &os, r2r_configuration const &cfg,
+                                std::string_view name) {
+    auto const fph = precision_helper(cfg.fp);
+    auto const N = cfg.N;
+    auto fb = function_builder(name.empty() ? cfg.identifier() + "_load" : std::string(name));
+    auto offset = var("offset");
+    if (is_type2(cfg)) {
+        auto x = var("x");
+        fb.return_type(fph.type());
+        fb.argument(pointer_to(fph.type(address_space::global_t)), x);
+        fb.argument(generic_size(), offset);
+        fb.body([&](block_builder &bb) {
+            auto p = decompose_offset(bb, offset, cfg.M, N);
+            auto j = bb.declare_assign(generic_size(), "j", even_odd_permutation(N, p.n));
+            if (is_sine(cfg)) {
+                // DST-II(x)_k = DCT-II((-1)^j x_j)_{N-1-k}
+                auto v = bb.declare_assign(fph.type(), "v", user_load(cfg, x, p, j));
+                bb.return_value(ternary_conditional(j % 2 == 0, v, -v));
+            } else {
+                bb.return_value(user_load(cfg, x, p, j));
+            }
+        });
+    } else {
+        // V_n = (X_n - i X_{N-n}) exp(i pi n / (2N)), X_N = 0
+        auto in = var("in");
+        fb.return_type(fph.type(2));
+        fb.argument(pointer_to(fph.type(2, address_space::global_t)), in);
+        fb.argument(generic_size(), offset);
+        fb.body([&](block_builder &bb) {
+            auto x = bb.declare_assign(pointer_to(fph.type(address_space::global_t)), "x",
+                                       cast(pointer_to(fph.type(address_space::global_t)), in));
+            auto p = decompose_offset(bb, offset, cfg.M, N / 2 + 1);
+            // DST-III(X)_j = (-1)^j DCT-III(X_{N-1-n})_j
+            auto idx_a = is_sine(cfg) ? (N - 1) - p.n : p.n;
+            auto idx_b = is_sine(cfg) ? p.n - 1 : N - p.n;
+            auto a = bb.declare_assign(fph.type(), "a", user_load(cfg, x, p, idx_a));
+            auto b = bb.declare_assign(
+                fph.type(), "b",
+                ternary_conditional(p.n > 0, user_load(cfg, x, p, idx_b), fph.zero()));
+            auto [c, s] = twiddle(bb, cfg, fph, p.n);
+            bb.return_value(init_vector(fph.type(2), {a * c + b * s, a * s - b * c}));
+        });
+    }
+    generate_function(os, fb.get_product());
+}
+
+void generate_r2r_store_callback(std::ostream &os, r2r_configuration const &cfg,
+                                 std::string_view name) {
+    auto const fph = precision_helper(cfg.fp);
+    auto const N = cfg.N;
+    auto fb = function_builder(name.empty() ? cfg.identifier() + "_store" : std::string(name));
+    auto offset = var("offset");
+    auto value = var("value");
+    auto const out_idx = [&](expr idx) { return is_sine(cfg) ? (N - 1) - std::move(idx) : idx; };
+    if (is_type2(cfg)) {
+        // Y = V_n exp(-i pi n / (2N)), X_n = 2 Re(Y), X_{N-n} = -2 Im(Y)
+        auto out = var("out");
+        fb.argument(pointer_to(fph.type(2, address_space::global_t)), out);
+        fb.argument(generic_size(), offset);
+        fb.argument(fph.type(2), value);
+        fb.body([&](block_builder &bb) {
+            auto y = bb.declare_assign(pointer_to(fph.type(address_space::global_t)), "y",
+                                       cast(pointer_to(fph.type(address_space::global_t)), out));
+            auto p = decompose_offset(bb, offset, cfg.M, N / 2 + 1);
+            auto [c, s] = twiddle(bb, cfg, fph, p.n);
+            auto re = bb.declare_assign(fph.type(), "re", value.s(0) * c + value.s(1) * s);
+            auto im = bb.declare_assign(fph.type(), "im", value.s(1) * c - value.s(0) * s);
+            bb.add(user_store(cfg, y, p, out_idx(p.n), fph.constant(2.0) * re));
+            bb.add(if_selection_builder(p.n > 0 && 2 * p.n != N)
+                       .then([&](block_builder &bb) {
+                           bb.add(user_store(cfg, y, p, out_idx(N - p.n),
+                                             fph.constant(-2.0) * im));
+                       })
+                       .get_product());
+        });
+    } else {
+        // Inverse of the permutation in the type II load
+        auto y = var("y");
+        fb.argument(pointer_to(fph.type(address_space::global_t)), y);
+        fb.argument(generic_size(), offset);
+        fb.argument(fph.type(), value);
+        fb.body([&](block_builder &bb) {
+            auto p = decompose_offset(bb, offset, cfg.M, N);
+            auto j = bb.declare_assign(generic_size(), "j", even_odd_permutation(N, p.n));
+            bb.add(user_store(cfg, y, p, j,
+                              is_sine(cfg) ? ternary_conditional(j % 2 == 0, value, -value)
+                                           : expr(value)));
+        });
+    }
+    generate_function(os, fb.get_product());
+}
+
+} // namespace bbfft
@@ -0,0 +1,193 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "bbfft/bad_configuration.hpp"
+#include "bbfft/configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
+#include "bbfft/ragged_configuration.hpp"
+#include "generator/f2fft_gen.hpp"
+#include "generator/tensor_accessor.hpp"
+#include "generator/tensor_view.hpp"
+#include "generator/utility.hpp"
+
+#include "clir/attr_defs.hpp"
+#include "clir/builder.hpp"
+#include "clir/builtin_function.hpp"
+#include "clir/builtin_type.hpp"
+#include "clir/data_type.hpp"
+#include "clir/expr.hpp"
+#include "clir/stmt.hpp"
+#include "clir/var.hpp"
+#include "clir/visitor/unique_names.hpp"
+#include "clir/visitor/unsafe_simplification.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+
+using namespace clir;
+
+namespace bbfft {
+
+ragged_batch_configuration configure_ragged_batch_fft(ragged_configuration const &cfg,
+                                                      device_info const &info) {
+    if (cfg.lengths.empty()) {
+        throw bad_configuration("A ragged batch requires at least one transform length.");
+    }
+    if (compute_precision(cfg.fp) != cfg.fp) {
+        throw bad_configuration("Ragged batches do not support 16-bit storage precisions.");
+    }
+
+    auto lengths = cfg.lengths;
+    std::sort(lengths.begin(), lengths.end());
+    lengths.erase(std::unique(lengths.begin(), lengths.end()), lengths.end());
+
+    std::size_t sgs = info.min_subgroup_size();
+    std::size_t Nb = sgs;
+    auto factorizations = std::vector<std::vector<int>>{};
+    for (auto const &N : lengths) {
+        auto single = configuration{1, {1, N, 1}, cfg.fp, cfg.dir};
+        if (N < 2 || prefer_bluestein_fft(single, info) || prefer_four_step_fft(single, info)) {
+            throw bad_configuration("Transform length " + std::to_string(N) +
+                                    " is not supported in a ragged batch.");
+        }
+        auto f2c = configure_factor2_slm_fft(single, info);
+        factorizations.emplace_back(std::move(f2c.factorization));
+        Nb = std::max(Nb, f2c.Nb);
+    }
+    if (Nb > info.max_work_group_size) {
+        throw bad_configuration("The transform lengths of the ragged batch exceed the maximum "
+                                "work-group size.");
+    }
+
+    return {
+        static_cast<int>(cfg.dir), // direction
+        std::move(lengths),        // lengths
+        std::move(factorizations), // factorizations
+        Nb,                        // Nb
+        sgs,                       // sgs
+        cfg.fp                     // precision
+    };
+}
+
+std::string ragged_batch_configuration::identifier() const {
+    std::ostringstream oss;
+    oss << "rbfft_" << (direction < 0 ? 'm' : 'p') << std::abs(direction);
+    for (std::size_t i = 0; i < lengths.size(); ++i) {
+        oss << "_N" << lengths[i] << "f";
+        auto it = factorizations[i].begin();
+        if (it != factorizations[i].end()) {
+            oss << *it++;
+            for (; it != factorizations[i].end(); ++it) {
+                oss << "x" << *it;
+            }
+        }
+    }
+    oss << "_Nb" << Nb << "_sgs" << sgs << "_" << to_string(fp);
+    return oss.str();
+}
+
+factor2_slm_configuration ragged_batch_record_configuration(ragged_batch_configuration const &cfg,
+                                                            std::size_t i) {
+    auto const N = cfg.lengths[i];
+    return {
+        cfg.direction,          // direction
+        1,                      // M
+        1,                      // Mb
+        N,                      // N
+        cfg.factorizations[i],  // factorization
+        cfg.Nb,                 // Nb
+        1,                      // Kb
+        cfg.sgs,                // sgs
+        cfg.fp,                 // precision
+        transform_type::c2c,    // transform_type
+        {1, 1, N},              // istride
+        {1, 1, N},              // ostride
+        false,                  // inplace_unsupported
+        nullptr,                // load_function
+        nullptr,                // store_function
+        {0, 0}                  // planar_offset
+    };
+}
+
+auto ragged_batch_twiddle_table(ragged_batch_configuration const &cfg)
+    -> std::vector<std::complex<double>> {
+    auto table = std::vector<std::complex<double>>{};
+    for (std::size_t i = 0; i < cfg.lengths.size(); ++i) {
+        auto tw = factor2_slm_twiddle_table(ragged_batch_record_configuration(cfg, i));
+        table.insert(table.end(), tw.begin(), tw.end());
+    }
+    return table;
+}
+
+void generate_ragged_batch_fft(std::ostream &os, ragged_batch_configuration const &cfg,
+                               std::string_view name) {
+    auto in = var("in");
+    auto out = var("out");
+    auto records = var("records");
+    auto twiddle = var("twiddle");
+
+    auto fph = precision_helper{cfg.fp};
+    auto c_ty = fph.type(2, address_space::global_t);
+    auto slm_ty = fph.type(2, address_space::local_t);
+
+    auto fb = kernel_builder{name.empty() ? cfg.identifier() : std::string(name)};
+    fb.argument(pointer_to(c_ty), in);
+    fb.argument(pointer_to(c_ty), out);
+    fb.argument(pointer_to(global_ulong(2)), records);
+    fb.argument(pointer_to(fph.type(2, address_space::constant_t)), twiddle);
+    fb.attribute(reqd_work_group_size(1, static_cast<int>(cfg.Nb), 1));
+    fb.attribute(intel_reqd_sub_group_size(static_cast<int>(cfg.sgs)));
+
+    fb.body([&](block_builder &bb) {
+        auto X1 = bb.declare(array_of(slm_ty, cfg.lengths.back()), "X1");
+        auto n_local = bb.declare_assign(generic_size(), "n_local", get_local_id(1));
+        auto record = bb.declare_assign(generic_ulong(2), "record", records[get_global_id(2)]);
+        auto x_in = bb.declare_assign(pointer_to(c_ty), "x_in", in + record.s(0));
+        auto x_out = bb.declare_assign(pointer_to(c_ty), "x_out", out + record.s(0));
+        auto in_acc = std::make_shared<array_accessor>(x_in, c_ty);
+        auto out_acc = std::make_shared<array_accessor>(x_out, c_ty);
+        auto X1_acc = std::make_shared<array_accessor>(X1, slm_ty);
+
+        auto tw_offsets = std::vector<std::size_t>(cfg.lengths.size(), 0);
+        for (std::size_t i = 1; i < cfg.lengths.size(); ++i) {
+            auto tw = factor2_slm_twiddle_table(ragged_batch_record_configuration(cfg, i - 1));
+            tw_offsets[i] = tw_offsets[i - 1] + tw.size();
+        }
+
+        // The length is uniform within the work-group, therefore the barriers in the branches
+        // are reached by all work-items. Unknown lengths are skipped.
+        stmt dispatch = nullptr;
+        for (std::size_t i = cfg.lengths.size(); i-- > 0;) {
+            auto const N = cfg.lengths[i];
+            auto rc = ragged_batch_record_configuration(cfg, i);
+            auto branch = if_selection_builder(record.s(1) == N);
+            branch.then([&](block_builder &bb) {
+                auto stride = std::array<expr, 3u>{1u, 1u, N};
+                auto in_view = tensor_view(in_acc, {1u, N, 1u}, stride);
+                auto out_view = tensor_view(out_acc, {1u, N, 1u}, stride);
+                auto X1_view = tensor_view(X1_acc, std::array<expr, 1u>{N});
+                // Every record is a 1 x N x 1 tensor, hence m = k = 0 and K = 1
+                auto bp = f2fft_gen::body_params{
+                    in_view, out_view, X1_view, 0u, 0u, n_local, 1u, twiddle + tw_offsets[i]};
+                f2fft_gen_c2c(N).generate_body(bb, rc, bp);
+            });
+            if (dispatch) {
+                branch.otherwise(std::move(dispatch));
+            }
+            dispatch = branch.get_product();
+        }
+        bb.add(std::move(dispatch));
+    });
+
+    auto f = fb.get_product();
+    make_names_unique(f);
+    unsafe_simplify(f);
+
+    generate_kernel(os, f);
+}
+
+} // namespace bbfft
@@ -14,11 +14,11 @@
 #include "clir/expr.hpp"
 #include "clir/stmt.hpp"
 #include "clir/var.hpp"
-#include "clir/visitor/codegen_opencl.hpp"
 #include "clir/visitor/unique_names.hpp"
 #include "clir/visitor/unsafe_simplification.hpp"
 
 #include <cmath>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <utility>
@@ -33,104 +33,264 @@ void sbfft_gen::generate(std::ostream &os, small_batch_configuration const &cfg,
     auto out = var("out");
     auto K = var("K");
 
-    auto fph = precision_helper{cfg.fp};
-    auto in_ty = fph.type(p_.in_components, address_space::global_t);
-    auto out_ty = fph.type(p_.out_components, address_space::global_t);
-    auto slm_in_ty = fph.type(p_.in_components, address_space::local_t);
-    auto slm_out_ty = fph.type(p_.out_components, address_space::local_t);
+    auto [in_ty, out_ty] = argument_types(cfg);
 
     auto fb = kernel_builder{name.empty() ? cfg.identifier() : std::string(name)};
     fb.argument(pointer_to(in_ty), in);
     fb.argument(pointer_to(out_ty), out);
     fb.argument(generic_ulong(), K);
+    auto [in_im, out_im] = planar_arguments(fb, cfg, "");
     fb.attribute(reqd_work_group_size(static_cast<int>(cfg.Mb), static_cast<int>(cfg.Kb), 1));
     fb.attribute(intel_reqd_sub_group_size(static_cast<int>(cfg.sgs)));
 
-    auto xy_ty = data_type(array_of(fph.type(2), p_.N_fft));
+    auto [in_acc, out_acc] = accessors(cfg, in, out, in_im, out_im);
+
+    fb.body([&](block_builder &bb) {
+        auto X1 = bb.declare(
+            array_of(precision_helper{cfg.fp}.type(2, address_space::local_t), slm_size(cfg)),
+            "X1");
+        auto bp = body_params{in_acc, out_acc, K, X1, get_group_id(0), get_group_id(1)};
+        generate_body(bb, cfg, std::move(bp));
+    });
+
+    auto f = fb.get_product();
+    make_names_unique(f);
+    unsafe_simplify(f);
+
+    generate_kernel(os, f);
+}
+
+auto sbfft_gen::argument_types(small_batch_configuration const &cfg) const
+    -> std::pair<data_type, data_type> {
+    auto fph = precision_helper{cfg.fp};
+    bool const planar_in = cfg.planar_offset[0] != 0;
+    bool const planar_out = cfg.planar_offset[1] != 0;
+    auto in_ty = planar_in ? fph.type(address_space::global_t)
+                           : fph.storage_type(p_.in_components, address_space::global_t);
+    auto out_ty = planar_out ? fph.type(address_space::global_t)
+                             : fph.storage_type(p_.out_components, address_space::global_t);
+    return {std::move(in_ty), std::move(out_ty)};
+}
+
+auto sbfft_gen::planar_arguments(kernel_builder &fb, small_batch_configuration const &cfg,
+                                 std::string const &suffix) const -> std::pair<expr, expr> {
+    auto ty = pointer_to(precision_helper{cfg.fp}.type(address_space::global_t));
+    expr in_im = nullptr, out_im = nullptr;
+    if (cfg.planar_offset[0] != 0) {
+        auto v = var("in_im" + suffix);
+        fb.argument(ty, v);
+        in_im = std::move(v);
+    }
+    if (cfg.planar_offset[1] != 0) {
+        auto v = var("out_im" + suffix);
+        fb.argument(ty, v);
+        out_im = std::move(v);
+    }
+    return {std::move(in_im), std::move(out_im)};
+}
+
+auto sbfft_gen::accessors(small_batch_configuration const &cfg, expr in, expr out, expr in_im,
+                          expr out_im) const
+    -> std::pair<std::shared_ptr<tensor_accessor>, std::shared_ptr<tensor_accessor>> {
+    auto fph = precision_helper{cfg.fp};
+    bool const planar_in = cfg.planar_offset[0] != 0;
+    bool const planar_out = cfg.planar_offset[1] != 0;
+    auto [in_ty, out_ty] = argument_types(cfg);
 
     std::shared_ptr<tensor_accessor> in_acc, out_acc;
     if (cfg.load_function) {
         in_acc = std::make_shared<callback_accessor>(in, in_ty, cfg.load_function);
+    } else if (planar_in) {
+        in_acc = std::make_shared<array_accessor>(in, std::move(in_im), cfg.fp);
+    } else if (fph.converts_storage()) {
+        in_acc = std::make_shared<storage_accessor>(in, cfg.fp, p_.in_components);
     } else {
         in_acc = std::make_shared<array_accessor>(in, in_ty);
     }
     if (cfg.store_function) {
         out_acc = std::make_shared<callback_accessor>(out, out_ty, nullptr, cfg.store_function);
+    } else if (planar_out) {
+        out_acc = std::make_shared<array_accessor>(out, std::move(out_im), cfg.fp);
+    } else if (fph.converts_storage()) {
+        out_acc = std::make_shared<storage_accessor>(out, cfg.fp, p_.out_components);
     } else {
         out_acc = std::make_shared<array_accessor>(out, out_ty);
     }
+    return {std::move(in_acc), std::move(out_acc)};
+}
+
+std::size_t sbfft_gen::slm_size(small_batch_configuration const &cfg) const {
+    return cfg.Kb * p_.N_slm * cfg.Mb;
+}
+
+void sbfft_gen::generate_body(block_builder &bb, small_batch_configuration const &cfg,
+                              body_params bp) const {
+    auto fph = precision_helper{cfg.fp};
+    auto slm_in_ty = fph.type(p_.in_components, address_space::local_t);
+    auto slm_out_ty = fph.type(p_.out_components, address_space::local_t);
+    auto xy_ty = data_type(array_of(fph.type(2), p_.N_fft));
 
     // load in SLM from global memory, load transposed in registers from SLM
-    fb.body([&](block_builder &bb) {
-        expr mb = nullptr;
-        if (cfg.M < cfg.Mb) {
-            mb = cfg.M;
-        } else if (cfg.M % cfg.Mb == 0) {
-            mb = cfg.Mb;
-        } else {
-            mb = bb.declare_assign(generic_uint(), "mb", cfg.M - get_group_id(0) * cfg.Mb);
+    expr mb = nullptr;
+    if (cfg.M < cfg.Mb) {
+        mb = cfg.M;
+    } else if (cfg.M % cfg.Mb == 0) {
+        mb = cfg.Mb;
+    } else {
+        mb = bb.declare_assign(generic_uint(), "mb", cfg.M - bp.group_id_m * cfg.Mb);
+    }
+    auto k_first =
+        bb.declare_assign(generic_size(), "k_first", bp.group_id_k * p_.k_stride * cfg.Kb);
+    auto kb = bb.declare_assign(generic_uint(), "kb", (bp.K - k_first - 1) / p_.k_stride + 1);
+    expr kb_odd = nullptr;
+    if (p_.k_stride == 2) {
+        kb_odd = bb.declare_assign(generic_uint(), "kb_odd", kb - bp.K % 2);
+    }
+    bb.assign(kb, select(cfg.Kb, kb, kb < cfg.Kb));
+    if (p_.k_stride == 2) {
+        bb.assign(kb_odd, select(cfg.Kb, kb_odd, kb_odd < cfg.Kb));
+    }
+
+    auto in_view =
+        tensor_view(bp.in_acc, {cfg.M, p_.N_in, bp.K},
+                    std::array<expr, 3u>{cfg.istride[0], cfg.istride[1], cfg.istride[2]})
+            .subview(bb, slice{bp.group_id_m * cfg.Mb, mb}, slice{}, slice{k_first, kb});
+
+    auto X1_in =
+        bb.declare_assign(pointer_to(slm_in_ty), "X1_in", cast(pointer_to(slm_in_ty), bp.X1));
+
+    auto X1_in_view = tensor_view(std::make_shared<array_accessor>(X1_in, slm_in_ty),
+                                  std::array<expr, 3u>{cfg.Mb, p_.N_in, cfg.Kb});
+    auto X1_in_1d = X1_in_view.subview(bb, get_local_id(0), slice{0u, p_.N_in}, get_local_id(1));
+
+    auto x = bb.declare(xy_ty, "x");
+    auto x_acc = std::make_shared<array_accessor>(x, xy_ty);
+    auto x_view = tensor_view(x_acc, std::array<expr, 1u>{p_.N_fft});
+
+    // The block of a work-group is dense if the work-group covers the whole M-mode and the
+    // strides are the default ones
+    auto const is_dense = [&](std::shared_ptr<tensor_accessor> const &acc,
+                              std::array<std::size_t, 3u> const &stride, std::size_t N,
+                              std::size_t length) {
+        auto a = std::dynamic_pointer_cast<array_accessor>(acc);
+        return a && a->is_dense() && p_.k_stride == 1 && length == 0 && cfg.M == cfg.Mb &&
+               (cfg.M == 1 || stride[0] == 1) && stride[1] == cfg.M && stride[2] == cfg.M * N;
+    };
+    bool const dense_in = is_dense(bp.in_acc, cfg.istride, p_.N_in, cfg.input_length);
+    bool const dense_out = is_dense(bp.out_acc, cfg.ostride, p_.N_out, cfg.output_length);
+
+    load(bb, copy_params{cfg, fph, in_view, X1_in_view, X1_in_1d, x_view, x_acc, mb, bp.K, kb,
+                         kb_odd, identity, dense_in});
+
+    auto factorization = trial_division(p_.N_fft);
+    generate_fft::pair_optimization_inplace(bb, cfg.fp, cfg.direction, factorization, x, nullptr,
+                                            cfg.input_length);
+    auto P = unscrambler(factorization);
+
+    if (bp.filter) {
+        if (p_.N_fft != cfg.N || p_.in_components != 2 || p_.out_components != 2) {
+            throw std::logic_error("Filters are only supported for c2c transforms");
         }
-        auto k_first =
-            bb.declare_assign(generic_size(), "k_first", get_group_id(1) * p_.k_stride * cfg.Kb);
-        auto kb = bb.declare_assign(generic_uint(), "kb", (K - k_first - 1) / p_.k_stride + 1);
-        expr kb_odd = nullptr;
-        if (p_.k_stride == 2) {
-            kb_odd = bb.declare_assign(generic_uint(), "kb_odd", kb - K % 2);
+        // x[P(j)] holds the j-th Fourier coefficient; y is passed in natural order to the
+        // inverse transform
+        auto cmul = complex_mul(fph);
+        auto y = bb.declare(xy_ty, "y");
+        for (std::size_t j = 0; j < p_.N_fft; ++j) {
+            auto h = bb.declare_assign(fph.type(2), "h", bp.filter[j]);
+            if (bp.correlation) {
+                bb.assign(h.s(1), -h.s(1));
+            }
+            bb.assign(y[j], cmul(x[P(j)], h));
         }
-        bb.assign(kb, select(cfg.Kb, kb, kb < cfg.Kb));
-        if (p_.k_stride == 2) {
-            bb.assign(kb_odd, select(cfg.Kb, kb_odd, kb_odd < cfg.Kb));
+        generate_fft::pair_optimization_inplace(bb, cfg.fp, -cfg.direction, factorization, y);
+        x_acc = std::make_shared<array_accessor>(y, xy_ty);
+        x_view = tensor_view(x_acc, std::array<expr, 1u>{p_.N_fft});
+    }
+
+    if (cfg.scale != 1.0) {
+        for (std::size_t j = 0; j < p_.N_fft; ++j) {
+            bb.add(x_view.store(x_view(j) * fph.constant(cfg.scale), j));
         }
+    }
 
-        auto in_view =
-            tensor_view(in_acc, {cfg.M, p_.N_in, K},
-                        std::array<expr, 3u>{cfg.istride[0], cfg.istride[1], cfg.istride[2]})
-                .subview(bb, slice{get_group_id(0) * cfg.Mb, mb}, slice{}, slice{k_first, kb});
+    bb.add(barrier(cl_mem_fence_flags::CLK_LOCAL_MEM_FENCE));
 
-        auto X1 = bb.declare(
-            array_of(fph.type(2, address_space::local_t), cfg.Kb * p_.N_slm * cfg.Mb), "X1");
-        auto X1_in =
-            bb.declare_assign(pointer_to(slm_in_ty), "X1_in", cast(pointer_to(slm_in_ty), X1));
-
-        auto X1_in_view = tensor_view(std::make_shared<array_accessor>(X1_in, slm_in_ty),
-                                      std::array<expr, 3u>{cfg.Mb, p_.N_in, cfg.Kb});
-        auto X1_in_1d =
-            X1_in_view.subview(bb, get_local_id(0), slice{0u, p_.N_in}, get_local_id(1));
-
-        auto x = bb.declare(xy_ty, "x");
-        auto x_acc = std::make_shared<array_accessor>(x, xy_ty);
-        auto x_view = tensor_view(x_acc, std::array<expr, 1u>{p_.N_fft});
-
-        load(bb, copy_params{cfg, fph, in_view, X1_in_view, X1_in_1d, x_view, x_acc, mb, K, kb,
-                             kb_odd});
-
-        auto factorization = trial_division(p_.N_fft);
-        generate_fft::pair_optimization_inplace(bb, cfg.fp, cfg.direction, factorization, x);
-        auto P = unscrambler(factorization);
-
-        bb.add(barrier(cl_mem_fence_flags::CLK_LOCAL_MEM_FENCE));
-
-        auto out_view =
-            tensor_view(out_acc, {cfg.M, p_.N_out, K},
-                        std::array<expr, 3u>{cfg.ostride[0], cfg.ostride[1], cfg.ostride[2]})
-                .subview(bb, slice{get_group_id(0) * cfg.Mb, mb}, slice{}, slice{k_first, kb});
-
-        auto X1_out =
-            bb.declare_assign(pointer_to(slm_out_ty), "X1_out", cast(pointer_to(slm_out_ty), X1));
-        auto X1_out_view = tensor_view(std::make_shared<array_accessor>(X1_out, slm_out_ty),
-                                       std::array<expr, 3u>{cfg.Mb, p_.N_out, cfg.Kb});
-        auto X1_out_1d =
-            X1_out_view.subview(bb, get_local_id(0), slice{0u, p_.N_out}, get_local_id(1));
-
-        store(bb, copy_params{cfg, fph, out_view, X1_out_view, X1_out_1d, x_view, x_acc, mb, K, kb,
-                              kb_odd, P});
-    });
+    auto out_view =
+        tensor_view(bp.out_acc, {cfg.M, p_.N_out, bp.K},
+                    std::array<expr, 3u>{cfg.ostride[0], cfg.ostride[1], cfg.ostride[2]})
+            .subview(bb, slice{bp.group_id_m * cfg.Mb, mb}, slice{}, slice{k_first, kb});
 
-    auto f = fb.get_product();
-    make_names_unique(f);
-    unsafe_simplify(f);
+    auto X1_out =
+        bb.declare_assign(pointer_to(slm_out_ty), "X1_out", cast(pointer_to(slm_out_ty), bp.X1));
+    auto X1_out_view = tensor_view(std::make_shared<array_accessor>(X1_out, slm_out_ty),
+                                   std::array<expr, 3u>{cfg.Mb, p_.N_out, cfg.Kb});
+    auto X1_out_1d =
+        X1_out_view.subview(bb, get_local_id(0), slice{0u, p_.N_out}, get_local_id(1));
 
-    generate_opencl(os, f);
+    store(bb, copy_params{cfg, fph, out_view, X1_out_view, X1_out_1d, x_view, x_acc, mb, bp.K, kb,
+                          kb_odd, P, dense_out});
+}
+
+void sbfft_gen::global_to_slm(block_builder &bb, copy_params const &cp, std::size_t N) const {
+    if (!cp.dense) {
+        copy_mbNkb_block_on_2D_grid(bb, cp.view, cp.X1_view, cp.mb, N, cp.kb);
+        return;
+    }
+    auto const &cfg = cp.cfg;
+    auto src = std::static_pointer_cast<array_accessor>(cp.view.accessor())->pointer();
+    auto dest = std::static_pointer_cast<array_accessor>(cp.X1_view.accessor())->pointer();
+    auto local_id = get_local_id(0) + get_local_id(1) * cfg.Mb;
+    std::size_t const work_group_size = cfg.Mb * cfg.Kb;
+    if (work_group_size % cfg.sgs == 0) {
+        std::size_t const words_per_entry = cp.fph.bits() * p_.in_components / 32;
+        copy_dense_block_with_block_reads(bb, src, dest, words_per_entry * cp.mb * N * cp.kb,
+                                          local_id, work_group_size, cfg.sgs);
+    } else {
+        copy_dense_block(bb, src, dest, cp.mb * N * cp.kb, local_id, work_group_size);
+    }
+}
+
+void sbfft_gen::slm_to_global(block_builder &bb, copy_params const &cp, std::size_t N) const {
+    if (!cp.dense) {
+        copy_mbNkb_block_on_2D_grid(bb, cp.X1_view, cp.view, cp.mb, N, cp.kb);
+        return;
+    }
+    auto const &cfg = cp.cfg;
+    auto src = std::static_pointer_cast<array_accessor>(cp.X1_view.accessor())->pointer();
+    auto dest = std::static_pointer_cast<array_accessor>(cp.view.accessor())->pointer();
+    auto local_id = get_local_id(0) + get_local_id(1) * cfg.Mb;
+    std::size_t const work_group_size = cfg.Mb * cfg.Kb;
+    // Block writes require 16-byte alignment. If the blocks of consecutive work-groups are
+    // 16 bytes apart, all work-groups inherit the alignment of the base pointer, which is checked
+    // at run-time; otherwise, the block writes would only be taken by some work-groups.
+    std::size_t const bytes_per_entry = cp.fph.bits() * p_.out_components / 8;
+    if (work_group_size % cfg.sgs == 0 && (cfg.Kb * cfg.M * N * bytes_per_entry) % 16 == 0) {
+        std::size_t const words_per_entry = bytes_per_entry / 4;
+        copy_dense_block_with_block_writes(bb, src, dest, words_per_entry * cp.mb * N * cp.kb,
+                                           local_id, work_group_size, cfg.sgs);
+    } else {
+        copy_dense_block(bb, src, dest, cp.mb * N * cp.kb, local_id, work_group_size);
+    }
+}
+
+auto make_sbfft_gen(small_batch_configuration const &cfg) -> std::unique_ptr<sbfft_gen> {
+    switch (cfg.type) {
+    case transform_type::c2c:
+        return std::make_unique<sbfft_gen_c2c>(cfg.N);
+    case transform_type::r2c:
+        if (cfg.N % 2 == 1) {
+            return std::make_unique<sbfft_gen_r2c_double>(cfg.N);
+        }
+        return std::make_unique<sbfft_gen_r2c_half>(cfg.N);
+    case transform_type::c2r:
+        if (cfg.N % 2 == 1) {
+            return std::make_unique<sbfft_gen_c2r_double>(cfg.N);
+        }
+        return std::make_unique<sbfft_gen_c2r_half>(cfg.N);
+    default:
+        break;
+    }
+    throw std::logic_error("Internal logic error: Did you mess with the cfg.type field?");
 }
 
 void sbfft_gen::double_load(block_builder &bb, copy_params cp, int k_offset) const {
@@ -148,19 +308,22 @@ void sbfft_gen::double_store(block_builder &bb, copy_params cp, int k_offset) co
 }
 
 void sbfft_gen_c2c::load(block_builder &bb, copy_params cp) const {
-    copy_mbNkb_block_on_2D_grid(bb, cp.view, cp.X1_view, cp.mb, p().N_in, cp.kb);
+    // Points beyond the input length are zero and are pruned from the FFT
+    std::size_t L = cp.cfg.input_length ? cp.cfg.input_length : p().N_in;
+    global_to_slm(bb, cp, L);
     bb.add(barrier(cl_mem_fence_flags::CLK_LOCAL_MEM_FENCE));
-    copy_N_block_with_permutation(bb, cp.X1_1d, cp.x_view, p().N_fft);
+    copy_N_block_with_permutation(bb, cp.X1_1d, cp.x_view, L);
 }
 
 void sbfft_gen_c2c::store(block_builder &bb, copy_params cp) const {
-    copy_N_block_with_permutation(bb, cp.x_view, cp.X1_1d, p().N_fft, cp.P);
+    std::size_t L = cp.cfg.output_length ? cp.cfg.output_length : p().N_out;
+    copy_N_block_with_permutation(bb, cp.x_view, cp.X1_1d, L, cp.P);
     bb.add(barrier(cl_mem_fence_flags::CLK_LOCAL_MEM_FENCE));
-    copy_mbNkb_block_on_2D_grid(bb, cp.X1_view, cp.view, cp.mb, p().N_out, cp.kb);
+    slm_to_global(bb, cp, L);
 }
 
 void sbfft_gen_r2c_half::load(block_builder &bb, copy_params cp) const {
-    copy_mbNkb_block_on_2D_grid(bb, cp.view, cp.X1_view, cp.mb, p().N_in, cp.kb);
+    global_to_slm(bb, cp, p().N_in);
     bb.add(barrier(cl_mem_fence_flags::CLK_LOCAL_MEM_FENCE));
 
     auto X1_src = cp.X1_1d.reshaped_mode(0, std::array<expr, 2u>{2, p().N_fft});
@@ -174,7 +337,7 @@ void sbfft_gen_r2c_half::load(block_builder &bb, copy_params cp) const {
 void sbfft_gen_r2c_half::store(block_builder &bb, copy_params cp) const {
     postprocess(bb, cp.fph, cp.x_view, cp.X1_1d, cp.cfg.N, cp.P);
     bb.add(barrier(cl_mem_fence_flags::CLK_LOCAL_MEM_FENCE));
-    copy_mbNkb_block_on_2D_grid(bb, cp.X1_view, cp.view, cp.mb, p().N_out, cp.kb);
+    slm_to_global(bb, cp, p().N_out);
 }
 
 void sbfft_gen_r2c_half::postprocess(block_builder &bb, precision_helper fph,
@@ -200,7 +363,7 @@ void sbfft_gen_r2c_half::postprocess(block_builder &bb, precision_helper fph,
 }
 
 void sbfft_gen_c2r_half::load(block_builder &bb, copy_params cp) const {
-    copy_mbNkb_block_on_2D_grid(bb, cp.view, cp.X1_view, cp.mb, p().N_in, cp.kb);
+    global_to_slm(bb, cp, p().N_in);
     bb.add(barrier(cl_mem_fence_flags::CLK_LOCAL_MEM_FENCE));
 
     preprocess(bb, cp.fph, cp.X1_1d, cp.x_view, cp.cfg.N);
@@ -215,7 +378,7 @@ void sbfft_gen_c2r_half::store(block_builder &bb, copy_params cp) const {
     cp.x_acc->component(-1);
 
     bb.add(barrier(cl_mem_fence_flags::CLK_LOCAL_MEM_FENCE));
-    copy_mbNkb_block_on_2D_grid(bb, cp.X1_view, cp.view, cp.mb, p().N_out, cp.kb);
+    slm_to_global(bb, cp, p().N_out);
 }
 
 void sbfft_gen_c2r_half::preprocess(block_builder &bb, precision_helper fph,
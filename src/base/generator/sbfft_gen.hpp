@@ -11,12 +11,16 @@
 #include "generator/utility.hpp"
 
 #include "clir/builder.hpp"
+#include "clir/data_type.hpp"
 #include "clir/expr.hpp"
 
 #include <cstdint>
 #include <functional>
 #include <iosfwd>
+#include <memory>
+#include <string>
 #include <string_view>
+#include <utility>
 
 namespace bbfft {
 
@@ -26,6 +30,17 @@ class sbfft_gen {
         std::size_t N_in, N_out, N_slm, N_fft;
         short in_components, out_components, k_stride;
     };
+    struct body_params {
+        std::shared_ptr<tensor_accessor> in_acc;
+        std::shared_ptr<tensor_accessor> out_acc;
+        clir::expr K;
+        clir::expr X1;
+        clir::expr group_id_m;
+        clir::expr group_id_k;
+        clir::expr filter = nullptr; ///< Multiply the spectrum with filter and transform back
+        bool correlation = false;    ///< Multiply with the conjugate of filter
+    };
+
     sbfft_gen(gen_cfg p) : p_(p) {}
     virtual ~sbfft_gen() {}
 
@@ -33,6 +48,43 @@ class sbfft_gen {
                   std::string_view name) const;
     inline auto const &p() const { return p_; }
 
+    /**
+     * @brief Global memory types of the in and out kernel arguments
+     */
+    auto argument_types(small_batch_configuration const &cfg) const
+        -> std::pair<clir::data_type, clir::data_type>;
+    /**
+     * @brief Add the pointers to the imaginary parts of planar tensors as kernel arguments
+     *
+     * @return in_im and out_im; nullptr if the tensor is interleaved
+     */
+    auto planar_arguments(clir::kernel_builder &fb, small_batch_configuration const &cfg,
+                          std::string const &suffix) const -> std::pair<clir::expr, clir::expr>;
+    /**
+     * @brief Accessors for the in and out kernel arguments
+     *
+     * in_im and out_im are the pointers to the imaginary parts of planar tensors.
+     */
+    auto accessors(small_batch_configuration const &cfg, clir::expr in, clir::expr out,
+                   clir::expr in_im = nullptr, clir::expr out_im = nullptr) const
+        -> std::pair<std::shared_ptr<tensor_accessor>, std::shared_ptr<tensor_accessor>>;
+    /**
+     * @brief Number of complex numbers the body needs in shared local memory
+     */
+    std::size_t slm_size(small_batch_configuration const &cfg) const;
+    /**
+     * @brief Generate the kernel body of one work-group
+     *
+     * X1 must point to a local array with at least slm_size(cfg) complex numbers and the
+     * work-group size must equal Mb x Kb.
+     * The group ids select the M-block and K-block of the work-group.
+     * If a filter is given, the spectrum is multiplied point-wise with the N complex numbers
+     * filter[0], ..., filter[N-1] and transformed back with the opposite direction before the
+     * store (c2c only).
+     */
+    void generate_body(clir::block_builder &bb, small_batch_configuration const &cfg,
+                       body_params bp) const;
+
   protected:
     struct copy_params {
         small_batch_configuration const &cfg;
@@ -47,11 +99,27 @@ class sbfft_gen {
         clir::expr kb;
         clir::expr kb_odd = nullptr;
         permutation_fun P = identity;
+        bool dense = false; ///< view and X1_view are dense arrays of mb x N x kb entries
     };
 
     virtual void load(clir::block_builder &bb, copy_params cp) const = 0;
     virtual void store(clir::block_builder &bb, copy_params cp) const = 0;
 
+    /**
+     * @brief Copy the mb x N x kb block from global memory to shared local memory
+     *
+     * Dense blocks are copied with a flat loop and sub-group block reads if all sub-groups
+     * are full.
+     */
+    void global_to_slm(clir::block_builder &bb, copy_params const &cp, std::size_t N) const;
+    /**
+     * @brief Copy the mb x N x kb block from shared local memory to global memory
+     *
+     * Dense blocks are copied with a flat loop and sub-group block writes if all sub-groups
+     * are full and the blocks of all work-groups are 16-byte aligned relative to each other.
+     */
+    void slm_to_global(clir::block_builder &bb, copy_params const &cp, std::size_t N) const;
+
     void double_load(clir::block_builder &bb, copy_params cp, int k_offset) const;
     void double_store(clir::block_builder &bb, copy_params cp, int k_offset) const;
 
@@ -133,6 +201,8 @@ class sbfft_gen_c2r_double : public sbfft_gen_c2r {
                            tensor_view<1u> const &x, std::size_t N, int component);
 };
 
+auto make_sbfft_gen(small_batch_configuration const &cfg) -> std::unique_ptr<sbfft_gen>;
+
 } // namespace bbfft
 
 #endif // SBFFT_GEN_20230811_HPP
@@ -1,23 +1,45 @@
 // Copyright (C) 2022 Intel Corporation
 // SPDX-License-Identifier: BSD-3-Clause
 
+#include "bbfft/bad_configuration.hpp"
 #include "bbfft/configuration.hpp"
 #include "bbfft/detail/generator_impl.hpp"
+#include "bbfft/wisdom.hpp"
 #include "generator/sbfft_gen.hpp"
+#include "generator/utility.hpp"
 #include "math.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <sstream>
 #include <stdexcept>
 
 namespace bbfft {
 
-small_batch_configuration configure_small_batch_fft(configuration const &cfg,
-                                                    device_info const &info) {
+std::size_t small_batch_register_space(configuration const &cfg, device_info const &info) {
+    std::size_t sgs = info.min_subgroup_size();
+    std::size_t N = cfg.shape[1];
+    auto required_reg_space_for_small_batch =
+        2 * size_in_bytes(compute_precision(cfg.fp)) * N * sgs;
+    // Can halve register space for real DFT with even N
+    if (cfg.type != transform_type::c2c && N % 2 == 0) {
+        required_reg_space_for_small_batch /= 2;
+    }
+    return required_reg_space_for_small_batch;
+}
+
+bool prefer_small_batch_fft(configuration const &cfg, device_info const &info) {
+    return small_batch_register_space(cfg, info) < info.register_space_max() / 2;
+}
+
+namespace {
+
+small_batch_configuration heuristic_small_batch_configuration(configuration const &cfg,
+                                                              device_info const &info) {
     auto M = cfg.shape[0];
     std::size_t N = cfg.shape[1];
     std::size_t N_slm = N;
-    std::size_t sizeof_real = static_cast<std::size_t>(cfg.fp);
+    std::size_t sizeof_real = size_in_bytes(compute_precision(cfg.fp));
 
     bool is_real = cfg.type == transform_type::r2c || cfg.type == transform_type::c2r;
     if (is_real) {
@@ -40,28 +62,75 @@ small_batch_configuration configure_small_batch_fft(configuration const &cfg,
     auto istride = std::array<std::size_t, 3>{cfg.istride[0], cfg.istride[1], cfg.istride[2]};
     auto ostride = std::array<std::size_t, 3>{cfg.ostride[0], cfg.ostride[1], cfg.ostride[2]};
 
+    if (cfg.input_length > N || cfg.output_length > N) {
+        throw bad_configuration("The input and output length must not exceed the FFT length.");
+    }
+    // Zero encodes the full length such that unpruned FFTs keep their identifiers
+    std::size_t input_length = cfg.input_length == N ? 0 : cfg.input_length;
+    std::size_t output_length = cfg.output_length == N ? 0 : cfg.output_length;
+    if ((input_length || output_length) && cfg.type != transform_type::c2c) {
+        throw bad_configuration("Pruned FFTs are only supported for c2c transforms.");
+    }
+
     return {
-        static_cast<int>(cfg.dir),   // direction
-        M,                           // M
-        Mb,                          // Mb
-        N,                           // N
-        Kb,                          // Kb
-        sgs,                         // sgs
-        cfg.fp,                      // precision
-        cfg.type,                    // transform type
-        istride,                     // istride
-        ostride,                     // ostride
-        inplace_unsupported,         // inplace_unsupported
-        cfg.callbacks.load_function, // load_function
-        cfg.callbacks.store_function // store_function
+        static_cast<int>(cfg.dir),    // direction
+        M,                            // M
+        Mb,                           // Mb
+        N,                            // N
+        Kb,                           // Kb
+        sgs,                          // sgs
+        cfg.fp,                       // precision
+        cfg.type,                     // transform type
+        istride,                      // istride
+        ostride,                      // ostride
+        inplace_unsupported,          // inplace_unsupported
+        cfg.callbacks.load_function,  // load_function
+        cfg.callbacks.store_function, // store_function
+        cfg.planar_offset,            // planar_offset
+        cfg.scale,                    // scale
+        input_length,                 // input_length
+        output_length                 // output_length
     };
 }
 
+} // namespace
+
+small_batch_configuration configure_small_batch_fft(configuration const &cfg,
+                                                    device_info const &info) {
+    if (auto tc = lookup_wisdom(cfg, info); tc.algorithm == tuning_algorithm::small_batch) {
+        return configure_small_batch_fft(cfg, info, tc);
+    }
+    return heuristic_small_batch_configuration(cfg, info);
+}
+
+small_batch_configuration configure_small_batch_fft(configuration const &cfg,
+                                                    device_info const &info,
+                                                    tuning_candidate const &tc) {
+    if (tc.algorithm != tuning_algorithm::small_batch) {
+        throw bad_configuration("The tuning candidate does not select the small batch algorithm.");
+    }
+    auto sbc = heuristic_small_batch_configuration(cfg, info);
+    bool is_real = cfg.type == transform_type::r2c || cfg.type == transform_type::c2r;
+    std::size_t N_slm = is_real ? sbc.N / 2 + 1 : sbc.N;
+    std::size_t sizeof_real = size_in_bytes(compute_precision(cfg.fp));
+    if (std::find(info.subgroup_sizes.begin(), info.subgroup_sizes.end(), tc.sgs) ==
+            info.subgroup_sizes.end() ||
+        tc.Mb == 0 || tc.Kb == 0 || tc.Mb * tc.Kb > info.max_work_group_size ||
+        tc.Mb * tc.Kb * N_slm * 2 * sizeof_real > info.local_memory_size) {
+        throw bad_configuration("The tuning candidate exceeds the limits of the device.");
+    }
+    sbc.Mb = tc.Mb;
+    sbc.Kb = tc.Kb;
+    sbc.sgs = tc.sgs;
+    sbc.inplace_unsupported = is_real && sbc.Mb < sbc.M;
+    return sbc;
+}
+
 std::string small_batch_configuration::identifier() const {
     std::ostringstream oss;
     oss << "sbfft_" << (direction < 0 ? 'm' : 'p') << std::abs(direction) << "_M" << M << "_Mb"
-        << Mb << "_N" << N << "_Kb" << Kb << "_sgs" << sgs << "_f" << static_cast<int>(fp) * 8
-        << '_' << to_string(type) << "_is";
+        << Mb << "_N" << N << "_Kb" << Kb << "_sgs" << sgs << "_" << to_string(fp) << '_'
+        << to_string(type) << "_is";
     for (auto const &is : istride) {
         oss << is << "_";
     }
@@ -76,36 +145,19 @@ std::string small_batch_configuration::identifier() const {
     if (store_function) {
         oss << "_" << store_function;
     }
+    if (planar_offset[0] || planar_offset[1]) {
+        oss << "_pl" << (planar_offset[0] != 0) << (planar_offset[1] != 0);
+    }
+    oss << scale_identifier(scale);
+    if (input_length || output_length) {
+        oss << "_li" << input_length << "_lo" << output_length;
+    }
     return oss.str();
 }
 
 void generate_small_batch_fft(std::ostream &os, small_batch_configuration const &cfg,
                               std::string_view name) {
-    auto gen = std::unique_ptr<sbfft_gen>{};
-    switch (cfg.type) {
-    case transform_type::c2c:
-        gen = std::make_unique<sbfft_gen_c2c>(cfg.N);
-        break;
-    case transform_type::r2c:
-        if (cfg.N % 2 == 1) {
-            gen = std::make_unique<sbfft_gen_r2c_double>(cfg.N);
-        } else {
-            gen = std::make_unique<sbfft_gen_r2c_half>(cfg.N);
-        }
-        break;
-    case transform_type::c2r:
-        if (cfg.N % 2 == 1) {
-            gen = std::make_unique<sbfft_gen_c2r_double>(cfg.N);
-        } else {
-            gen = std::make_unique<sbfft_gen_c2r_half>(cfg.N);
-        }
-        break;
-    default:
-        break;
-    }
-    if (!gen) {
-        throw std::logic_error("Internal logic error: Did you mess with the cfg.type field?");
-    }
+    auto gen = make_sbfft_gen(cfg);
     gen->generate(os, cfg, name);
 }
 
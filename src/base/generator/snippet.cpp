@@ -50,6 +50,81 @@ void copy_mbNkb_block_on_2D_grid(block_builder &bb, tensor_view<3u> const &X_src
     }
 }
 
+void copy_dense_block(block_builder &bb, expr src, expr dest, expr size, expr local_id,
+                      std::size_t work_group_size) {
+    auto i = var("i");
+    bb.add(for_loop_builder(declaration_assignment(generic_uint(), i, std::move(local_id)),
+                            i < size, add_into(i, work_group_size))
+               .body([&](block_builder &bb) { bb.assign(dest[i], src[i]); })
+               .get_product());
+}
+
+void copy_dense_block_with_block_reads(block_builder &bb, expr src, expr dest, expr num_words,
+                                       expr local_id, std::size_t work_group_size,
+                                       std::size_t sgs) {
+    constexpr short words_per_item = 4;
+    std::size_t const chunk = words_per_item * sgs;
+    auto src_w = bb.declare_assign(pointer_to(global_uint()), "src_w",
+                                   cast(pointer_to(global_uint()), src));
+    auto dest_w = bb.declare_assign(pointer_to(local_uint()), "dest_w",
+                                    cast(pointer_to(local_uint()), dest));
+    auto num_chunks = bb.declare_assign(generic_uint(), "num_chunks", num_words / chunk);
+    auto c = var("c");
+    bb.add(for_loop_builder(declaration_assignment(generic_uint(), c, get_sub_group_id()),
+                            c < num_chunks, add_into(c, work_group_size / sgs))
+               .body([&](block_builder &bb) {
+                   auto w = bb.declare_assign(generic_uint(words_per_item), "w",
+                                              intel_sub_group_block_read4(src_w + c * chunk));
+                   auto d = bb.declare_assign(pointer_to(local_uint()), "d",
+                                              dest_w + c * chunk + get_sub_group_local_id());
+                   for (short j = 0; j < words_per_item; ++j) {
+                       bb.assign(d[j * sgs], w.s(j));
+                   }
+               })
+               .get_product());
+    auto i = var("i");
+    bb.add(for_loop_builder(
+               declaration_assignment(generic_uint(), i, num_chunks * chunk + std::move(local_id)),
+               i < num_words, add_into(i, work_group_size))
+               .body([&](block_builder &bb) { bb.assign(dest_w[i], src_w[i]); })
+               .get_product());
+}
+
+void copy_dense_block_with_block_writes(block_builder &bb, expr src, expr dest, expr num_words,
+                                        expr local_id, std::size_t work_group_size,
+                                        std::size_t sgs) {
+    constexpr short words_per_item = 4;
+    std::size_t const chunk = words_per_item * sgs;
+    auto src_w = bb.declare_assign(pointer_to(local_uint()), "src_w",
+                                   cast(pointer_to(local_uint()), src));
+    auto dest_w = bb.declare_assign(pointer_to(global_uint()), "dest_w",
+                                    cast(pointer_to(global_uint()), dest));
+    // Block writes need 16-byte aligned addresses; the chunks are multiples of 16 bytes such that
+    // it suffices to check the start of the block, which is uniform in the work-group
+    auto num_chunks = bb.declare_assign(
+        generic_uint(), "num_chunks",
+        ternary_conditional((cast(generic_ulong(), dest_w) & 15) == 0, num_words / chunk, 0));
+    auto c = var("c");
+    bb.add(for_loop_builder(declaration_assignment(generic_uint(), c, get_sub_group_id()),
+                            c < num_chunks, add_into(c, work_group_size / sgs))
+               .body([&](block_builder &bb) {
+                   auto s = bb.declare_assign(pointer_to(local_uint()), "s",
+                                              src_w + c * chunk + get_sub_group_local_id());
+                   auto w = bb.declare(generic_uint(words_per_item), "w");
+                   for (short j = 0; j < words_per_item; ++j) {
+                       bb.assign(w.s(j), s[j * sgs]);
+                   }
+                   bb.add(intel_sub_group_block_write4(dest_w + c * chunk, w));
+               })
+               .get_product());
+    auto i = var("i");
+    bb.add(for_loop_builder(
+               declaration_assignment(generic_uint(), i, num_chunks * chunk + std::move(local_id)),
+               i < num_words, add_into(i, work_group_size))
+               .body([&](block_builder &bb) { bb.assign(dest_w[i], src_w[i]); })
+               .get_product());
+}
+
 void copy_N_block(block_builder &bb, tensor_view<1u> const &X_src, tensor_view<1u> const &X_dest,
                   int N, int unroll_factor) {
     auto j1 = var("j1");
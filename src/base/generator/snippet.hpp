@@ -22,6 +22,40 @@ void copy_mbNkb_block_on_2D_grid(clir::block_builder &bb, tensor_view<3u> const
                                  tensor_view<3u> const &X_dest, clir::expr mb, std::size_t N,
                                  clir::expr kb);
 
+/**
+ * @brief Copy size entries of a dense array with a flat loop over the work-group
+ *
+ * @param local_id Linear id of the work-item in the work-group
+ * @param work_group_size Number of work-items in the work-group
+ */
+void copy_dense_block(clir::block_builder &bb, clir::expr src, clir::expr dest, clir::expr size,
+                      clir::expr local_id, std::size_t work_group_size);
+
+/**
+ * @brief Copy num_words 32-bit words of a dense array from global to local memory
+ *
+ * Chunks of 4 x sgs words are loaded with sub-group block reads and the remaining words are
+ * copied with a flat loop.
+ * The work-group size must be a multiple of the sub-group size and the source must be 4-byte
+ * aligned.
+ */
+void copy_dense_block_with_block_reads(clir::block_builder &bb, clir::expr src, clir::expr dest,
+                                       clir::expr num_words, clir::expr local_id,
+                                       std::size_t work_group_size, std::size_t sgs);
+
+/**
+ * @brief Copy num_words 32-bit words of a dense array from local to global memory
+ *
+ * Chunks of 4 x sgs words are stored with sub-group block writes and the remaining words are
+ * copied with a flat loop.
+ * Block writes to global memory require 16-byte aligned addresses, which is checked at run-time
+ * for the destination; if the destination is misaligned, all words are copied with the flat loop.
+ * The work-group size must be a multiple of the sub-group size.
+ */
+void copy_dense_block_with_block_writes(clir::block_builder &bb, clir::expr src, clir::expr dest,
+                                        clir::expr num_words, clir::expr local_id,
+                                        std::size_t work_group_size, std::size_t sgs);
+
 void copy_N_block(clir::block_builder &bb, tensor_view<1u> const &X_src,
                   tensor_view<1u> const &X_dest, int N, int unroll_factor = 2);
 
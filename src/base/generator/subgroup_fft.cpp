@@ -0,0 +1,228 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "bbfft/bad_configuration.hpp"
+#include "bbfft/configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
+#include "bbfft/wisdom.hpp"
+#include "generator/utility.hpp"
+#include "math.hpp"
+#include "mixed_radix_fft.hpp"
+#include "prime_factorization.hpp"
+#include "scrambler.hpp"
+
+#include "clir/attr_defs.hpp"
+#include "clir/builder.hpp"
+#include "clir/builtin_function.hpp"
+#include "clir/builtin_type.hpp"
+#include "clir/data_type.hpp"
+#include "clir/expr.hpp"
+#include "clir/var.hpp"
+#include "clir/visitor/unique_names.hpp"
+#include "clir/visitor/unsafe_simplification.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+using namespace clir;
+
+namespace bbfft {
+
+namespace {
+
+//! Maximum number of points per lane, such that the DFT stays in registers
+constexpr std::size_t max_points_per_lane = 16;
+
+bool is_subgroup_fft_applicable(configuration const &cfg, std::size_t sgs) {
+    std::size_t N = cfg.shape[1];
+    bool const is_pruned = (cfg.input_length != 0 && cfg.input_length != N) ||
+                           (cfg.output_length != 0 && cfg.output_length != N);
+    bool const is_planar = cfg.planar_offset[0] != 0 || cfg.planar_offset[1] != 0;
+    if (cfg.dim != 1 || cfg.type != transform_type::c2c || cfg.shape[0] != 1 || cfg.callbacks ||
+        is_pruned || is_planar || compute_precision(cfg.fp) != cfg.fp) {
+        return false;
+    }
+    // The DFT over the lanes is computed with radix-2 butterflies
+    bool const is_power_of_2 = sgs >= 2 && (sgs & (sgs - 1)) == 0;
+    return is_power_of_2 && N % sgs == 0 && N / sgs >= 2 && N / sgs <= max_points_per_lane;
+}
+
+std::size_t heuristic_subgroup_size(configuration const &cfg, device_info const &info) {
+    std::size_t sgs = 0;
+    for (auto const &s : info.subgroup_sizes) {
+        if (is_subgroup_fft_applicable(cfg, s) && (sgs == 0 || s < sgs)) {
+            sgs = s;
+        }
+    }
+    return sgs;
+}
+
+subgroup_configuration make_subgroup_configuration(configuration const &cfg,
+                                                   device_info const &info, std::size_t sgs) {
+    std::size_t max_work_group_size = std::min(std::size_t(128), info.max_work_group_size);
+    std::size_t max_Kb = std::max(std::size_t(1), max_work_group_size / sgs);
+    std::size_t Kb = std::min(cfg.shape[2], max_power_of_2_less_equal(max_Kb));
+
+    auto istride = std::array<std::size_t, 3>{cfg.istride[0], cfg.istride[1], cfg.istride[2]};
+    auto ostride = std::array<std::size_t, 3>{cfg.ostride[0], cfg.ostride[1], cfg.ostride[2]};
+
+    return {
+        static_cast<int>(cfg.dir), // direction
+        cfg.shape[1],              // N
+        Kb,                        // Kb
+        sgs,                       // sgs
+        cfg.fp,                    // precision
+        istride,                   // istride
+        ostride,                   // ostride
+        cfg.scale                  // scale
+    };
+}
+
+} // namespace
+
+bool prefer_subgroup_fft(configuration const &cfg, device_info const &info) {
+    return heuristic_subgroup_size(cfg, info) != 0;
+}
+
+subgroup_configuration configure_subgroup_fft(configuration const &cfg, device_info const &info) {
+    if (auto tc = lookup_wisdom(cfg, info); tc.algorithm == tuning_algorithm::subgroup) {
+        return configure_subgroup_fft(cfg, info, tc);
+    }
+    auto sgs = heuristic_subgroup_size(cfg, info);
+    if (sgs == 0) {
+        throw bad_configuration("The sub-group FFT does not support the configuration.");
+    }
+    return make_subgroup_configuration(cfg, info, sgs);
+}
+
+subgroup_configuration configure_subgroup_fft(configuration const &cfg, device_info const &info,
+                                              tuning_candidate const &tc) {
+    if (tc.algorithm != tuning_algorithm::subgroup) {
+        throw bad_configuration("The tuning candidate does not select the sub-group algorithm.");
+    }
+    if (!is_subgroup_fft_applicable(cfg, tc.sgs)) {
+        throw bad_configuration("The sub-group FFT does not support the configuration.");
+    }
+    if (std::find(info.subgroup_sizes.begin(), info.subgroup_sizes.end(), tc.sgs) ==
+            info.subgroup_sizes.end() ||
+        tc.Kb == 0 || tc.sgs * tc.Kb > info.max_work_group_size) {
+        throw bad_configuration("The tuning candidate exceeds the limits of the device.");
+    }
+    auto sgc = make_subgroup_configuration(cfg, info, tc.sgs);
+    sgc.Kb = tc.Kb;
+    return sgc;
+}
+
+std::string subgroup_configuration::identifier() const {
+    std::ostringstream oss;
+    oss << "sgfft_" << (direction < 0 ? 'm' : 'p') << std::abs(direction) << "_N" << N << "_Kb"
+        << Kb << "_sgs" << sgs << "_" << to_string(fp) << "_is";
+    for (auto const &is : istride) {
+        oss << is << "_";
+    }
+    oss << "os";
+    for (auto const &os : ostride) {
+        oss << os << "_";
+    }
+    oss << scale_identifier(scale);
+    return oss.str();
+}
+
+void generate_subgroup_fft(std::ostream &os, subgroup_configuration const &cfg,
+                           std::string_view name) {
+    if (cfg.sgs < 2 || (cfg.sgs & (cfg.sgs - 1)) != 0 || cfg.N % cfg.sgs != 0) {
+        throw bad_configuration(
+            "The DFT length must be a multiple of the sub-group size, which must be a power of 2.");
+    }
+    auto fph = precision_helper{cfg.fp};
+    auto cmul = complex_mul(fph);
+    int const N = static_cast<int>(cfg.N);
+    int const sgs = static_cast<int>(cfg.sgs);
+    int const r = N / sgs;
+    int log2_sgs = 0;
+    while ((1 << log2_sgs) < sgs) {
+        ++log2_sgs;
+    }
+
+    auto in = var("in");
+    auto out = var("out");
+    auto K = var("K");
+
+    auto fb = kernel_builder{name.empty() ? cfg.identifier() : std::string(name)};
+    fb.argument(pointer_to(fph.type(2, address_space::global_t)), in);
+    fb.argument(pointer_to(fph.type(2, address_space::global_t)), out);
+    fb.argument(generic_ulong(), K);
+    fb.attribute(reqd_work_group_size(sgs, static_cast<int>(cfg.Kb), 1));
+    fb.attribute(intel_reqd_sub_group_size(sgs));
+    fb.body([&](block_builder &bb) {
+        auto l = bb.declare_assign(generic_uint(), "l", get_sub_group_local_id());
+        auto k = bb.declare_assign(generic_size(), "k", get_global_id(1));
+        // k is uniform within a sub-group, therefore all lanes take part in the shuffles
+        bb.add(
+            if_selection_builder(k < K)
+                .then([&](block_builder &bb) {
+                    // Lane l holds the points n = l + sgs * j
+                    auto x = bb.declare(array_of(fph.type(2), r), "x");
+                    for (int j = 0; j < r; ++j) {
+                        bb.assign(x[j], in[(l + j * sgs) * cfg.istride[1] + k * cfg.istride[2]]);
+                    }
+
+                    // DFTs of length r in registers
+                    auto factorization = trial_division(r);
+                    generate_fft::pair_optimization_inplace(bb, cfg.fp, cfg.direction,
+                                                            factorization, x);
+                    auto P = unscrambler(factorization);
+                    for (int j = 1; j < r; ++j) {
+                        auto phi = cast(fph.type(), l * j % N) * fph.constant(2.0 / N);
+                        auto w = bb.declare_assign(
+                            fph.type(2), "w",
+                            init_vector(fph.type(2),
+                                        {cospi(phi), fph.constant(cfg.direction) * sinpi(phi)}));
+                        bb.assign(x[P(j)], cmul(x[P(j)], w));
+                    }
+
+                    // DFTs of length sgs over the lanes with radix-2 decimation in frequency;
+                    // lane l ends up with coefficient bit_reverse(l)
+                    for (int h = sgs / 2; h >= 1; h /= 2) {
+                        auto is_upper = (l & h) != 0u;
+                        auto sign = bb.declare_assign(
+                            fph.type(), "sign",
+                            ternary_conditional(is_upper, fph.constant(-1.0), fph.constant(1.0)));
+                        auto w = var{};
+                        if (h > 1) {
+                            auto phi = ternary_conditional(
+                                is_upper, cast(fph.type(), l & (h - 1)) * fph.constant(1.0 / h),
+                                fph.zero());
+                            w = bb.declare_assign(
+                                fph.type(2), "w",
+                                init_vector(fph.type(2), {cospi(phi), fph.constant(cfg.direction) *
+                                                                          sinpi(phi)}));
+                        }
+                        for (int j = 0; j < r; ++j) {
+                            auto y = bb.declare_assign(
+                                fph.type(2), "y",
+                                intel_sub_group_shuffle_xor(x[j], static_cast<unsigned>(h)) +
+                                    sign * x[j]);
+                            bb.assign(x[j], h > 1 ? cmul(y, w) : expr(y));
+                        }
+                    }
+
+                    auto k1 = bb.declare_assign(generic_uint(), "k1", (l & 1u) << (log2_sgs - 1));
+                    for (int b = 1; b < log2_sgs; ++b) {
+                        bb.assign(k1, k1 | (((l >> b) & 1u) << (log2_sgs - 1 - b)));
+                    }
+                    for (int j = 0; j < r; ++j) {
+                        auto y = cfg.scale != 1.0 ? x[P(j)] * fph.constant(cfg.scale) : x[P(j)];
+                        bb.assign(out[(j + k1 * r) * cfg.ostride[1] + k * cfg.ostride[2]], y);
+                    }
+                })
+                .get_product());
+    });
+    auto f = fb.get_product();
+    make_names_unique(f);
+    unsafe_simplify(f);
+    generate_kernel(os, f);
+}
+
+} // namespace bbfft
@@ -17,20 +17,65 @@ auto zero_accessor::subview(block_builder &, expr const &) const
 
 array_accessor::array_accessor(expr x, data_type type, int component)
     : x_(std::move(x)), type_(std::move(type)), component_(component) {}
+array_accessor::array_accessor(expr re, expr im, precision fp)
+    : x_(std::move(re)), type_(precision_helper{fp}.type(address_space::global_t)),
+      component_(-1), im_(std::move(im)), complex_type_(precision_helper{fp}.type(2)) {}
 
 expr array_accessor::operator()(expr const &offset) const {
+    if (im_) {
+        return init_vector(complex_type_, {x_[offset], im_[offset]});
+    }
     auto e = x_[offset];
     return component_ >= 0 ? e.s(component_) : e;
 }
 expr array_accessor::store(expr value, expr const &offset) const {
+    if (im_) {
+        return comma(assignment(x_[offset], value.s(0)), assignment(im_[offset], value.s(1)));
+    }
     return assignment(this->operator()(offset), std::move(value));
 }
 auto array_accessor::subview(block_builder &bb, expr const &offset) const
     -> std::shared_ptr<tensor_accessor> {
     auto e = bb.declare_assign(pointer_to(type_), "sub", x_ + offset);
+    if (im_) {
+        auto e_im = bb.declare_assign(pointer_to(type_), "sub_im", im_ + offset);
+        auto acc = std::make_shared<array_accessor>(*this);
+        acc->x_ = std::move(e);
+        acc->im_ = std::move(e_im);
+        return acc;
+    }
     return std::make_shared<array_accessor>(e, type_);
 }
 
+storage_accessor::storage_accessor(expr x, precision fp, short components)
+    : x_(std::move(x)), fph_(fp), components_(components) {}
+
+expr storage_accessor::operator()(expr const &offset) const {
+    if (fph_.storage_cl_type() == builtin_type::half_t) {
+        return components_ == 1 ? vload_half(offset, x_) : vload_half2(offset, x_);
+    }
+    if (components_ == 1) {
+        return intel_convert_as_bfloat16_float(x_[offset]);
+    }
+    return intel_convert_as_bfloat162_float2(vload2(offset, x_));
+}
+expr storage_accessor::store(expr value, expr const &offset) const {
+    if (fph_.storage_cl_type() == builtin_type::half_t) {
+        return components_ == 1 ? vstore_half(std::move(value), offset, x_)
+                                : vstore_half2(std::move(value), offset, x_);
+    }
+    if (components_ == 1) {
+        return assignment(x_[offset], intel_convert_bfloat16_as_ushort(std::move(value)));
+    }
+    return vstore2(intel_convert_bfloat162_as_ushort2(std::move(value)), offset, x_);
+}
+auto storage_accessor::subview(block_builder &bb, expr const &offset) const
+    -> std::shared_ptr<tensor_accessor> {
+    auto ty = fph_.storage_type(components_, address_space::global_t);
+    auto e = bb.declare_assign(pointer_to(ty), "sub", x_ + components_ * offset);
+    return std::make_shared<storage_accessor>(e, fph_.storage_precision(), components_);
+}
+
 callback_accessor::callback_accessor(expr x, data_type type, char const *load, char const *store,
                                      expr offset)
     : x_(std::move(x)), type_(std::move(type)), load_(load), store_(store),
@@ -38,6 +38,14 @@ class zero_accessor : public tensor_accessor {
 class array_accessor : public tensor_accessor {
   public:
     array_accessor(clir::expr x, clir::data_type type, int component = -1);
+    /**
+     * @brief Accessor for complex numbers in planar layout
+     *
+     * @param re Pointer to real parts
+     * @param im Pointer to imaginary parts
+     * @param fp Floating-point precision
+     */
+    array_accessor(clir::expr re, clir::expr im, precision fp);
 
     clir::expr operator()(clir::expr const &offset) const override;
     clir::expr store(clir::expr value, clir::expr const &offset) const override;
@@ -46,11 +54,39 @@ class array_accessor : public tensor_accessor {
 
     inline int component() const { return component_; }
     inline void component(int c) { component_ = c; }
+    //! True if the offset indexes the array directly, i.e. neither component nor planar access
+    inline bool is_dense() const { return component_ < 0 && !bool(im_); }
+    inline clir::expr const &pointer() const { return x_; }
 
   private:
     clir::expr x_;
     clir::data_type type_;
     int component_;
+    clir::expr im_ = nullptr;
+    clir::data_type complex_type_ = nullptr;
+};
+
+/**
+ * @brief Accessor for global memory with 16-bit storage precision
+ *
+ * Loads convert from the storage type to the compute type and stores convert
+ * from the compute type to the storage type.
+ * The pointer has scalar storage type and the offset counts vectors with the given number
+ * of components.
+ */
+class storage_accessor : public tensor_accessor {
+  public:
+    storage_accessor(clir::expr x, precision fp, short components);
+
+    clir::expr operator()(clir::expr const &offset) const override;
+    clir::expr store(clir::expr value, clir::expr const &offset) const override;
+    auto subview(clir::block_builder &bb, clir::expr const &offset) const
+        -> std::shared_ptr<tensor_accessor> override;
+
+  private:
+    clir::expr x_;
+    precision_helper fph_;
+    short components_;
 };
 
 class callback_accessor : public tensor_accessor {
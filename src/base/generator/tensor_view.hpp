@@ -39,6 +39,7 @@ template <std::size_t D> class tensor_view {
     virtual ~tensor_view() {}
 
     auto shape(unsigned int d) const { return indexer_.shape(d); }
+    auto const &accessor() const { return accessor_; }
 
     expr operator()(std::array<expr, D> const &idx) const { return (*accessor_)(indexer_(idx)); }
     template <typename... Entry, typename = std::enable_if_t<sizeof...(Entry) == D, int>>
@@ -3,29 +3,178 @@
 
 #include "utility.hpp"
 
+#include "bbfft/detail/compiler_options.hpp"
+#include "clir/builtin_function.hpp"
+#include "clir/internal/function_node.hpp"
+#include "clir/visitor/codegen_opencl.hpp"
+#include "clir/visitor/common_subexpression.hpp"
+#include "clir/visitor/constant_folding.hpp"
+#include "clir/visitor/dead_store.hpp"
+#include "clir/visitor/kernel_statistics.hpp"
+#include "clir/visitor/required_extensions.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+
 using namespace clir;
 
 namespace bbfft {
 
+struct kernel_recorder::recording {
+    std::unordered_map<std::string, func> functions;
+};
+
+namespace {
+thread_local kernel_statistics_collector *active_collector = nullptr;
+// Non-owning such that the recording may outlive the thread-local storage, e.g. in static objects
+thread_local std::weak_ptr<kernel_recorder::recording> active_recording;
+
+auto function_name(func f) -> std::string {
+    if (auto fn = dynamic_cast<internal::function *>(f.get()); fn) {
+        if (auto proto = dynamic_cast<internal::prototype *>(fn->prototype().get()); proto) {
+            return std::string(proto->name());
+        }
+    }
+    return {};
+}
+
+bool is_identifier_char(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+//! True if source contains name followed by an opening parenthesis
+bool mentions_function(std::string_view source, std::string_view name) {
+    for (auto pos = source.find(name); pos != std::string_view::npos;
+         pos = source.find(name, pos + 1)) {
+        auto const end = pos + name.size();
+        if ((pos == 0 || !is_identifier_char(source[pos - 1])) && end < source.size() &&
+            source[end] == '(') {
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace
+
 builtin_type precision_to_builtin_type(precision fp) {
     builtin_type t = builtin_type::void_t;
-    switch (fp) {
+    switch (compute_precision(fp)) {
     case precision::f32:
         t = builtin_type::float_t;
         break;
     case precision::f64:
         t = builtin_type::double_t;
         break;
+    default:
+        break;
     }
     return t;
 }
 
-short precision_to_bits(precision fp) { return static_cast<int>(fp) * 8; }
+short precision_to_bits(precision fp) {
+    return static_cast<short>(size_in_bytes(compute_precision(fp)) * 8);
+}
+
+std::string scale_identifier(double scale) {
+    if (scale == 1.0) {
+        return {};
+    }
+    std::uint64_t bits;
+    static_assert(sizeof(bits) == sizeof(scale));
+    std::memcpy(&bits, &scale, sizeof(bits));
+    std::ostringstream oss;
+    oss << "_sc" << std::hex << bits;
+    return oss.str();
+}
+
+namespace {
+void optimize_and_record(func &f) {
+    fold_constants(f);
+    eliminate_common_subexpressions(f);
+    eliminate_dead_stores(f);
+    if (auto rec = active_recording.lock(); rec) {
+        rec->functions[function_name(f)] = f;
+    }
+}
+} // namespace
+
+namespace {
+/*
+ * Extensions that are not listed in detail::required_extensions are only enabled in the source
+ * of the functions that need them, e.g. the bfloat16 conversions of bf16 kernels, such that
+ * other kernels compile on devices without those extensions
+ */
+void enable_extensions(std::ostream &os, func f) {
+    auto const &global = detail::required_extensions;
+    for (auto ext : get_required_extensions(std::move(f))) {
+        auto const name = std::string(to_string(ext));
+        if (std::find(global.begin(), global.end(), name) == global.end()) {
+            os << "#pragma OPENCL EXTENSION " << name << " : enable" << std::endl;
+        }
+    }
+}
+} // namespace
+
+void generate_kernel(std::ostream &os, func f) {
+    optimize_and_record(f);
+    if (active_collector) {
+        auto s = get_kernel_statistics(f);
+        active_collector->stats_.emplace_back(bbfft::kernel_statistics{
+            std::move(s.name), s.flops, s.global_loads, s.global_stores, s.local_loads,
+            s.local_stores, s.barriers, s.sub_group_shuffles, s.private_array_bytes,
+            s.local_memory_bytes});
+    }
+    enable_extensions(os, f);
+    generate_opencl(os, std::move(f));
+}
+
+void generate_function(std::ostream &os, func f) {
+    optimize_and_record(f);
+    enable_extensions(os, f);
+    generate_opencl(os, std::move(f));
+}
+
+kernel_statistics_collector::kernel_statistics_collector() : previous_(active_collector) {
+    active_collector = this;
+}
+kernel_statistics_collector::~kernel_statistics_collector() { active_collector = previous_; }
+
+kernel_recorder::kernel_recorder() : recording_(active_recording.lock()) {
+    if (!recording_) {
+        recording_ = std::make_shared<recording>();
+        active_recording = recording_;
+    }
+}
+kernel_recorder::~kernel_recorder() = default;
+auto kernel_recorder::take(std::string_view source) -> std::vector<func> {
+    auto kernels = std::vector<func>{};
+    for (auto it = recording_->functions.begin(); it != recording_->functions.end();) {
+        if (mentions_function(source, it->first)) {
+            kernels.emplace_back(std::move(it->second));
+            it = recording_->functions.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return kernels;
+}
 
 precision_helper::precision_helper(precision fp) : fp_(fp) {}
-builtin_type precision_helper::cl_type() const {
+builtin_type precision_helper::cl_type() const { return precision_to_builtin_type(fp_); }
+builtin_type precision_helper::storage_cl_type() const {
     builtin_type t = builtin_type::void_t;
     switch (fp_) {
+    case precision::f16:
+        t = builtin_type::half_t;
+        break;
+    case precision::bf16:
+        t = builtin_type::ushort_t;
+        break;
     case precision::f32:
         t = builtin_type::float_t;
         break;
@@ -35,20 +184,30 @@ builtin_type precision_helper::cl_type() const {
     }
     return t;
 }
-short precision_helper::bits() const { return static_cast<int>(fp_) * 8; }
+bool precision_helper::converts_storage() const { return fp_ != compute_precision(fp_); }
+short precision_helper::bits() const { return precision_to_bits(fp_); }
 data_type precision_helper::type(address_space as) const { return data_type(cl_type(), as); }
 data_type precision_helper::type(short size, address_space as) const {
     return data_type(cl_type(), size, as);
 }
+data_type precision_helper::storage_type(short size, address_space as) const {
+    if (converts_storage()) {
+        // 16-bit data is accessed with scalar pointers and vload / vstore
+        return data_type(storage_cl_type(), as);
+    }
+    return data_type(cl_type(), size, as);
+}
 data_type precision_helper::select_type() const {
     data_type cast_type = nullptr;
-    switch (fp_) {
+    switch (compute_precision(fp_)) {
     case precision::f32:
         cast_type = generic_uint();
         break;
     case precision::f64:
         cast_type = generic_ulong();
         break;
+    default:
+        break;
     }
     return cast_type;
 }
@@ -5,25 +5,111 @@
 #define UTILITY_20221205_HPP
 
 #include "bbfft/configuration.hpp"
+#include "bbfft/export.hpp"
+#include "bbfft/generator.hpp"
 #include "clir/builtin_type.hpp"
 #include "clir/data_type.hpp"
 #include "clir/expr.hpp"
+#include "clir/func.hpp"
+
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace bbfft {
 
 clir::builtin_type precision_to_builtin_type(precision fp);
 short precision_to_bits(precision fp);
+/**
+ * @brief Identifier suffix for a scale factor
+ *
+ * Empty for scale 1; otherwise "_sc" followed by the bits of the double in hexadecimal, such that
+ * the identifier is exact and a valid OpenCL C identifier.
+ */
+std::string scale_identifier(double scale);
+
+/**
+ * @brief Generate OpenCL C code of a kernel
+ *
+ * The static statistics of the kernel are recorded when a kernel_statistics_collector is alive
+ * on the calling thread; the optimized kernel is recorded when a kernel_recorder is alive.
+ */
+void generate_kernel(std::ostream &os, clir::func f);
+/**
+ * @brief Generate OpenCL C code of a helper function called by kernels
+ *
+ * Same as generate_kernel except that no statistics are recorded for the function.
+ */
+void generate_function(std::ostream &os, clir::func f);
+
+/**
+ * @brief Collects the statistics of all kernels generated on the calling thread while alive
+ */
+class kernel_statistics_collector {
+  public:
+    kernel_statistics_collector();
+    ~kernel_statistics_collector();
+    kernel_statistics_collector(kernel_statistics_collector const &) = delete;
+    kernel_statistics_collector &operator=(kernel_statistics_collector const &) = delete;
+
+    inline auto statistics() const -> std::vector<kernel_statistics> const & { return stats_; }
+
+  private:
+    friend void generate_kernel(std::ostream &os, clir::func f);
+
+    kernel_statistics_collector *previous_;
+    std::vector<kernel_statistics> stats_;
+};
+
+/**
+ * @brief Records the clir functions of the kernels and helper functions generated on the calling
+ * thread
+ *
+ * Functions are recorded while at least one recorder is alive on the calling thread. The
+ * recordings are keyed by function name and shared by all recorders of the thread, such that a
+ * recorder finds the functions of a source independent of the recorder that was created last.
+ * Recordings are dropped when the last recorder of the thread is destroyed.
+ *
+ * Used to execute generated kernels with the clir interpreter.
+ */
+class BBFFT_EXPORT kernel_recorder {
+  public:
+    kernel_recorder();
+    ~kernel_recorder();
+    kernel_recorder(kernel_recorder const &) = delete;
+    kernel_recorder &operator=(kernel_recorder const &) = delete;
+
+    //! Removes the recorded functions that are defined in the OpenCL C source and returns them
+    auto take(std::string_view source) -> std::vector<clir::func>;
+
+    struct recording;
+
+  private:
+    std::shared_ptr<recording> recording_;
+};
 
+/**
+ * @brief Types and constants for a precision
+ *
+ * Types and constants refer to the compute precision. The storage type of global memory
+ * may differ for the 16-bit storage precisions.
+ */
 class precision_helper {
   public:
     precision_helper(precision fp);
     clir::builtin_type cl_type() const;
+    clir::builtin_type storage_cl_type() const;
+    bool converts_storage() const;
     short bits() const;
     clir::data_type type(clir::address_space as = clir::address_space::generic_t) const;
     clir::data_type type(short size, clir::address_space as = clir::address_space::generic_t) const;
+    clir::data_type storage_type(short size, clir::address_space as) const;
     clir::data_type select_type() const;
     clir::expr constant(double value) const;
     clir::expr zero() const;
+    inline precision storage_precision() const { return fp_; }
 
   private:
     precision fp_;
@@ -4,6 +4,7 @@
 #include "mixed_radix_fft.hpp"
 #include "bbfft/tensor_indexer.hpp"
 #include "math.hpp"
+#include "prime_factorization.hpp"
 #include "root_of_unity.hpp"
 #include "scrambler.hpp"
 
@@ -14,6 +15,7 @@
 #include "clir/var.hpp"
 
 #include <algorithm>
+#include <complex>
 #include <cstddef>
 #include <type_traits>
 #include <unordered_map>
@@ -43,13 +45,19 @@ expr complex_mul::pair_imag(clir::expr x1, clir::expr x2, std::complex<double> c
     return wi * init_vector(fph_.type(2), {x2.s(1) - x1.s(1), x1.s(0) - x2.s(0)});
 }
 
+namespace {
+expr add_term(expr sum, expr term) { return sum ? sum + std::move(term) : term; }
+} // namespace
+
 clir::expr basic_esum::operator()(block_builder &, int kf) {
     expr esum = x_(0);
     for (int jf = 1; jf < Nf_; ++jf) {
-        auto w = power_of_w(direction_ * kf * jf, Nf_);
-        esum = esum + cmul_(x_(jf), w);
+        if (auto x = x_(jf); x) {
+            auto w = power_of_w(direction_ * kf * jf, Nf_);
+            esum = add_term(esum, cmul_(x, w));
+        }
     }
-    return esum;
+    return esum ? esum : cmul_.fph().zero();
 }
 
 /*
@@ -96,17 +104,29 @@ clir::expr pair_optimization_esum::operator()(block_builder &bb, int kf) {
     }
 
     for (auto const &s : singletons) {
-        auto w = power_of_w(s.w_arg);
-        esum = esum + cmul_(x_(s.jf), w);
+        if (auto x = x_(s.jf); x) {
+            esum = add_term(esum, cmul_(x, power_of_w(s.w_arg)));
+        }
     }
     for (auto const &p : pairs) {
+        auto xa = x_(p.first.jf);
+        auto xb = x_(p.second.jf);
+        // Pairs with a known-zero input reduce to a single product
+        if (!bool(xa) || !bool(xb)) {
+            if (xa) {
+                esum = add_term(esum, cmul_(xa, power_of_w(p.first.w_arg)));
+            } else if (xb) {
+                esum = add_term(esum, cmul_(xb, power_of_w(p.second.w_arg)));
+            }
+            continue;
+        }
         auto p1 = p.first;
         auto p2 = p.second;
         p1.w_arg.first *= -1;
         p2.w_arg.first *= -1;
         auto other_pair = std::make_pair(p1, p2);
         if (auto it = available_pairs_.find(other_pair); it != available_pairs_.end()) {
-            esum = esum + it->second.first - it->second.second;
+            esum = add_term(esum, it->second.first) - it->second.second;
         } else {
             p1 = p.first;
             p2 = p.second;
@@ -119,10 +139,10 @@ clir::expr pair_optimization_esum::operator()(block_builder &bb, int kf) {
             auto v1 = bb.declare_assign(cmul_.fph().type(2), "p1", cmul_.pair_real(x1, x2, w));
             auto v2 = bb.declare_assign(cmul_.fph().type(2), "p2", cmul_.pair_imag(x1, x2, w));
             available_pairs_[p] = std::make_pair(v1, v2);
-            esum = esum + v1 + v2;
+            esum = add_term(esum, v1) + v2;
         }
     }
-    return esum;
+    return esum ? esum : cmul_.fph().zero();
 }
 
 expr multiply_imaginary_unit(precision_helper fph, expr x, expr is_odd) {
@@ -212,9 +232,88 @@ void generate_fft::basic(block_builder &bb, precision fp, int direction,
     std::swap(x, y);
 }
 
+namespace {
+/*
+ * Prime factors p >= 17 are computed with Rader's algorithm if p-1 only has factors <= 7,
+ * otherwise the FFTs of length p-1 are too expensive to beat the direct sum with pair optimization.
+ */
+bool use_rader(int p) {
+    if (p < 17 || !is_prime(p)) {
+        return false;
+    }
+    auto factors = trial_division(p - 1);
+    return *std::max_element(factors.begin(), factors.end()) <= 7;
+}
+} // namespace
+
+template <typename ESum>
+void inplace(clir::block_builder &bb, precision fp, int direction, std::vector<int> factorization,
+             clir::var x, clir::expr twiddle = nullptr, std::size_t input_length = 0);
+
+/*
+ * Rader's algorithm for prime p
+ *
+ * Let g be a primitive root modulo p. Substituting j = g^r and k = g^{-q} for j,k != 0 gives
+ *
+ * X(g^{-q}) = x(0) + sum_{r=0}^{p-2} x(g^r) * w_p^{g^{r-q}}
+ *           = x(0) + (a * c)(q),
+ *
+ * where a(r) = x(g^r), c(m) = w_p^{g^{-m}}, and * is the cyclic convolution of length p-1.
+ * The convolution is computed as IDFT(DFT(a) .* DFT(c) / (p-1)), where DFT(c) / (p-1) is a
+ * compile-time constant, and the DFTs of length p-1 are again mixed-radix FFTs.
+ * Moreover, X(0) = x(0) + DFT(a)(0).
+ *
+ * The direct sum needs O(p^2) operations whereas Rader's algorithm needs O(p log p) operations.
+ */
+template <typename ESum>
+void rader_butterfly(clir::block_builder &bb, precision fp, int direction, int p,
+                     std::function<clir::expr(int)> x, clir::var y) {
+    int const P = p - 1;
+    int const g = primitive_root(p);
+    int g_inv = 1;
+    for (int i = 0; i < P - 1; ++i) {
+        g_inv = g_inv * g % p;
+    }
+
+    auto factorization = trial_division(P);
+    auto P_of = unscrambler(factorization);
+
+    auto c = std::vector<std::complex<double>>(P);
+    for (int m = 0, gm = 1; m < P; ++m, gm = gm * g_inv % p) {
+        c[m] = power_of_w(direction * gm, p);
+    }
+    auto C = std::vector<std::complex<double>>(P);
+    for (int q = 0; q < P; ++q) {
+        for (int m = 0; m < P; ++m) {
+            C[q] += c[m] * power_of_w(-((m * q) % P), P);
+        }
+        C[q] /= static_cast<double>(P);
+    }
+
+    auto fph = precision_helper(fp);
+    auto cmul = complex_mul(fph);
+    auto x0 = x(0) ? x(0) : fph.zero();
+    auto a = bb.declare(array_of(fph.type(2), P), "a");
+    for (int r = 0, gr = 1; r < P; ++r, gr = gr * g % p) {
+        auto xr = x(gr);
+        bb.assign(a[r], xr ? xr : fph.zero());
+    }
+    inplace<ESum>(bb, fp, -1, factorization, a);
+    bb.assign(y[0], x0 + a[0]);
+
+    auto b = bb.declare(array_of(fph.type(2), P), "b");
+    for (int q = 0; q < P; ++q) {
+        bb.assign(b[q], cmul(a[P_of(q)], C[q]));
+    }
+    inplace<ESum>(bb, fp, 1, factorization, b);
+    for (int q = 0, gq = 1; q < P; ++q, gq = gq * g_inv % p) {
+        bb.assign(y[gq], x0 + b[P_of(q)]);
+    }
+}
+
 template <typename ESum>
 void inplace(clir::block_builder &bb, precision fp, int direction, std::vector<int> factorization,
-             clir::var x, clir::expr twiddle = nullptr) {
+             clir::var x, clir::expr twiddle, std::size_t input_length) {
     int L = factorization.size();
     int N = product(factorization.begin(), factorization.end(), 1);
     int J = N;
@@ -223,6 +322,11 @@ void inplace(clir::block_builder &bb, precision fp, int direction, std::vector<i
     auto scramble = scrambler(factorization);
 
     auto cmul = complex_mul(fph);
+    // is_zero[i] is true if x[i] is known to be zero; such entries are never read
+    auto is_zero = std::vector<bool>(N, false);
+    for (int i = input_length; i < N && input_length > 0; ++i) {
+        is_zero[i] = true;
+    }
 
     for (int f = L - 1; f >= 0; --f) {
         auto Nf = factorization[f];
@@ -231,9 +335,26 @@ void inplace(clir::block_builder &bb, precision fp, int direction, std::vector<i
         auto indexer = tensor_indexer<int, 3, layout::col_major>({J, Nf, K});
         for (int j = 0; j < J; ++j) {
             for (int k = 0; k < K; ++k) {
-                auto esum = ESum(fph, direction, Nf, [&](int jf) { return x[indexer(j, jf, k)]; });
+                bool all_zero = true;
+                for (int jf = 0; jf < Nf; ++jf) {
+                    all_zero = all_zero && is_zero[indexer(j, jf, k)];
+                }
+                if (all_zero) {
+                    continue;
+                }
+                auto x_jk = [&](int jf) -> expr {
+                    auto idx = indexer(j, jf, k);
+                    return is_zero[idx] ? expr(nullptr) : expr(x[idx]);
+                };
+                if (use_rader(Nf)) {
+                    rader_butterfly<ESum>(bb, fp, direction, Nf, x_jk, y);
+                } else {
+                    auto esum = ESum(fph, direction, Nf, x_jk);
+                    for (int kf = 0; kf < Nf; ++kf) {
+                        bb.assign(y[kf], esum(bb, kf));
+                    }
+                }
                 for (int kf = 0; kf < Nf; ++kf) {
-                    bb.assign(y[kf], esum(bb, kf));
                     auto tw = power_of_w(direction * kf * j, J * Nf);
                     if (bool(twiddle) && f == 0) {
                         auto tw_idx = scramble(indexer(j, kf, k));
@@ -246,11 +367,17 @@ void inplace(clir::block_builder &bb, precision fp, int direction, std::vector<i
                 }
                 for (int kf = 0; kf < Nf; ++kf) {
                     bb.assign(x[indexer(j, kf, k)], y[kf]);
+                    is_zero[indexer(j, kf, k)] = false;
                 }
             }
         }
         K *= Nf;
     }
+    for (int i = 0; i < N; ++i) {
+        if (is_zero[i]) {
+            bb.assign(x[i], fph.zero());
+        }
+    }
 }
 
 void generate_fft::basic_inplace(block_builder &bb, precision fp, int direction,
@@ -260,9 +387,11 @@ void generate_fft::basic_inplace(block_builder &bb, precision fp, int direction,
 }
 
 void generate_fft::pair_optimization_inplace(block_builder &bb, precision fp, int direction,
-                                             std::vector<int> factorization, var x, expr twiddle) {
+                                             std::vector<int> factorization, var x, expr twiddle,
+                                             std::size_t input_length) {
     inplace<pair_optimization_esum>(bb, std::move(fp), std::move(direction),
-                                    std::move(factorization), std::move(x), std::move(twiddle));
+                                    std::move(factorization), std::move(x), std::move(twiddle),
+                                    input_length);
 }
 
 void generate_fft::basic_inplace_subgroup(block_builder &bb, precision fp, int direction,
@@ -35,6 +35,12 @@ class complex_mul {
     precision_helper fph_;
 };
 
+/**
+ * @brief Sum over the inputs of a butterfly
+ *
+ * The input function returns nullptr for inputs that are known to be zero; these terms are
+ * omitted.
+ */
 class basic_esum {
   public:
     basic_esum(precision_helper fph, int direction, int Nf, std::function<clir::expr(int)> x)
@@ -73,9 +79,15 @@ void basic(clir::block_builder &bb, precision fp, int direction, std::vector<int
 void basic_inplace(clir::block_builder &bb, precision fp, int direction,
                    std::vector<int> factorization, clir::var x, clir::expr twiddle = nullptr);
 
+/**
+ * @brief In-place FFT with pair optimization
+ *
+ * If input_length is non-zero then x[n] is known to be zero for n >= input_length. These entries
+ * are never read and butterflies on known-zero inputs are pruned.
+ */
 void pair_optimization_inplace(clir::block_builder &bb, precision fp, int direction,
                                std::vector<int> factorization, clir::var x,
-                               clir::expr twiddle = nullptr);
+                               clir::expr twiddle = nullptr, std::size_t input_length = 0);
 
 void basic_inplace_subgroup(clir::block_builder &bb, precision fp, int direction,
                             std::vector<int> factorization, clir::var x, clir::expr is_odd,
@@ -79,8 +79,35 @@ configuration parse_fft_descriptor(std::string_view desc) {
         throw std::runtime_error(format_error(message));
     };
     auto const expected = [&](const char *c) { fail("expected " + std::string(c)); };
+    auto const parse_real = [&]() {
+        auto begin = it;
+        while (it != desc.cend() &&
+               (std::isdigit(static_cast<unsigned char>(*it)) || *it == '.' || *it == 'e' ||
+                *it == 'E' || *it == '+' || *it == '-')) {
+            ++it;
+        }
+        auto str = std::string(begin, it);
+        std::size_t pos = 0;
+        double val = 0.0;
+        try {
+            val = std::stod(str, &pos);
+        } catch (std::exception const &) {
+            pos = 0;
+        }
+        if (str.empty() || pos != str.size()) {
+            it = begin;
+            throw std::runtime_error(format_error("expected real number"));
+        }
+        return val;
+    };
 
     switch (advance()) {
+    case 'h':
+        cfg.fp = precision::f16;
+        break;
+    case 'b':
+        cfg.fp = precision::bf16;
+        break;
     case 's':
         cfg.fp = precision::f32;
         break;
@@ -88,7 +115,7 @@ configuration parse_fft_descriptor(std::string_view desc) {
         cfg.fp = precision::f64;
         break;
     default:
-        expected("'s' (single) or 'd' (double)");
+        expected("'h' (half), 'b' (bfloat16), 's' (single), or 'd' (double)");
         break;
     }
     switch (advance()) {
@@ -98,8 +125,14 @@ configuration parse_fft_descriptor(std::string_view desc) {
     case 'r':
         cfg.type = transform_type::r2c;
         break;
+    case 'e':
+        cfg.type = transform_type::dct2;
+        break;
+    case 'o':
+        cfg.type = transform_type::dst2;
+        break;
     default:
-        expected("'c' (complex) or 'r' (real)");
+        expected("'c' (complex), 'r' (real), 'e' (real even / DCT), or 'o' (real odd / DST)");
         break;
     }
     switch (advance()) {
@@ -110,6 +143,10 @@ configuration parse_fft_descriptor(std::string_view desc) {
         cfg.dir = direction::backward;
         if (cfg.type == transform_type::r2c) {
             cfg.type = transform_type::c2r;
+        } else if (cfg.type == transform_type::dct2) {
+            cfg.type = transform_type::dct3;
+        } else if (cfg.type == transform_type::dst2) {
+            cfg.type = transform_type::dst3;
         }
         break;
     default:
@@ -194,8 +231,26 @@ configuration parse_fft_descriptor(std::string_view desc) {
             parse_stride(cfg.ostride);
             custom_ostride = true;
             break;
+        case 'p':
+            cfg.planar_offset[0] = parse_number();
+            if (advance() != ',') {
+                expected(",");
+            }
+            cfg.planar_offset[1] = parse_number();
+            break;
+        case 'l':
+            cfg.input_length = parse_number();
+            if (advance() != ',') {
+                expected(",");
+            }
+            cfg.output_length = parse_number();
+            break;
+        case 's':
+            cfg.scale = parse_real();
+            break;
         default:
-            expected("'i' (istride) or 'o' (ostride)");
+            expected("'i' (istride), 'o' (ostride), 'p' (planar offset), 'l' (input and output "
+                     "length), or 's' (scale)");
             break;
         }
     }
@@ -269,4 +324,62 @@ device_info parse_device_info(std::string_view desc) {
     return info;
 }
 
+tuning_candidate parse_tuning_candidate(std::string_view desc) {
+    tuning_candidate tc = {};
+
+    auto it = desc.cbegin();
+    auto format_error = error_formatter(desc, it);
+    auto parse_number = number_parser(desc, it);
+    auto const accept = [&](std::string_view token) {
+        if (desc.substr(std::distance(desc.cbegin(), it)).substr(0, token.size()) == token) {
+            it += token.size();
+            return true;
+        }
+        return false;
+    };
+    auto const expect = [&](std::string_view token) {
+        if (!accept(token)) {
+            throw std::runtime_error(format_error("expected '" + std::string(token) + "'"));
+        }
+    };
+
+    if (accept("auto")) {
+        tc.algorithm = tuning_algorithm::automatic;
+    } else if (accept("sb_Mb")) {
+        tc.algorithm = tuning_algorithm::small_batch;
+        tc.Mb = parse_number();
+        expect("_Kb");
+        tc.Kb = parse_number();
+        expect("_sgs");
+        tc.sgs = parse_number();
+    } else if (accept("f2_Mb")) {
+        tc.algorithm = tuning_algorithm::factor2_slm;
+        tc.Mb = parse_number();
+        expect("_Nb");
+        tc.Nb = parse_number();
+        expect("_Kb");
+        tc.Kb = parse_number();
+        expect("_sgs");
+        tc.sgs = parse_number();
+        expect("_f");
+        tc.factorization.emplace_back(parse_number());
+        while (accept("x")) {
+            tc.factorization.emplace_back(parse_number());
+        }
+    } else if (accept("sg_Kb")) {
+        tc.algorithm = tuning_algorithm::subgroup;
+        tc.Kb = parse_number();
+        expect("_sgs");
+        tc.sgs = parse_number();
+    } else {
+        throw std::runtime_error(format_error("expected 'auto', 'sb' (small batch), 'f2' "
+                                              "(factor2 SLM), or 'sg' (sub-group)"));
+    }
+    if (it != desc.cend()) {
+        throw std::runtime_error(format_error("unexpected trailing characters"));
+    }
+
+    return tc;
+}
+
 } // namespace bbfft
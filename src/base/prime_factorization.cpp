@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <limits>
 
 namespace bbfft {
@@ -24,6 +25,31 @@ std::vector<int> trial_division(int n) {
     return factorization;
 }
 
+int primitive_root(int p) {
+    if (p == 2) {
+        return 1;
+    }
+    auto factors = trial_division(p - 1);
+    factors.erase(std::unique(factors.begin(), factors.end()), factors.end());
+    auto const pow_mod = [p](int64_t g, int e) {
+        int64_t r = 1;
+        for (; e > 0; e >>= 1) {
+            if (e & 1) {
+                r = r * g % p;
+            }
+            g = g * g % p;
+        }
+        return r;
+    };
+    for (int g = 2; g < p; ++g) {
+        if (std::all_of(factors.begin(), factors.end(),
+                        [&](int q) { return pow_mod(g, (p - 1) / q) != 1; })) {
+            return g;
+        }
+    }
+    return 0;
+}
+
 std::pair<unsigned, double> update_factor(unsigned n, unsigned index, double const target,
                                           unsigned *factors, unsigned *workspace) {
     if (index == 1) {
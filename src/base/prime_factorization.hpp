@@ -18,6 +18,15 @@ namespace bbfft {
  */
 std::vector<int> trial_division(int n);
 
+/**
+ * @brief Smallest primitive root modulo prime p
+ *
+ * @param p prime number
+ *
+ * @return Generator g of the multiplicative group of integers modulo p
+ */
+int primitive_root(int p);
+
 std::pair<unsigned, double> update_factor(unsigned n, unsigned index, double const target,
                                           unsigned *factors, unsigned *workspace);
 
@@ -0,0 +1,127 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef REFERENCE_API_20240502_HPP
+#define REFERENCE_API_20240502_HPP
+
+#include "generator/utility.hpp"
+
+#include "bbfft/bad_configuration.hpp"
+#include "bbfft/detail/plan_impl.hpp"
+#include "bbfft/device_info.hpp"
+#include "bbfft/shared_handle.hpp"
+#include "clir/builder.hpp"
+#include "clir/visitor/interpreter.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bbfft {
+
+/**
+ * @brief Api that executes the generated kernels on the host with the clir interpreter
+ *
+ * Kernels are recorded while they are generated, which requires that plans are created on the
+ * thread that created the api object. build_module looks up the recorded kernels by the names
+ * defined in the source. Kernels that are only available as OpenCL C source, e.g. user
+ * callbacks, cannot be executed.
+ * Kernels run synchronously and pointer arguments must be host pointers.
+ */
+class reference_api {
+  public:
+    using event_type = int;
+    using plan_type = detail::plan_impl<event_type>;
+    using convolution_plan_type = detail::convolution_plan_impl<event_type>;
+    using plan_group_type = detail::plan_group_impl<event_type>;
+    using buffer_type = void *;
+
+    struct module {
+        clir::interpreter ip;
+    };
+    using kernel_bundle_type = module *;
+    struct kernel_type {
+        module *mod = nullptr;
+        std::string name;
+    };
+
+    inline reference_api(device_info info)
+        : info_(std::move(info)), recorder_(std::make_shared<kernel_recorder>()) {}
+
+    inline device_info info() { return info_; }
+    inline uint64_t device_id() { return 0; }
+    inline uint64_t context_id() { return 0; }
+
+    inline auto build_module(std::string const &source) -> shared_handle<module_handle_t> {
+        auto kernels = recorder_->take(source);
+        if (kernels.empty()) {
+            throw bad_configuration("reference_api: source contains no clir kernel");
+        }
+        auto pb = clir::program_builder{};
+        for (auto &k : kernels) {
+            pb.add(std::move(k));
+        }
+        auto mod = new module{clir::interpreter(pb.get_product())};
+        return {reinterpret_cast<module_handle_t>(mod),
+                [](module_handle_t m) { delete reinterpret_cast<module *>(m); }};
+    }
+    inline auto make_kernel_bundle(module_handle_t mod) -> kernel_bundle_type {
+        return reinterpret_cast<module *>(mod);
+    }
+    inline auto create_kernel(kernel_bundle_type bundle, std::string const &name) -> kernel_type {
+        return {bundle, name};
+    }
+    template <typename T>
+    event_type launch_kernel(kernel_type &k, std::array<std::size_t, 3> global_work_size,
+                             std::array<std::size_t, 3> local_work_size,
+                             std::vector<event_type> const &, T set_args) {
+        auto handler = argument_handler{k.mod->ip};
+        set_args(handler);
+        k.mod->ip.launch(k.name, global_work_size, local_work_size);
+        return 0;
+    }
+
+    inline buffer_type create_device_buffer(std::size_t bytes) { return std::malloc(bytes); }
+    template <typename T> buffer_type create_device_buffer(std::size_t num_elements) {
+        return create_device_buffer(num_elements * sizeof(T));
+    }
+
+    inline buffer_type create_twiddle_table(void *src, std::size_t bytes) {
+        auto table = create_device_buffer(bytes);
+        std::memcpy(table, src, bytes);
+        return table;
+    }
+    template <typename T> inline buffer_type create_twiddle_table(std::vector<T> &src) {
+        return create_twiddle_table(src.data(), src.size() * sizeof(T));
+    }
+
+    inline static void wait(event_type) {}
+    inline static void release_event(event_type) {}
+    inline static void release_buffer(buffer_type buf) { std::free(buf); }
+    inline static void release_kernel(kernel_type) {}
+
+  private:
+    class argument_handler {
+      public:
+        argument_handler(clir::interpreter &ip) : ip_(ip) {}
+
+        template <typename T> void set_arg(unsigned index, T const &arg) {
+            ip_.set_arg(index, sizeof(T), &arg);
+        }
+
+      private:
+        clir::interpreter &ip_;
+    };
+
+    device_info info_;
+    std::shared_ptr<kernel_recorder> recorder_;
+};
+
+} // namespace bbfft
+
+#endif // REFERENCE_API_20240502_HPP
@@ -4,6 +4,8 @@
 #include "root_of_unity.hpp"
 #include "clir/builtin_function.hpp"
 
+#include <cmath>
+#include <cstdint>
 #include <numeric>
 
 namespace bbfft {
@@ -183,9 +185,37 @@ std::complex<double> power_of_w(int k, int N) {
         }
         return {re, im};
     }
-    constexpr double tau = 6.28318530717958647693;
-    auto arg = (tau / N) * k;
-    return {std::cos(arg), std::sin(arg)};
+    if (N == 0) {
+        return {1.0, 0.0};
+    }
+
+    // Exact argument reduction: The phase k / N is split into an octant and an integer
+    // remainder such that cos and sin are only evaluated in extended precision on [0, pi/4]
+    constexpr long double pi_4 = 0.785398163397448309615660845819875721L;
+    auto const k8 = 8 * static_cast<int64_t>(k < 0 ? k + N : k);
+    auto const octant = static_cast<int>(k8 / N);
+    auto const rem = k8 - octant * static_cast<int64_t>(N);
+    long double c, s;
+    if (octant % 2 == 0) {
+        auto const x = pi_4 * rem / N;
+        c = std::cos(x);
+        s = std::sin(x);
+    } else {
+        // w = exp(i (pi/2 - x)) relative to the quadrant
+        auto const x = pi_4 * (N - rem) / N;
+        c = std::sin(x);
+        s = std::cos(x);
+    }
+    switch (octant / 2) {
+    case 1:
+        return {static_cast<double>(-s), static_cast<double>(c)};
+    case 2:
+        return {static_cast<double>(-c), static_cast<double>(-s)};
+    case 3:
+        return {static_cast<double>(s), static_cast<double>(-c)};
+    default:
+        return {static_cast<double>(c), static_cast<double>(s)};
+    }
 }
 
 } // namespace bbfft
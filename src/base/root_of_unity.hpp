@@ -1175,6 +1175,9 @@ std::pair<int, int> simplify_power_of_w(int k, int N);
 /**
  * @brief Computes w_N^k where w_N = exp(2 pi i / N)
  *
+ * The result is correctly rounded for N <= 64 and accurate to about half an ulp otherwise, as
+ * the argument is reduced exactly in integer arithmetic.
+ *
  * @param k Exponent
  * @param N N-th root of unity
  *
@@ -0,0 +1,155 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "bbfft/wisdom.hpp"
+#include "bbfft/bad_configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
+#include "bbfft/parser.hpp"
+
+#include <fstream>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+
+namespace bbfft {
+
+namespace {
+
+auto wisdom_key(configuration const &cfg, device_info const &info)
+    -> std::pair<std::string, std::string> {
+    return {info.to_string(), cfg.to_string()};
+}
+
+std::mutex &wisdom_mutex() {
+    static std::mutex m;
+    return m;
+}
+
+std::shared_ptr<wisdom const> &installed_wisdom() {
+    static std::shared_ptr<wisdom const> w;
+    return w;
+}
+
+} // namespace
+
+void wisdom::insert(configuration const &cfg, device_info const &info,
+                    tuning_candidate const &tc) {
+    if (cfg.callbacks) {
+        throw bad_configuration("Wisdom is not supported for FFTs with user callbacks.");
+    }
+    auto key = wisdom_key(cfg, info);
+    if (tc.algorithm == tuning_algorithm::automatic) {
+        entries_.erase(key);
+        return;
+    }
+    if (default_tuning_candidate(cfg, info).algorithm == tuning_algorithm::automatic) {
+        throw bad_configuration("The configuration does not support tuning candidates.");
+    }
+    if (tc.algorithm == tuning_algorithm::small_batch) {
+        configure_small_batch_fft(cfg, info, tc);
+    } else if (tc.algorithm == tuning_algorithm::subgroup) {
+        configure_subgroup_fft(cfg, info, tc);
+    } else {
+        if (cfg.input_length != 0 || cfg.output_length != 0) {
+            throw bad_configuration("Pruned FFTs require the small batch algorithm.");
+        }
+        configure_factor2_slm_fft(cfg, info, tc);
+    }
+    entries_[std::move(key)] = tc;
+}
+
+auto wisdom::find(configuration const &cfg, device_info const &info) const -> tuning_candidate {
+    if (cfg.callbacks) {
+        return {};
+    }
+    if (auto it = entries_.find(wisdom_key(cfg, info)); it != entries_.end()) {
+        return it->second;
+    }
+    return {};
+}
+
+void wisdom::load(std::istream &is) {
+    // Entries are inserted into a copy such that a malformed line leaves the wisdom unchanged
+    auto loaded = *this;
+    std::string line;
+    for (std::size_t line_no = 1; std::getline(is, line); ++line_no) {
+        auto const fail = [&line_no](std::string const &message) {
+            throw std::runtime_error("==> Wisdom line " + std::to_string(line_no) + ": " +
+                                     message);
+        };
+        auto first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+        // The device info is enclosed in braces that may contain further braces and blanks
+        int depth = 0;
+        auto last = first;
+        for (; last < line.size(); ++last) {
+            if (line[last] == '{') {
+                ++depth;
+            } else if (line[last] == '}' && --depth == 0) {
+                break;
+            }
+        }
+        if (line[first] != '{' || last == line.size()) {
+            fail("expected device info enclosed in braces");
+        }
+        auto rest = std::istringstream(line.substr(last + 1));
+        std::string desc, candidate, trailing;
+        if (!(rest >> desc >> candidate) || (rest >> trailing)) {
+            fail("expected device info, FFT descriptor, and tuning candidate");
+        }
+        try {
+            auto info = parse_device_info(std::string_view(line).substr(first, last + 1 - first));
+            auto cfg = parse_fft_descriptor(desc);
+            auto tc = parse_tuning_candidate(candidate);
+            loaded.insert(cfg, info, tc);
+        } catch (std::exception const &e) {
+            fail(e.what());
+        }
+    }
+    entries_.swap(loaded.entries_);
+}
+
+void wisdom::save(std::ostream &os) const {
+    os << "# bbfft wisdom: <device info> <fft descriptor> <tuning candidate>" << std::endl;
+    for (auto const &[key, tc] : entries_) {
+        os << key.first << " " << key.second << " " << tc << std::endl;
+    }
+}
+
+void wisdom::load_file(std::string const &filename) {
+    auto file = std::ifstream(filename);
+    if (!file) {
+        throw std::runtime_error("==> Could not open " + filename + " for reading.");
+    }
+    load(file);
+}
+
+void wisdom::save_file(std::string const &filename) const {
+    auto file = std::ofstream(filename);
+    if (!file) {
+        throw std::runtime_error("==> Could not open " + filename + " for writing.");
+    }
+    save(file);
+}
+
+void set_wisdom(std::shared_ptr<wisdom const> w) {
+    auto lock = std::lock_guard<std::mutex>(wisdom_mutex());
+    installed_wisdom() = std::move(w);
+}
+
+auto get_wisdom() -> std::shared_ptr<wisdom const> {
+    auto lock = std::lock_guard<std::mutex>(wisdom_mutex());
+    return installed_wisdom();
+}
+
+auto lookup_wisdom(configuration const &cfg, device_info const &info) -> tuning_candidate {
+    auto w = get_wisdom();
+    return w ? w->find(cfg, info) : tuning_candidate{};
+}
+
+} // namespace bbfft
@@ -50,6 +50,7 @@ void api::operator=(api const &other) {
 device_info api::info() { return get_device_info(device_); }
 
 uint64_t api::device_id() { return get_device_id(device_); }
+uint64_t api::context_id() { return reinterpret_cast<std::uintptr_t>(context_); }
 
 auto api::build_module(std::string const &source) -> shared_handle<module_handle_t> {
     cl_program mod = ::bbfft::cl::build_kernel_bundle(
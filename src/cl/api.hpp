@@ -25,6 +25,8 @@ class api {
   public:
     using event_type = cl_event;
     using plan_type = detail::plan_impl<event_type>;
+    using convolution_plan_type = detail::convolution_plan_impl<event_type>;
+    using plan_group_type = detail::plan_group_impl<event_type>;
     using buffer_type = cl_mem;
     using kernel_bundle_type = cl_program;
     using kernel_type = cl_kernel;
@@ -38,6 +40,7 @@ class api {
 
     device_info info();
     uint64_t device_id();
+    uint64_t context_id();
 
     auto build_module(std::string const &source) -> shared_handle<module_handle_t>;
     auto make_kernel_bundle(module_handle_t mod) -> kernel_bundle_type;
@@ -4,11 +4,17 @@
 #include "bbfft/plan.hpp"
 #include "algorithm.hpp"
 #include "api.hpp"
+#include "autotuner.hpp"
+#include "bbfft/autotune.hpp"
 #include "bbfft/cl/make_plan.hpp"
 #include "bbfft/configuration.hpp"
+#include "bbfft/convolution_configuration.hpp"
 #include "bbfft/jit_cache.hpp"
+#include "bbfft/ragged_configuration.hpp"
 
 #include <CL/cl.h>
+#include <memory>
+#include <vector>
 
 namespace bbfft {
 
@@ -21,5 +27,52 @@ auto make_plan(configuration const &cfg, cl_command_queue queue, cl_context cont
     return opencl_plan(select_fft_algorithm<cl::api>(cfg, cl::api(queue, context, device), cache));
 }
 
+auto make_plan(configuration const &cfg, tuning_candidate const &tc, cl_command_queue queue,
+               jit_cache *cache) -> opencl_plan {
+    return opencl_plan(make_tuned_fft<cl::api>(cfg, tc, cl::api(queue), cache));
+}
+
+auto make_plan(configuration const &cfg, tuning_candidate const &tc, cl_command_queue queue,
+               cl_context context, cl_device_id device, jit_cache *cache) -> opencl_plan {
+    return opencl_plan(
+        make_tuned_fft<cl::api>(cfg, tc, cl::api(queue, context, device), cache));
+}
+
+auto make_plan(ragged_configuration const &cfg, cl_command_queue queue, jit_cache *cache)
+    -> opencl_plan {
+    return opencl_plan(std::make_shared<ragged_batch_fft<cl::api>>(cfg, cl::api(queue), cache));
+}
+
+auto make_plan(ragged_configuration const &cfg, cl_command_queue queue, cl_context context,
+               cl_device_id device, jit_cache *cache) -> opencl_plan {
+    return opencl_plan(
+        std::make_shared<ragged_batch_fft<cl::api>>(cfg, cl::api(queue, context, device), cache));
+}
+
+auto make_plan(convolution_configuration const &cfg, cl_command_queue queue, jit_cache *cache)
+    -> opencl_convolution_plan {
+    return opencl_convolution_plan(
+        std::make_shared<convolution_fft<cl::api>>(cfg, cl::api(queue), cache));
+}
+
+auto make_plan(convolution_configuration const &cfg, cl_command_queue queue, cl_context context,
+               cl_device_id device, jit_cache *cache) -> opencl_convolution_plan {
+    return opencl_convolution_plan(
+        std::make_shared<convolution_fft<cl::api>>(cfg, cl::api(queue, context, device), cache));
+}
+
+auto make_plan_group(std::vector<configuration> const &cfgs, cl_command_queue queue,
+                     jit_cache *cache) -> opencl_plan_group {
+    return opencl_plan_group(
+        std::make_shared<plan_group_fft<cl::api>>(cfgs, cl::api(queue), cache));
+}
+
+auto make_plan_group(std::vector<configuration> const &cfgs, cl_command_queue queue,
+                     cl_context context, cl_device_id device, jit_cache *cache)
+    -> opencl_plan_group {
+    return opencl_plan_group(std::make_shared<plan_group_fft<cl::api>>(
+        cfgs, cl::api(queue, context, device), cache));
+}
+
 } // namespace bbfft
 
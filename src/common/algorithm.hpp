@@ -4,11 +4,18 @@
 #ifndef ALGORITHM_20220602_HPP
 #define ALGORITHM_20220602_HPP
 
+#include "algorithm/convolution_fft.hpp"
 #include "algorithm/nd_fft.hpp"
+#include "algorithm/nd_slm_fft.hpp"
+#include "algorithm/plan_group_fft.hpp"
+#include "algorithm/r2r_fft.hpp"
+#include "algorithm/ragged_batch_fft.hpp"
 #include "algorithm_1d.hpp"
 #include "bbfft/bad_configuration.hpp"
 #include "bbfft/configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
 #include "bbfft/detail/plan_impl.hpp"
+#include "bbfft/device_info.hpp"
 #include "bbfft/jit_cache.hpp"
 
 #include <memory>
@@ -17,15 +24,55 @@
 
 namespace bbfft {
 
+inline void check_fft_configuration(configuration const &cfg, device_info const &info) {
+    if (cfg.dim < 1 || cfg.dim > max_fft_dim) {
+        throw bad_configuration("Unsupported FFT dimension: " + std::to_string(cfg.dim));
+    }
+    if (cfg.dim > 1 && compute_precision(cfg.fp) != cfg.fp) {
+        throw bad_configuration("16-bit storage precisions are only supported for 1d FFTs.");
+    }
+    if (cfg.planar_offset[0] != 0 || cfg.planar_offset[1] != 0) {
+        if (cfg.dim > 1 || is_r2r(cfg.type)) {
+            throw bad_configuration("The planar layout is only supported for 1d c2c, r2c, and "
+                                    "c2r FFTs.");
+        }
+        if ((cfg.type == transform_type::r2c && cfg.planar_offset[0] != 0) ||
+            (cfg.type == transform_type::c2r && cfg.planar_offset[1] != 0)) {
+            throw bad_configuration("The planar layout requires a complex tensor.");
+        }
+        if (cfg.callbacks || compute_precision(cfg.fp) != cfg.fp) {
+            throw bad_configuration(
+                "The planar layout cannot be combined with callbacks or 16-bit storage.");
+        }
+    }
+    if (cfg.input_length != 0 || cfg.output_length != 0) {
+        if (cfg.dim > 1 || cfg.type != transform_type::c2c) {
+            throw bad_configuration("Pruned FFTs are only supported for 1d c2c FFTs.");
+        }
+        if (cfg.input_length > cfg.shape[1] || cfg.output_length > cfg.shape[1]) {
+            throw bad_configuration("The input and output length must not exceed the FFT length.");
+        }
+        if (prefer_bluestein_fft(cfg, info) || prefer_four_step_fft(cfg, info) ||
+            !prefer_small_batch_fft(cfg, info)) {
+            throw bad_configuration("Pruned FFTs are only supported for transform lengths that "
+                                    "are computed in registers by the small batch algorithm.");
+        }
+    }
+}
+
 template <typename Api>
 auto select_fft_algorithm(configuration const &cfg, Api api, jit_cache *cache)
     -> std::shared_ptr<typename Api::plan_type> {
-    if (cfg.dim < 1 || cfg.dim > max_fft_dim) {
-        throw bad_configuration("Unsupported FFT dimension: " + std::to_string(cfg.dim));
+    check_fft_configuration(cfg, api.info());
+    if (is_r2r(cfg.type)) {
+        return std::make_shared<r2r_fft<Api>>(cfg, std::move(api), cache);
     }
     if (cfg.dim == 1) {
         return select_1d_fft_algorithm<Api>(cfg, std::move(api), cache);
     }
+    if (prefer_nd_slm_fft(cfg, api.info())) {
+        return std::make_shared<nd_slm_fft<Api>>(cfg, std::move(api), cache);
+    }
     return std::make_shared<nd_fft<Api>>(cfg, std::move(api), cache);
 }
 
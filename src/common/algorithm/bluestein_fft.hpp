@@ -0,0 +1,246 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef BLUESTEIN_FFT_20240410_HPP
+#define BLUESTEIN_FFT_20240410_HPP
+
+#include "bbfft/configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
+#include "bbfft/detail/plan_impl.hpp"
+#include "bbfft/device_info.hpp"
+#include "bbfft/jit_cache.hpp"
+#include "bbfft/shared_handle.hpp"
+#include "twiddle_registry.hpp"
+
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace bbfft {
+
+template <typename Api>
+auto select_1d_fft_algorithm(configuration const &cfg, Api api, jit_cache *cache)
+    -> std::shared_ptr<typename Api::plan_type>;
+
+/**
+ * @brief Bluestein FFT for lengths with large prime factors
+ *
+ * The DFT of length N is computed as cyclic convolution of length L = 2^l >= 2N-1.
+ * Execution consists of five launches: pre-multiplication with the chirp, forward FFT of length L,
+ * point-wise multiplication with the transformed filter, backward FFT of length L, and
+ * post-multiplication with the chirp.
+ */
+template <typename Api> class bluestein_fft_base : public Api::plan_type {
+  public:
+    using buffer = typename Api::buffer_type;
+    using kernel_bundle = typename Api::kernel_bundle_type;
+    using kernel = typename Api::kernel_type;
+
+    bluestein_fft_base(configuration const &cfg, Api api, jit_cache *cache)
+        : api_(std::move(api)), module_(setup(cfg, cache)),
+          bundle_(api_.make_kernel_bundle(module_.get())),
+          k_pre_(api_.create_kernel(bundle_, identifier_ + "_pre")),
+          k_mul_(api_.create_kernel(bundle_, identifier_ + "_mul")),
+          k_post_(api_.create_kernel(bundle_, identifier_ + "_post")) {
+        auto const L = L_;
+        auto const M = cfg.shape[0];
+        auto const K = cfg.shape[2];
+        auto shape = std::array<std::size_t, max_tensor_dim>{M, L, K};
+        auto stride = std::array<std::size_t, max_tensor_dim>{1, M, M * L};
+        auto fwd_cfg = configuration{
+            1, shape, cfg.fp, direction::forward, transform_type::c2c, stride, stride};
+        auto bwd_cfg = fwd_cfg;
+        bwd_cfg.dir = direction::backward;
+        fwd_ = select_1d_fft_algorithm<Api>(fwd_cfg, api_, cache);
+        bwd_ = select_1d_fft_algorithm<Api>(bwd_cfg, api_, cache);
+
+        tmp_ = api_.create_device_buffer(M * L * K * 2 * size_in_bytes(compute_precision(cfg.fp)));
+    }
+
+    ~bluestein_fft_base() {
+        api_.release_kernel(k_pre_);
+        api_.release_kernel(k_mul_);
+        api_.release_kernel(k_post_);
+        api_.release_buffer(tmp_);
+    }
+
+    bluestein_fft_base(bluestein_fft_base const &) = delete;
+    bluestein_fft_base(bluestein_fft_base &&) = delete;
+    bluestein_fft_base &operator=(bluestein_fft_base const &) = delete;
+    bluestein_fft_base &operator=(bluestein_fft_base &&) = delete;
+
+  protected:
+    // The chirp and the transformed filter only depend on N, L, the direction, and the precision
+    template <typename T> void create_twiddle(bluestein_configuration const &bc) {
+        std::ostringstream key;
+        key << "bluestein_" << (bc.direction < 0 ? 'm' : 'p') << std::abs(bc.direction) << "_N"
+            << bc.N << "_L" << bc.L << "_f" << 8 * sizeof(T);
+        twiddle_handle_ = twiddle_registry<Api>::instance().get(api_, key.str(), [this, &bc]() {
+            auto table = bluestein_twiddle_table(bc);
+            auto twiddle = std::vector<T>(2 * table.size());
+            for (std::size_t i = 0; i < table.size(); ++i) {
+                twiddle[2 * i] = table[i].real();
+                twiddle[2 * i + 1] = table[i].imag();
+            }
+            return api_.create_twiddle_table(twiddle);
+        });
+        twiddle_ = static_cast<buffer>(twiddle_handle_.get());
+    }
+
+    auto setup(configuration const &cfg, jit_cache *cache) -> shared_handle<module_handle_t> {
+        std::stringstream ss;
+        if (cfg.callbacks) {
+            ss << std::string_view(cfg.callbacks.data, cfg.callbacks.length) << std::endl;
+        }
+        auto bc = configure_bluestein_fft(cfg, api_.info());
+
+        switch (compute_precision(cfg.fp)) {
+        case precision::f32:
+            create_twiddle<float>(bc);
+            break;
+        case precision::f64:
+            create_twiddle<double>(bc);
+            break;
+        default:
+            break;
+        }
+
+        std::size_t const N_out = cfg.type == transform_type::r2c ? bc.N / 2 + 1 : bc.N;
+        std::size_t const Mg = (bc.M - 1) / bc.Mb + 1;
+        std::size_t const K = cfg.shape[2];
+        std::size_t const Lg = (bc.L - 1) / bc.Nb + 1;
+        std::size_t const Ng = (N_out - 1) / bc.Nb + 1;
+        gws_ = std::array<std::size_t, 3>{Mg * bc.Mb, Lg * bc.Nb, K};
+        gws_post_ = std::array<std::size_t, 3>{Mg * bc.Mb, Ng * bc.Nb, K};
+        lws_ = std::array<std::size_t, 3>{bc.Mb, bc.Nb, 1};
+        L_ = bc.L;
+        identifier_ = bc.identifier();
+
+        auto const make_cache_key = [this]() {
+            return jit_cache_key{identifier_ + "_pre", api_.device_id()};
+        };
+
+        if (cache) {
+            auto bundle = cache->get(make_cache_key());
+            if (bundle) {
+                return bundle;
+            }
+        }
+
+        generate_bluestein_fft(ss, bc);
+
+        auto mod = api_.build_module(ss.str());
+        if (cache) {
+            cache->store(make_cache_key(), mod);
+        }
+
+        return mod;
+    }
+
+    Api api_;
+    // Initialized by setup, hence declared before module_
+    typename twiddle_registry<Api>::handle twiddle_handle_;
+    buffer twiddle_;
+    std::array<std::size_t, 3> gws_;
+    std::array<std::size_t, 3> gws_post_;
+    std::array<std::size_t, 3> lws_;
+    std::size_t L_;
+    std::string identifier_;
+    shared_handle<module_handle_t> module_;
+    kernel_bundle bundle_;
+    kernel k_pre_;
+    kernel k_mul_;
+    kernel k_post_;
+    buffer tmp_ = nullptr;
+    std::shared_ptr<typename Api::plan_type> fwd_;
+    std::shared_ptr<typename Api::plan_type> bwd_;
+};
+
+template <typename Api, typename PlanImplT = typename Api::plan_type> class bluestein_fft;
+
+template <typename Api>
+class bluestein_fft<Api, detail::plan_impl<typename Api::event_type>>
+    : public bluestein_fft_base<Api> {
+  public:
+    using bluestein_fft_base<Api>::bluestein_fft_base;
+    using event = typename Api::event_type;
+
+    auto execute(void const *in, void *out, std::vector<event> const &dep_events)
+        -> event override {
+        auto &api = this->api_;
+        void *tmp = this->tmp_;
+        event e = api.launch_kernel(this->k_pre_, this->gws_, this->lws_, dep_events, [&](auto &h) {
+            h.set_arg(0, in);
+            h.set_arg(1, this->tmp_);
+            h.set_arg(2, this->twiddle_);
+        });
+        auto next_e = this->fwd_->execute(tmp, tmp, std::vector<event>{e});
+        api.release_event(std::move(e));
+        e = api.launch_kernel(this->k_mul_, this->gws_, this->lws_, std::vector<event>{next_e},
+                              [&](auto &h) {
+                                  h.set_arg(0, this->tmp_);
+                                  h.set_arg(1, this->twiddle_);
+                              });
+        api.release_event(std::move(next_e));
+        next_e = this->bwd_->execute(tmp, tmp, std::vector<event>{e});
+        api.release_event(std::move(e));
+        e = api.launch_kernel(this->k_post_, this->gws_post_, this->lws_,
+                              std::vector<event>{next_e}, [&](auto &h) {
+                                  h.set_arg(0, this->tmp_);
+                                  h.set_arg(1, out);
+                                  h.set_arg(2, this->twiddle_);
+                              });
+        api.release_event(std::move(next_e));
+        return e;
+    }
+};
+
+template <typename Api>
+class bluestein_fft<Api, detail::plan_unmanaged_event_impl<typename Api::event_type>>
+    : public bluestein_fft_base<Api> {
+  public:
+    using bluestein_fft_base<Api>::bluestein_fft_base;
+    using event = typename Api::event_type;
+
+    void execute(void const *in, void *out, event signal_event, std::uint32_t num_dep_events,
+                 event *dep_events) override {
+        auto &api = this->api_;
+        void *tmp = this->tmp_;
+        auto e = api.get_internal_event();
+        api.launch_kernel(this->k_pre_, this->gws_, this->lws_, e, num_dep_events, dep_events,
+                          [&](auto &h) {
+                              h.set_arg(0, in);
+                              h.set_arg(1, this->tmp_);
+                              h.set_arg(2, this->twiddle_);
+                          });
+        auto next_e = api.get_internal_event();
+        this->fwd_->execute(tmp, tmp, next_e, 1, &e);
+        api.append_reset_event(e);
+        e = api.get_internal_event();
+        api.launch_kernel(this->k_mul_, this->gws_, this->lws_, e, 1, &next_e, [&](auto &h) {
+            h.set_arg(0, this->tmp_);
+            h.set_arg(1, this->twiddle_);
+        });
+        api.append_reset_event(next_e);
+        next_e = api.get_internal_event();
+        this->bwd_->execute(tmp, tmp, next_e, 1, &e);
+        api.append_reset_event(e);
+        api.launch_kernel(this->k_post_, this->gws_post_, this->lws_, signal_event, 1, &next_e,
+                          [&](auto &h) {
+                              h.set_arg(0, this->tmp_);
+                              h.set_arg(1, out);
+                              h.set_arg(2, this->twiddle_);
+                          });
+        api.append_reset_event(next_e);
+    }
+};
+
+} // namespace bbfft
+
+#endif // BLUESTEIN_FFT_20240410_HPP
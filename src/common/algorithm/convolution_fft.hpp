@@ -0,0 +1,127 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef CONVOLUTION_FFT_20240502_HPP
+#define CONVOLUTION_FFT_20240502_HPP
+
+#include "bbfft/bad_configuration.hpp"
+#include "bbfft/convolution_configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
+#include "bbfft/detail/plan_impl.hpp"
+#include "bbfft/jit_cache.hpp"
+#include "bbfft/shared_handle.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bbfft {
+
+template <typename Api> class convolution_fft_base : public Api::convolution_plan_type {
+  public:
+    using kernel_bundle = typename Api::kernel_bundle_type;
+    using kernel = typename Api::kernel_type;
+
+    convolution_fft_base(convolution_configuration const &cfg, Api api, jit_cache *cache)
+        : api_(std::move(api)), module_(setup(cfg, cache)),
+          bundle_(api_.make_kernel_bundle(module_.get())),
+          k_(api_.create_kernel(bundle_, identifier_)) {}
+    ~convolution_fft_base() { api_.release_kernel(k_); }
+
+    convolution_fft_base(convolution_fft_base const &) = delete;
+    convolution_fft_base(convolution_fft_base &&) = delete;
+    convolution_fft_base &operator=(convolution_fft_base const &) = delete;
+    convolution_fft_base &operator=(convolution_fft_base &&) = delete;
+
+  protected:
+    auto setup(convolution_configuration const &cfg, jit_cache *cache)
+        -> shared_handle<module_handle_t> {
+        auto cvc = configure_convolution_fft(cfg, api_.info());
+
+        K_ = cfg.shape[2];
+        std::size_t Mg = (cvc.fft.M - 1) / cvc.fft.Mb + 1;
+        std::size_t Kg = (K_ - 1) / cvc.fft.Kb + 1;
+        gws_ = std::array<std::size_t, 3>{Mg * cvc.fft.Mb, Kg * cvc.fft.Kb, 1};
+        lws_ = std::array<std::size_t, 3>{cvc.fft.Mb, cvc.fft.Kb, 1};
+        identifier_ = cvc.identifier();
+
+        auto const make_cache_key = [this]() {
+            return jit_cache_key{identifier_, api_.device_id()};
+        };
+
+        if (cache) {
+            auto bundle = cache->get(make_cache_key());
+            if (bundle) {
+                return bundle;
+            }
+        }
+
+        std::stringstream ss;
+        generate_convolution_fft(ss, cvc);
+
+        auto mod = api_.build_module(ss.str());
+        if (cache) {
+            cache->store(make_cache_key(), mod);
+        }
+
+        return mod;
+    }
+
+    Api api_;
+    std::array<std::size_t, 3> gws_;
+    std::array<std::size_t, 3> lws_;
+    std::string identifier_;
+    shared_handle<module_handle_t> module_;
+    kernel_bundle bundle_;
+    kernel k_;
+    uint64_t K_;
+};
+
+template <typename Api, typename PlanImplT = typename Api::convolution_plan_type>
+class convolution_fft;
+
+template <typename Api>
+class convolution_fft<Api, detail::convolution_plan_impl<typename Api::event_type>>
+    : public convolution_fft_base<Api> {
+  public:
+    using convolution_fft_base<Api>::convolution_fft_base;
+    using event = typename Api::event_type;
+
+    auto execute(void const *in, void const *filter, void *out,
+                 std::vector<event> const &dep_events) -> event override {
+        return this->api_.launch_kernel(this->k_, this->gws_, this->lws_, dep_events, [&](auto &h) {
+            h.set_arg(0, in);
+            h.set_arg(1, out);
+            h.set_arg(2, this->K_);
+            h.set_arg(3, filter);
+        });
+    }
+};
+
+template <typename Api>
+class convolution_fft<Api,
+                      detail::convolution_plan_unmanaged_event_impl<typename Api::event_type>>
+    : public convolution_fft_base<Api> {
+  public:
+    using convolution_fft_base<Api>::convolution_fft_base;
+    using event = typename Api::event_type;
+
+    void execute(void const *in, void const *filter, void *out, event signal_event,
+                 std::uint32_t num_dep_events, event *dep_events) override {
+        this->api_.launch_kernel(this->k_, this->gws_, this->lws_, signal_event, num_dep_events,
+                                 dep_events, [&](auto &h) {
+                                     h.set_arg(0, in);
+                                     h.set_arg(1, out);
+                                     h.set_arg(2, this->K_);
+                                     h.set_arg(3, filter);
+                                 });
+    }
+};
+
+} // namespace bbfft
+
+#endif // CONVOLUTION_FFT_20240502_HPP
@@ -4,6 +4,7 @@
 #ifndef FACTOR2_SLM_FFT_20220413_HPP
 #define FACTOR2_SLM_FFT_20220413_HPP
 
+#include "bbfft/autotune.hpp"
 #include "bbfft/bad_configuration.hpp"
 #include "bbfft/configuration.hpp"
 #include "bbfft/detail/generator_impl.hpp"
@@ -11,6 +12,8 @@
 #include "bbfft/device_info.hpp"
 #include "bbfft/jit_cache.hpp"
 #include "bbfft/shared_handle.hpp"
+#include "planar_layout.hpp"
+#include "twiddle_registry.hpp"
 
 #include <algorithm>
 #include <array>
@@ -19,6 +22,7 @@
 #include <cstring>
 #include <numeric>
 #include <sstream>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -31,14 +35,14 @@ template <typename Api> class factor2_slm_fft_base : public Api::plan_type {
     using kernel = typename Api::kernel_type;
 
     factor2_slm_fft_base(configuration const &cfg, Api api, jit_cache *cache)
-        : api_(std::move(api)), module_(setup(cfg, cache)),
+        : factor2_slm_fft_base(cfg, tuning_candidate{}, std::move(api), cache) {}
+    factor2_slm_fft_base(configuration const &cfg, tuning_candidate const &tc, Api api,
+                         jit_cache *cache)
+        : api_(std::move(api)), module_(setup(cfg, tc, cache)),
           bundle_(api_.make_kernel_bundle(module_.get())),
           k_(api_.create_kernel(bundle_, identifier_)) {}
 
-    ~factor2_slm_fft_base() {
-        api_.release_kernel(k_);
-        api_.release_buffer(twiddle_);
-    }
+    ~factor2_slm_fft_base() { api_.release_kernel(k_); }
 
     factor2_slm_fft_base(factor2_slm_fft_base const &) = delete;
     factor2_slm_fft_base(factor2_slm_fft_base &&) = delete;
@@ -46,68 +50,53 @@ template <typename Api> class factor2_slm_fft_base : public Api::plan_type {
     factor2_slm_fft_base &operator=(factor2_slm_fft_base &&) = delete;
 
   protected:
-    template <typename T>
-    void create_twiddle(int direction, std::vector<int> const &factorization, bool have_2N) {
-        constexpr double tau = 6.28318530717958647693;
-        if (factorization.size() < 2) {
-            throw bad_configuration("At least 2 factors are required.");
-        }
-
-        int N = factorization[0] * factorization[1];
-        int tw_size = N;
-        auto const L = factorization.size();
-        for (std::size_t k = 2; k < L; ++k) {
-            N *= factorization[k];
-            tw_size += N;
-        }
-        tw_size += have_2N * N;
-        tw_size *= 2;
-
-        auto twiddle = std::vector<T>(tw_size);
-        auto tw_ptr = twiddle.data();
-        int J1 = N;
-        for (int f = L - 1; f >= 1; --f) {
-            auto const Nf = factorization[f];
-            J1 /= Nf;
-            for (int i = 0; i < J1; ++i) {
-                for (int j = 0; j < Nf; ++j) {
-                    auto arg = direction * tau / (J1 * Nf) * i * j;
-                    tw_ptr[2 * (j + Nf * i)] = std::cos(arg);
-                    tw_ptr[2 * (j + Nf * i) + 1] = std::sin(arg);
-                }
-            }
-            tw_ptr += 2 * J1 * Nf;
+    // The table only depends on the factorization, the direction, the precision, and on whether
+    // the twiddles for the even-length real FFT are appended, hence plans share the table
+    template <typename T> void create_twiddle(factor2_slm_configuration const &f2c) {
+        bool is_real = f2c.type == transform_type::r2c || f2c.type == transform_type::c2r;
+        std::ostringstream key;
+        key << "f2_" << (f2c.direction < 0 ? 'm' : 'p') << std::abs(f2c.direction) << "_";
+        for (std::size_t i = 0; i < f2c.factorization.size(); ++i) {
+            key << (i > 0 ? "x" : "") << f2c.factorization[i];
         }
-        if (have_2N) {
-            for (int i = 0; i < N; ++i) {
-                auto arg = direction * tau / (2 * N) * i;
-                // pre-multiplied with sqrt(-1)
-                tw_ptr[2 * i] = -std::sin(arg);
-                tw_ptr[2 * i + 1] = std::cos(arg);
+        key << "_f" << 8 * sizeof(T) << (is_real && f2c.N % 2 == 0 ? "_2N" : "");
+        twiddle_handle_ = twiddle_registry<Api>::instance().get(api_, key.str(), [this, &f2c]() {
+            auto table = factor2_slm_twiddle_table(f2c);
+            auto twiddle = std::vector<T>(2 * table.size());
+            for (std::size_t i = 0; i < table.size(); ++i) {
+                twiddle[2 * i] = table[i].real();
+                twiddle[2 * i + 1] = table[i].imag();
             }
-        }
-        twiddle_ = api_.create_twiddle_table(twiddle);
+            return api_.create_twiddle_table(twiddle);
+        });
+        twiddle_ = static_cast<buffer>(twiddle_handle_.get());
     }
 
-    auto setup(configuration const &cfg, jit_cache *cache) -> shared_handle<module_handle_t> {
+    auto setup(configuration const &cfg, tuning_candidate const &tc, jit_cache *cache)
+        -> shared_handle<module_handle_t> {
         std::stringstream ss;
         if (cfg.callbacks) {
             ss << std::string_view(cfg.callbacks.data, cfg.callbacks.length) << std::endl;
         }
         bool is_real = cfg.type == transform_type::r2c || cfg.type == transform_type::c2r;
-        auto f2c = configure_factor2_slm_fft(cfg, api_.info());
+        auto f2c = tc.algorithm == tuning_algorithm::automatic
+                       ? configure_factor2_slm_fft(cfg, api_.info())
+                       : configure_factor2_slm_fft(cfg, api_.info(), tc);
 
         auto N = cfg.shape[1];
         K_ = cfg.shape[2];
+        fp_ = cfg.fp;
+        planar_offset_ = cfg.planar_offset;
 
         auto is_even = N % 2 == 0;
-        auto have_2N = is_real && is_even;
-        switch (cfg.fp) {
+        switch (compute_precision(cfg.fp)) {
         case precision::f32:
-            create_twiddle<float>(static_cast<int>(cfg.dir), f2c.factorization, have_2N);
+            create_twiddle<float>(f2c);
             break;
         case precision::f64:
-            create_twiddle<double>(static_cast<int>(cfg.dir), f2c.factorization, have_2N);
+            create_twiddle<double>(f2c);
+            break;
+        default:
             break;
         }
 
@@ -143,7 +132,26 @@ template <typename Api> class factor2_slm_fft_base : public Api::plan_type {
         return mod;
     }
 
+    template <typename Handler> void set_args(Handler &h, void const *in, void *out) {
+        h.set_arg(0, in);
+        h.set_arg(1, out);
+        h.set_arg(2, twiddle_);
+        h.set_arg(3, K_);
+        unsigned arg = 4;
+        if (planar_offset_[0] != 0) {
+            auto in_im = imaginary_part(in, planar_offset_[0], fp_);
+            h.set_arg(arg++, in_im);
+        }
+        if (planar_offset_[1] != 0) {
+            auto out_im = imaginary_part(out, planar_offset_[1], fp_);
+            h.set_arg(arg++, out_im);
+        }
+    }
+
     Api api_;
+    // Initialized by setup, hence declared before module_
+    typename twiddle_registry<Api>::handle twiddle_handle_;
+    buffer twiddle_;
     std::array<std::size_t, 3> gws_;
     std::array<std::size_t, 3> lws_;
     bool inplace_unsupported_;
@@ -152,7 +160,8 @@ template <typename Api> class factor2_slm_fft_base : public Api::plan_type {
     kernel_bundle bundle_;
     kernel k_;
     uint64_t K_;
-    buffer twiddle_;
+    precision fp_;
+    std::array<std::size_t, 2> planar_offset_;
 };
 
 template <typename Api, typename PlanImplT = typename Api::plan_type> class factor2_slm_fft;
@@ -170,12 +179,8 @@ class factor2_slm_fft<Api, detail::plan_impl<typename Api::event_type>>
             throw bad_configuration("The plan does not support in-place transform on the current "
                                     "device. Please use the out-of-place transform.");
         }
-        return this->api_.launch_kernel(this->k_, this->gws_, this->lws_, dep_events, [&](auto &h) {
-            h.set_arg(0, in);
-            h.set_arg(1, out);
-            h.set_arg(2, this->twiddle_);
-            h.set_arg(3, this->K_);
-        });
+        return this->api_.launch_kernel(this->k_, this->gws_, this->lws_, dep_events,
+                                        [&](auto &h) { this->set_args(h, in, out); });
     }
 };
 
@@ -193,12 +198,7 @@ class factor2_slm_fft<Api, detail::plan_unmanaged_event_impl<typename Api::event
                                     "device. Please use the out-of-place transform.");
         }
         this->api_.launch_kernel(this->k_, this->gws_, this->lws_, signal_event, num_dep_events,
-                                 dep_events, [&](auto &h) {
-                                     h.set_arg(0, in);
-                                     h.set_arg(1, out);
-                                     h.set_arg(2, this->twiddle_);
-                                     h.set_arg(3, this->K_);
-                                 });
+                                 dep_events, [&](auto &h) { this->set_args(h, in, out); });
     }
 };
 
@@ -0,0 +1,146 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef FOUR_STEP_FFT_20240411_HPP
+#define FOUR_STEP_FFT_20240411_HPP
+
+#include "bbfft/bad_configuration.hpp"
+#include "bbfft/configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
+#include "bbfft/detail/plan_impl.hpp"
+#include "bbfft/device_info.hpp"
+#include "bbfft/jit_cache.hpp"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bbfft {
+
+template <typename Api>
+auto select_1d_fft_algorithm(configuration const &cfg, Api api, jit_cache *cache)
+    -> std::shared_ptr<typename Api::plan_type>;
+
+/**
+ * @brief Four-step FFT for lengths that do not fit into shared local memory
+ *
+ * The N-mode is split into N = N1 * N2, such that the input tensor is viewed as
+ * x(m + M * n1, n2, k). The first pass computes FFTs of length N2, where the M-mode of the
+ * inner FFT absorbs the factor N1, and stores the result multiplied with twiddle factors in
+ * transposed order y(m + M * k1, n1, k). The second pass computes FFTs of length N1.
+ */
+template <typename Api> class four_step_fft_base : public Api::plan_type {
+  public:
+    using buffer = typename Api::buffer_type;
+    using event = typename Api::event_type;
+
+    four_step_fft_base(configuration const &cfg, Api api, jit_cache *cache)
+        : api_(std::move(api)) {
+        if (cfg.type != transform_type::c2c) {
+            throw bad_configuration("The four-step FFT only supports c2c transforms.");
+        }
+        auto const M = cfg.shape[0];
+        auto const K = cfg.shape[2];
+        if (cfg.istride[1] != M * cfg.istride[0] || cfg.ostride[1] != M * cfg.ostride[0]) {
+            throw bad_configuration(
+                "The four-step FFT requires that the M-mode and N-mode are contiguous.");
+        }
+        auto const fsc = configure_four_step_fft(cfg, api_.info());
+        if (fsc.N2 < 2) {
+            throw bad_configuration("The four-step FFT requires a composite FFT length.");
+        }
+        auto const N1 = fsc.N1;
+        auto const N2 = fsc.N2;
+        auto const N = N1 * N2;
+
+        auto twiddle_name = fsc.identifier();
+        auto src = std::ostringstream{};
+        if (cfg.callbacks) {
+            src << std::string_view(cfg.callbacks.data, cfg.callbacks.length) << std::endl;
+        }
+        generate_four_step_fft_twiddle(src, fsc, twiddle_name);
+        auto first_source = src.str();
+
+        auto first = configuration{1,
+                                   {M * N1, N2, K},
+                                   cfg.fp,
+                                   cfg.dir,
+                                   transform_type::c2c,
+                                   {cfg.istride[0], N1 * cfg.istride[1], cfg.istride[2]},
+                                   {1, M * N1, M * N}};
+        first.callbacks = {first_source.c_str(), first_source.size(),
+                           cfg.callbacks.load_function, twiddle_name.c_str()};
+        auto second = configuration{1,
+                                    {M * N2, N1, K},
+                                    cfg.fp,
+                                    cfg.dir,
+                                    transform_type::c2c,
+                                    {1, M * N2, M * N},
+                                    {cfg.ostride[0], N2 * cfg.ostride[1], cfg.ostride[2]}};
+        second.scale = cfg.scale;
+        if (cfg.callbacks.store_function) {
+            second.callbacks = {cfg.callbacks.data, cfg.callbacks.length, nullptr,
+                                cfg.callbacks.store_function};
+        }
+        plans_[0] = select_1d_fft_algorithm<Api>(first, api_, cache);
+        plans_[1] = select_1d_fft_algorithm<Api>(second, api_, cache);
+
+        tmp_ = api_.create_device_buffer(M * N * K * 2 * size_in_bytes(compute_precision(cfg.fp)));
+    }
+
+    ~four_step_fft_base() { api_.release_buffer(tmp_); }
+
+    four_step_fft_base(four_step_fft_base const &) = delete;
+    four_step_fft_base(four_step_fft_base &&) = delete;
+    four_step_fft_base &operator=(four_step_fft_base const &) = delete;
+    four_step_fft_base &operator=(four_step_fft_base &&) = delete;
+
+  protected:
+    Api api_;
+    std::array<std::shared_ptr<typename Api::plan_type>, 2> plans_;
+    buffer tmp_ = nullptr;
+};
+
+template <typename Api, typename PlanImplT = typename Api::plan_type> class four_step_fft;
+
+template <typename Api>
+class four_step_fft<Api, detail::plan_impl<typename Api::event_type>>
+    : public four_step_fft_base<Api> {
+  public:
+    using four_step_fft_base<Api>::four_step_fft_base;
+    using event = typename Api::event_type;
+
+    auto execute(void const *in, void *out, std::vector<event> const &dep_events)
+        -> event override {
+        void *tmp = this->tmp_;
+        event e = this->plans_[0]->execute(in, tmp, dep_events);
+        auto last_e = this->plans_[1]->execute(tmp, out, std::vector<event>{e});
+        this->api_.release_event(std::move(e));
+        return last_e;
+    }
+};
+
+template <typename Api>
+class four_step_fft<Api, detail::plan_unmanaged_event_impl<typename Api::event_type>>
+    : public four_step_fft_base<Api> {
+  public:
+    using four_step_fft_base<Api>::four_step_fft_base;
+    using event = typename Api::event_type;
+
+    void execute(void const *in, void *out, event signal_event, std::uint32_t num_dep_events,
+                 event *dep_events) override {
+        void *tmp = this->tmp_;
+        auto e = this->api_.get_internal_event();
+        this->plans_[0]->execute(in, tmp, e, num_dep_events, dep_events);
+        this->plans_[1]->execute(tmp, out, signal_event, 1, &e);
+        this->api_.append_reset_event(e);
+    }
+};
+
+} // namespace bbfft
+
+#endif // FOUR_STEP_FFT_20240411_HPP
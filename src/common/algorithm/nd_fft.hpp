@@ -6,14 +6,16 @@
 
 #include "algorithm/factor2_slm_fft.hpp"
 #include "algorithm_1d.hpp"
-#include "bbfft/bad_configuration.hpp"
 #include "bbfft/configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
 #include "bbfft/detail/plan_impl.hpp"
 #include "bbfft/device_info.hpp"
 #include "bbfft/jit_cache.hpp"
 
 #include <cstddef>
 #include <memory>
+#include <sstream>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -26,88 +28,47 @@ template <typename Api> class nd_fft_base : public Api::plan_type {
 
     nd_fft_base(configuration const &cfg, Api api, jit_cache *cache)
         : api_(std::move(api)), dim_(cfg.dim) {
+        auto ndc = configure_nd_fft(cfg);
+
+        // The user's load callback is used in the first pass and the store callback in the last
+        // pass; in both cases the offset refers to the user's input or output tensor
+        auto user_source = std::string{};
+        char const *load_function = nullptr;
+        char const *store_function = nullptr;
         if (cfg.callbacks) {
-            throw bad_configuration("User modules are unsuported for FFT dimension > 1.");
+            user_source = std::string(cfg.callbacks.data, cfg.callbacks.length) + "\n";
+            load_function = cfg.callbacks.load_function;
+            store_function = cfg.callbacks.store_function;
         }
-
-        auto compare_strides = [](std::array<std::size_t, max_tensor_dim> const &s1,
-                                  std::array<std::size_t, max_tensor_dim> const &s2, unsigned dim) {
-            bool equal = true;
-            for (unsigned d = 0; d < dim + 2; ++d) {
-                equal = equal && (s1[d] == s2[d]);
-            }
-            return equal;
-        };
-        auto is_default_stride = [&compare_strides](configuration const &cfg, bool inplace) {
-            auto const def_istride = default_istride(cfg.dim, cfg.shape, cfg.type, inplace);
-            auto const def_ostride = default_ostride(cfg.dim, cfg.shape, cfg.type, inplace);
-            return compare_strides(cfg.istride, def_istride, cfg.dim) &&
-                   compare_strides(cfg.ostride, def_ostride, cfg.dim);
-        };
-        if (!is_default_stride(cfg, false) && !is_default_stride(cfg, true)) {
-            throw bad_configuration("Only default tensor layouts are supported for the nd_fft.");
+        std::string load_source = user_source, store_source = user_source;
+        std::string load_name, store_name;
+        if (ndc.load_layout) {
+            auto ss = std::ostringstream{};
+            load_name = ndc.lin.identifier() + "_load";
+            generate_layout_load_callback(ss, ndc.lin, load_name);
+            load_source += ss.str();
+            load_function = load_name.c_str();
         }
-        bool inplace_layout = is_default_stride(cfg, true);
-
-        bool is_real = cfg.type == transform_type::r2c || cfg.type == transform_type::c2r;
-        auto Nd_complex = [&](unsigned d) {
-            return d == 0 && is_real ? cfg.shape[1] / 2 + 1 : cfg.shape[d + 1];
-        };
-        auto Nd_real = [&](unsigned d) {
-            return d == 0 && is_real && inplace_layout ? 2 * (cfg.shape[1] / 2 + 1)
-                                                       : cfg.shape[d + 1];
-        };
-
-        std::size_t N = 1;
-        for (unsigned d = 0; d < dim_; ++d) {
-            N *= Nd_complex(d);
+        if (ndc.store_layout) {
+            auto ss = std::ostringstream{};
+            store_name = ndc.lout.identifier() + "_store";
+            generate_layout_store_callback(ss, ndc.lout, store_name);
+            store_source += ss.str();
+            store_function = store_name.c_str();
         }
-
-        std::array<configuration, max_fft_dim> cfg1d = {};
-        std::size_t M = cfg.shape[0];
-        std::size_t K = N * cfg.shape[dim_ + 1];
-        std::array<std::size_t, max_tensor_dim> shape = {};
-        std::array<std::size_t, max_tensor_dim> istride = {};
-        std::array<std::size_t, max_tensor_dim> ostride = {};
-        for (unsigned d = 0; d < dim_; ++d) {
-            std::size_t Nd = cfg.shape[d + 1];
-            std::size_t Ndc = Nd_complex(d);
-            K /= Ndc;
-            shape[0] = M;
-            shape[1] = Nd;
-            shape[2] = K;
-            auto type = d == 0 ? cfg.type : transform_type::c2c;
-            istride[0] = 1;
-            istride[1] = M;
-            istride[2] = M * Nd_real(d);
-            ostride[0] = 1;
-            ostride[1] = M;
-            ostride[2] = M * Ndc;
-            cfg1d[d] = {1, shape, cfg.fp, cfg.dir, type, istride, ostride};
-            M *= Ndc;
+        if (load_function) {
+            ndc.passes[0].callbacks = {load_source.c_str(), load_source.size(), load_function};
+        }
+        if (store_function) {
+            ndc.passes[dim_ - 1].callbacks = {store_source.c_str(), store_source.size(), nullptr,
+                                              store_function};
         }
-        if (cfg.type == transform_type::c2r) {
-            for (unsigned d = 0; d < dim_; ++d) {
-                auto &c = cfg1d[dim_ - 1 - d];
-                std::swap(c.istride, c.ostride);
-                plans_[d] = select_1d_fft_algorithm<Api>(c, api_, cache);
-            }
-        } else {
-            for (unsigned d = 0; d < dim_; ++d) {
-                plans_[d] = select_1d_fft_algorithm<Api>(cfg1d[d], api_, cache);
-            }
+        for (unsigned d = 0; d < dim_; ++d) {
+            plans_[d] = select_1d_fft_algorithm<Api>(ndc.passes[d], api_, cache);
         }
 
-        std::size_t bytes_per_real = static_cast<std::size_t>(cfg.fp);
-        std::size_t bytes_per_complex = 2 * bytes_per_real;
-        auto ibytes = cfg.type == transform_type::r2c ? bytes_per_real : bytes_per_complex;
-        auto obytes = cfg.type == transform_type::c2r ? bytes_per_real : bytes_per_complex;
-        auto isize = cfg.istride[dim_ + 1] * cfg.shape[dim_ + 1] * ibytes;
-        auto osize = cfg.ostride[dim_ + 1] * cfg.shape[dim_ + 1] * obytes;
-        // if the input buffer is larger than the output buffer than temporaries are larger than the
-        // output buffer and we cannot reuse the output buffer for temporaries
-        if (isize > osize) {
-            tmp_ = api_.create_device_buffer(isize);
+        if (ndc.scratch_bytes > 0) {
+            tmp_ = api_.create_device_buffer(ndc.scratch_bytes);
         }
     }
 
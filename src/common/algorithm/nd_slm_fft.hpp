@@ -0,0 +1,118 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef ND_SLM_FFT_20240412_HPP
+#define ND_SLM_FFT_20240412_HPP
+
+#include "bbfft/configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
+#include "bbfft/detail/plan_impl.hpp"
+#include "bbfft/device_info.hpp"
+#include "bbfft/jit_cache.hpp"
+#include "bbfft/shared_handle.hpp"
+
+#include <array>
+#include <cstddef>
+#include <sstream>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace bbfft {
+
+template <typename Api> class nd_slm_fft_base : public Api::plan_type {
+  public:
+    using kernel_bundle = typename Api::kernel_bundle_type;
+    using kernel = typename Api::kernel_type;
+
+    nd_slm_fft_base(configuration const &cfg, Api api, jit_cache *cache)
+        : api_(std::move(api)), module_(setup(cfg, cache)),
+          bundle_(api_.make_kernel_bundle(module_.get())),
+          k_(api_.create_kernel(bundle_, identifier_)) {}
+    ~nd_slm_fft_base() { api_.release_kernel(k_); }
+
+    nd_slm_fft_base(nd_slm_fft_base const &) = delete;
+    nd_slm_fft_base(nd_slm_fft_base &&) = delete;
+    nd_slm_fft_base &operator=(nd_slm_fft_base const &) = delete;
+    nd_slm_fft_base &operator=(nd_slm_fft_base &&) = delete;
+
+  protected:
+    auto setup(configuration const &cfg, jit_cache *cache) -> shared_handle<module_handle_t> {
+        std::stringstream ss;
+        if (cfg.callbacks) {
+            ss << std::string_view(cfg.callbacks.data, cfg.callbacks.length) << std::endl;
+        }
+        auto nsc = configure_nd_slm_fft(cfg, api_.info());
+
+        std::size_t Mg = (nsc.M - 1) / nsc.Mb + 1;
+        gws_ = std::array<std::size_t, 3>{Mg * nsc.Mb, nsc.Nt, cfg.shape[cfg.dim + 1]};
+        lws_ = std::array<std::size_t, 3>{nsc.Mb, nsc.Nt, 1};
+        identifier_ = nsc.identifier();
+
+        auto const make_cache_key = [this]() {
+            return jit_cache_key{identifier_, api_.device_id()};
+        };
+
+        if (cache) {
+            auto bundle = cache->get(make_cache_key());
+            if (bundle) {
+                return bundle;
+            }
+        }
+
+        generate_nd_slm_fft(ss, nsc);
+
+        auto mod = api_.build_module(ss.str());
+        if (cache) {
+            cache->store(make_cache_key(), mod);
+        }
+
+        return mod;
+    }
+
+    Api api_;
+    std::array<std::size_t, 3> gws_;
+    std::array<std::size_t, 3> lws_;
+    std::string identifier_;
+    shared_handle<module_handle_t> module_;
+    kernel_bundle bundle_;
+    kernel k_;
+};
+
+template <typename Api, typename PlanImplT = typename Api::plan_type> class nd_slm_fft;
+
+template <typename Api>
+class nd_slm_fft<Api, detail::plan_impl<typename Api::event_type>> : public nd_slm_fft_base<Api> {
+  public:
+    using nd_slm_fft_base<Api>::nd_slm_fft_base;
+    using event = typename Api::event_type;
+
+    auto execute(void const *in, void *out, std::vector<event> const &dep_events)
+        -> event override {
+        return this->api_.launch_kernel(this->k_, this->gws_, this->lws_, dep_events, [&](auto &h) {
+            h.set_arg(0, in);
+            h.set_arg(1, out);
+        });
+    }
+};
+
+template <typename Api>
+class nd_slm_fft<Api, detail::plan_unmanaged_event_impl<typename Api::event_type>>
+    : public nd_slm_fft_base<Api> {
+  public:
+    using nd_slm_fft_base<Api>::nd_slm_fft_base;
+    using event = typename Api::event_type;
+
+    void execute(void const *in, void *out, event signal_event, std::uint32_t num_dep_events,
+                 event *dep_events) override {
+        this->api_.launch_kernel(this->k_, this->gws_, this->lws_, signal_event, num_dep_events,
+                                 dep_events, [&](auto &h) {
+                                     h.set_arg(0, in);
+                                     h.set_arg(1, out);
+                                 });
+    }
+};
+
+} // namespace bbfft
+
+#endif // ND_SLM_FFT_20240412_HPP
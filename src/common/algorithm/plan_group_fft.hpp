@@ -0,0 +1,165 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef PLAN_GROUP_FFT_20240502_HPP
+#define PLAN_GROUP_FFT_20240502_HPP
+
+#include "bbfft/bad_configuration.hpp"
+#include "bbfft/configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
+#include "bbfft/detail/plan_impl.hpp"
+#include "bbfft/jit_cache.hpp"
+#include "bbfft/shared_handle.hpp"
+#include "planar_layout.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bbfft {
+
+template <typename Api> class plan_group_fft_base : public Api::plan_group_type {
+  public:
+    using kernel_bundle = typename Api::kernel_bundle_type;
+    using kernel = typename Api::kernel_type;
+
+    plan_group_fft_base(std::vector<configuration> const &cfgs, Api api, jit_cache *cache)
+        : api_(std::move(api)), module_(setup(cfgs, cache)),
+          bundle_(api_.make_kernel_bundle(module_.get())),
+          k_(api_.create_kernel(bundle_, identifier_)) {}
+    ~plan_group_fft_base() { api_.release_kernel(k_); }
+
+    plan_group_fft_base(plan_group_fft_base const &) = delete;
+    plan_group_fft_base(plan_group_fft_base &&) = delete;
+    plan_group_fft_base &operator=(plan_group_fft_base const &) = delete;
+    plan_group_fft_base &operator=(plan_group_fft_base &&) = delete;
+
+  protected:
+    auto setup(std::vector<configuration> const &cfgs, jit_cache *cache)
+        -> shared_handle<module_handle_t> {
+        auto pgc = configure_plan_group_fft(cfgs, api_.info());
+
+        std::size_t num_groups = 0;
+        for (auto const &n : pgc.num_groups) {
+            num_groups += n;
+        }
+        auto const &first = pgc.members.front();
+        gws_ = std::array<std::size_t, 3>{first.Mb, first.Kb, num_groups};
+        lws_ = std::array<std::size_t, 3>{first.Mb, first.Kb, 1};
+        inplace_unsupported_.clear();
+        K_.assign(pgc.K.begin(), pgc.K.end());
+        fp_.clear();
+        planar_offset_.clear();
+        for (auto const &sbc : pgc.members) {
+            inplace_unsupported_.emplace_back(sbc.inplace_unsupported);
+            fp_.emplace_back(sbc.fp);
+            planar_offset_.emplace_back(sbc.planar_offset);
+        }
+        identifier_ = pgc.identifier();
+
+        auto const make_cache_key = [this]() {
+            return jit_cache_key{identifier_, api_.device_id()};
+        };
+
+        if (cache) {
+            auto bundle = cache->get(make_cache_key());
+            if (bundle) {
+                return bundle;
+            }
+        }
+
+        std::stringstream ss;
+        generate_plan_group_fft(ss, pgc);
+
+        auto mod = api_.build_module(ss.str());
+        if (cache) {
+            cache->store(make_cache_key(), mod);
+        }
+
+        return mod;
+    }
+
+    void check_args(std::vector<std::pair<void const *, void *>> const &args) const {
+        if (args.size() != inplace_unsupported_.size()) {
+            throw bad_configuration("The plan group expects one pair of pointers per member.");
+        }
+        for (std::size_t i = 0; i < args.size(); ++i) {
+            if (args[i].first == args[i].second && inplace_unsupported_[i]) {
+                throw bad_configuration("Member " + std::to_string(i) +
+                                        " of the plan group does not support in-place transform "
+                                        "on the current device. Please use the out-of-place "
+                                        "transform.");
+            }
+        }
+    }
+
+    template <typename Handler>
+    void set_args(Handler &h, std::vector<std::pair<void const *, void *>> const &args) const {
+        unsigned arg = 0;
+        for (std::size_t i = 0; i < args.size(); ++i) {
+            h.set_arg(arg++, args[i].first);
+            h.set_arg(arg++, args[i].second);
+            h.set_arg(arg++, K_[i]);
+            if (planar_offset_[i][0] != 0) {
+                auto in_im = imaginary_part(args[i].first, planar_offset_[i][0], fp_[i]);
+                h.set_arg(arg++, in_im);
+            }
+            if (planar_offset_[i][1] != 0) {
+                auto out_im = imaginary_part(args[i].second, planar_offset_[i][1], fp_[i]);
+                h.set_arg(arg++, out_im);
+            }
+        }
+    }
+
+    Api api_;
+    std::array<std::size_t, 3> gws_;
+    std::array<std::size_t, 3> lws_;
+    std::vector<bool> inplace_unsupported_;
+    std::vector<uint64_t> K_;
+    std::vector<precision> fp_;
+    std::vector<std::array<std::size_t, 2>> planar_offset_;
+    std::string identifier_;
+    shared_handle<module_handle_t> module_;
+    kernel_bundle bundle_;
+    kernel k_;
+};
+
+template <typename Api, typename PlanImplT = typename Api::plan_group_type> class plan_group_fft;
+
+template <typename Api>
+class plan_group_fft<Api, detail::plan_group_impl<typename Api::event_type>>
+    : public plan_group_fft_base<Api> {
+  public:
+    using plan_group_fft_base<Api>::plan_group_fft_base;
+    using event = typename Api::event_type;
+
+    auto execute(std::vector<std::pair<void const *, void *>> const &args,
+                 std::vector<event> const &dep_events) -> event override {
+        this->check_args(args);
+        return this->api_.launch_kernel(this->k_, this->gws_, this->lws_, dep_events,
+                                        [&](auto &h) { this->set_args(h, args); });
+    }
+};
+
+template <typename Api>
+class plan_group_fft<Api, detail::plan_group_unmanaged_event_impl<typename Api::event_type>>
+    : public plan_group_fft_base<Api> {
+  public:
+    using plan_group_fft_base<Api>::plan_group_fft_base;
+    using event = typename Api::event_type;
+
+    void execute(std::vector<std::pair<void const *, void *>> const &args, event signal_event,
+                 std::uint32_t num_dep_events, event *dep_events) override {
+        this->check_args(args);
+        this->api_.launch_kernel(this->k_, this->gws_, this->lws_, signal_event, num_dep_events,
+                                 dep_events, [&](auto &h) { this->set_args(h, args); });
+    }
+};
+
+} // namespace bbfft
+
+#endif // PLAN_GROUP_FFT_20240502_HPP
@@ -0,0 +1,90 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef R2R_FFT_20240415_HPP
+#define R2R_FFT_20240415_HPP
+
+#include "bbfft/configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
+#include "bbfft/detail/plan_impl.hpp"
+#include "bbfft/jit_cache.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bbfft {
+
+template <typename Api>
+auto select_1d_fft_algorithm(configuration const &cfg, Api api, jit_cache *cache)
+    -> std::shared_ptr<typename Api::plan_type>;
+
+/**
+ * @brief Real-to-real transforms (DCT-II/III, DST-II/III)
+ *
+ * Type II transforms are computed with an r2c FFT of length N, type III transforms with a
+ * c2r FFT of length N. The permutation and twiddle steps are generated as load and store
+ * callbacks of the real FFT, such that input and output are touched only once.
+ */
+template <typename Api> class r2r_fft_base : public Api::plan_type {
+  public:
+    using event = typename Api::event_type;
+
+    r2r_fft_base(configuration const &cfg, Api api, jit_cache *cache) : api_(std::move(api)) {
+        auto const rc = configure_r2r_fft(cfg);
+        auto const name = rc.identifier();
+        auto load_name = name + "_load";
+        auto store_name = name + "_store";
+
+        auto src = std::ostringstream{};
+        if (cfg.callbacks) {
+            src << std::string_view(cfg.callbacks.data, cfg.callbacks.length) << std::endl;
+        }
+        generate_r2r_load_callback(src, rc, load_name);
+        generate_r2r_store_callback(src, rc, store_name);
+        auto source = src.str();
+
+        auto inner = r2r_fft_inner_configuration(rc, cfg.shape[2]);
+        inner.callbacks = {source.c_str(), source.size(), load_name.c_str(), store_name.c_str()};
+        inner.scale = cfg.scale;
+        plan_ = select_1d_fft_algorithm<Api>(inner, api_, cache);
+    }
+
+  protected:
+    Api api_;
+    std::shared_ptr<typename Api::plan_type> plan_;
+};
+
+template <typename Api, typename PlanImplT = typename Api::plan_type> class r2r_fft;
+
+template <typename Api>
+class r2r_fft<Api, detail::plan_impl<typename Api::event_type>> : public r2r_fft_base<Api> {
+  public:
+    using r2r_fft_base<Api>::r2r_fft_base;
+    using event = typename Api::event_type;
+
+    auto execute(void const *in, void *out, std::vector<event> const &dep_events)
+        -> event override {
+        return this->plan_->execute(in, out, dep_events);
+    }
+};
+
+template <typename Api>
+class r2r_fft<Api, detail::plan_unmanaged_event_impl<typename Api::event_type>>
+    : public r2r_fft_base<Api> {
+  public:
+    using r2r_fft_base<Api>::r2r_fft_base;
+    using event = typename Api::event_type;
+
+    void execute(void const *in, void *out, event signal_event, std::uint32_t num_dep_events,
+                 event *dep_events) override {
+        this->plan_->execute(in, out, signal_event, num_dep_events, dep_events);
+    }
+};
+
+} // namespace bbfft
+
+#endif // R2R_FFT_20240415_HPP
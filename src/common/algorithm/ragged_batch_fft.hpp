@@ -0,0 +1,153 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef RAGGED_BATCH_FFT_20240502_HPP
+#define RAGGED_BATCH_FFT_20240502_HPP
+
+#include "bbfft/bad_configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
+#include "bbfft/detail/plan_impl.hpp"
+#include "bbfft/jit_cache.hpp"
+#include "bbfft/ragged_configuration.hpp"
+#include "bbfft/shared_handle.hpp"
+
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bbfft {
+
+template <typename Api> class ragged_batch_fft_base : public Api::plan_type {
+  public:
+    using buffer = typename Api::buffer_type;
+    using kernel_bundle = typename Api::kernel_bundle_type;
+    using kernel = typename Api::kernel_type;
+
+    ragged_batch_fft_base(ragged_configuration const &cfg, Api api, jit_cache *cache)
+        : api_(std::move(api)), module_(setup(cfg, cache)),
+          bundle_(api_.make_kernel_bundle(module_.get())),
+          k_(api_.create_kernel(bundle_, identifier_)) {}
+    ~ragged_batch_fft_base() {
+        api_.release_kernel(k_);
+        api_.release_buffer(twiddle_);
+    }
+
+    ragged_batch_fft_base(ragged_batch_fft_base const &) = delete;
+    ragged_batch_fft_base(ragged_batch_fft_base &&) = delete;
+    ragged_batch_fft_base &operator=(ragged_batch_fft_base const &) = delete;
+    ragged_batch_fft_base &operator=(ragged_batch_fft_base &&) = delete;
+
+  protected:
+    auto setup(ragged_configuration const &cfg, jit_cache *cache)
+        -> shared_handle<module_handle_t> {
+        if (cfg.num_records == 0 || cfg.records == nullptr) {
+            throw bad_configuration("A ragged batch requires at least one record.");
+        }
+        auto rbc = configure_ragged_batch_fft(cfg, api_.info());
+
+        records_ = cfg.records;
+        gws_ = std::array<std::size_t, 3>{1, rbc.Nb, cfg.num_records};
+        lws_ = std::array<std::size_t, 3>{1, rbc.Nb, 1};
+        identifier_ = rbc.identifier();
+
+        switch (compute_precision(rbc.fp)) {
+        case precision::f32:
+            create_twiddle<float>(rbc);
+            break;
+        case precision::f64:
+            create_twiddle<double>(rbc);
+            break;
+        default:
+            throw bad_configuration("Unsupported floating point type");
+        }
+
+        auto const make_cache_key = [this]() {
+            return jit_cache_key{identifier_, api_.device_id()};
+        };
+
+        if (cache) {
+            auto bundle = cache->get(make_cache_key());
+            if (bundle) {
+                return bundle;
+            }
+        }
+
+        std::stringstream ss;
+        generate_ragged_batch_fft(ss, rbc);
+
+        auto mod = api_.build_module(ss.str());
+        if (cache) {
+            cache->store(make_cache_key(), mod);
+        }
+
+        return mod;
+    }
+
+    template <typename T> void create_twiddle(ragged_batch_configuration const &rbc) {
+        auto table = ragged_batch_twiddle_table(rbc);
+        auto twiddle = std::vector<T>(2 * table.size());
+        for (std::size_t i = 0; i < table.size(); ++i) {
+            twiddle[2 * i] = table[i].real();
+            twiddle[2 * i + 1] = table[i].imag();
+        }
+        twiddle_ = api_.create_twiddle_table(twiddle);
+    }
+
+    Api api_;
+    std::array<std::size_t, 3> gws_;
+    std::array<std::size_t, 3> lws_;
+    std::string identifier_;
+    shared_handle<module_handle_t> module_;
+    kernel_bundle bundle_;
+    kernel k_;
+    void const *records_;
+    buffer twiddle_;
+};
+
+template <typename Api, typename PlanImplT = typename Api::plan_type> class ragged_batch_fft;
+
+template <typename Api>
+class ragged_batch_fft<Api, detail::plan_impl<typename Api::event_type>>
+    : public ragged_batch_fft_base<Api> {
+  public:
+    using ragged_batch_fft_base<Api>::ragged_batch_fft_base;
+    using event = typename Api::event_type;
+
+    auto execute(void const *in, void *out, std::vector<event> const &dep_events)
+        -> event override {
+        return this->api_.launch_kernel(this->k_, this->gws_, this->lws_, dep_events, [&](auto &h) {
+            h.set_arg(0, in);
+            h.set_arg(1, out);
+            h.set_arg(2, this->records_);
+            h.set_arg(3, this->twiddle_);
+        });
+    }
+};
+
+template <typename Api>
+class ragged_batch_fft<Api, detail::plan_unmanaged_event_impl<typename Api::event_type>>
+    : public ragged_batch_fft_base<Api> {
+  public:
+    using ragged_batch_fft_base<Api>::ragged_batch_fft_base;
+    using event = typename Api::event_type;
+
+    void execute(void const *in, void *out, event signal_event, std::uint32_t num_dep_events,
+                 event *dep_events) override {
+        this->api_.launch_kernel(this->k_, this->gws_, this->lws_, signal_event, num_dep_events,
+                                 dep_events, [&](auto &h) {
+                                     h.set_arg(0, in);
+                                     h.set_arg(1, out);
+                                     h.set_arg(2, this->records_);
+                                     h.set_arg(3, this->twiddle_);
+                                 });
+    }
+};
+
+} // namespace bbfft
+
+#endif // RAGGED_BATCH_FFT_20240502_HPP
@@ -4,6 +4,7 @@
 #ifndef SMALL_BATCH_FFT_20220413_HPP
 #define SMALL_BATCH_FFT_20220413_HPP
 
+#include "bbfft/autotune.hpp"
 #include "bbfft/bad_configuration.hpp"
 #include "bbfft/configuration.hpp"
 #include "bbfft/detail/generator_impl.hpp"
@@ -11,6 +12,7 @@
 #include "bbfft/device_info.hpp"
 #include "bbfft/jit_cache.hpp"
 #include "bbfft/shared_handle.hpp"
+#include "planar_layout.hpp"
 
 #include <algorithm>
 #include <array>
@@ -28,7 +30,10 @@ template <typename Api> class small_batch_fft_base : public Api::plan_type {
     using kernel = typename Api::kernel_type;
 
     small_batch_fft_base(configuration const &cfg, Api api, jit_cache *cache)
-        : api_(std::move(api)), module_(setup(cfg, cache)),
+        : small_batch_fft_base(cfg, tuning_candidate{}, std::move(api), cache) {}
+    small_batch_fft_base(configuration const &cfg, tuning_candidate const &tc, Api api,
+                         jit_cache *cache)
+        : api_(std::move(api)), module_(setup(cfg, tc, cache)),
           bundle_(api_.make_kernel_bundle(module_.get())),
           k_(api_.create_kernel(bundle_, identifier_)) {}
     ~small_batch_fft_base() { api_.release_kernel(k_); }
@@ -39,15 +44,20 @@ template <typename Api> class small_batch_fft_base : public Api::plan_type {
     small_batch_fft_base &operator=(small_batch_fft_base &&) = delete;
 
   protected:
-    auto setup(configuration const &cfg, jit_cache *cache) -> shared_handle<module_handle_t> {
+    auto setup(configuration const &cfg, tuning_candidate const &tc, jit_cache *cache)
+        -> shared_handle<module_handle_t> {
         std::stringstream ss;
         if (cfg.callbacks) {
             ss << std::string_view(cfg.callbacks.data, cfg.callbacks.length) << std::endl;
         }
-        auto sbc = configure_small_batch_fft(cfg, api_.info());
+        auto sbc = tc.algorithm == tuning_algorithm::automatic
+                       ? configure_small_batch_fft(cfg, api_.info())
+                       : configure_small_batch_fft(cfg, api_.info(), tc);
 
         auto N = cfg.shape[1];
         K_ = cfg.shape[2];
+        fp_ = cfg.fp;
+        planar_offset_ = cfg.planar_offset;
 
         std::size_t Mg = (sbc.M - 1) / sbc.Mb + 1;
         bool is_real = cfg.type == transform_type::r2c || cfg.type == transform_type::c2r;
@@ -82,6 +92,21 @@ template <typename Api> class small_batch_fft_base : public Api::plan_type {
         return mod;
     }
 
+    template <typename Handler> void set_args(Handler &h, void const *in, void *out) {
+        h.set_arg(0, in);
+        h.set_arg(1, out);
+        h.set_arg(2, K_);
+        unsigned arg = 3;
+        if (planar_offset_[0] != 0) {
+            auto in_im = imaginary_part(in, planar_offset_[0], fp_);
+            h.set_arg(arg++, in_im);
+        }
+        if (planar_offset_[1] != 0) {
+            auto out_im = imaginary_part(out, planar_offset_[1], fp_);
+            h.set_arg(arg++, out_im);
+        }
+    }
+
     Api api_;
     std::array<std::size_t, 3> gws_;
     std::array<std::size_t, 3> lws_;
@@ -91,6 +116,8 @@ template <typename Api> class small_batch_fft_base : public Api::plan_type {
     kernel_bundle bundle_;
     kernel k_;
     uint64_t K_;
+    precision fp_;
+    std::array<std::size_t, 2> planar_offset_;
 };
 
 template <typename Api, typename PlanImplT = typename Api::plan_type> class small_batch_fft;
@@ -108,11 +135,8 @@ class small_batch_fft<Api, detail::plan_impl<typename Api::event_type>>
             throw bad_configuration("The plan does not support in-place transform on the current "
                                     "device. Please use the out-of-place transform.");
         }
-        return this->api_.launch_kernel(this->k_, this->gws_, this->lws_, dep_events, [&](auto &h) {
-            h.set_arg(0, in);
-            h.set_arg(1, out);
-            h.set_arg(2, this->K_);
-        });
+        return this->api_.launch_kernel(this->k_, this->gws_, this->lws_, dep_events,
+                                        [&](auto &h) { this->set_args(h, in, out); });
     }
 };
 
@@ -130,11 +154,7 @@ class small_batch_fft<Api, detail::plan_unmanaged_event_impl<typename Api::event
                                     "device. Please use the out-of-place transform.");
         }
         this->api_.launch_kernel(this->k_, this->gws_, this->lws_, signal_event, num_dep_events,
-                                 dep_events, [&](auto &h) {
-                                     h.set_arg(0, in);
-                                     h.set_arg(1, out);
-                                     h.set_arg(2, this->K_);
-                                 });
+                                 dep_events, [&](auto &h) { this->set_args(h, in, out); });
     }
 };
 
@@ -0,0 +1,124 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef SUBGROUP_FFT_20240502_HPP
+#define SUBGROUP_FFT_20240502_HPP
+
+#include "bbfft/autotune.hpp"
+#include "bbfft/configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
+#include "bbfft/detail/plan_impl.hpp"
+#include "bbfft/jit_cache.hpp"
+#include "bbfft/shared_handle.hpp"
+
+#include <array>
+#include <cstddef>
+#include <sstream>
+#include <vector>
+
+namespace bbfft {
+
+template <typename Api> class subgroup_fft_base : public Api::plan_type {
+  public:
+    using kernel_bundle = typename Api::kernel_bundle_type;
+    using kernel = typename Api::kernel_type;
+
+    subgroup_fft_base(configuration const &cfg, Api api, jit_cache *cache)
+        : subgroup_fft_base(cfg, tuning_candidate{}, std::move(api), cache) {}
+    subgroup_fft_base(configuration const &cfg, tuning_candidate const &tc, Api api,
+                      jit_cache *cache)
+        : api_(std::move(api)), module_(setup(cfg, tc, cache)),
+          bundle_(api_.make_kernel_bundle(module_.get())),
+          k_(api_.create_kernel(bundle_, identifier_)) {}
+    ~subgroup_fft_base() { api_.release_kernel(k_); }
+
+    subgroup_fft_base(subgroup_fft_base const &) = delete;
+    subgroup_fft_base(subgroup_fft_base &&) = delete;
+    subgroup_fft_base &operator=(subgroup_fft_base const &) = delete;
+    subgroup_fft_base &operator=(subgroup_fft_base &&) = delete;
+
+  protected:
+    auto setup(configuration const &cfg, tuning_candidate const &tc, jit_cache *cache)
+        -> shared_handle<module_handle_t> {
+        auto sgc = tc.algorithm == tuning_algorithm::automatic
+                       ? configure_subgroup_fft(cfg, api_.info())
+                       : configure_subgroup_fft(cfg, api_.info(), tc);
+
+        K_ = cfg.shape[2];
+        std::size_t Kg = (K_ - 1) / sgc.Kb + 1;
+        gws_ = std::array<std::size_t, 3>{sgc.sgs, Kg * sgc.Kb, 1};
+        lws_ = std::array<std::size_t, 3>{sgc.sgs, sgc.Kb, 1};
+        identifier_ = sgc.identifier();
+
+        auto const make_cache_key = [this]() {
+            return jit_cache_key{identifier_, api_.device_id()};
+        };
+
+        if (cache) {
+            auto bundle = cache->get(make_cache_key());
+            if (bundle) {
+                return bundle;
+            }
+        }
+
+        std::stringstream ss;
+        generate_subgroup_fft(ss, sgc);
+
+        auto mod = api_.build_module(ss.str());
+        if (cache) {
+            cache->store(make_cache_key(), mod);
+        }
+
+        return mod;
+    }
+
+    Api api_;
+    std::array<std::size_t, 3> gws_;
+    std::array<std::size_t, 3> lws_;
+    std::string identifier_;
+    shared_handle<module_handle_t> module_;
+    kernel_bundle bundle_;
+    kernel k_;
+    uint64_t K_;
+};
+
+template <typename Api, typename PlanImplT = typename Api::plan_type> class subgroup_fft;
+
+template <typename Api>
+class subgroup_fft<Api, detail::plan_impl<typename Api::event_type>>
+    : public subgroup_fft_base<Api> {
+  public:
+    using subgroup_fft_base<Api>::subgroup_fft_base;
+    using event = typename Api::event_type;
+
+    auto execute(void const *in, void *out, std::vector<event> const &dep_events)
+        -> event override {
+        return this->api_.launch_kernel(this->k_, this->gws_, this->lws_, dep_events, [&](auto &h) {
+            h.set_arg(0, in);
+            h.set_arg(1, out);
+            h.set_arg(2, this->K_);
+        });
+    }
+};
+
+template <typename Api>
+class subgroup_fft<Api, detail::plan_unmanaged_event_impl<typename Api::event_type>>
+    : public subgroup_fft_base<Api> {
+  public:
+    using subgroup_fft_base<Api>::subgroup_fft_base;
+    using event = typename Api::event_type;
+
+    void execute(void const *in, void *out, event signal_event, std::uint32_t num_dep_events,
+                 event *dep_events) override {
+        this->api_.launch_kernel(this->k_, this->gws_, this->lws_, signal_event, num_dep_events,
+                                 dep_events, [&](auto &h) {
+                                     h.set_arg(0, in);
+                                     h.set_arg(1, out);
+                                     h.set_arg(2, this->K_);
+                                 });
+    }
+};
+
+} // namespace bbfft
+
+#endif // SUBGROUP_FFT_20240502_HPP
@@ -4,9 +4,13 @@
 #ifndef ALGORITHM_1D_20220602_HPP
 #define ALGORITHM_1D_20220602_HPP
 
+#include "algorithm/bluestein_fft.hpp"
 #include "algorithm/factor2_slm_fft.hpp"
+#include "algorithm/four_step_fft.hpp"
 #include "algorithm/small_batch_fft.hpp"
+#include "algorithm/subgroup_fft.hpp"
 #include "bbfft/configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
 #include "bbfft/detail/plan_impl.hpp"
 #include "bbfft/jit_cache.hpp"
 
@@ -19,18 +23,17 @@ namespace bbfft {
 template <typename Api>
 auto select_1d_fft_algorithm(configuration const &cfg, Api api, jit_cache *cache)
     -> std::shared_ptr<typename Api::plan_type> {
-    auto info = api.info();
-    int sgs = info.min_subgroup_size();
-    auto reg_space = info.register_space_max();
-    std::size_t N = cfg.shape[1];
-    auto required_reg_space_for_small_batch = 2 * static_cast<int>(cfg.fp) * N * sgs;
-    // Can halve register space for real DFT with even N
-    if (cfg.type != transform_type::c2c && N % 2 == 0) {
-        required_reg_space_for_small_batch /= 2;
-    }
-
-    if (required_reg_space_for_small_batch >= reg_space / 2) {
+    switch (select_algorithm_1d(cfg, api.info())) {
+    case algorithm_1d::small_batch:
+        break;
+    case algorithm_1d::factor2_slm:
         return std::make_shared<factor2_slm_fft<Api>>(cfg, std::move(api), cache);
+    case algorithm_1d::subgroup:
+        return std::make_shared<subgroup_fft<Api>>(cfg, std::move(api), cache);
+    case algorithm_1d::bluestein:
+        return std::make_shared<bluestein_fft<Api>>(cfg, std::move(api), cache);
+    case algorithm_1d::four_step:
+        return std::make_shared<four_step_fft<Api>>(cfg, std::move(api), cache);
     }
     return std::make_shared<small_batch_fft<Api>>(cfg, std::move(api), cache);
 }
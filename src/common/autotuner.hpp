@@ -0,0 +1,135 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef AUTOTUNER_20240502_HPP
+#define AUTOTUNER_20240502_HPP
+
+#include "algorithm.hpp"
+#include "algorithm/factor2_slm_fft.hpp"
+#include "algorithm/small_batch_fft.hpp"
+#include "algorithm/subgroup_fft.hpp"
+#include "bbfft/autotune.hpp"
+#include "bbfft/bad_configuration.hpp"
+#include "bbfft/configuration.hpp"
+#include "bbfft/jit_cache.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <utility>
+
+namespace bbfft {
+
+template <typename Api>
+auto make_tuned_fft(configuration const &cfg, tuning_candidate const &tc, Api api,
+                    jit_cache *cache) -> std::shared_ptr<typename Api::plan_type> {
+    if (tc.algorithm == tuning_algorithm::automatic) {
+        return select_fft_algorithm<Api>(cfg, std::move(api), cache);
+    }
+    auto info = api.info();
+    check_fft_configuration(cfg, info);
+    if (default_tuning_candidate(cfg, info).algorithm == tuning_algorithm::automatic) {
+        throw bad_configuration("The configuration does not support tuning candidates.");
+    }
+    if (tc.algorithm == tuning_algorithm::small_batch) {
+        return std::make_shared<small_batch_fft<Api>>(cfg, tc, std::move(api), cache);
+    }
+    if (tc.algorithm == tuning_algorithm::subgroup) {
+        return std::make_shared<subgroup_fft<Api>>(cfg, tc, std::move(api), cache);
+    }
+    if (cfg.input_length != 0 || cfg.output_length != 0) {
+        throw bad_configuration("Pruned FFTs require the small batch algorithm.");
+    }
+    return std::make_shared<factor2_slm_fft<Api>>(cfg, tc, std::move(api), cache);
+}
+
+/**
+ * @brief Time the execution of an out-of-place transform on scratch buffers
+ *
+ * Requires an API with managed events and device pointers as buffers.
+ *
+ * @return Average run-time per execution in seconds
+ */
+template <typename Api>
+double measure_fft(configuration const &cfg, Api &api, typename Api::plan_type &plan,
+                   unsigned repetitions = 10) {
+    auto const extent = [&cfg](auto const &stride, std::size_t N) {
+        return stride[0] * (cfg.shape[0] - 1) + stride[1] * (N - 1) +
+               stride[2] * (cfg.shape[2] - 1) + 1;
+    };
+    std::size_t N = cfg.shape[1];
+    std::size_t sizeof_real = size_in_bytes(cfg.fp);
+    std::size_t in_bytes =
+        cfg.type == transform_type::r2c
+            ? extent(cfg.istride, N) * sizeof_real
+            : extent(cfg.istride, cfg.type == transform_type::c2r ? N / 2 + 1 : N) * 2 *
+                  sizeof_real;
+    std::size_t out_bytes =
+        cfg.type == transform_type::c2r
+            ? extent(cfg.ostride, N) * sizeof_real
+            : extent(cfg.ostride, cfg.type == transform_type::r2c ? N / 2 + 1 : N) * 2 *
+                  sizeof_real;
+    in_bytes += cfg.planar_offset[0] * sizeof_real;
+    out_bytes += cfg.planar_offset[1] * sizeof_real;
+
+    auto in = api.create_device_buffer(in_bytes);
+    auto out = api.create_device_buffer(out_bytes);
+
+    // The first execution is not timed as it may include one-time costs of the runtime
+    auto e = plan.execute(in, out);
+    api.wait(e);
+    api.release_event(e);
+
+    auto start = std::chrono::steady_clock::now();
+    e = plan.execute(in, out);
+    for (unsigned r = 1; r < repetitions; ++r) {
+        auto next = plan.execute(in, out, e);
+        api.release_event(e);
+        e = next;
+    }
+    api.wait(e);
+    api.release_event(e);
+    auto time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    api.release_buffer(in);
+    api.release_buffer(out);
+    return time / repetitions;
+}
+
+/**
+ * @brief Select the fastest candidate of the tuning search space
+ *
+ * @param measure Functor that is called with the plan of a candidate and the candidate and
+ * returns a run-time; smaller is better
+ *
+ * @return Fastest candidate; the automatic candidate if the search space is empty
+ */
+template <typename Api, typename Measure>
+auto autotune_fft(configuration const &cfg, Api api, jit_cache *cache, Measure &&measure)
+    -> tuning_candidate {
+    auto info = api.info();
+    check_fft_configuration(cfg, info);
+    auto best = tuning_candidate{};
+    double best_time = std::numeric_limits<double>::infinity();
+    for (auto const &tc : tuning_search_space(cfg, info)) {
+        auto plan = std::shared_ptr<typename Api::plan_type>{};
+        try {
+            plan = make_tuned_fft<Api>(cfg, tc, api, cache);
+        } catch (std::exception const &) {
+            // Candidates whose kernels the device compiler rejects are not viable
+            continue;
+        }
+        double time = measure(*plan, tc);
+        if (time < best_time) {
+            best = tc;
+            best_time = time;
+        }
+    }
+    return best;
+}
+
+} // namespace bbfft
+
+#endif // AUTOTUNER_20240502_HPP
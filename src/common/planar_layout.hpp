@@ -0,0 +1,30 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef PLANAR_LAYOUT_20240611_HPP
+#define PLANAR_LAYOUT_20240611_HPP
+
+#include "bbfft/configuration.hpp"
+
+#include <cstddef>
+
+namespace bbfft {
+
+/**
+ * @brief Pointer to the imaginary parts of a tensor in planar layout
+ *
+ * @param x Pointer to the real parts
+ * @param offset Distance of the imaginary parts from the real parts in reals
+ * @param fp Precision of the tensor
+ */
+inline void const *imaginary_part(void const *x, std::size_t offset, precision fp) {
+    return static_cast<char const *>(x) + offset * size_in_bytes(fp);
+}
+//! @copydoc imaginary_part
+inline void *imaginary_part(void *x, std::size_t offset, precision fp) {
+    return static_cast<char *>(x) + offset * size_in_bytes(fp);
+}
+
+} // namespace bbfft
+
+#endif // PLANAR_LAYOUT_20240611_HPP
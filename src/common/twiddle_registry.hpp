@@ -0,0 +1,95 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef TWIDDLE_REGISTRY_20240502_HPP
+#define TWIDDLE_REGISTRY_20240502_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace bbfft {
+
+/**
+ * @brief Identifies a twiddle table on a device
+ *
+ * The table string must encode every parameter that the contents of the table depend on.
+ */
+struct twiddle_key {
+    std::string table;   ///< Description of the table contents
+    uint64_t device_id;  ///< Device the table lives on
+    uint64_t context_id; ///< Context the table is allocated in
+
+    inline bool operator<(twiddle_key const &other) const {
+        return std::tie(table, device_id, context_id) <
+               std::tie(other.table, other.device_id, other.context_id);
+    }
+};
+
+/**
+ * @brief Registry of reference-counted twiddle tables that are shared between plans
+ *
+ * The registry only holds weak references; a table is released as soon as the last plan
+ * using it is destroyed.
+ */
+template <typename Api> class twiddle_registry {
+  public:
+    using buffer = typename Api::buffer_type;
+    using handle = std::shared_ptr<std::remove_pointer_t<buffer>>;
+
+    static auto instance() -> twiddle_registry & {
+        static twiddle_registry registry;
+        return registry;
+    }
+
+    /**
+     * @brief Get a shared twiddle table
+     *
+     * @param api API the table is created with and released with
+     * @param table Description of the table contents
+     * @param create Functor that uploads the table and returns the buffer; only called if no
+     * table is registered under the key
+     *
+     * @return Handle to the twiddle table
+     */
+    template <typename Create> auto get(Api &api, std::string table, Create &&create) -> handle {
+        auto key = twiddle_key{std::move(table), api.device_id(), api.context_id()};
+        auto lock = std::lock_guard<std::mutex>(mutex_);
+        if (auto it = tables_.find(key); it != tables_.end()) {
+            if (auto h = it->second.lock()) {
+                return h;
+            }
+        }
+        for (auto it = tables_.begin(); it != tables_.end();) {
+            it = it->second.expired() ? tables_.erase(it) : std::next(it);
+        }
+        auto h = handle(create(), [api](buffer buf) mutable { api.release_buffer(buf); });
+        tables_[std::move(key)] = h;
+        return h;
+    }
+
+    //! Number of twiddle tables that are alive
+    inline std::size_t size() const {
+        auto lock = std::lock_guard<std::mutex>(mutex_);
+        std::size_t num = 0;
+        for (auto const &entry : tables_) {
+            num += entry.second.expired() ? 0 : 1;
+        }
+        return num;
+    }
+
+  private:
+    mutable std::mutex mutex_;
+    std::map<twiddle_key, std::weak_ptr<std::remove_pointer_t<buffer>>> tables_;
+};
+
+} // namespace bbfft
+
+#endif // TWIDDLE_REGISTRY_20240502_HPP
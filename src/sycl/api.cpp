@@ -3,11 +3,13 @@
 
 #include "api.hpp"
 
+#include "bbfft/cl/error.hpp"
 #include "bbfft/detail/compiler_options.hpp"
 #include "bbfft/sycl/device.hpp"
 #include "bbfft/sycl/online_compiler.hpp"
 
 #include <CL/cl.h>
+#include <cstdint>
 #include <level_zero/ze_api.h>
 
 using ::sycl::backend;
@@ -23,6 +25,17 @@ api::api(::sycl::queue queue, ::sycl::context context, ::sycl::device device)
 device_info api::info() { return get_device_info(device_); }
 
 uint64_t api::device_id() { return get_device_id(device_); }
+uint64_t api::context_id() {
+    // Native handles are unique while the context is alive; twiddle tables keep the context alive
+    if (context_.get_backend() == backend::ext_oneapi_level_zero) {
+        return reinterpret_cast<std::uintptr_t>(
+            ::sycl::get_native<backend::ext_oneapi_level_zero, ::sycl::context>(context_));
+    }
+    auto native_context = ::sycl::get_native<backend::opencl, ::sycl::context>(context_);
+    auto id = reinterpret_cast<std::uintptr_t>(native_context);
+    CL_CHECK(clReleaseContext(native_context));
+    return id;
+}
 
 auto api::build_module(std::string const &source) -> shared_handle<module_handle_t> {
     return ::bbfft::sycl::make_shared_handle(
@@ -23,6 +23,8 @@ class api {
   public:
     using event_type = ::sycl::event;
     using plan_type = detail::plan_impl<event_type>;
+    using convolution_plan_type = detail::convolution_plan_impl<event_type>;
+    using plan_group_type = detail::plan_group_impl<event_type>;
     using buffer_type = void *;
     using kernel_bundle_type = ::sycl::kernel_bundle<::sycl::bundle_state::executable>;
     using kernel_type = ::sycl::kernel;
@@ -32,6 +34,7 @@ class api {
 
     device_info info();
     uint64_t device_id();
+    uint64_t context_id();
 
     auto build_module(std::string const &source) -> shared_handle<module_handle_t>;
     auto make_kernel_bundle(module_handle_t mod) -> kernel_bundle_type;
@@ -62,6 +65,7 @@ class api {
         return create_twiddle_table(twiddle_table.data(), twiddle_table.size() * sizeof(T));
     }
 
+    inline void wait(event_type e) { e.wait(); }
     inline void release_event(event_type) {}
     inline void release_buffer(buffer_type ptr) { free(ptr, context_); }
     inline void release_kernel(kernel_type) {}
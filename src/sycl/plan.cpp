@@ -4,12 +4,18 @@
 #include "bbfft/plan.hpp"
 #include "algorithm.hpp"
 #include "api.hpp"
+#include "autotuner.hpp"
+#include "bbfft/autotune.hpp"
 #include "bbfft/configuration.hpp"
+#include "bbfft/convolution_configuration.hpp"
 #include "bbfft/jit_cache.hpp"
+#include "bbfft/ragged_configuration.hpp"
 #include "bbfft/sycl/make_plan.hpp"
 
 #include <CL/sycl.hpp>
+#include <memory>
 #include <utility>
+#include <vector>
 
 namespace bbfft {
 
@@ -23,5 +29,56 @@ auto make_plan(configuration const &cfg, ::sycl::queue q, ::sycl::context c, ::s
         cfg, sycl::api(std::move(q), std::move(c), std::move(d)), cache));
 }
 
+auto make_plan(configuration const &cfg, tuning_candidate const &tc, ::sycl::queue q,
+               jit_cache *cache) -> sycl_plan {
+    return make_plan(cfg, tc, q, q.get_context(), q.get_device(), cache);
+}
+
+auto make_plan(configuration const &cfg, tuning_candidate const &tc, ::sycl::queue q,
+               ::sycl::context c, ::sycl::device d, jit_cache *cache) -> sycl_plan {
+    return sycl_plan(make_tuned_fft<sycl::api>(
+        cfg, tc, sycl::api(std::move(q), std::move(c), std::move(d)), cache));
+}
+
+auto autotune(configuration const &cfg, ::sycl::queue q, jit_cache *cache) -> tuning_candidate {
+    auto api = sycl::api(std::move(q));
+    return autotune_fft<sycl::api>(
+        cfg, api, cache, [&](sycl::api::plan_type &plan, tuning_candidate const &) {
+            return measure_fft(cfg, api, plan);
+        });
+}
+
+auto make_plan(ragged_configuration const &cfg, ::sycl::queue q, jit_cache *cache) -> sycl_plan {
+    return make_plan(cfg, q, q.get_context(), q.get_device(), cache);
+}
+
+auto make_plan(ragged_configuration const &cfg, ::sycl::queue q, ::sycl::context c,
+               ::sycl::device d, jit_cache *cache) -> sycl_plan {
+    return sycl_plan(std::make_shared<ragged_batch_fft<sycl::api>>(
+        cfg, sycl::api(std::move(q), std::move(c), std::move(d)), cache));
+}
+
+auto make_plan(convolution_configuration const &cfg, ::sycl::queue q, jit_cache *cache)
+    -> sycl_convolution_plan {
+    return make_plan(cfg, q, q.get_context(), q.get_device(), cache);
+}
+
+auto make_plan(convolution_configuration const &cfg, ::sycl::queue q, ::sycl::context c,
+               ::sycl::device d, jit_cache *cache) -> sycl_convolution_plan {
+    return sycl_convolution_plan(std::make_shared<convolution_fft<sycl::api>>(
+        cfg, sycl::api(std::move(q), std::move(c), std::move(d)), cache));
+}
+
+auto make_plan_group(std::vector<configuration> const &cfgs, ::sycl::queue q, jit_cache *cache)
+    -> sycl_plan_group {
+    return make_plan_group(cfgs, q, q.get_context(), q.get_device(), cache);
+}
+
+auto make_plan_group(std::vector<configuration> const &cfgs, ::sycl::queue q, ::sycl::context c,
+                     ::sycl::device d, jit_cache *cache) -> sycl_plan_group {
+    return sycl_plan_group(std::make_shared<plan_group_fft<sycl::api>>(
+        cfgs, sycl::api(std::move(q), std::move(c), std::move(d)), cache));
+}
+
 } // namespace bbfft
 
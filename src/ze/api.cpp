@@ -17,6 +17,7 @@ api::api(ze_command_list_handle_t command_list, ze_context_handle_t context,
 device_info api::info() { return get_device_info(device_); }
 
 uint64_t api::device_id() { return get_device_id(device_); }
+uint64_t api::context_id() { return reinterpret_cast<std::uintptr_t>(context_); }
 
 auto api::build_module(std::string const &source) -> shared_handle<module_handle_t> {
     ze_module_handle_t mod = ::bbfft::ze::build_kernel_bundle(
@@ -29,6 +29,8 @@ class api {
 
     using event_type = ze_event_handle_t;
     using plan_type = detail::plan_unmanaged_event_impl<event_type>;
+    using convolution_plan_type = detail::convolution_plan_unmanaged_event_impl<event_type>;
+    using plan_group_type = detail::plan_group_unmanaged_event_impl<event_type>;
     using buffer_type = void *;
     using kernel_bundle_type = ze_module_handle_t;
     using kernel_type = ze_kernel_handle_t;
@@ -37,6 +39,7 @@ class api {
 
     device_info info();
     uint64_t device_id();
+    uint64_t context_id();
 
     auto build_module(std::string const &source) -> shared_handle<module_handle_t>;
     auto make_kernel_bundle(module_handle_t mod) -> kernel_bundle_type;
@@ -4,11 +4,17 @@
 #include "bbfft/plan.hpp"
 #include "algorithm.hpp"
 #include "api.hpp"
+#include "autotuner.hpp"
+#include "bbfft/autotune.hpp"
 #include "bbfft/configuration.hpp"
+#include "bbfft/convolution_configuration.hpp"
 #include "bbfft/jit_cache.hpp"
+#include "bbfft/ragged_configuration.hpp"
 #include "bbfft/ze/make_plan.hpp"
 
 #include <level_zero/ze_api.h>
+#include <memory>
+#include <vector>
 
 namespace bbfft {
 
@@ -19,5 +25,33 @@ auto make_plan(configuration const &cfg, ze_command_list_handle_t queue,
         select_fft_algorithm<ze::api>(cfg, ze::api(queue, context, device), cache));
 }
 
+auto make_plan(configuration const &cfg, tuning_candidate const &tc,
+               ze_command_list_handle_t queue, ze_context_handle_t context,
+               ze_device_handle_t device, jit_cache *cache) -> level_zero_plan {
+    return level_zero_plan(
+        make_tuned_fft<ze::api>(cfg, tc, ze::api(queue, context, device), cache));
+}
+
+auto make_plan(ragged_configuration const &cfg, ze_command_list_handle_t queue,
+               ze_context_handle_t context, ze_device_handle_t device, jit_cache *cache)
+    -> level_zero_plan {
+    return level_zero_plan(std::make_shared<ragged_batch_fft<ze::api>>(
+        cfg, ze::api(queue, context, device), cache));
+}
+
+auto make_plan(convolution_configuration const &cfg, ze_command_list_handle_t queue,
+               ze_context_handle_t context, ze_device_handle_t device, jit_cache *cache)
+    -> level_zero_convolution_plan {
+    return level_zero_convolution_plan(std::make_shared<convolution_fft<ze::api>>(
+        cfg, ze::api(queue, context, device), cache));
+}
+
+auto make_plan_group(std::vector<configuration> const &cfgs, ze_command_list_handle_t queue,
+                     ze_context_handle_t context, ze_device_handle_t device, jit_cache *cache)
+    -> level_zero_plan_group {
+    return level_zero_plan_group(std::make_shared<plan_group_fft<ze::api>>(
+        cfgs, ze::api(queue, context, device), cache));
+}
+
 } // namespace bbfft
 
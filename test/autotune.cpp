@@ -0,0 +1,255 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "autotuner.hpp"
+#include "bbfft/autotune.hpp"
+#include "bbfft/bad_configuration.hpp"
+#include "bbfft/configuration.hpp"
+#include "bbfft/detail/generator_impl.hpp"
+#include "bbfft/jit_cache_all.hpp"
+#include "bbfft/parser.hpp"
+#include "bbfft/wisdom.hpp"
+#include "dummy_api.hpp"
+
+#include "doctest/doctest.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace bbfft;
+
+TEST_CASE("tuning search space") {
+    auto info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+    for (auto const &desc : {"scfo16*64", "srfo32*100", "dcbo4.64*16", "scfo96*8", "srfi7.105*3",
+                             "scfo16*64l4,0"}) {
+        auto cfg = parse_fft_descriptor(desc);
+        auto space = tuning_search_space(cfg, info);
+        REQUIRE(space.size() > 1);
+        CHECK(space.front() == default_tuning_candidate(cfg, info));
+
+        bool is_real = cfg.type != transform_type::c2c;
+        for (auto const &tc : space) {
+            if (tc.algorithm == tuning_algorithm::small_batch) {
+                auto sbc = configure_small_batch_fft(cfg, info, tc);
+                CHECK(sbc.Mb * sbc.Kb <= info.max_work_group_size);
+                CHECK(!(is_real && sbc.inplace_unsupported && sbc.M <= info.max_subgroup_size()));
+            } else if (tc.algorithm == tuning_algorithm::subgroup) {
+                auto sgc = configure_subgroup_fft(cfg, info, tc);
+                CHECK(sgc.sgs * sgc.Kb <= info.max_work_group_size);
+                CHECK(sgc.N % sgc.sgs == 0);
+            } else {
+                REQUIRE(tc.algorithm == tuning_algorithm::factor2_slm);
+                CHECK(cfg.input_length == 0);
+                auto f2c = configure_factor2_slm_fft(cfg, info, tc);
+                CHECK(f2c.Mb * f2c.Nb * f2c.Kb <= info.max_work_group_size);
+            }
+        }
+
+        // Every candidate yields a distinct kernel
+        auto os = std::ostringstream{};
+        auto api = dummy_api(info, &os);
+        auto cache = jit_cache_all{};
+        for (auto const &tc : space) {
+            make_tuned_fft(cfg, tc, api, &cache);
+        }
+        CHECK(cache.kernel_names().size() == space.size());
+    }
+
+    CHECK(tuning_search_space(parse_fft_descriptor("scfo16x16*4"), info).empty());
+    CHECK(tuning_search_space(parse_fft_descriptor("sefo16*4"), info).empty());
+    CHECK(tuning_search_space(parse_fft_descriptor("scfo4099*4"), info).empty());
+    CHECK(default_tuning_candidate(parse_fft_descriptor("scfo16x16*4"), info) ==
+          tuning_candidate{});
+}
+
+TEST_CASE("tuning candidate") {
+    auto info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+    auto cfg = parse_fft_descriptor("scfo16*64");
+
+    auto tc = tuning_candidate{tuning_algorithm::small_batch, 2, 8, 0, 32, {}};
+    auto sbc = configure_small_batch_fft(cfg, info, tc);
+    CHECK(sbc.Mb == 2);
+    CHECK(sbc.Kb == 8);
+    CHECK(sbc.sgs == 32);
+    auto oss = std::ostringstream{};
+    oss << tc;
+    CHECK(oss.str() == "sb_Mb2_Kb8_sgs32");
+
+    CHECK_THROWS_AS(configure_factor2_slm_fft(cfg, info, tc), bad_configuration);
+    tc.sgs = 8;
+    CHECK_THROWS_AS(configure_small_batch_fft(cfg, info, tc), bad_configuration);
+    tc.sgs = 16;
+    tc.Kb = 1024;
+    CHECK_THROWS_AS(configure_small_batch_fft(cfg, info, tc), bad_configuration);
+
+    tc = tuning_candidate{tuning_algorithm::factor2_slm, 1, 1, 4, 16, {4, 4}};
+    auto f2c = configure_factor2_slm_fft(cfg, info, tc);
+    CHECK(f2c.Nb == 4);
+    CHECK(f2c.factorization == std::vector<int>{4, 4});
+    oss = std::ostringstream{};
+    oss << tc;
+    CHECK(oss.str() == "f2_Mb1_Nb4_Kb1_sgs16_f4x4");
+    tc.factorization = {3, 4};
+    CHECK_THROWS_AS(configure_factor2_slm_fft(cfg, info, tc), bad_configuration);
+
+    cfg = parse_fft_descriptor("scfo96*8");
+    tc = tuning_candidate{tuning_algorithm::subgroup, 0, 4, 0, 32, {}};
+    CHECK(default_tuning_candidate(cfg, info) ==
+          tuning_candidate{tuning_algorithm::subgroup, 0, 8, 0, 16, {}});
+    auto sgc = configure_subgroup_fft(cfg, info, tc);
+    CHECK(sgc.Kb == 4);
+    CHECK(sgc.sgs == 32);
+    oss = std::ostringstream{};
+    oss << tc;
+    CHECK(oss.str() == "sg_Kb4_sgs32");
+    tc.sgs = 8;
+    CHECK_THROWS_AS(configure_subgroup_fft(cfg, info, tc), bad_configuration);
+    tc.sgs = 16;
+    CHECK_THROWS_AS(configure_subgroup_fft(parse_fft_descriptor("scfo2.96*8"), info, tc),
+                    bad_configuration);
+
+    auto api = dummy_api(info);
+    CHECK_THROWS_AS(make_tuned_fft(parse_fft_descriptor("scfo16x16*4"),
+                                   tuning_candidate{tuning_algorithm::small_batch, 1, 1, 0, 16},
+                                   api, nullptr),
+                    bad_configuration);
+}
+
+TEST_CASE("autotune") {
+    auto info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+    auto api = dummy_api(info);
+
+    auto cfg = parse_fft_descriptor("scfo16*64");
+    auto space = tuning_search_space(cfg, info);
+    auto const time = [](tuning_candidate const &tc) {
+        return std::abs(static_cast<double>(tc.Kb) - 4.0) + (tc.sgs == 32 ? 0.0 : 0.5) +
+               (tc.algorithm == tuning_algorithm::factor2_slm ? 0.25 : 0.0) +
+               static_cast<double>(tc.Mb);
+    };
+    unsigned num_measured = 0;
+    auto best = autotune_fft(cfg, api, nullptr, [&](dummy_api::plan_type &, tuning_candidate tc) {
+        ++num_measured;
+        return time(tc);
+    });
+    CHECK(num_measured == space.size());
+    CHECK(best == tuning_candidate{tuning_algorithm::small_batch, 1, 4, 0, 32, {}});
+
+    num_measured = 0;
+    best = autotune_fft(parse_fft_descriptor("scfo16x16*4"), api, nullptr,
+                        [&](dummy_api::plan_type &, tuning_candidate tc) {
+                            ++num_measured;
+                            return time(tc);
+                        });
+    CHECK(num_measured == 0);
+    CHECK(best.algorithm == tuning_algorithm::automatic);
+}
+
+TEST_CASE("wisdom") {
+    auto info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+    auto cfg = parse_fft_descriptor("scfo16*64");
+    auto heuristic = default_tuning_candidate(cfg, info);
+    auto sb = tuning_candidate{tuning_algorithm::small_batch, 2, 8, 0, 32, {}};
+    auto rcfg = parse_fft_descriptor("srfo3.32*5");
+    auto f2 = tuning_candidate{tuning_algorithm::factor2_slm, 4, 1, 4, 16, {4, 4}};
+    REQUIRE(heuristic != sb);
+
+    auto w = std::make_shared<wisdom>();
+    w->insert(cfg, info, sb);
+    w->insert(rcfg, info, f2);
+    CHECK(w->size() == 2);
+    CHECK(w->find(cfg, info) == sb);
+    CHECK(w->find(parse_fft_descriptor("scfo16*65"), info) == tuning_candidate{});
+    CHECK(w->find(cfg, device_info{1024, {16}, 128 * 1024, device_type::gpu}) ==
+          tuning_candidate{});
+    CHECK_THROWS_AS(w->insert(parse_fft_descriptor("scfo16x16*4"), info, sb), bad_configuration);
+    auto f2_cfg = tuning_candidate{tuning_algorithm::factor2_slm, 1, 1, 4, 16, {4, 4}};
+    CHECK_THROWS_AS(w->insert(parse_fft_descriptor("scfo16*64l4,0"), info, f2_cfg),
+                    bad_configuration);
+    auto too_large = tuning_candidate{tuning_algorithm::small_batch, 64, 64, 0, 16, {}};
+    CHECK_THROWS_AS(w->insert(cfg, info, too_large), bad_configuration);
+
+    auto oss = std::ostringstream{};
+    w->save(oss);
+    auto w2 = wisdom{};
+    auto iss = std::istringstream(oss.str());
+    w2.load(iss);
+    CHECK(w2.size() == 2);
+    CHECK(w2.find(cfg, info) == sb);
+    CHECK(w2.find(rcfg, info) == f2);
+
+    iss = std::istringstream("# comment\n\n{1024, {16, 32}, 131072, gpu} scfo16*64 auto\n");
+    w2.load(iss);
+    CHECK(w2.size() == 1);
+    for (auto const &malformed : {"{1024, {16, 32}, 131072, gpu scfo16*64 sb_Mb2_Kb8_sgs32",
+                                  "{1024, {16, 32}, 131072, gpu} scfo16*64",
+                                  "{1024, {16, 32}, 131072, gpu} scfo16*64 sb_Mb2_Kb8_sgs32 x",
+                                  "{1024, {16, 32}, 131072, gpu} scfo16*64 sb_Mb2_Kb8"}) {
+        iss = std::istringstream(malformed);
+        CHECK_THROWS_AS(w2.load(iss), std::runtime_error);
+    }
+    // A candidate that cannot be applied is reported with its line and no entry is added
+    iss = std::istringstream("{1024, {16, 32}, 131072, gpu} srfo16*64 sb_Mb2_Kb8_sgs32\n"
+                             "{1024, {16, 32}, 131072, gpu} scfo16*64 sb_Mb64_Kb64_sgs16\n");
+    try {
+        w2.load(iss);
+        FAIL("expected exception");
+    } catch (std::runtime_error const &e) {
+        CHECK(std::string(e.what()).find("Wisdom line 2") != std::string::npos);
+    }
+    CHECK(w2.size() == 1);
+    CHECK(w2.find(parse_fft_descriptor("srfo16*64"), info) == tuning_candidate{});
+
+    // Installed wisdom overrides the heuristics in kernel generation and plan creation
+    set_wisdom(w);
+    CHECK(default_tuning_candidate(cfg, info) == sb);
+    auto sbc = configure_small_batch_fft(cfg, info);
+    CHECK(sbc.Mb == 2);
+    CHECK(sbc.Kb == 8);
+    CHECK(sbc.sgs == 32);
+    auto f2c = configure_factor2_slm_fft(rcfg, info);
+    CHECK(f2c.Mb == 4);
+    CHECK(f2c.Nb == 4);
+
+    auto os = std::ostringstream{};
+    auto api = dummy_api(info, &os);
+    auto cache = jit_cache_all{};
+    make_tuned_fft(cfg, tuning_candidate{}, api, &cache);
+    make_tuned_fft(rcfg, tuning_candidate{}, api, &cache);
+    auto names = cache.kernel_names();
+    REQUIRE(names.size() == 2);
+    auto sb_name = configure_small_batch_fft(cfg, info, sb).identifier();
+    auto f2_name = configure_factor2_slm_fft(rcfg, info, f2).identifier();
+    CHECK(std::find(names.begin(), names.end(), sb_name) != names.end());
+    CHECK(std::find(names.begin(), names.end(), f2_name) != names.end());
+
+    set_wisdom(nullptr);
+    CHECK(get_wisdom() == nullptr);
+    CHECK(default_tuning_candidate(cfg, info) == heuristic);
+}
+
+TEST_CASE("plan group wisdom") {
+    auto info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+    auto cfgs = std::vector<configuration>{parse_fft_descriptor("scfo16*64"),
+                                           parse_fft_descriptor("scbo12*8")};
+    auto w = std::make_shared<wisdom>();
+    w->insert(cfgs[0], info, tuning_candidate{tuning_algorithm::small_batch, 1, 4, 0, 32, {}});
+    set_wisdom(w);
+    REQUIRE(configure_small_batch_fft(cfgs[0], info).sgs == 32);
+    REQUIRE(configure_small_batch_fft(cfgs[1], info).sgs == 16);
+
+    // Members with different sub-group sizes share the smallest one
+    for (auto const &order : {std::vector<std::size_t>{0, 1}, std::vector<std::size_t>{1, 0}}) {
+        auto pgc = configure_plan_group_fft({cfgs[order[0]], cfgs[order[1]]}, info);
+        for (auto const &sbc : pgc.members) {
+            CHECK(sbc.sgs == 16);
+        }
+        auto oss = std::ostringstream{};
+        generate_plan_group_fft(oss, pgc);
+        CHECK(oss.str().find("intel_reqd_sub_group_size(16)") != std::string::npos);
+    }
+    set_wisdom(nullptr);
+}
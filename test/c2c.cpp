@@ -3,12 +3,18 @@
 
 #include "fft.hpp"
 
+#include "bbfft/autotune.hpp"
 #include "bbfft/configuration.hpp"
+#include "bbfft/convolution_configuration.hpp"
+#include "bbfft/ragged_configuration.hpp"
 #include "bbfft/sycl/make_plan.hpp"
 #include "bbfft/tensor_indexer.hpp"
 
+#include <array>
 #include <complex>
+#include <cstdint>
 #include <random>
+#include <utility>
 #include <vector>
 
 using namespace bbfft;
@@ -56,7 +62,22 @@ TEST_CASE_TEMPLATE("c2c forward", T, TEST_PRECISIONS) {
     auto KK = std::vector<std::size_t>{1, 32};
     auto MM = std::vector<std::size_t>{1, 2, 3, 16, 17, 64, 256, 1024};
     auto NN =
-        std::vector<std::size_t>{2, 3, 5, 7, 11, 13, 4, 8, 16, 32, 128, 256, 512, 27, 63, 105, 363};
+        std::vector<std::size_t>{2,  3,   5,   7,   11,  13,  4,   8,   16,
+                                 32, 128, 256, 512, 27,  63,  105, 363, 509};
+
+    std::size_t M, N, K;
+    DOCTEST_TENSOR3_TEST(MM, NN, KK);
+
+    configuration cfg = {1, {M, N, K}, to_precision_v<T>, direction::forward};
+    test_c2c_forward<T>(cfg, Q);
+}
+
+TEST_CASE_TEMPLATE("c2c large forward", T, TEST_PRECISIONS) {
+    auto Q = queue();
+
+    auto KK = std::vector<std::size_t>{1, 2};
+    auto MM = std::vector<std::size_t>{1, 3};
+    auto NN = std::vector<std::size_t>{24576, 65536, 1048576};
 
     std::size_t M, N, K;
     DOCTEST_TENSOR3_TEST(MM, NN, KK);
@@ -81,6 +102,270 @@ TEST_CASE_TEMPLATE("c2c non-packed forward", T, TEST_PRECISIONS) {
     test_c2c_forward<T>(cfg, Q);
 }
 
+TEST_CASE_TEMPLATE("c2c M-strided forward", T, TEST_PRECISIONS) {
+    auto Q = queue();
+
+    auto KK = std::vector<std::size_t>{1, 7};
+    auto MM = std::vector<std::size_t>{1, 3, 16};
+    auto NN = std::vector<std::size_t>{8, 17, 64, 105};
+
+    std::size_t M, N, K;
+    DOCTEST_TENSOR3_TEST(MM, NN, KK);
+
+    std::array<std::size_t, bbfft::max_tensor_dim> stride = {2, 2 * M + 1, (2 * M + 1) * N};
+    configuration cfg = {
+        1, {M, N, K}, to_precision_v<T>, direction::forward, transform_type::c2c, stride, stride};
+    test_c2c_forward<T>(cfg, Q);
+}
+
+TEST_CASE_TEMPLATE("c2c ragged batch forward", T, TEST_PRECISIONS) {
+    auto Q = queue();
+
+    auto lengths = std::vector<std::size_t>{16, 48, 64, 96};
+    auto records = std::vector<ragged_record>{};
+    std::uint64_t offset = 0;
+    for (std::size_t k = 0; k < 13; ++k) {
+        std::uint64_t N = lengths[(5 * k) % lengths.size()];
+        records.emplace_back(ragged_record{offset, N});
+        offset += N;
+    }
+
+    auto r = malloc_device<ragged_record>(records.size(), Q);
+    auto x = malloc_device<std::complex<T>>(offset, Q);
+    auto X = std::vector<std::complex<T>>(offset);
+    Q.copy(records.data(), r, records.size()).wait();
+
+    auto cfg = ragged_configuration{to_precision_v<T>, direction::forward, lengths, records.size(),
+                                    r};
+    auto plan = make_plan(cfg, Q);
+
+    for (std::size_t k = 0; k < records.size(); ++k) {
+        std::size_t off = records[k].offset, N = records[k].N;
+        Q.parallel_for(range{N}, [=](id<1> n) {
+             T arg = (T(tau) / N) * (k % N) * n[0];
+             x[off + n[0]] = std::complex{std::cos(arg), std::sin(arg)} / T(N);
+         }).wait();
+    }
+    plan.execute(x).wait();
+    Q.copy(x, X.data(), offset).wait();
+
+    for (std::size_t k = 0; k < records.size(); ++k) {
+        std::size_t off = records[k].offset, N = records[k].N;
+        double eps = tol<T>(N);
+        for (std::size_t n = 0; n < N; ++n) {
+            T ref = periodic_delta<T>(static_cast<long>(n) - static_cast<long>(k % N), N);
+            REQUIRE(X[off + n].real() == doctest::Approx(ref).epsilon(eps));
+            REQUIRE(X[off + n].imag() == doctest::Approx(T(0.0)).epsilon(eps));
+        }
+    }
+
+    free(x, Q);
+    free(r, Q);
+}
+
+TEST_CASE_TEMPLATE("c2c plan group forward", T, TEST_PRECISIONS) {
+    auto Q = queue();
+
+    auto cfgs = std::vector<configuration>{};
+    for (auto const &shape : std::vector<std::array<std::size_t, 3u>>{
+             {1, 16, 5}, {3, 7, 33}, {16, 13, 2}, {1, 12, 64}, {2, 8, 1}}) {
+        cfgs.push_back({1, {shape[0], shape[1], shape[2]}, to_precision_v<T>, direction::forward});
+    }
+    auto plan = make_plan_group(cfgs, Q);
+
+    auto x = std::vector<std::complex<T> *>{};
+    auto args = std::vector<std::pair<void const *, void *>>{};
+    for (auto const &cfg : cfgs) {
+        std::size_t M = cfg.shape[0], N = cfg.shape[1], K = cfg.shape[2];
+        auto xi = x.emplace_back(malloc_device<std::complex<T>>(M * N * K, Q));
+        args.emplace_back(xi, xi);
+        Q.parallel_for(range{K, N, M}, [=](id<3> idx) {
+             auto k = idx[0], n = idx[1], m = idx[2];
+             T arg = (T(tau) / N) * ((m + k) % N) * n;
+             xi[m + n * M + k * M * N] = std::complex{std::cos(arg), std::sin(arg)} / T(N);
+         }).wait();
+    }
+    plan.execute(args).wait();
+
+    for (std::size_t i = 0; i < cfgs.size(); ++i) {
+        std::size_t M = cfgs[i].shape[0], N = cfgs[i].shape[1], K = cfgs[i].shape[2];
+        auto X = std::vector<std::complex<T>>(M * N * K);
+        Q.copy(x[i], X.data(), X.size()).wait();
+        double eps = tol<T>(N);
+        for (std::size_t k = 0; k < K; ++k) {
+            for (std::size_t n = 0; n < N; ++n) {
+                for (std::size_t m = 0; m < M; ++m) {
+                    long basis_no = (m + k) % N;
+                    T ref = periodic_delta<T>(static_cast<long>(n) - basis_no, N);
+                    REQUIRE(X[m + n * M + k * M * N].real() == doctest::Approx(ref).epsilon(eps));
+                    REQUIRE(X[m + n * M + k * M * N].imag() ==
+                            doctest::Approx(T(0.0)).epsilon(eps));
+                }
+            }
+        }
+        free(x[i], Q);
+    }
+}
+
+TEST_CASE_TEMPLATE("c2c convolution", T, TEST_PRECISIONS) {
+    auto Q = queue();
+
+    auto KK = std::vector<std::size_t>{1, 7};
+    auto MM = std::vector<std::size_t>{1, 3};
+    auto NN = std::vector<std::size_t>{5, 12, 16};
+
+    std::size_t M, N, K;
+    DOCTEST_TENSOR3_TEST(MM, NN, KK);
+
+    auto rd = std::random_device{};
+    auto gen = std::mt19937(rd());
+    auto Y = std::uniform_real_distribution<T>(-1.0, 1.0);
+
+    auto x_ref = std::vector<std::complex<T>>(M * N * K);
+    auto h_ref = std::vector<std::complex<T>>(N);
+    for (auto &x : x_ref) {
+        x = std::complex{Y(gen), Y(gen)};
+    }
+    for (auto &h : h_ref) {
+        h = std::complex{Y(gen), Y(gen)};
+    }
+
+    auto x = malloc_device<std::complex<T>>(x_ref.size(), Q);
+    auto H = malloc_device<std::complex<T>>(N, Q);
+    auto X = std::vector<std::complex<T>>(x_ref.size());
+    Q.copy(x_ref.data(), x, x_ref.size()).wait();
+    Q.copy(h_ref.data(), H, N).wait();
+
+    for (auto type : {convolution_type::convolution, convolution_type::correlation}) {
+        auto cfg = convolution_configuration{to_precision_v<T>, {M, N, K}, type};
+        auto plan = make_plan(cfg, Q);
+        auto y = malloc_device<std::complex<T>>(x_ref.size(), Q);
+        plan.execute(x, H, y).wait();
+        Q.copy(y, X.data(), X.size()).wait();
+        free(y, Q);
+
+        // Reference: backward DFT of the product of the forward DFT and the filter spectrum
+        double eps = tol<T>(N);
+        auto const phase = [N](long j) {
+            double arg = tau * (j % static_cast<long>(N)) / N;
+            return std::complex<double>(std::cos(arg), std::sin(arg));
+        };
+        for (std::size_t k = 0; k < K; ++k) {
+            for (std::size_t m = 0; m < M; ++m) {
+                auto Xf = std::vector<std::complex<double>>(N);
+                for (std::size_t j = 0; j < N; ++j) {
+                    for (std::size_t n = 0; n < N; ++n) {
+                        Xf[j] += std::complex<double>(x_ref[m + n * M + k * M * N]) *
+                                 std::conj(phase(j * n));
+                    }
+                    auto h = std::complex<double>(h_ref[j]);
+                    Xf[j] *= type == convolution_type::correlation ? std::conj(h) : h;
+                }
+                for (std::size_t n = 0; n < N; ++n) {
+                    auto ref = std::complex<double>{};
+                    for (std::size_t j = 0; j < N; ++j) {
+                        ref += Xf[j] * phase(j * n);
+                    }
+                    auto const &got = X[m + n * M + k * M * N];
+                    REQUIRE(got.real() == doctest::Approx(ref.real()).epsilon(eps).scale(N));
+                    REQUIRE(got.imag() == doctest::Approx(ref.imag()).epsilon(eps).scale(N));
+                }
+            }
+        }
+    }
+
+    free(H, Q);
+    free(x, Q);
+}
+
+TEST_CASE_TEMPLATE("c2c normalized identity", T, TEST_PRECISIONS) {
+    auto Q = queue();
+
+    auto KK = std::vector<std::size_t>{3};
+    auto MM = std::vector<std::size_t>{1, 5};
+    auto NN = std::vector<std::size_t>{16, 105, 1021};
+
+    std::size_t M, N, K;
+    DOCTEST_TENSOR3_TEST(MM, NN, KK);
+
+    auto rd = std::random_device{};
+    auto gen = std::mt19937(rd());
+    auto Y = std::uniform_real_distribution<T>(0.0, 1.0);
+
+    std::size_t size = M * N * K;
+    auto x_ref = std::vector<std::complex<T>>(size);
+    auto x_host = std::vector<std::complex<T>>(size);
+    auto x_device = malloc_device<std::complex<T>>(size, Q);
+
+    configuration cfg = {1, {M, N, K}, to_precision_v<T>, direction::forward};
+    auto plan = make_plan(cfg, Q);
+    cfg.dir = direction::backward;
+    cfg.scale = 1.0 / N;
+    auto iplan = make_plan(cfg, Q);
+
+    for (auto &x : x_ref) {
+        x = std::complex{Y(gen), Y(gen)};
+    }
+
+    Q.copy(x_ref.data(), x_device, size).wait();
+    plan.execute(x_device).wait();
+    iplan.execute(x_device).wait();
+    Q.copy(x_device, x_host.data(), size).wait();
+
+    double eps = tol<T>(N);
+    for (std::size_t j = 0; j < size; ++j) {
+        REQUIRE(x_host[j].real() == doctest::Approx(x_ref[j].real()).epsilon(eps));
+        REQUIRE(x_host[j].imag() == doctest::Approx(x_ref[j].imag()).epsilon(eps));
+    }
+
+    free(x_device, Q);
+}
+
+TEST_CASE_TEMPLATE("c2c tuned identity", T, TEST_PRECISIONS) {
+    auto Q = queue();
+
+    auto KK = std::vector<std::size_t>{3};
+    auto MM = std::vector<std::size_t>{1, 5};
+    auto NN = std::vector<std::size_t>{16, 96};
+
+    std::size_t M, N, K;
+    DOCTEST_TENSOR3_TEST(MM, NN, KK);
+
+    auto rd = std::random_device{};
+    auto gen = std::mt19937(rd());
+    auto Y = std::uniform_real_distribution<T>(0.0, 1.0);
+
+    std::size_t size = M * N * K;
+    auto x_ref = std::vector<std::complex<T>>(size);
+    auto x_host = std::vector<std::complex<T>>(size);
+    auto x_device = malloc_device<std::complex<T>>(size, Q);
+
+    configuration cfg = {1, {M, N, K}, to_precision_v<T>, direction::forward};
+    auto tc = autotune(cfg, Q);
+    REQUIRE(tc.algorithm != tuning_algorithm::automatic);
+    auto plan = make_plan(cfg, tc, Q);
+    cfg.dir = direction::backward;
+    cfg.scale = 1.0 / N;
+    auto iplan = make_plan(cfg, Q);
+
+    for (auto &x : x_ref) {
+        x = std::complex{Y(gen), Y(gen)};
+    }
+
+    Q.copy(x_ref.data(), x_device, size).wait();
+    plan.execute(x_device).wait();
+    iplan.execute(x_device).wait();
+    Q.copy(x_device, x_host.data(), size).wait();
+
+    double eps = tol<T>(N);
+    for (std::size_t j = 0; j < size; ++j) {
+        REQUIRE(x_host[j].real() == doctest::Approx(x_ref[j].real()).epsilon(eps));
+        REQUIRE(x_host[j].imag() == doctest::Approx(x_ref[j].imag()).epsilon(eps));
+    }
+
+    free(x_device, Q);
+}
+
 TEST_CASE_TEMPLATE("c2c identity", T, TEST_PRECISIONS) {
     auto Q = queue();
 
@@ -7,8 +7,10 @@
 #include "bbfft/sycl/make_plan.hpp"
 #include "bbfft/tensor_indexer.hpp"
 
+#include <array>
 #include <complex>
 #include <cstdio>
+#include <limits>
 #include <random>
 #include <vector>
 
@@ -200,3 +202,147 @@ void store(global %s2* out, size_t offset, %s2 value) {
     delete[] X;
     free(X_d, Q);
 }
+
+TEST_CASE_TEMPLATE("2d store callback", T, TEST_PRECISIONS) {
+    auto Q = queue();
+
+    auto shapes = std::vector<std::array<std::size_t, 4u>>{{1, 16, 16, 4}, {3, 512, 3, 2}};
+    for (auto const &shape : shapes) {
+        auto xi = tensor_indexer<std::size_t, 4u, layout::col_major>(shape);
+        auto x = new std::complex<T>[xi.size()];
+        auto x_d = malloc_device<std::complex<T>>(xi.size(), Q);
+        auto X_ref = new std::complex<T>[xi.size()];
+        auto X_ref_d = malloc_device<std::complex<T>>(xi.size(), Q);
+        auto X = new std::complex<T>[xi.size()];
+        auto X_d = malloc_device<std::complex<T>>(xi.size(), Q);
+
+        auto const stride = fit_array<bbfft::max_tensor_dim>(xi.stride());
+        configuration cfg_ref = {2,
+                                 {shape[0], shape[1], shape[2], shape[3]},
+                                 to_precision_v<T>,
+                                 direction::forward,
+                                 transform_type::c2c,
+                                 stride,
+                                 stride};
+        auto plan_ref = make_plan(cfg_ref, Q);
+
+        char const store_template[] = R"OpenCL(
+void store(global %s2* out, size_t offset, %s2 value) {
+    out[offset] = value * ((%s) %a);
+})OpenCL";
+        char store[1024];
+        char const *real_type = std::is_same_v<double, T> ? "double" : "float";
+        double const scale = 1.0 / (shape[1] * shape[2]);
+        std::size_t length = snprintf(store, sizeof(store), store_template, real_type, real_type,
+                                      real_type, scale);
+
+        configuration cfg = cfg_ref;
+        cfg.callbacks = {store, length, nullptr, "store"};
+        auto plan = make_plan(cfg, Q);
+
+        auto rd = std::random_device{};
+        auto gen = std::mt19937(rd());
+        auto Y = std::uniform_real_distribution<T>(0.0, 1.0);
+        for (std::size_t j = 0; j < xi.size(); ++j) {
+            x[j] = std::complex<T>{Y(gen), Y(gen)};
+        }
+
+        Q.copy(x, x_d, xi.size()).wait();
+        plan_ref.execute(x_d, X_ref_d).wait();
+        plan.execute(x_d, X_d).wait();
+        Q.copy(X_ref_d, X_ref, xi.size()).wait();
+        Q.copy(X_d, X, xi.size()).wait();
+
+        auto const eps = 10 * std::numeric_limits<T>::epsilon();
+        for (std::size_t j = 0; j < xi.size(); ++j) {
+            auto ref = X_ref[j] * T(scale);
+            REQUIRE(std::abs(ref - X[j]) <= eps * std::abs(ref) + eps);
+        }
+
+        delete[] x;
+        free(x_d, Q);
+        delete[] X_ref;
+        free(X_ref_d, Q);
+        delete[] X;
+        free(X_d, Q);
+    }
+}
+
+TEST_CASE_TEMPLATE("2d load callback with strides", T, TEST_PRECISIONS) {
+    auto Q = queue();
+
+    // The user callback is chained behind the generated callbacks of the padded layouts
+    auto shapes = std::vector<std::array<std::size_t, 4u>>{{1, 16, 16, 4}, {3, 24, 5, 2}};
+    for (auto const &shape : shapes) {
+        auto const istride = std::array<std::size_t, max_tensor_dim>{
+            1, shape[0] + 1, (shape[0] + 1) * (shape[1] + 2),
+            (shape[0] + 1) * (shape[1] + 2) * shape[2]};
+        auto const ostride = std::array<std::size_t, max_tensor_dim>{
+            1, shape[0], shape[0] * shape[1] + 3, (shape[0] * shape[1] + 3) * (shape[2] + 1)};
+        std::size_t const isize = istride[3] * shape[3];
+        std::size_t const osize = ostride[3] * shape[3];
+        auto x = new std::complex<T>[isize];
+        auto x_d = malloc_device<std::complex<T>>(isize, Q);
+        auto X_ref = new std::complex<T>[osize];
+        auto X_ref_d = malloc_device<std::complex<T>>(osize, Q);
+        auto X = new std::complex<T>[osize];
+        auto X_d = malloc_device<std::complex<T>>(osize, Q);
+
+        configuration cfg_ref = {2,
+                                 {shape[0], shape[1], shape[2], shape[3]},
+                                 to_precision_v<T>,
+                                 direction::forward,
+                                 transform_type::c2c,
+                                 istride,
+                                 ostride};
+        auto plan_ref = make_plan(cfg_ref, Q);
+
+        char const load_template[] = R"OpenCL(
+%s2 load(global %s2* in, size_t offset) {
+    return in[offset] * ((%s) %a);
+})OpenCL";
+        char load[1024];
+        char const *real_type = std::is_same_v<double, T> ? "double" : "float";
+        double const scale = 1.0 / (shape[1] * shape[2]);
+        std::size_t length = snprintf(load, sizeof(load), load_template, real_type, real_type,
+                                      real_type, scale);
+
+        configuration cfg = cfg_ref;
+        cfg.callbacks = {load, length, "load"};
+        auto plan = make_plan(cfg, Q);
+
+        auto rd = std::random_device{};
+        auto gen = std::mt19937(rd());
+        auto Y = std::uniform_real_distribution<T>(0.0, 1.0);
+        for (std::size_t j = 0; j < isize; ++j) {
+            x[j] = std::complex<T>{Y(gen), Y(gen)};
+        }
+
+        Q.copy(x, x_d, isize).wait();
+        plan_ref.execute(x_d, X_ref_d).wait();
+        plan.execute(x_d, X_d).wait();
+        Q.copy(X_ref_d, X_ref, osize).wait();
+        Q.copy(X_d, X, osize).wait();
+
+        auto const eps = 100 * std::numeric_limits<T>::epsilon();
+        for (std::size_t k = 0; k < shape[3]; ++k) {
+            for (std::size_t n2 = 0; n2 < shape[2]; ++n2) {
+                for (std::size_t n1 = 0; n1 < shape[1]; ++n1) {
+                    for (std::size_t m = 0; m < shape[0]; ++m) {
+                        auto const i =
+                            m * ostride[0] + n1 * ostride[1] + n2 * ostride[2] + k * ostride[3];
+                        auto ref = X_ref[i] * T(scale);
+                        REQUIRE(std::abs(ref - X[i]) <= eps * std::abs(ref) + eps);
+                    }
+                }
+            }
+        }
+
+        delete[] x;
+        free(x_d, Q);
+        delete[] X_ref;
+        free(X_ref_d, Q);
+        delete[] X;
+        free(X_d, Q);
+    }
+}
@@ -1,13 +1,21 @@
 // Copyright (C) 2022 Intel Corporation
 // SPDX-License-Identifier: BSD-3-Clause
 
+#include "bbfft/bad_configuration.hpp"
 #include "bbfft/configuration.hpp"
+#include "bbfft/convolution_configuration.hpp"
 #include "bbfft/detail/generator_impl.hpp"
+#include "bbfft/generator.hpp"
+#include "bbfft/parser.hpp"
 #include "math.hpp"
 #include "prime_factorization.hpp"
 #include "scrambler.hpp"
 
 #include "doctest/doctest.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <sstream>
 #include <vector>
 
 using namespace bbfft;
@@ -98,6 +106,14 @@ TEST_CASE("math") {
 }
 
 TEST_CASE("prime factorization") {
+    CHECK(primitive_root(2) == 1);
+    CHECK(primitive_root(3) == 2);
+    CHECK(primitive_root(7) == 3);
+    CHECK(primitive_root(17) == 3);
+    CHECK(primitive_root(23) == 5);
+    CHECK(primitive_root(31) == 3);
+    CHECK(primitive_root(61) == 2);
+
     CHECK(factor(4096, 0) == std::vector<unsigned>{});
     CHECK(factor(4096, 1) == std::vector<unsigned>{4096});
     CHECK(factor(4096, 2) == std::vector<unsigned>{64, 64});
@@ -147,4 +163,554 @@ TEST_CASE("identifier") {
                                          nullptr};
     CHECK(f2c.identifier() ==
           "f2fft_p1_M1_Mb1_N512_factorization16x32_Nb16_Kb1_sgs16_f64_c2c_is1_1_512_os1_1_512_in1");
+
+    auto blc = bluestein_configuration{
+        -1,           1,           1,      509,    1024, 128, precision::f32, transform_type::c2c,
+        {1, 1, 509}, {1, 1, 509}, nullptr, nullptr};
+    CHECK(blc.identifier() == "bluestein_m1_M1_Mb1_N509_Nb128_f32_c2c_is1_1_509_os1_1_509_L1024");
+
+    auto fsc = four_step_configuration{-1, 3, 2048, 1024, precision::f64};
+    CHECK(fsc.identifier() == "four_step_m1_M3_N2048x1024_f64");
+
+    auto nsc = nd_slm_configuration{-1,
+                                    2,
+                                    5,
+                                    8,
+                                    {16, 32, 0},
+                                    32,
+                                    16,
+                                    precision::f32,
+                                    {1, 5, 80, 2560},
+                                    {1, 5, 80, 2560},
+                                    nullptr,
+                                    nullptr};
+    CHECK(nsc.identifier() ==
+          "ndslmfft_m1_M5_Mb8_N16x32_Nt32_sgs16_f32_is1_5_80_2560_os1_5_80_2560");
+}
+
+TEST_CASE("four step") {
+    auto info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+    auto const make_cfg = [](std::size_t N) {
+        return configuration{1, {1, N, 1}, precision::f32};
+    };
+    CHECK(!prefer_four_step_fft(make_cfg(4096), info));
+    CHECK(prefer_four_step_fft(make_cfg(32768), info));
+
+    auto fsc = configure_four_step_fft(make_cfg(1 << 20), info);
+    CHECK(fsc.N1 == 1024);
+    CHECK(fsc.N2 == 1024);
+    fsc = configure_four_step_fft(make_cfg(1 << 21), info);
+    CHECK(fsc.N1 == 2048);
+    CHECK(fsc.N2 == 1024);
+    fsc = configure_four_step_fft(make_cfg(24576), info);
+    CHECK(fsc.N1 * fsc.N2 == 24576);
+    CHECK(fsc.N2 == 128);
+}
+
+TEST_CASE("subgroup") {
+    auto info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+    auto const make_cfg = [](std::size_t M, std::size_t N) {
+        return configuration{1, {M, N, 100}, precision::f32};
+    };
+    CHECK(!prefer_subgroup_fft(make_cfg(1, 16), info));
+    CHECK(prefer_subgroup_fft(make_cfg(1, 32), info));
+    CHECK(prefer_subgroup_fft(make_cfg(1, 512), info));
+    CHECK(!prefer_subgroup_fft(make_cfg(1, 1024), info));
+    CHECK(!prefer_subgroup_fft(make_cfg(1, 100), info));
+    CHECK(!prefer_subgroup_fft(make_cfg(2, 64), info));
+    auto cfg = make_cfg(1, 64);
+    cfg.type = transform_type::r2c;
+    cfg.set_strides_default(false);
+    CHECK(!prefer_subgroup_fft(cfg, info));
+
+    auto sgc = configure_subgroup_fft(make_cfg(1, 256), info);
+    CHECK(sgc.sgs == 16);
+    CHECK(sgc.Kb == 8);
+    CHECK(sgc.identifier() == "sgfft_m1_N256_Kb8_sgs16_f32_is1_1_256_os1_1_256_");
+    sgc = configure_subgroup_fft(make_cfg(1, 480), info);
+    CHECK(sgc.sgs == 32);
+    CHECK(sgc.Kb == 4);
+    CHECK_THROWS_AS(configure_subgroup_fft(make_cfg(1, 1024), info), bad_configuration);
+
+    // Data is exchanged with shuffles only
+    auto oss = std::ostringstream{};
+    generate_subgroup_fft(oss, sgc);
+    auto code = oss.str();
+    CHECK(code.find("intel_sub_group_shuffle_xor") != std::string::npos);
+    CHECK(code.find("local ") == std::string::npos);
+    CHECK(code.find("barrier") == std::string::npos);
+}
+
+TEST_CASE("kernel statistics") {
+    auto info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+    auto stats = generate_fft_kernel_statistics(
+        {parse_fft_descriptor("scfo256*100"), parse_fft_descriptor("scfo2.256*100")}, info);
+    REQUIRE(stats.size() == 2);
+    auto const by_name = [](kernel_statistics const &a, kernel_statistics const &b) {
+        return a.name < b.name;
+    };
+    std::sort(stats.begin(), stats.end(), by_name);
+
+    auto const &f2 = stats[0];
+    CHECK(f2.name.find("f2fft") == 0);
+    CHECK(f2.flops > 0);
+    CHECK(f2.local_loads > 0);
+    CHECK(f2.local_stores > 0);
+    CHECK(f2.barriers > 0);
+    CHECK(f2.local_memory_bytes > 0);
+
+    auto const &sg = stats[1];
+    CHECK(sg.name.find("sgfft") == 0);
+    CHECK(sg.flops > 0);
+    CHECK(sg.global_loads == 16);
+    CHECK(sg.global_stores == 16);
+    CHECK(sg.local_loads == 0);
+    CHECK(sg.local_stores == 0);
+    CHECK(sg.barriers == 0);
+    CHECK(sg.sub_group_shuffles == 4 * 16);
+    CHECK(sg.private_array_bytes >= 16 * 8);
+    CHECK(sg.local_memory_bytes == 0);
+}
+
+TEST_CASE("rader flops") {
+    auto info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+    auto const flops_per_p2 = [&](char const *desc, double p) {
+        auto stats = generate_fft_kernel_statistics({parse_fft_descriptor(desc)}, info);
+        REQUIRE(stats.size() == 1);
+        return stats[0].flops / (p * p);
+    };
+    // 23 - 1 = 2 * 11, hence 23 uses the direct sum with O(p^2) flops
+    auto const direct = flops_per_p2("scfo23*4", 23);
+    CHECK(flops_per_p2("scfo17*4", 17) < 0.7 * direct);
+    CHECK(flops_per_p2("scfo31*2", 31) < 0.7 * direct);
+}
+
+TEST_CASE("nd slm") {
+    auto info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+    auto cfg = configuration{3, {1, 8, 8, 8, 100}, precision::f32};
+    CHECK(prefer_nd_slm_fft(cfg, info));
+    auto nsc = configure_nd_slm_fft(cfg, info);
+    CHECK(nsc.Mb == 1);
+    CHECK(nsc.Nt == 64);
+
+    cfg = configuration{2, {7, 16, 16, 10}, precision::f32};
+    CHECK(prefer_nd_slm_fft(cfg, info));
+    nsc = configure_nd_slm_fft(cfg, info);
+    CHECK(nsc.Mb == 8);
+    CHECK(nsc.Nt == 16);
+
+    CHECK(!prefer_nd_slm_fft(configuration{2, {1, 256, 256, 1}, precision::f32}, info));
+    CHECK(!prefer_nd_slm_fft(configuration{1, {1, 64, 1}, precision::f32}, info));
+    CHECK(!prefer_nd_slm_fft(
+        configuration{2, {1, 16, 16, 1}, precision::f32, direction::forward, transform_type::r2c},
+        info));
+}
+
+TEST_CASE("layout callback") {
+    auto lc = layout_callback_configuration{
+        2, {1, 512, 3, 2}, {1, 520, 1600, 5000}, precision::f32, true};
+    CHECK(lc.identifier() == "layout_c_f32_s1x512x3x2_st1_520_1600_5000");
+
+    auto ss = std::ostringstream{};
+    generate_layout_load_callback(ss, lc, "load");
+    CHECK(ss.str() == "float2 load(global float2* in, size_t offset) {\n"
+                      "    return in[offset % 512u * 520u + offset / 512u % 3u * 1600u + "
+                      "offset / 1536u * 5000u];\n"
+                      "}\n");
+
+    lc.fp = precision::f64;
+    lc.is_complex = false;
+    ss = std::ostringstream{};
+    generate_layout_store_callback(ss, lc, "store");
+    CHECK(ss.str() == "void store(global double* out, size_t offset, double value) {\n"
+                      "    out[offset % 512u * 520u + offset / 512u % 3u * 1600u + "
+                      "offset / 1536u * 5000u] = value;\n"
+                      "}\n");
+
+    lc.user_function = "user_store";
+    CHECK(lc.identifier() == "layout_r_f64_s1x512x3x2_st1_520_1600_5000_user_store");
+    ss = std::ostringstream{};
+    generate_layout_store_callback(ss, lc, "store");
+    CHECK(ss.str() == "void store(global double* out, size_t offset, double value) {\n"
+                      "    user_store(out, offset % 512u * 520u + offset / 512u % 3u * 1600u + "
+                      "offset / 1536u * 5000u, value);\n"
+                      "}\n");
+}
+
+TEST_CASE("r2r") {
+    auto cfg = configuration{1, {3, 17, 5}, precision::f64, direction::backward,
+                             transform_type::dst3};
+    auto rc = configure_r2r_fft(cfg);
+    CHECK(rc.identifier() == "r2r_dst3_M3_N17_f64_is1_3_51_os1_3_51");
+    auto inner = r2r_fft_inner_configuration(rc, 5);
+    CHECK(inner.type == transform_type::c2r);
+    CHECK(inner.istride[2] == 27);
+    CHECK(inner.ostride[2] == 51);
+
+    cfg.dir = direction::forward;
+    CHECK_THROWS_AS(configure_r2r_fft(cfg), bad_configuration);
+    cfg = configuration{2, {1, 8, 8, 1}, precision::f32, direction::forward, transform_type::dct2};
+    CHECK_THROWS_AS(configure_r2r_fft(cfg), bad_configuration);
+}
+
+TEST_CASE("16-bit storage") {
+    auto info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+    auto cfg = configuration{1, {1, 16, 3}, precision::f16, direction::forward};
+    auto sbc = configure_small_batch_fft(cfg, info);
+    CHECK(sbc.identifier() == "sbfft_m1_M1_Mb1_N16_Kb3_sgs16_f16_c2c_is1_1_16_os1_1_16_in0");
+    auto oss = std::ostringstream{};
+    generate_small_batch_fft(oss, sbc);
+    auto code = oss.str();
+    CHECK(code.find("global half* in") != std::string::npos);
+    CHECK(code.find("vload_half2") != std::string::npos);
+    CHECK(code.find("vstore_half2") != std::string::npos);
+    CHECK(code.find("float2 x[16]") != std::string::npos);
+    CHECK(code.find("cl_intel_bfloat16_conversions") == std::string::npos);
+
+    cfg = configuration{1, {1, 16, 3}, precision::bf16, direction::forward, transform_type::r2c};
+    cfg.set_strides_default(false);
+    sbc = configure_small_batch_fft(cfg, info);
+    CHECK(sbc.identifier() == "sbfft_m1_M1_Mb1_N16_Kb3_sgs16_bf16_r2c_is1_1_16_os1_1_9_in0");
+    oss = std::ostringstream{};
+    generate_small_batch_fft(oss, sbc);
+    code = oss.str();
+    CHECK(code.find("global ushort* in") != std::string::npos);
+    CHECK(code.find("intel_convert_as_bfloat16_float") != std::string::npos);
+    CHECK(code.find("intel_convert_bfloat162_as_ushort2") != std::string::npos);
+    // Only bf16 kernels enable the bfloat16 conversions
+    CHECK(code.find("#pragma OPENCL EXTENSION cl_intel_bfloat16_conversions : enable") == 0);
+
+    cfg = configuration{1, {1, 1021, 1}, precision::f16, direction::forward};
+    CHECK_THROWS_AS(configure_bluestein_fft(cfg, info), bad_configuration);
+    CHECK_THROWS_AS(configure_four_step_fft(cfg, info), bad_configuration);
+}
+
+TEST_CASE("planar layout") {
+    auto info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+    auto cfg = configuration{1, {1, 16, 3}, precision::f32, direction::forward,
+                             transform_type::r2c};
+    cfg.set_strides_default(false);
+    cfg.planar_offset = {0, 100};
+    auto sbc = configure_small_batch_fft(cfg, info);
+    CHECK(sbc.identifier() ==
+          "sbfft_m1_M1_Mb1_N16_Kb3_sgs16_f32_r2c_is1_1_16_os1_1_9_in0_pl01");
+    // The offset is a run-time property of the tensor
+    cfg.planar_offset = {0, 512};
+    CHECK(configure_small_batch_fft(cfg, info).identifier() == sbc.identifier());
+    auto oss = std::ostringstream{};
+    generate_small_batch_fft(oss, sbc);
+    auto code = oss.str();
+    CHECK(code.find("global float* in") != std::string::npos);
+    CHECK(code.find("global float* out") != std::string::npos);
+    CHECK(code.find("global float* out_im") != std::string::npos);
+    CHECK(code.find("in_im") == std::string::npos);
+
+    cfg = configuration{1, {1, 1021, 1}, precision::f32, direction::forward};
+    cfg.planar_offset = {1024, 1024};
+    CHECK_THROWS_AS(configure_bluestein_fft(cfg, info), bad_configuration);
+    CHECK_THROWS_AS(configure_four_step_fft(cfg, info), bad_configuration);
+}
+
+TEST_CASE("scale") {
+    auto info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+    auto cfg = configuration{1, {1, 16, 3}, precision::f32, direction::backward};
+    auto sbc = configure_small_batch_fft(cfg, info);
+    cfg.scale = 0.0625;
+    auto sbc_scaled = configure_small_batch_fft(cfg, info);
+    CHECK(sbc_scaled.identifier() == sbc.identifier() + "_sc3fb0000000000000");
+    auto oss = std::ostringstream{};
+    generate_small_batch_fft(oss, sbc_scaled);
+    CHECK(oss.str().find("* 0x1p-4f") != std::string::npos);
+
+    cfg.shape = {1, 105, 3};
+    auto f2c = configure_factor2_slm_fft(cfg, info);
+    CHECK(f2c.identifier().find("_sc3fb0000000000000") != std::string::npos);
+    oss = std::ostringstream{};
+    generate_factor2_slm_fft(oss, f2c);
+    CHECK(oss.str().find("* 0x1p-4f") != std::string::npos);
+
+    cfg = configuration{2, {1, 8, 8, 1}, precision::f64, direction::backward};
+    cfg.scale = 0.5;
+    auto ndc = configure_nd_slm_fft(cfg, info);
+    CHECK(ndc.identifier().find("_sc3fe0000000000000") != std::string::npos);
+    oss = std::ostringstream{};
+    generate_nd_slm_fft(oss, ndc);
+    CHECK(oss.str().find("* 0x1p-1") != std::string::npos);
+}
+
+TEST_CASE("pruned") {
+    auto info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+    auto cfg = configuration{1, {1, 16, 3}, precision::f32, direction::forward};
+    auto sbc = configure_small_batch_fft(cfg, info);
+    auto oss = std::ostringstream{};
+    generate_small_batch_fft(oss, sbc);
+    auto const full = oss.str();
+
+    cfg.input_length = 4;
+    cfg.output_length = 8;
+    auto sbc_pruned = configure_small_batch_fft(cfg, info);
+    CHECK(sbc_pruned.identifier() == sbc.identifier() + "_li4_lo8");
+    oss = std::ostringstream{};
+    generate_small_batch_fft(oss, sbc_pruned);
+    CHECK(oss.str().size() < full.size());
+
+    cfg.input_length = 16;
+    cfg.output_length = 16;
+    CHECK(configure_small_batch_fft(cfg, info).identifier() == sbc.identifier());
+    cfg.input_length = 17;
+    CHECK_THROWS_AS(configure_small_batch_fft(cfg, info), bad_configuration);
+    cfg.input_length = 4;
+    cfg.type = transform_type::r2c;
+    CHECK_THROWS_AS(configure_small_batch_fft(cfg, info), bad_configuration);
+}
+
+TEST_CASE("M-mode stride") {
+    auto info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+    auto cfg = configuration{1,
+                             {4, 16, 3},
+                             precision::f32,
+                             direction::forward,
+                             transform_type::c2c,
+                             {2, 8, 128},
+                             {1, 4, 64}};
+    auto sbc = configure_small_batch_fft(cfg, info);
+    CHECK(sbc.identifier().find("_is2_8_128_os1_4_64_") != std::string::npos);
+    auto oss = std::ostringstream{};
+    generate_small_batch_fft(oss, sbc);
+    CHECK(oss.str().find("m_in * 2u") != std::string::npos);
+
+    cfg = configuration{1,
+                        {4, 64, 3},
+                        precision::f32,
+                        direction::forward,
+                        transform_type::c2c,
+                        {3, 12, 768},
+                        {3, 12, 768}};
+    auto f2c = configure_factor2_slm_fft(cfg, info);
+    CHECK(f2c.identifier().find("_is3_12_768_os3_12_768_") != std::string::npos);
+    oss = std::ostringstream{};
+    generate_factor2_slm_fft(oss, f2c);
+    CHECK(oss.str().find("mm * 3u") != std::string::npos);
+}
+
+TEST_CASE("dense block copy") {
+    auto info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+    auto const generate = [&info](configuration const &cfg) {
+        auto oss = std::ostringstream{};
+        generate_small_batch_fft(oss, configure_small_batch_fft(cfg, info));
+        return oss.str();
+    };
+
+    // Dense input and output use flat loops with block reads and writes for full sub-groups
+    auto cfg = configuration{1, {1, 16, 1000}, precision::f32};
+    auto src = generate(cfg);
+    CHECK(src.find("intel_sub_group_block_read4") != std::string::npos);
+    CHECK(src.find("intel_sub_group_block_write4") != std::string::npos);
+    CHECK(src.find("m_local") == std::string::npos);
+
+    cfg.type = transform_type::r2c;
+    cfg.set_strides_default(false);
+    src = generate(cfg);
+    CHECK(src.find("intel_sub_group_block_read4") != std::string::npos);
+    CHECK(src.find("m_local") == std::string::npos);
+
+    // Padded input falls back to the element-wise copy
+    cfg.istride = {1, 1, 18};
+    src = generate(cfg);
+    CHECK(src.find("intel_sub_group_block_read4") == std::string::npos);
+    CHECK(src.find("m_local") != std::string::npos);
+
+    // Pruned input is never dense
+    cfg = configuration{1, {1, 16, 1000}, precision::f32};
+    cfg.input_length = 8;
+    src = generate(cfg);
+    CHECK(src.find("intel_sub_group_block_read4") == std::string::npos);
+}
+
+TEST_CASE("ragged batch") {
+    auto info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+    auto cfg = ragged_configuration{precision::f32, direction::forward, {96, 48, 64, 80, 64}, 5,
+                                    nullptr};
+    auto rbc = configure_ragged_batch_fft(cfg, info);
+    CHECK(rbc.lengths == std::vector<std::size_t>{48, 64, 80, 96});
+    CHECK(rbc.identifier() == "rbfft_m1_N48f6x8_N64f8x8_N80f8x10_N96f8x12_Nb16_sgs16_f32");
+    auto oss = std::ostringstream{};
+    generate_ragged_batch_fft(oss, rbc);
+    auto code = oss.str();
+    CHECK(code.find("global ulong2* records") != std::string::npos);
+    CHECK(code.find("constant float2* twiddle") != std::string::npos);
+    CHECK(code.find("local float2 X1[96]") != std::string::npos);
+    for (auto N : rbc.lengths) {
+        CHECK(code.find("record.y == " + std::to_string(N) + "u") != std::string::npos);
+    }
+
+    std::size_t table_size = 0;
+    for (std::size_t i = 0; i < rbc.lengths.size(); ++i) {
+        auto rc = ragged_batch_record_configuration(rbc, i);
+        CHECK(rc.N == rbc.lengths[i]);
+        table_size += factor2_slm_twiddle_table(rc).size();
+    }
+    CHECK(ragged_batch_twiddle_table(rbc).size() == table_size);
+
+    cfg.lengths = {};
+    CHECK_THROWS_AS(configure_ragged_batch_fft(cfg, info), bad_configuration);
+    cfg.lengths = {64, 1021};
+    CHECK_THROWS_AS(configure_ragged_batch_fft(cfg, info), bad_configuration);
+    cfg.lengths = {64};
+    cfg.fp = precision::f16;
+    CHECK_THROWS_AS(configure_ragged_batch_fft(cfg, info), bad_configuration);
+}
+
+TEST_CASE("plan group") {
+    auto info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+    auto cfgs = std::vector<configuration>{
+        {1, {1, 16, 5}, precision::f32, direction::forward},
+        {1, {5, 15, 3}, precision::f64, direction::forward, transform_type::r2c},
+        {1, {2, 7, 33}, precision::f32, direction::backward}};
+    auto pgc = configure_plan_group_fft(cfgs, info);
+    REQUIRE(pgc.members.size() == 3);
+    CHECK(pgc.K == std::vector<std::size_t>{5, 3, 33});
+    for (auto const &sbc : pgc.members) {
+        CHECK(sbc.Mb == 8);
+        CHECK(sbc.Kb == 16);
+    }
+    CHECK(pgc.num_groups == std::vector<std::size_t>{1, 1, 3});
+    CHECK(pgc.members[1].inplace_unsupported == false);
+    auto oss = std::ostringstream{};
+    generate_plan_group_fft(oss, pgc);
+    auto code = oss.str();
+    CHECK(code.find("global float2* in_0, global float2* out_0, ulong K_0, global double* in_1, "
+                    "global double2* out_1, ulong K_1, global float2* in_2, global float2* out_2, "
+                    "ulong K_2") != std::string::npos);
+    // The batch sizes are kernel arguments and the identifier is bounded
+    auto id = pgc.identifier();
+    CHECK(id.substr(0, 9) == "pgfft_n3_");
+    CHECK(id.size() == 25);
+    cfgs[2].shape[2] = 40;
+    CHECK(configure_plan_group_fft(cfgs, info).identifier() == id);
+    cfgs[2].shape[0] = 3;
+    CHECK(configure_plan_group_fft(cfgs, info).identifier() != id);
+    CHECK(code.find("local double2 X1[") != std::string::npos);
+    CHECK(code.find("get_group_id(2)") != std::string::npos);
+
+    CHECK_THROWS_AS(configure_plan_group_fft({}, info), bad_configuration);
+    cfgs.push_back({2, {1, 16, 16, 1}, precision::f32, direction::forward});
+    CHECK_THROWS_AS(configure_plan_group_fft(cfgs, info), bad_configuration);
+    cfgs.back() = {1, {1, 256, 1}, precision::f32, direction::forward};
+    CHECK_THROWS_AS(configure_plan_group_fft(cfgs, info), bad_configuration);
+}
+
+TEST_CASE("convolution") {
+    auto info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+    auto cfg = convolution_configuration{precision::f32, {1, 16, 5}};
+    auto cvc = configure_convolution_fft(cfg, info);
+    CHECK(cvc.identifier().substr(0, 6) == "cvfft_");
+    auto oss = std::ostringstream{};
+    generate_convolution_fft(oss, cvc);
+    auto code = oss.str();
+    CHECK(code.find("global float2* filter") != std::string::npos);
+    CHECK(code.find("float2 y[") != std::string::npos);
+
+    cfg.type = convolution_type::correlation;
+    CHECK(configure_convolution_fft(cfg, info).identifier().substr(0, 6) == "crfft_");
+
+    cfg.fp = precision::f16;
+    CHECK_THROWS_AS(configure_convolution_fft(cfg, info), bad_configuration);
+    cfg = convolution_configuration{precision::f32, {1, 4096, 1}};
+    CHECK_THROWS_AS(configure_convolution_fft(cfg, info), bad_configuration);
+}
+
+TEST_CASE("bluestein") {
+    constexpr double tau = 6.28318530717958647693;
+    auto const dft = [](std::vector<std::complex<double>> const &x, int direction) {
+        int const L = x.size();
+        auto y = std::vector<std::complex<double>>(L);
+        for (int k = 0; k < L; ++k) {
+            for (int n = 0; n < L; ++n) {
+                y[k] += x[n] * std::polar(1.0, direction * tau * ((n * k) % L) / L);
+            }
+        }
+        return y;
+    };
+
+    for (int direction : {-1, 1}) {
+        for (int N : {1, 7, 13, 67}) {
+            auto cfg = configuration{1, {1, static_cast<std::size_t>(N), 1}, precision::f32,
+                                     static_cast<bbfft::direction>(direction)};
+            auto blc = configure_bluestein_fft(
+                cfg, device_info{1024, {16, 32}, 128 * 1024, device_type::gpu});
+            int const L = blc.L;
+            CHECK(L >= 2 * N - 1);
+            auto table = bluestein_twiddle_table(blc);
+            REQUIRE(table.size() == static_cast<std::size_t>(N + L));
+
+            auto x = std::vector<std::complex<double>>(N);
+            for (int n = 0; n < N; ++n) {
+                x[n] = {std::cos(n + 1.0), std::sin(2.0 * n)};
+            }
+            auto a = std::vector<std::complex<double>>(L);
+            for (int n = 0; n < N; ++n) {
+                a[n] = x[n] * table[n];
+            }
+            a = dft(a, -1);
+            for (int n = 0; n < L; ++n) {
+                a[n] *= table[N + n];
+            }
+            a = dft(a, 1);
+
+            auto X = dft(x, direction);
+            for (int k = 0; k < N; ++k) {
+                CHECK(std::abs(table[k] * a[k] - X[k]) < 1e-10 * N);
+            }
+        }
+    }
+}
+
+TEST_CASE("twiddle accuracy") {
+    constexpr long double tau = 6.283185307179586476925286766559005768L;
+    auto const info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+    auto const w = [&tau](long long k, long long N) {
+        auto const arg = tau * (((k % N) + N) % N) / N;
+        return std::complex<long double>{std::cos(arg), std::sin(arg)};
+    };
+    auto const error = [](std::complex<double> const &a, std::complex<long double> const &b) {
+        return std::max(std::abs(a.real() - b.real()), std::abs(a.imag() - b.imag()));
+    };
+
+    for (auto desc : {"dcfo4096*1", "dcbo3000*1", "drfo2048*1", "drbo2048*1"}) {
+        auto cfg = parse_fft_descriptor(desc);
+        auto f2c = configure_factor2_slm_fft(cfg, info);
+        auto table = factor2_slm_twiddle_table(f2c);
+        auto const &factorization = f2c.factorization;
+        long long N = 1;
+        for (auto f : factorization) {
+            N *= f;
+        }
+
+        long double max_error = 0.0L;
+        std::size_t offset = 0;
+        long long J1 = N;
+        for (auto f = factorization.size() - 1; f >= 1; --f) {
+            long long const Nf = factorization[f];
+            J1 /= Nf;
+            for (long long i = 0; i < J1; ++i) {
+                for (long long j = 0; j < Nf; ++j) {
+                    auto const &tw = table[offset + j + Nf * i];
+                    max_error = std::max(max_error, error(tw, w(f2c.direction * i * j, J1 * Nf)));
+                }
+            }
+            offset += J1 * Nf;
+        }
+        if (cfg.type != transform_type::c2c) {
+            REQUIRE(table.size() == offset + N);
+            for (long long i = 0; i < N; ++i) {
+                auto ref = w(f2c.direction * i, 2 * N) * std::complex<long double>{0.0L, 1.0L};
+                max_error = std::max(max_error, error(table[offset + i], ref));
+            }
+        } else {
+            CHECK(table.size() == offset);
+        }
+        // Correct rounding gives at most 2^-54 as all entries have magnitude <= 1
+        CHECK(max_error <= 0x1.01p-54L);
+    }
 }
@@ -0,0 +1,87 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "bbfft/autotune.hpp"
+#include "bbfft/bad_configuration.hpp"
+#include "bbfft/cost.hpp"
+#include "bbfft/parser.hpp"
+
+#include "doctest/doctest.h"
+#include <sstream>
+
+using namespace bbfft;
+
+TEST_CASE("cost estimate") {
+    auto info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+
+    auto cost = estimate_cost(parse_fft_descriptor("scfo16*64"), info);
+    REQUIRE(cost.kernels.size() == 1);
+    CHECK(cost.global_bytes() == 2 * 16 * 64 * 8);
+    CHECK(cost.slm_bytes() == 2 * cost.global_bytes());
+    CHECK(cost.flops() == doctest::Approx(64 * 5 * 16 * 4));
+    CHECK(cost.register_bytes() == 16 * 8);
+    CHECK(cost.scratch_bytes == 0);
+    CHECK(cost.occupancy() > 0.0);
+    CHECK(cost.occupancy() <= 1.0);
+    CHECK(cost.time() > device_throughput{}.launch_latency);
+
+    // Larger batches move more data and take longer
+    auto large = estimate_cost(parse_fft_descriptor("scfo16*65536"), info);
+    CHECK(large.global_bytes() == 1024 * cost.global_bytes());
+    CHECK(large.occupancy() == 1.0);
+    CHECK(large.time() > cost.time());
+
+    // Storage precision and pruning reduce global memory traffic
+    CHECK(estimate_cost(parse_fft_descriptor("hcfo16*64"), info).global_bytes() ==
+          cost.global_bytes() / 2);
+    CHECK(estimate_cost(parse_fft_descriptor("scfo16*64l4,8"), info).global_bytes() ==
+          (4 + 8) * 64 * 8);
+    CHECK(estimate_cost(parse_fft_descriptor("srfo16*64"), info).global_bytes() ==
+          (16 * 4 + 9 * 8) * 64);
+
+    CHECK(estimate_cost(parse_fft_descriptor("scfo4099*4"), info).kernels.size() == 5);
+    auto four_step = estimate_cost(parse_fft_descriptor("scfo65536*2"), info);
+    CHECK(four_step.kernels.size() == 2);
+    CHECK(four_step.scratch_bytes == 65536 * 2 * 8);
+    CHECK(estimate_cost(parse_fft_descriptor("scfo128x128x128"), info).kernels.size() == 3);
+    // Strided layouts keep temporaries in a scratch buffer
+    CHECK(estimate_cost(parse_fft_descriptor("srfo16x16*4"), info).scratch_bytes == 0);
+    CHECK(estimate_cost(parse_fft_descriptor("srfo16x16*4i1,1,17,272"), info).scratch_bytes ==
+          9 * 16 * 4 * 8);
+    CHECK(estimate_cost(parse_fft_descriptor("sefo32*16"), info).kernels.size() == 1);
+
+    auto oss = std::ostringstream{};
+    oss << cost;
+    CHECK(oss.str().find(cost.kernels.front().name) != std::string::npos);
+}
+
+TEST_CASE("cost estimate of tuning candidates") {
+    auto info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+    auto cfg = parse_fft_descriptor("scfo16*64");
+
+    CHECK(estimate_cost(cfg, info, tuning_candidate{}).kernels.front().name ==
+          estimate_cost(cfg, info).kernels.front().name);
+    for (auto const &tc : tuning_search_space(cfg, info)) {
+        auto cost = estimate_cost(cfg, info, tc);
+        REQUIRE(cost.kernels.size() == 1);
+        CHECK(cost.global_bytes() == 2 * 16 * 64 * 8);
+        CHECK(cost.kernels.front().work_group_size ==
+              tc.Mb * tc.Kb * (tc.algorithm == tuning_algorithm::factor2_slm ? tc.Nb : 1));
+    }
+
+    auto sb = tuning_candidate{tuning_algorithm::small_batch, 1, 1, 0, 16, {}};
+    auto f2 = tuning_candidate{tuning_algorithm::factor2_slm, 1, 1, 4, 16, {4, 4}};
+    CHECK(estimate_cost(cfg, info, f2).kernels.front().register_bytes <
+          estimate_cost(cfg, info, sb).kernels.front().register_bytes);
+    CHECK(estimate_cost(cfg, info, f2).slm_bytes() > estimate_cost(cfg, info, sb).slm_bytes());
+
+    // One work-item per work-group leaves most of the sub-group idle
+    auto large = parse_fft_descriptor("scfo16*4096");
+    CHECK(estimate_cost(large, info, sb).occupancy() < estimate_cost(large, info).occupancy());
+    CHECK(estimate_cost(large, info, sb).time() > estimate_cost(large, info).time());
+
+    CHECK_THROWS_AS(estimate_cost(parse_fft_descriptor("scfo16x16*4"), info, sb),
+                    bad_configuration);
+    CHECK_THROWS_AS(estimate_cost(parse_fft_descriptor("scfo16*64l4,0"), info, f2),
+                    bad_configuration);
+}
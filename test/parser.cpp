@@ -122,5 +122,80 @@ TEST_CASE("fft descriptor parser") {
     CHECK(cfg.ostride == make_shape(1, 1, 20));
     CHECK(cfg.to_string() == desc);
 
+    cfg = parse_fft_descriptor(desc = "sefi64*3");
+    CHECK(cfg.dim == 1);
+    CHECK(cfg.shape == make_shape(1, 64, 3));
+    CHECK(cfg.fp == precision::f32);
+    CHECK(cfg.dir == direction::forward);
+    CHECK(cfg.type == transform_type::dct2);
+    CHECK(cfg.istride == default_istride(cfg, true));
+    CHECK(cfg.ostride == default_ostride(cfg, true));
+    CHECK(cfg.to_string() == desc);
+
+    cfg = parse_fft_descriptor(desc = "dobo2.17o1,2,40");
+    CHECK(cfg.dim == 1);
+    CHECK(cfg.shape == make_shape(2, 17, 1));
+    CHECK(cfg.fp == precision::f64);
+    CHECK(cfg.dir == direction::backward);
+    CHECK(cfg.type == transform_type::dst3);
+    CHECK(cfg.istride == default_istride(cfg, false));
+    CHECK(cfg.ostride == make_shape(1, 2, 40));
+    CHECK(cfg.to_string() == desc);
+
+    cfg = parse_fft_descriptor(desc = "hcfi16*3");
+    CHECK(cfg.fp == precision::f16);
+    CHECK(cfg.to_string() == desc);
+    cfg = parse_fft_descriptor(desc = "brbi15*3");
+    CHECK(cfg.fp == precision::bf16);
+    CHECK(cfg.type == transform_type::c2r);
+    CHECK(cfg.to_string() == desc);
+
+    cfg = parse_fft_descriptor(desc = "scfi16*32p512,600");
+    CHECK(cfg.planar_offset == std::array<std::size_t, 2>{512, 600});
+    CHECK(cfg.istride == default_istride(cfg, true));
+    CHECK(cfg.to_string() == desc);
+    CHECK(parse_fft_descriptor("srfo16").planar_offset == std::array<std::size_t, 2>{0, 0});
+
+    cfg = parse_fft_descriptor(desc = "dcbi5.64*2s0.015625");
+    CHECK(cfg.scale == 0.015625);
+    CHECK(cfg.to_string() == desc);
+    cfg = parse_fft_descriptor("scbi12p24,24s0.1");
+    CHECK(cfg.scale == 0.1);
+    CHECK(parse_fft_descriptor(cfg.to_string()).scale == 0.1);
+    CHECK(parse_fft_descriptor("scfi12").scale == 1.0);
+    CHECK_THROWS_AS((parse_fft_descriptor("scfi12s")), std::runtime_error);
+    CHECK_THROWS_AS((parse_fft_descriptor("scfi12s1.0.5")), std::runtime_error);
+    CHECK_THROWS_AS((parse_fft_descriptor("scfi12s\xe9")), std::runtime_error);
+
+    cfg = parse_fft_descriptor(desc = "scfi16*32l5,8");
+    CHECK(cfg.input_length == 5);
+    CHECK(cfg.output_length == 8);
+    CHECK(cfg.to_string() == desc);
+    CHECK(parse_fft_descriptor("scfi16l0,4s0.5").to_string() == "scfi16l0,4s0.5");
+    CHECK(parse_fft_descriptor("scfo16").input_length == 0);
+    CHECK_THROWS_AS((parse_fft_descriptor("scfo16l5")), std::runtime_error);
+
+    CHECK(parse_fft_descriptor("debi12").type == transform_type::dct3);
+    CHECK(parse_fft_descriptor("sofo12").type == transform_type::dst2);
+
     CHECK_THROWS_AS((parse_fft_descriptor("srb4x5*6x7")), std::runtime_error);
 }
+
+TEST_CASE("tuning candidate parser") {
+    for (auto const &tc :
+         {tuning_candidate{}, tuning_candidate{tuning_algorithm::small_batch, 2, 8, 0, 32, {}},
+          tuning_candidate{tuning_algorithm::factor2_slm, 1, 1, 4, 16, {4, 4}},
+          tuning_candidate{tuning_algorithm::factor2_slm, 16, 2, 8, 32, {3, 5, 7}},
+          tuning_candidate{tuning_algorithm::subgroup, 0, 4, 0, 16, {}}}) {
+        std::ostringstream oss;
+        oss << tc;
+        CHECK(parse_tuning_candidate(oss.str()) == tc);
+    }
+
+    CHECK_THROWS_AS((parse_tuning_candidate("")), std::runtime_error);
+    CHECK_THROWS_AS((parse_tuning_candidate("automatic")), std::runtime_error);
+    CHECK_THROWS_AS((parse_tuning_candidate("sb_Mb2_Kb8")), std::runtime_error);
+    CHECK_THROWS_AS((parse_tuning_candidate("sb_Mb2_Kbx_sgs16")), std::runtime_error);
+    CHECK_THROWS_AS((parse_tuning_candidate("f2_Mb1_Nb4_Kb1_sgs16_f")), std::runtime_error);
+    CHECK_THROWS_AS((parse_tuning_candidate("f2_Mb1_Nb4_Kb1_sgs16_f4x")), std::runtime_error);
+}
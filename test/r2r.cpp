@@ -0,0 +1,90 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "fft.hpp"
+
+#include "bbfft/configuration.hpp"
+#include "bbfft/sycl/make_plan.hpp"
+#include "bbfft/tensor_indexer.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace bbfft;
+using namespace sycl;
+
+template <typename T>
+void test_r2r(transform_type type, std::size_t M, std::size_t N, std::size_t K, queue Q) {
+    auto dir = type == transform_type::dct2 || type == transform_type::dst2 ? direction::forward
+                                                                             : direction::backward;
+    auto cfg = configuration{1, {M, N, K}, to_precision_v<T>, dir, type};
+    cfg.set_strides_default(false);
+    auto xi = tensor_indexer<std::size_t, 3u, layout::col_major>(fit_array<3u>(cfg.shape));
+
+    auto x = std::vector<T>(xi.size());
+    auto rd = std::random_device{};
+    auto gen = std::mt19937(rd());
+    auto Y = std::uniform_real_distribution<T>(-1.0, 1.0);
+    for (auto &v : x) {
+        v = Y(gen);
+    }
+
+    auto x_d = malloc_device<T>(xi.size(), Q);
+    auto X_d = malloc_device<T>(xi.size(), Q);
+    auto X = std::vector<T>(xi.size());
+    auto plan = make_plan(cfg, Q);
+    Q.copy(x.data(), x_d, xi.size()).wait();
+    plan.execute(x_d, X_d).wait();
+    Q.copy(X_d, X.data(), xi.size()).wait();
+
+    // Unnormalized DCT/DST conventions of REDFT10, REDFT01, RODFT10, RODFT01
+    auto const basis = [&](std::size_t j, std::size_t n) -> double {
+        double const pi = tau / 2.0;
+        switch (type) {
+        case transform_type::dct2:
+            return 2.0 * std::cos(pi * (2 * n + 1) * j / (2.0 * N));
+        case transform_type::dct3:
+            return n == 0 ? 1.0 : 2.0 * std::cos(pi * n * (2 * j + 1) / (2.0 * N));
+        case transform_type::dst2:
+            return 2.0 * std::sin(pi * (2 * n + 1) * (j + 1) / (2.0 * N));
+        case transform_type::dst3:
+            return (n == N - 1 ? 1.0 : 2.0) * std::sin(pi * (n + 1) * (2 * j + 1) / (2.0 * N));
+        default:
+            break;
+        }
+        return 0.0;
+    };
+
+    double eps = tol<T>(N);
+    for (std::size_t k = 0; k < K; ++k) {
+        for (std::size_t j = 0; j < N; ++j) {
+            for (std::size_t m = 0; m < M; ++m) {
+                double ref = 0.0;
+                for (std::size_t n = 0; n < N; ++n) {
+                    ref += basis(j, n) * x[xi(m, n, k)];
+                }
+                REQUIRE(X[xi(m, j, k)] == doctest::Approx(ref).epsilon(eps).scale(2.0 * N));
+            }
+        }
+    }
+
+    free(x_d, Q);
+    free(X_d, Q);
+}
+
+TEST_CASE_TEMPLATE("r2r", T, TEST_PRECISIONS) {
+    auto Q = queue();
+
+    auto KK = std::vector<std::size_t>{1, 5};
+    auto MM = std::vector<std::size_t>{1, 3};
+    auto NN = std::vector<std::size_t>{2, 7, 16, 31, 64, 100};
+
+    std::size_t M, N, K;
+    DOCTEST_TENSOR3_TEST(MM, NN, KK);
+
+    for (auto type : {transform_type::dct2, transform_type::dct3, transform_type::dst2,
+                      transform_type::dst3}) {
+        test_r2r<T>(type, M, N, K, Q);
+    }
+}
@@ -0,0 +1,638 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "algorithm.hpp"
+#include "autotuner.hpp"
+#include "bbfft/autotune.hpp"
+#include "bbfft/configuration.hpp"
+#include "bbfft/convolution_configuration.hpp"
+#include "bbfft/parser.hpp"
+#include "bbfft/ragged_configuration.hpp"
+#include "bbfft/wisdom.hpp"
+#include "reference_api.hpp"
+
+#include "doctest/doctest.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace bbfft;
+
+namespace {
+
+using cdouble = std::complex<double>;
+using index_array = std::array<std::size_t, max_tensor_dim>;
+
+constexpr double pi = 3.14159265358979323846;
+
+auto half_to_float(std::uint16_t h) -> float {
+    int const e = (h >> 10) & 0x1f;
+    int const m = h & 0x3ff;
+    float const v = e == 0 ? std::ldexp(static_cast<float>(m), -24)
+                           : std::ldexp(static_cast<float>(m | 0x400), e - 25);
+    return h & 0x8000 ? -v : v;
+}
+
+auto float_to_half(float f) -> std::uint16_t {
+    std::uint32_t x;
+    std::memcpy(&x, &f, sizeof(x));
+    auto const sign = static_cast<std::uint16_t>((x >> 16) & 0x8000);
+    std::uint32_t const a = x & 0x7fffffff;
+    if (a >= 0x477ff000) { // rounds to infinity
+        return sign | 0x7c00;
+    }
+    if (a < 0x38800000) { // subnormal
+        return sign | static_cast<std::uint16_t>(std::nearbyint(std::abs(f) * 16777216.0f));
+    }
+    return sign | static_cast<std::uint16_t>((a + 0xfff + ((a >> 13) & 1) - 0x38000000) >> 13);
+}
+
+auto bf16_to_float(std::uint16_t h) -> float {
+    auto const x = static_cast<std::uint32_t>(h) << 16;
+    float f;
+    std::memcpy(&f, &x, sizeof(f));
+    return f;
+}
+
+auto float_to_bf16(float f) -> std::uint16_t {
+    std::uint32_t x;
+    std::memcpy(&x, &f, sizeof(x));
+    return static_cast<std::uint16_t>((x + 0x7fff + ((x >> 16) & 1)) >> 16);
+}
+
+/**
+ * @brief Tensor in host memory in one of the storage precisions; indexed in reals
+ */
+class host_tensor {
+  public:
+    host_tensor(precision fp, std::size_t num_reals)
+        : fp_(fp), bytes_(num_reals * size_in_bytes(fp)) {}
+
+    auto data() -> void * { return bytes_.data(); }
+
+    auto get(std::size_t i) const -> double {
+        switch (fp_) {
+        case precision::f16:
+            return half_to_float(load<std::uint16_t>(i));
+        case precision::bf16:
+            return bf16_to_float(load<std::uint16_t>(i));
+        case precision::f32:
+            return load<float>(i);
+        case precision::f64:
+            return load<double>(i);
+        }
+        return 0.0;
+    }
+    //! Stores v rounded to the storage precision and returns the stored value
+    auto set(std::size_t i, double v) -> double {
+        switch (fp_) {
+        case precision::f16:
+            store(i, float_to_half(static_cast<float>(v)));
+            break;
+        case precision::bf16:
+            store(i, float_to_bf16(static_cast<float>(v)));
+            break;
+        case precision::f32:
+            store(i, static_cast<float>(v));
+            break;
+        case precision::f64:
+            store(i, v);
+            break;
+        }
+        return get(i);
+    }
+
+  private:
+    template <typename T> auto load(std::size_t i) const -> T {
+        T v;
+        std::memcpy(&v, bytes_.data() + i * sizeof(T), sizeof(T));
+        return v;
+    }
+    template <typename T> void store(std::size_t i, T v) {
+        std::memcpy(bytes_.data() + i * sizeof(T), &v, sizeof(T));
+    }
+
+    precision fp_;
+    std::vector<std::uint8_t> bytes_;
+};
+
+/**
+ * @brief Shape and strides of the input or output tensor of a transform
+ */
+struct tensor_layout {
+    unsigned dim;
+    index_array shape;
+    index_array stride;
+    std::array<std::size_t, 2> planar_offset; ///< Real and imaginary part offset in reals
+    bool is_complex;
+
+    auto size() const -> std::size_t {
+        std::size_t s = 1;
+        for (unsigned d = 0; d < dim + 2; ++d) {
+            s *= shape[d];
+        }
+        return s;
+    }
+    //! Offset in reals or complex numbers of the entry with packed index i
+    auto offset(std::size_t i) const -> std::size_t {
+        std::size_t o = 0;
+        for (unsigned d = 0; d < dim + 2; ++d) {
+            o += i % shape[d] * stride[d];
+            i /= shape[d];
+        }
+        return o;
+    }
+    //! Real offsets of the real and imaginary part of the entry with packed index i
+    auto real_offsets(std::size_t i) const -> std::array<std::size_t, 2> {
+        auto const o = offset(i);
+        if (!is_complex) {
+            return {o, o};
+        }
+        if (planar_offset[1] > 0) {
+            return {o + planar_offset[0], o + planar_offset[1]};
+        }
+        return {2 * o, 2 * o + 1};
+    }
+    auto num_reals() const -> std::size_t {
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < size(); ++i) {
+            auto const ro = real_offsets(i);
+            n = std::max(n, std::max(ro[0], ro[1]) + 1);
+        }
+        return n;
+    }
+};
+
+auto make_layout(configuration const &cfg, bool output) -> tensor_layout {
+    auto shape = cfg.shape;
+    bool const half_complex =
+        output ? cfg.type == transform_type::r2c : cfg.type == transform_type::c2r;
+    if (half_complex) {
+        shape[1] = shape[1] / 2 + 1;
+    }
+    bool const is_complex = cfg.type == transform_type::c2c || half_complex;
+    return {cfg.dim, shape, output ? cfg.ostride : cfg.istride,
+            std::array<std::size_t, 2>{0, cfg.planar_offset[output ? 1 : 0]}, is_complex};
+}
+
+/**
+ * @brief Naive DFT along the N-modes of a packed tensor
+ */
+void dft(unsigned dim, index_array const &shape, std::vector<cdouble> &x, double sign) {
+    std::size_t stride = shape[0];
+    auto tmp = std::vector<cdouble>{};
+    for (unsigned d = 1; d <= dim; ++d) {
+        std::size_t const N = shape[d];
+        tmp.resize(N);
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            if ((i / stride) % N != 0) {
+                continue;
+            }
+            for (std::size_t n = 0; n < N; ++n) {
+                tmp[n] = {};
+                for (std::size_t j = 0; j < N; ++j) {
+                    tmp[n] += x[i + j * stride] * std::polar(1.0, sign * 2.0 * pi *
+                                                                      ((j * n) % N) / N);
+                }
+            }
+            for (std::size_t n = 0; n < N; ++n) {
+                x[i + n * stride] = tmp[n];
+            }
+        }
+        stride *= N;
+    }
+}
+
+/**
+ * @brief Naive DCT-II/III or DST-II/III along the N-mode of a packed M x N x K tensor
+ *
+ * Conventions follow FFTW's REDFT10, REDFT01, RODFT10, and RODFT01.
+ */
+void r2r(transform_type type, index_array const &shape, std::vector<cdouble> &x) {
+    std::size_t const M = shape[0], N = shape[1], K = shape[2];
+    auto const basis = [&](std::size_t j, std::size_t n) {
+        double const a = pi / (2.0 * N);
+        switch (type) {
+        case transform_type::dct2:
+            return 2.0 * std::cos(a * (2 * n + 1) * j);
+        case transform_type::dct3:
+            return n == 0 ? 1.0 : 2.0 * std::cos(a * n * (2 * j + 1));
+        case transform_type::dst2:
+            return 2.0 * std::sin(a * (2 * n + 1) * (j + 1));
+        case transform_type::dst3:
+            return (n == N - 1 ? 1.0 : 2.0) * std::sin(a * (n + 1) * (2 * j + 1));
+        default:
+            return 0.0;
+        }
+    };
+    auto y = std::vector<cdouble>(x.size());
+    for (std::size_t k = 0; k < K; ++k) {
+        for (std::size_t j = 0; j < N; ++j) {
+            for (std::size_t m = 0; m < M; ++m) {
+                for (std::size_t n = 0; n < N; ++n) {
+                    y[m + j * M + k * M * N] += basis(j, n) * x[m + n * M + k * M * N];
+                }
+            }
+        }
+    }
+    x = std::move(y);
+}
+
+/**
+ * @brief Random input and reference output of a transform
+ *
+ * Input entries that are not read by the transform, i.e. pruned entries, are zero in the
+ * reference computation; output entries that are not written are not checked.
+ */
+class transform_test {
+  public:
+    transform_test(configuration const &cfg, bool inplace, unsigned seed = 42)
+        : cfg_(cfg), in_layout_(make_layout(cfg, false)), out_layout_(make_layout(cfg, true)),
+          in_(cfg.fp, in_layout_.num_reals()),
+          out_(cfg.fp, inplace ? 0 : out_layout_.num_reals()), inplace_(inplace) {
+        if (inplace) {
+            in_ = host_tensor(cfg.fp, std::max(in_layout_.num_reals(), out_layout_.num_reals()));
+        }
+        auto rnd = std::mt19937(seed);
+        auto dist = std::uniform_real_distribution<double>(-1.0, 1.0);
+        std::size_t full_size = 1;
+        for (unsigned d = 0; d < cfg.dim + 2; ++d) {
+            full_size *= cfg.shape[d];
+        }
+        auto full = std::vector<cdouble>(full_size);
+        std::size_t const N1 = cfg.shape[1];
+        std::size_t const M = cfg.shape[0];
+        auto const in_length = cfg.input_length ? cfg.input_length : N1;
+        auto const is_pruned = [&](std::size_t i) { return i / M % N1 >= in_length; };
+        double const sign = cfg.dir == direction::forward ? -1.0 : 1.0;
+        switch (cfg.type) {
+        case transform_type::c2c:
+            for (std::size_t i = 0; i < full.size(); ++i) {
+                auto const ro = in_layout_.real_offsets(i);
+                auto const re = in_.set(ro[0], dist(rnd));
+                auto const im = in_.set(ro[1], dist(rnd));
+                full[i] = is_pruned(i) ? cdouble{} : cdouble{re, im};
+            }
+            dft(cfg.dim, cfg.shape, full, sign);
+            break;
+        case transform_type::r2c:
+            for (std::size_t i = 0; i < full.size(); ++i) {
+                full[i] = in_.set(in_layout_.offset(i), dist(rnd));
+            }
+            dft(cfg.dim, cfg.shape, full, sign);
+            break;
+        case transform_type::c2r: {
+            // The input is the half spectrum of a real tensor x, such that the result is NN x
+            for (auto &v : full) {
+                v = dist(rnd);
+            }
+            auto spectrum = full;
+            dft(cfg.dim, cfg.shape, spectrum, -1.0);
+            double NN = 1.0;
+            for (unsigned d = 1; d <= cfg.dim; ++d) {
+                NN *= cfg.shape[d];
+            }
+            std::size_t const N1c = N1 / 2 + 1;
+            for (std::size_t i = 0; i < in_layout_.size(); ++i) {
+                auto const hi = i % M + (i / M % N1c) * M + (i / (M * N1c)) * M * N1;
+                auto const ro = in_layout_.real_offsets(i);
+                in_.set(ro[0], spectrum[hi].real());
+                in_.set(ro[1], spectrum[hi].imag());
+            }
+            for (auto &v : full) {
+                v *= NN;
+            }
+            break;
+        }
+        default:
+            for (std::size_t i = 0; i < full.size(); ++i) {
+                full[i] = in_.set(in_layout_.offset(i), dist(rnd));
+            }
+            r2r(cfg.type, cfg.shape, full);
+            break;
+        }
+        // Restrict the reference to the output tensor
+        ref_.resize(out_layout_.size());
+        auto const &os = out_layout_.shape;
+        for (std::size_t i = 0; i < ref_.size(); ++i) {
+            auto const fi = i % M + (i / M % os[1]) * M + (i / (M * os[1])) * M * N1;
+            ref_[i] = cfg.scale * full[fi];
+        }
+    }
+
+    auto in() -> void const * { return in_.data(); }
+    auto out() -> void * { return inplace_ ? in_.data() : out_.data(); }
+
+    //! Returns the largest error relative to the tolerance; values <= 1 pass
+    auto error() const -> double {
+        auto const fp = compute_precision(cfg_.fp);
+        double const eps_c = fp == precision::f64 ? 1e-12 : 1e-5;
+        double const eps_s = cfg_.fp == precision::f16    ? 1.0 / 1024.0
+                             : cfg_.fp == precision::bf16 ? 1.0 / 128.0
+                                                           : 0.0;
+        double NN = 1.0;
+        for (unsigned d = 1; d <= cfg_.dim; ++d) {
+            NN *= cfg_.shape[d];
+        }
+        double const tol =
+            (eps_c * std::sqrt(NN) + eps_s) * NN * std::max(1.0, std::abs(cfg_.scale));
+        auto const &y = inplace_ ? in_ : out_;
+        std::size_t const M = cfg_.shape[0];
+        std::size_t const out_length =
+            cfg_.output_length ? cfg_.output_length : out_layout_.shape[1];
+        double max_error = 0.0;
+        for (std::size_t i = 0; i < ref_.size(); ++i) {
+            if (i / M % out_layout_.shape[1] >= out_length) {
+                continue;
+            }
+            auto const ro = out_layout_.real_offsets(i);
+            auto const Y = out_layout_.is_complex ? cdouble{y.get(ro[0]), y.get(ro[1])}
+                                                  : cdouble{y.get(ro[0]), 0.0};
+            auto const ref = out_layout_.is_complex ? ref_[i] : cdouble{ref_[i].real(), 0.0};
+            max_error = std::max(max_error, std::abs(Y - ref) / (tol + eps_s * std::abs(ref)));
+        }
+        return max_error;
+    }
+
+  private:
+    configuration cfg_;
+    tensor_layout in_layout_, out_layout_;
+    host_tensor in_, out_;
+    bool inplace_;
+    std::vector<cdouble> ref_;
+};
+
+bool is_inplace(char const *desc) { return std::strlen(desc) > 3 && desc[3] == 'i'; }
+
+auto const info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+
+void check(char const *desc, device_info const &dev = info) {
+    INFO(desc);
+    auto cfg = parse_fft_descriptor(desc);
+    auto plan = select_fft_algorithm(cfg, reference_api(dev), nullptr);
+    auto t = transform_test(cfg, is_inplace(desc));
+    plan->execute(t.in(), t.out(), {});
+    CHECK(t.error() <= 1.0);
+}
+
+} // namespace
+
+TEST_CASE("reference api c2c") {
+    for (auto const &desc : {"scfo16*5", "scbo12*3", "scfo2.16*3", "scfo7*4", "scfo9*33",
+                             "scfo64*2", "scfo512*2", "scfo4096*1", "scfo2053*1", "scfi16*3",
+                             "scfo16*32l5,8", "scbo12*2s0.125"}) {
+        check(desc);
+    }
+#ifndef NO_DOUBLE_PRECISION
+    check("dcfo32*3");
+#endif
+    // Small shared local memory selects the four-step FFT
+    check("scfo4096*1", device_info{1024, {16, 32}, 16 * 1024, device_type::gpu});
+
+    auto cfg = parse_fft_descriptor("scfo16*64");
+    for (auto const &tc : tuning_search_space(cfg, info)) {
+        INFO(tc);
+        auto plan = make_tuned_fft(cfg, tc, reference_api(info), nullptr);
+        auto t = transform_test(cfg, false);
+        plan->execute(t.in(), t.out(), {});
+        CHECK(t.error() <= 1.0);
+    }
+}
+
+TEST_CASE("reference api dense block copy") {
+    // Dense blocks are stored with block writes if the output is 16-byte aligned and with a flat
+    // loop otherwise
+    std::size_t const N = 16, K = 64;
+    auto cfg = configuration{1, {1, N, K}, precision::f32};
+    auto plan = select_fft_algorithm(cfg, reference_api(info), nullptr);
+    auto rnd = std::mt19937(42);
+    auto dist = std::uniform_real_distribution<float>(-1.0f, 1.0f);
+    auto x = std::vector<std::complex<float>>(N * K);
+    for (auto &v : x) {
+        v = {dist(rnd), dist(rnd)};
+    }
+    auto ref = std::vector<cdouble>(x.begin(), x.end());
+    dft(1, cfg.shape, ref, -1.0);
+    double const tol = 1e-5 * std::sqrt(static_cast<double>(N)) * N;
+    auto y = std::vector<std::complex<double>>(N * K + 1);
+    for (std::size_t misalignment : {0, 1}) {
+        INFO(misalignment);
+        auto out = reinterpret_cast<std::complex<float> *>(y.data()) + misalignment;
+        plan->execute(x.data(), out, {});
+        for (std::size_t i = 0; i < ref.size(); ++i) {
+            CHECK(std::abs(cdouble(out[i]) - ref[i]) <= tol);
+        }
+    }
+}
+
+TEST_CASE("reference api rader") {
+    for (auto const &desc : {"scfo17*4", "scfo31*2", "scfo62*2", "scbo244*1", "scbo19*3"}) {
+        check(desc);
+    }
+#ifndef NO_DOUBLE_PRECISION
+    check("dcfo17*2");
+#endif
+}
+
+TEST_CASE("reference api r2c and c2r") {
+    for (auto const &desc : {"srfo16*3", "srbo16*3", "srfo15*2", "srbo15*2", "srfi32*2",
+                             "srbi32*2", "srfo2.12*3", "srbo3.10"}) {
+        check(desc);
+    }
+#ifndef NO_DOUBLE_PRECISION
+    check("drfo24*2");
+    check("drbo24*2");
+#endif
+}
+
+TEST_CASE("reference api r2r") {
+    for (auto const &desc : {"sefo16*3", "sebo16*3", "sofo16*3", "sobo16*3", "sefo15*2",
+                             "sebo15*2", "sofo15*2", "sobo15*2", "sefo2.12", "sobo3.9*2"}) {
+        check(desc);
+    }
+#ifndef NO_DOUBLE_PRECISION
+    check("defo20*2");
+#endif
+}
+
+TEST_CASE("reference api M-mode stride") {
+    for (auto const &desc : {"scfo2.16*3i2,4,64o1,2,32", "scbo3.12*2i1,3,36o2,6,72",
+                             "srfo2.16*3i2,4,64o1,2,18", "srbo2.16*3i3,6,54o1,2,32",
+                             "scfo2.8x6*2i2,4,32,192o1,2,16,96"}) {
+        check(desc);
+    }
+}
+
+TEST_CASE("reference api planar") {
+    for (auto const &desc : {"scfo16*3p48,48", "scbo12*3p40,0", "scfo16*3p0,64", "scfi16*3p48,48",
+                             "scbi12*2p30,30", "srfo16*3p0,27", "srfo16*3o1,1,9p0,27",
+                             "srbo16*3p30,0", "srfo15*2p0,20", "srbo15*2p16,0",
+                             "scfo256*2p512,600", "srbo256*2p300,0"}) {
+        check(desc);
+    }
+}
+
+TEST_CASE("reference api f16 and bf16") {
+    for (auto const &desc : {"hcfo16*3", "hcbi12*4", "bcfo16*3", "bcbo12*5", "hrfo16*3",
+                             "hrbo16*3", "brfo12*2", "brbo15*2"}) {
+        check(desc);
+    }
+}
+
+TEST_CASE("reference api nd") {
+    for (auto const &desc : {"scfo8x6*2", "scbo2.4x5*2", "scfo4x4x4", "scfi8x8*2", "srfo8x6*2",
+                             "srbo8x6*2", "srfi6x4x4", "srbo5x4x3"}) {
+        check(desc);
+    }
+    // Non-default strides
+    for (auto const &desc :
+         {"scfo8x6*3i1,2,20,130o1,1,8,48", "scbo8x6*2i1,6,1,50o1,1,10,70",
+          "scfo4x3x5*2i1,1,5,16,90o1,3,12,40,200", "srfo8x6*2i1,1,9,60o1,6,1,40",
+          "srfo4x3x5*2i1,2,8,24,130o1,1,3,9,50", "srbo8x6*2i1,1,6,40o1,2,16,100"}) {
+        check(desc);
+    }
+}
+
+TEST_CASE("reference api plan group") {
+    auto cfgs = std::vector<configuration>{};
+    auto descs = std::vector<char const *>{"scfo16*3", "scfo12*2", "srfo16*2", "srbo10*3",
+                                           "scbo12*3p40,36"};
+    for (auto const &desc : descs) {
+        cfgs.emplace_back(parse_fft_descriptor(desc));
+    }
+    auto plan = plan_group_fft<reference_api>(cfgs, reference_api(info), nullptr);
+    auto tests = std::vector<transform_test>{};
+    auto args = std::vector<std::pair<void const *, void *>>{};
+    for (auto const &cfg : cfgs) {
+        tests.emplace_back(cfg, false);
+    }
+    for (auto &t : tests) {
+        args.emplace_back(t.in(), t.out());
+    }
+    plan.execute(args, {});
+    for (std::size_t i = 0; i < tests.size(); ++i) {
+        INFO(descs[i]);
+        CHECK(tests[i].error() <= 1.0);
+    }
+
+    // Wisdom that pins different sub-group sizes for the members
+    auto w = std::make_shared<wisdom>();
+    w->insert(cfgs[0], info, tuning_candidate{tuning_algorithm::small_batch, 1, 4, 0, 32, {}});
+    set_wisdom(w);
+    auto pinned_plan = plan_group_fft<reference_api>(cfgs, reference_api(info), nullptr);
+    set_wisdom(nullptr);
+    tests.clear();
+    args.clear();
+    for (auto const &cfg : cfgs) {
+        tests.emplace_back(cfg, false, 7);
+    }
+    for (auto &t : tests) {
+        args.emplace_back(t.in(), t.out());
+    }
+    pinned_plan.execute(args, {});
+    for (std::size_t i = 0; i < tests.size(); ++i) {
+        INFO(descs[i]);
+        CHECK(tests[i].error() <= 1.0);
+    }
+}
+
+TEST_CASE("reference api convolution") {
+    std::size_t const M = 3, N = 12, K = 5;
+    auto rnd = std::mt19937(42);
+    auto dist = std::uniform_real_distribution<float>(-1.0f, 1.0f);
+    auto x = std::vector<std::complex<float>>(M * N * K);
+    auto filters = std::vector<std::vector<std::complex<float>>>(2);
+    for (auto &v : x) {
+        v = {dist(rnd), dist(rnd)};
+    }
+    for (auto &h : filters) {
+        h.resize(N);
+        for (auto &v : h) {
+            v = {dist(rnd), dist(rnd)};
+        }
+    }
+
+    for (auto type : {convolution_type::convolution, convolution_type::correlation}) {
+        INFO(static_cast<int>(type));
+        auto plan = convolution_fft<reference_api>(
+            convolution_configuration{precision::f32, {M, N, K}, type}, reference_api(info),
+            nullptr);
+        // The filter is passed to execute, hence one plan serves several filters
+        for (auto const &h : filters) {
+            auto y = std::vector<std::complex<float>>(x.size());
+            plan.execute(x.data(), h.data(), y.data(), {});
+
+            // Reference: backward DFT of the product of the forward DFT and the filter spectrum
+            auto ref = std::vector<cdouble>(x.begin(), x.end());
+            dft(1, {M, N, K}, ref, -1.0);
+            for (std::size_t i = 0; i < ref.size(); ++i) {
+                auto const hj = cdouble(h[i / M % N]);
+                ref[i] *= type == convolution_type::correlation ? std::conj(hj) : hj;
+            }
+            dft(1, {M, N, K}, ref, 1.0);
+            double const tol = 1e-5 * std::sqrt(static_cast<double>(N)) * N * N;
+            for (std::size_t i = 0; i < ref.size(); ++i) {
+                CHECK(std::abs(cdouble(y[i]) - ref[i]) <= tol);
+            }
+        }
+    }
+}
+
+TEST_CASE("reference api ragged batch") {
+    auto const lengths = std::vector<std::size_t>{8, 12, 16};
+    auto const records = std::vector<ragged_record>{{0, 16}, {16, 8}, {30, 12}, {42, 16}};
+    std::size_t const size = 58;
+    for (auto dir : {direction::forward, direction::backward}) {
+        auto plan = ragged_batch_fft<reference_api>(
+            ragged_configuration{precision::f32, dir, lengths, records.size(), records.data()},
+            reference_api(info), nullptr);
+
+        auto rnd = std::mt19937(42);
+        auto dist = std::uniform_real_distribution<float>(-1.0f, 1.0f);
+        auto x = std::vector<std::complex<float>>(size);
+        auto y = std::vector<std::complex<float>>(size);
+        for (auto &v : x) {
+            v = {dist(rnd), dist(rnd)};
+        }
+        plan.execute(x.data(), y.data(), {});
+
+        double const sign = dir == direction::forward ? -1.0 : 1.0;
+        for (auto const &r : records) {
+            auto ref = std::vector<cdouble>(x.begin() + r.offset, x.begin() + r.offset + r.N);
+            dft(1, {1, r.N, 1}, ref, sign);
+            double const tol = 1e-5 * std::sqrt(static_cast<double>(r.N)) * r.N;
+            for (std::size_t n = 0; n < r.N; ++n) {
+                CHECK(std::abs(cdouble(y[r.offset + n]) - ref[n]) <= tol);
+            }
+        }
+    }
+}
+
+TEST_CASE("reference api recorder") {
+    // Plans of two apis that are alive at the same time find their own kernels
+    auto api_a = reference_api(info);
+    auto api_b = reference_api(info);
+    auto cfg_a = parse_fft_descriptor("scfo16*3");
+    auto cfg_b = parse_fft_descriptor("scbo12*2");
+    auto plan_b = select_fft_algorithm(cfg_b, api_b, nullptr);
+    auto plan_a = select_fft_algorithm(cfg_a, api_a, nullptr);
+    auto t_a = transform_test(cfg_a, false);
+    auto t_b = transform_test(cfg_b, false);
+    plan_a->execute(t_a.in(), t_a.out(), {});
+    plan_b->execute(t_b.in(), t_b.out(), {});
+    CHECK(t_a.error() <= 1.0);
+    CHECK(t_b.error() <= 1.0);
+
+    // Sources without recorded kernels are rejected
+    CHECK_THROWS_AS(api_a.build_module("kernel void k(global float* x) {}"), bad_configuration);
+}
@@ -0,0 +1,97 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "algorithm.hpp"
+#include "bbfft/configuration.hpp"
+#include "bbfft/device_info.hpp"
+#include "bbfft/parser.hpp"
+#include "dummy_api.hpp"
+#include "twiddle_registry.hpp"
+
+#include "doctest/doctest.h"
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace bbfft;
+
+struct twiddle_counter {
+    std::size_t created = 0;
+    std::size_t released = 0;
+};
+
+class counting_api : public dummy_api {
+  public:
+    inline counting_api(device_info info, std::shared_ptr<twiddle_counter> counter)
+        : dummy_api(std::move(info)), counter_(std::move(counter)) {}
+
+    template <typename T> inline buffer_type create_twiddle_table(std::vector<T> &) {
+        ++counter_->created;
+        return std::malloc(1);
+    }
+    inline void release_buffer(buffer_type buf) {
+        if (buf) {
+            ++counter_->released;
+            std::free(buf);
+        }
+    }
+
+  private:
+    std::shared_ptr<twiddle_counter> counter_;
+};
+
+TEST_CASE("twiddle registry") {
+    auto info = device_info{1024, {16, 32}, 128 * 1024, device_type::gpu};
+    auto counter = std::make_shared<twiddle_counter>();
+    auto api = counting_api(info, counter);
+    auto &registry = twiddle_registry<counting_api>::instance();
+    auto const make_plan = [&api](char const *desc) {
+        return select_fft_algorithm<counting_api>(parse_fft_descriptor(desc), api, nullptr);
+    };
+
+    SUBCASE("factor2 slm") {
+        auto p1 = make_plan("scfo2.256*64");
+        CHECK(counter->created == 1);
+        CHECK(registry.size() == 1);
+
+        // Batch size and in-place do not change the table
+        auto p2 = make_plan("scfi2.256*1000");
+        CHECK(counter->created == 1);
+        CHECK(registry.size() == 1);
+
+        // Direction and precision do
+        auto p3 = make_plan("scbo2.256*64");
+        auto p4 = make_plan("dcfo2.256*64");
+        CHECK(counter->created == 3);
+        CHECK(registry.size() == 3);
+
+        p1.reset();
+        CHECK(counter->released == 0);
+        p2.reset();
+        CHECK(counter->released == 1);
+        CHECK(registry.size() == 2);
+
+        // An expired table is uploaded again
+        p1 = make_plan("scfo2.256*64");
+        CHECK(counter->created == 4);
+        p1.reset();
+        p3.reset();
+        p4.reset();
+        CHECK(counter->released == 4);
+        CHECK(registry.size() == 0);
+    }
+
+    SUBCASE("bluestein") {
+        auto p1 = make_plan("scfo997*16");
+        auto const created = counter->created;
+        CHECK(created > 0);
+        auto p2 = make_plan("scfo997*32");
+        CHECK(counter->created == created);
+        p1.reset();
+        p2.reset();
+        CHECK(counter->released == created);
+        CHECK(registry.size() == 0);
+    }
+}
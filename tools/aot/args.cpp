@@ -47,6 +47,10 @@ args parse_args(int argc, char **argv) {
                            std::strcmp(argv[i], "--device_info") == 0) {
                     ++i;
                     a.info = parse_device_info(argv[i]);
+                } else if (std::strcmp(argv[i], "-w") == 0 ||
+                           std::strcmp(argv[i], "--wisdom") == 0) {
+                    ++i;
+                    a.wisdom_filename = std::string(argv[i]);
                 } else {
                     fail();
                 }
@@ -98,5 +102,6 @@ optional arguments:
     -f, --format        native or spirv (default: native)
     -d, --device        Target device
     -i, --device_info   Device info
+    -w, --wisdom        Wisdom file with tuning parameters that override the heuristics
 )HELP";
 }
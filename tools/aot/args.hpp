@@ -19,6 +19,7 @@ struct args {
     bbfft::module_format format;
     std::string device;
     bbfft::device_info info;
+    std::string wisdom_filename;
 };
 
 args parse_args(int argc, char **argv);
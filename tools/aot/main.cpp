@@ -7,14 +7,17 @@
 #include <bbfft/detail/compiler_options.hpp>
 #include <bbfft/device_info.hpp>
 #include <bbfft/generator.hpp>
+#include <bbfft/wisdom.hpp>
 #include <bbfft/ze/online_compiler.hpp>
 
 #include <cstdint>
 #include <exception>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace bbfft;
@@ -34,6 +37,17 @@ int main(int argc, char **argv) {
         return 0;
     }
 
+    if (!a.wisdom_filename.empty()) {
+        try {
+            auto w = std::make_shared<wisdom>();
+            w->load_file(a.wisdom_filename);
+            set_wisdom(std::move(w));
+        } catch (std::exception const &e) {
+            std::cerr << e.what() << std::endl;
+            return -1;
+        }
+    }
+
     auto kernel_file = std::ofstream(a.kernel_filename, std::ios::binary);
     if (!kernel_file) {
         std::cerr << "==> Could not open " << a.kernel_filename << " for writing." << std::endl;
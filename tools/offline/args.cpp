@@ -26,6 +26,10 @@ args parse_args(int argc, char **argv) {
             };
             if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0) {
                 a.help = true;
+            } else if (std::strcmp(argv[i], "-c") == 0 || std::strcmp(argv[i], "--cost") == 0) {
+                a.cost = true;
+            } else if (std::strcmp(argv[i], "-s") == 0 || std::strcmp(argv[i], "--stats") == 0) {
+                a.stats = true;
             } else if (i + 1 < argc) {
                 if (std::strcmp(argv[i], "-d") == 0 || std::strcmp(argv[i], "--device") == 0) {
                     ++i;
@@ -34,6 +38,10 @@ args parse_args(int argc, char **argv) {
                            std::strcmp(argv[i], "--device_info") == 0) {
                     ++i;
                     a.info = parse_device_info(argv[i]);
+                } else if (std::strcmp(argv[i], "-w") == 0 ||
+                           std::strcmp(argv[i], "--wisdom") == 0) {
+                    ++i;
+                    a.wisdom_filename = std::string(argv[i]);
                 } else {
                     fail();
                 }
@@ -68,7 +76,10 @@ positional arguments:
 
 optional arguments:
     -h, --help          Show help and quit
+    -c, --cost          Print cost estimate instead of OpenCL code
     -d, --device        Target device, optional if -i is given
+    -s, --stats         Print static kernel statistics instead of OpenCL code
     -i, --device_info   Device info, optional if -d is given
+    -w, --wisdom        Wisdom file with tuning parameters that override the heuristics
 )HELP";
 }
@@ -14,8 +14,11 @@
 struct args {
     std::vector<bbfft::configuration> configurations;
     bool help;
+    bool cost;
+    bool stats;
     std::string device;
     bbfft::device_info info;
+    std::string wisdom_filename;
 };
 
 args parse_args(int argc, char **argv);
@@ -4,11 +4,15 @@
 #include "args.hpp"
 
 #include <bbfft/configuration.hpp>
+#include <bbfft/cost.hpp>
 #include <bbfft/device_info.hpp>
 #include <bbfft/generator.hpp>
+#include <bbfft/wisdom.hpp>
 
 #include <exception>
 #include <iostream>
+#include <memory>
+#include <utility>
 
 using namespace bbfft;
 
@@ -27,6 +31,41 @@ int main(int argc, char **argv) {
         return 0;
     }
 
+    if (!a.wisdom_filename.empty()) {
+        try {
+            auto w = std::make_shared<wisdom>();
+            w->load_file(a.wisdom_filename);
+            set_wisdom(std::move(w));
+        } catch (std::exception const &e) {
+            std::cerr << e.what() << std::endl;
+            return -1;
+        }
+    }
+
+    if (a.cost) {
+        try {
+            for (auto const &cfg : a.configurations) {
+                std::cout << cfg << std::endl << estimate_cost(cfg, a.info);
+            }
+        } catch (std::exception const &e) {
+            std::cerr << e.what() << std::endl;
+            return -1;
+        }
+        return 0;
+    }
+
+    if (a.stats) {
+        try {
+            for (auto const &stats : generate_fft_kernel_statistics(a.configurations, a.info)) {
+                std::cout << stats << std::endl;
+            }
+        } catch (std::exception const &e) {
+            std::cerr << e.what() << std::endl;
+            return -1;
+        }
+        return 0;
+    }
+
     generate_fft_kernels(std::cout, a.configurations, a.info);
 
     return 0;